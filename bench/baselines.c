@@ -0,0 +1,143 @@
+/**
+ * @file baselines.c
+ * @brief Rendimiento de referencia de cada kernel (mínimo por píxel x100).
+ *
+ * En el dispositivo la unidad son ciclos a clk_sys; en el host, nanosegundos
+ * medidos en la máquina de desarrollo, así que su comparación solo detecta
+ * regresiones gruesas. Las entradas se regeneran con `minivision_bench
+ * update-baseline` (en el dispositivo, pegando la salida tras medir con 'p').
+ */
+
+#include "pico/stdlib.h"
+
+#include "golden.h"
+
+const struct golden_baseline golden_baselines[] = {
+#if PICO_ON_DEVICE
+	/* Sin medidas de referencia todavía: golden_perf informa SKIP por kernel */
+	{ NULL, 0, 0, 0 },
+#else
+	{ "convert/rgb565be_to_native_bytewise", 80, 60, 127 },
+	{ "convert/rgb565be_to_native_bytewise", 160, 120, 121 },
+	{ "convert/rgb565be_to_native", 80, 60, 79 },
+	{ "convert/rgb565be_to_native", 160, 120, 79 },
+	{ "convert/yuyv_to_rgb565", 80, 60, 661 },
+	{ "convert/yuyv_to_rgb565", 160, 120, 559 },
+	{ "convert/yuyv_to_y8", 80, 60, 83 },
+	{ "convert/yuyv_to_y8", 160, 120, 104 },
+	{ "convert/rgb565be_to_y8", 80, 60, 234 },
+	{ "convert/rgb565be_to_y8", 160, 120, 245 },
+	{ "convert/scale_nn_half", 80, 60, 33 },
+	{ "convert/scale_nn_half", 160, 120, 36 },
+	{ "convert/gamma_lut565", 80, 60, 184 },
+	{ "convert/gamma_lut565", 160, 120, 113 },
+	{ "convert/yuyv_to_rgb565_interp", 80, 60, 274 },
+	{ "convert/yuyv_to_rgb565_interp", 160, 120, 274 },
+	{ "convert/rgb565be_to_y8_interp", 80, 60, 104 },
+	{ "convert/rgb565be_to_y8_interp", 160, 120, 104 },
+	{ "convert/scale_nn_half_interp", 80, 60, 19 },
+	{ "convert/scale_nn_half_interp", 160, 120, 18 },
+	{ "convert/gamma_lut565_interp", 80, 60, 81 },
+	{ "convert/gamma_lut565_interp", 160, 120, 81 },
+	{ "fuse/unfused_scale_gamma", 80, 60, 43 },
+	{ "fuse/unfused_scale_gamma", 160, 120, 42 },
+	{ "fuse/fused_scale_gamma", 80, 60, 29 },
+	{ "fuse/fused_scale_gamma", 160, 120, 30 },
+	{ "fuse/fused_scale_gamma_generic", 80, 60, 55 },
+	{ "fuse/fused_scale_gamma_generic", 160, 120, 57 },
+	{ "filter/box3_y8", 80, 60, 215 },
+	{ "filter/box3_y8", 160, 120, 283 },
+	{ "analytics/histogram_rgb565", 80, 60, 316 },
+	{ "analytics/histogram_rgb565", 160, 120, 223 },
+	{ "analytics/histogram_yuyv", 80, 60, 93 },
+	{ "analytics/histogram_yuyv", 160, 120, 82 },
+	{ "analytics/histogram_yuv422", 80, 60, 87 },
+	{ "analytics/histogram_yuv422", 160, 120, 81 },
+	{ "analytics/histogram_roi_rgb565", 80, 60, 34 },
+	{ "analytics/histogram_roi_rgb565", 160, 120, 33 },
+	{ "analytics/histogram_roi_yuyv", 80, 60, 10 },
+	{ "analytics/histogram_roi_yuyv", 160, 120, 9 },
+	{ "equalize/global", 80, 60, 26 },
+	{ "equalize/global", 160, 120, 25 },
+	{ "equalize/clahe_convert", 80, 60, 174 },
+	{ "equalize/clahe_convert", 160, 120, 145 },
+	{ "equalize/clahe_apply", 80, 60, 296 },
+	{ "equalize/clahe_apply", 160, 120, 262 },
+	{ "denoise/y8", 80, 60, 94 },
+	{ "denoise/y8", 160, 120, 91 },
+	{ "denoise/rgb565", 80, 60, 245 },
+	{ "denoise/rgb565", 160, 120, 245 },
+	{ "hdr/merge_rgb565", 80, 60, 466 },
+	{ "hdr/merge_rgb565", 160, 120, 466 },
+	{ "lens/correct_rgb565", 80, 60, 324 },
+	{ "lens/correct_rgb565", 160, 120, 322 },
+	{ "lens/correct_y8", 80, 60, 149 },
+	{ "lens/correct_y8", 160, 120, 146 },
+	{ "warp/nearest_rgb565", 80, 60, 110 },
+	{ "warp/nearest_rgb565", 160, 120, 109 },
+	{ "warp/bilinear_rgb565", 80, 60, 543 },
+	{ "warp/bilinear_rgb565", 160, 120, 542 },
+	{ "warp/bilinear_y8", 80, 60, 324 },
+	{ "warp/bilinear_y8", 160, 120, 324 },
+	{ "rotate/naive90_rgb565", 80, 60, 30 },
+	{ "rotate/naive90_rgb565", 160, 120, 37 },
+	{ "rotate/90_rgb565", 80, 60, 16 },
+	{ "rotate/90_rgb565", 160, 120, 20 },
+	{ "rotate/180_rgb565", 80, 60, 39 },
+	{ "rotate/180_rgb565", 160, 120, 37 },
+	{ "rotate/270_rgb565", 80, 60, 16 },
+	{ "rotate/270_rgb565", 160, 120, 20 },
+	{ "rotate/naive90_y8", 80, 60, 26 },
+	{ "rotate/naive90_y8", 160, 120, 29 },
+	{ "rotate/90_y8", 80, 60, 20 },
+	{ "rotate/90_y8", 160, 120, 19 },
+	{ "rotate/inplace90_rgb565", 80, 60, 42 },
+	{ "rotate/inplace90_rgb565", 160, 120, 41 },
+	{ "match/ncc_pyramid", 80, 60, 1475 },
+	{ "match/ncc_pyramid", 160, 120, 576 },
+	{ "code/detect_qr", 80, 60, 61 },
+	{ "code/detect_qr", 160, 120, 47 },
+	{ "code/decode_qr", 80, 60, 168 },
+	{ "code/decode_qr", 160, 120, 68 },
+	{ "code/decode_ean13", 80, 60, 123 },
+	{ "code/decode_ean13", 160, 120, 145 },
+	{ "code/decode_code128", 80, 60, 122 },
+	{ "code/decode_code128", 160, 120, 249 },
+	{ "flow/select", 80, 60, 3864 },
+	{ "flow/select", 160, 120, 4678 },
+	{ "flow/track", 80, 60, 840 },
+	{ "flow/track", 160, 120, 247 },
+	{ "census/5x5", 80, 60, 281 },
+	{ "census/5x5", 160, 120, 310 },
+	{ "census/7x7_strip", 80, 60, 256 },
+	{ "census/7x7_strip", 160, 120, 298 },
+	{ "census/disparity", 80, 60, 258 },
+	{ "census/disparity", 160, 120, 133 },
+	{ "census/search", 80, 60, 413 },
+	{ "census/search", 160, 120, 222 },
+	{ "lbp/scene", 80, 60, 732 },
+	{ "lbp/scene", 160, 120, 1219 },
+	{ "lbp/rings", 80, 60, 753 },
+	{ "lbp/rings", 160, 120, 1232 },
+	{ "mono1/threshold_yuyv", 80, 60, 65 },
+	{ "mono1/threshold_yuyv", 160, 120, 64 },
+	{ "mono1/threshold_rgb565", 80, 60, 139 },
+	{ "mono1/threshold_rgb565", 160, 120, 136 },
+	{ "mono1/erode", 80, 60, 7 },
+	{ "mono1/erode", 160, 120, 5 },
+	{ "mono1/dilate", 80, 60, 7 },
+	{ "mono1/dilate", 160, 120, 5 },
+	{ "mono1/open", 80, 60, 15 },
+	{ "mono1/open", 160, 120, 9 },
+	{ "mono1/close", 80, 60, 14 },
+	{ "mono1/close", 160, 120, 9 },
+	{ "mono1/area", 80, 60, 4 },
+	{ "mono1/area", 160, 120, 3 },
+	{ "codec/stream_result", 80, 60, 76 },
+	{ "codec/stream_result", 160, 120, 19 },
+	{ "codec/stream_thumbnail", 80, 60, 124 },
+	{ "codec/stream_thumbnail", 160, 120, 119 },
+#endif
+};
+
+const unsigned int golden_num_baselines = sizeof(golden_baselines) / sizeof(golden_baselines[0]);
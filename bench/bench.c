@@ -0,0 +1,136 @@
+/**
+ * @file bench.c
+ * @brief Ejecución de los benchmarks y generación del informe.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#if PICO_ON_DEVICE
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#endif
+
+#include "camera/format.h"
+#include "runtime/cycles.h"
+#include "bench.h"
+
+/**
+ * @brief Rellena un buffer con un gradiente más ruido xorshift32.
+ */
+void bench_fill(uint8_t *dst, uint32_t len, uint32_t seed)
+{
+	uint32_t s = seed ? seed : 0x9e3779b9;
+
+	for (uint32_t i = 0; i < len; i++) {
+		s ^= s << 13;
+		s ^= s >> 17;
+		s ^= s << 5;
+		dst[i] = (uint8_t)((i >> 3) + (i >> 9)) ^ (s & 0x1f);
+	}
+}
+
+/**
+ * @brief Ejecuta una repetición del kernel y devuelve los ciclos consumidos.
+ *
+ * En el dispositivo las interrupciones se desactivan durante la medida para
+ * que el USB no contamine los ciclos.
+ */
+static uint32_t bench_measure_once(const struct bench_kernel *kernel, struct bench_ctx *ctx)
+{
+#if PICO_ON_DEVICE
+	uint32_t irq_state = save_and_disable_interrupts();
+#endif
+	uint32_t start = cycles_now();
+	kernel->run(ctx);
+	uint32_t elapsed = cycles_elapsed(start, cycles_now());
+#if PICO_ON_DEVICE
+	restore_interrupts(irq_state);
+#endif
+
+	return elapsed;
+}
+
+/**
+ * @brief Mide un kernel: una repetición de calentamiento y `iterations` repeticiones medidas.
+ * @return 0 en éxito, -1 en error.
+ */
+int bench_run(const struct bench_kernel *kernel, struct bench_ctx *ctx, uint32_t iterations,
+	      struct bench_result *result)
+{
+	uint32_t samples[BENCH_MAX_ITERATIONS];
+
+	if (!iterations || iterations > BENCH_MAX_ITERATIONS ||
+	    ctx->width > BENCH_MAX_WIDTH || ctx->height > BENCH_MAX_HEIGHT) {
+		return -1;
+	}
+
+	ctx->format = kernel->format;
+	if (kernel->setup) {
+		kernel->setup(ctx);
+	}
+
+	// Calentamiento: carga la caché XIP y los buffers
+	kernel->run(ctx);
+
+	xip_counters_reset();
+	for (uint32_t i = 0; i < iterations; i++) {
+		samples[i] = bench_measure_once(kernel, ctx);
+	}
+	xip_counters_read(&result->xip);
+
+	// Ordenación por inserción: pocas muestras
+	for (uint32_t i = 1; i < iterations; i++) {
+		uint32_t v = samples[i];
+		uint32_t j = i;
+		for (; j > 0 && samples[j - 1] > v; j--) {
+			samples[j] = samples[j - 1];
+		}
+		samples[j] = v;
+	}
+
+	result->iterations = iterations;
+	result->min = samples[0];
+	result->median = samples[iterations / 2];
+	result->max = samples[iterations - 1];
+
+	return 0;
+}
+
+/**
+ * @brief Imprime la cabecera del informe, con la plataforma y la unidad de medida.
+ */
+void bench_report_header(void)
+{
+#if PICO_ON_DEVICE
+	printf("# minivision-bench platform=device unit=cycles clk_hz=%lu\n",
+	       (unsigned long)clock_get_hz(clk_sys));
+#else
+	printf("# minivision-bench platform=host unit=ns clk_hz=0\n");
+#endif
+	printf("kernel,group,width,height,iterations,min,median,max,per_pixel_x100,xip_hit,xip_acc\n");
+}
+
+/**
+ * @brief Imprime una fila CSV con el resultado de un kernel.
+ */
+void bench_report(const struct bench_kernel *kernel, const struct bench_ctx *ctx, const struct bench_result *result)
+{
+	uint32_t pixels = (uint32_t)ctx->width * ctx->height;
+
+	printf("%s,%s,%u,%u,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+	       kernel->name, kernel->group, ctx->width, ctx->height,
+	       (unsigned long)result->iterations, (unsigned long)result->min,
+	       (unsigned long)result->median, (unsigned long)result->max,
+	       (unsigned long)(((uint64_t)result->median * 100 + pixels / 2) / pixels),
+	       (unsigned long)result->xip.hit, (unsigned long)result->xip.acc);
+}
+
+/**
+ * @brief Marca el final del informe para los lectores automáticos.
+ */
+void bench_report_footer(void)
+{
+	printf("# end\n");
+}
@@ -0,0 +1,103 @@
+/**
+ * @file bench.h
+ * @brief Registro y ejecución de microbenchmarks de kernels sobre frames sintéticos.
+ *
+ * El mismo registro se compila para el dispositivo (ciclos de SysTick y
+ * contadores de la caché XIP) y para el host (nanosegundos), de modo que los
+ * informes de ambas plataformas se pueden comparar lado a lado.
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+
+#include "runtime/xip.h"
+
+#define BENCH_MAX_WIDTH      160  /**< Ancho máximo de los frames sintéticos */
+#define BENCH_MAX_HEIGHT     120  /**< Alto máximo de los frames sintéticos */
+#define BENCH_MAX_BPP        2    /**< Bytes por píxel máximos de los frames sintéticos */
+#define BENCH_MAX_ITERATIONS 32   /**< Máximo de repeticiones medidas por kernel */
+
+/**
+ * @struct bench_ctx
+ * @brief Frames sintéticos y estado compartido por los kernels durante una medida.
+ */
+struct bench_ctx {
+    uint16_t width;     /**< Ancho del frame de prueba */
+    uint16_t height;    /**< Alto del frame de prueba */
+    uint32_t format;    /**< Formato del frame de entrada */
+    uint8_t *src;       /**< Frame de entrada */
+    uint8_t *dst;       /**< Buffer de salida */
+    uint8_t *aux;       /**< Buffer auxiliar (referencias, planos intermedios) */
+    uint32_t out_len;   /**< Bytes de dst escritos por la última ejecución (para los hashes golden) */
+};
+
+/**
+ * @struct bench_kernel
+ * @brief Entrada del registro de benchmarks.
+ */
+struct bench_kernel {
+    const char *name;                         /**< Nombre único del kernel */
+    const char *group;                        /**< Grupo: convert, swar, interp, fuse, filter, analytics, equalize, denoise, hdr, lens, warp, rotate, match, code, flow, census, lbp, mono1, codec, xfer, bus */
+    uint32_t format;                          /**< Formato del frame sintético de entrada */
+    void (*setup)(struct bench_ctx *ctx);     /**< Preparación fuera de la medida (opcional) */
+    void (*run)(struct bench_ctx *ctx);       /**< Cuerpo medido */
+};
+
+/**
+ * @struct bench_result
+ * @brief Resultado de la medida de un kernel.
+ */
+struct bench_result {
+    uint32_t iterations;        /**< Repeticiones medidas */
+    uint32_t min;               /**< Mínimo (ciclos o ns) */
+    uint32_t median;            /**< Mediana */
+    uint32_t max;               /**< Máximo */
+    struct xip_counters xip;    /**< Contadores XIP acumulados en todas las repeticiones */
+};
+
+extern const struct bench_kernel bench_kernels[];  /**< Registro de kernels */
+extern const unsigned int bench_num_kernels;       /**< Entradas del registro */
+
+/**
+ * @brief Rellena un buffer con un patrón sintético determinista (gradiente más ruido).
+ * @param dst  Buffer destino
+ * @param len  Longitud en bytes
+ * @param seed Semilla del ruido
+ */
+void bench_fill(uint8_t *dst, uint32_t len, uint32_t seed);
+
+/**
+ * @brief Prepara el kernel y lo mide.
+ *
+ * ctx->src debe contener ya el frame de entrada en el formato del kernel.
+ *
+ * @param kernel     Kernel a medir
+ * @param ctx        Contexto con los buffers ya reservados y el tamaño fijado
+ * @param iterations Repeticiones medidas (<= BENCH_MAX_ITERATIONS)
+ * @param result     Resultado de la medida
+ * @return 0 en éxito, -1 si los parámetros no son válidos
+ */
+int bench_run(const struct bench_kernel *kernel, struct bench_ctx *ctx, uint32_t iterations,
+              struct bench_result *result);
+
+/**
+ * @brief Imprime la cabecera del informe CSV.
+ */
+void bench_report_header(void);
+
+/**
+ * @brief Imprime una fila del informe CSV.
+ * @param kernel Kernel medido
+ * @param ctx    Contexto de la medida
+ * @param result Resultado
+ */
+void bench_report(const struct bench_kernel *kernel, const struct bench_ctx *ctx, const struct bench_result *result);
+
+/**
+ * @brief Imprime el cierre del informe.
+ */
+void bench_report_footer(void);
+
+#endif /* __BENCH_H__ */
@@ -0,0 +1,1241 @@
+/**
+ * @file bench_kernels.c
+ * @brief Registro de kernels medidos por el runner de benchmarks.
+ *
+ * Cada entrada envuelve un kernel de la librería con la firma común de
+ * bench_kernel. Las transferencias SPI/DMA solo existen en el dispositivo.
+ */
+
+#include <string.h>
+
+#include "pico/stdlib.h"
+#if PICO_ON_DEVICE
+#include "hardware/dma.h"
+#include "hardware/spi.h"
+#endif
+
+#include "camera/format.h"
+#include "runtime/placement.h"
+#include "stream/stream.h"
+#include "vision/census.h"
+#include "vision/clahe.h"
+#include "vision/code.h"
+#include "vision/convert.h"
+#include "vision/denoise.h"
+#include "vision/filter.h"
+#include "vision/flow.h"
+#include "vision/fuse.h"
+#include "vision/hdr.h"
+#include "vision/histogram.h"
+#include "vision/lbp.h"
+#include "vision/lens.h"
+#include "vision/match.h"
+#include "vision/mono1.h"
+#include "vision/rotate.h"
+#include "vision/view.h"
+#include "vision/warp.h"
+#include "bench.h"
+
+/** @name Conversión de formato
+ *  @{
+ */
+
+/** @brief Versión byte a byte del intercambio RGB565, como el bucle original de pruebas_PIO. */
+static void run_rgb565be_to_native_bytewise(struct bench_ctx *ctx)
+{
+	uint32_t n = (uint32_t)ctx->width * ctx->height;
+	uint16_t *dst = (uint16_t *)ctx->dst;
+
+	for (uint32_t i = 0; i < n; i++) {
+		dst[i] = ctx->src[2 * i + 1] | (ctx->src[2 * i] << 8);
+	}
+	ctx->out_len = n * 2;
+}
+
+static void run_rgb565be_to_native(struct bench_ctx *ctx)
+{
+	convert_rgb565be_to_native((uint16_t *)ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_yuyv_to_rgb565(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_rgb565((uint16_t *)ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_yuyv_to_y8(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_y8(ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void run_rgb565be_to_y8(struct bench_ctx *ctx)
+{
+	convert_rgb565be_to_y8(ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void run_scale_nn_half(struct bench_ctx *ctx)
+{
+	convert_scale_nn_rgb565be((uint16_t *)ctx->dst, ctx->width / 2, ctx->height / 2,
+				  ctx->src, ctx->width * 2, ctx->width, ctx->height);
+	ctx->out_len = (uint32_t)(ctx->width / 2) * (ctx->height / 2) * 2;
+}
+
+static struct convert_lut565 gamma_lut565;
+
+static void setup_gamma_lut565(struct bench_ctx *ctx)
+{
+	uint8_t lut8[256];
+
+	convert_gamma_lut8(lut8, 0.45f);
+	convert_lut565_from_lut8(&gamma_lut565, lut8);
+	convert_rgb565be_to_native((uint16_t *)ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+}
+
+static void run_gamma_lut565(struct bench_ctx *ctx)
+{
+	convert_apply_lut565((uint16_t *)ctx->dst, (const uint16_t *)ctx->aux,
+			     (uint32_t)ctx->width * ctx->height, &gamma_lut565);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+/** @} */
+
+/** @name Variantes con interpoladores (comparar con las de arriba)
+ *  @{
+ */
+
+static void run_yuyv_to_rgb565_interp(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_rgb565_interp((uint16_t *)ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_rgb565be_to_y8_interp(struct bench_ctx *ctx)
+{
+	convert_rgb565be_to_y8_interp(ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void run_scale_nn_half_interp(struct bench_ctx *ctx)
+{
+	convert_scale_nn_rgb565be_interp((uint16_t *)ctx->dst, ctx->width / 2, ctx->height / 2,
+					 ctx->src, ctx->width * 2, ctx->width, ctx->height);
+	ctx->out_len = (uint32_t)(ctx->width / 2) * (ctx->height / 2) * 2;
+}
+
+static void run_gamma_lut565_interp(struct bench_ctx *ctx)
+{
+	convert_apply_lut565_interp((uint16_t *)ctx->dst, (const uint16_t *)ctx->aux,
+				    (uint32_t)ctx->width * ctx->height, &gamma_lut565);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+/** @} */
+
+/** @name Cadenas fusionadas (intercambio + escala + gamma)
+ *
+ * Las tres variantes producen la misma salida: en pasadas separadas, fusionada
+ * con el bucle especializado y fusionada con la LUT como operación genérica.
+ *  @{
+ */
+
+static void run_unfused_scale_gamma(struct bench_ctx *ctx)
+{
+	uint16_t w = ctx->width / 2, h = ctx->height / 2;
+
+	convert_scale_nn_rgb565be((uint16_t *)ctx->aux, w, h, ctx->src, ctx->width * 2, ctx->width, ctx->height);
+	convert_apply_lut565((uint16_t *)ctx->dst, (const uint16_t *)ctx->aux, (uint32_t)w * h, &gamma_lut565);
+	ctx->out_len = (uint32_t)w * h * 2;
+}
+
+static void run_fused_scale_gamma(struct bench_ctx *ctx)
+{
+	struct fuse_chain chain;
+	uint16_t w = ctx->width / 2, h = ctx->height / 2;
+
+	fuse_init(&chain);
+	fuse_set_lut(&chain, &gamma_lut565);
+	fuse_run_rgb565be(&chain, (uint16_t *)ctx->dst, w, h, ctx->src, ctx->width * 2, ctx->width, ctx->height);
+	ctx->out_len = (uint32_t)w * h * 2;
+}
+
+static uint16_t fuse_lut_op(uint16_t v, void *ctx)
+{
+	const struct convert_lut565 *lut = ctx;
+
+	return lut->r[v >> 11] | lut->g[(v >> 5) & 0x3f] | lut->b[v & 0x1f];
+}
+
+static void run_fused_scale_gamma_generic(struct bench_ctx *ctx)
+{
+	struct fuse_chain chain;
+	uint16_t w = ctx->width / 2, h = ctx->height / 2;
+
+	fuse_init(&chain);
+	fuse_add_pixel(&chain, fuse_lut_op, &gamma_lut565);
+	fuse_run_rgb565be(&chain, (uint16_t *)ctx->dst, w, h, ctx->src, ctx->width * 2, ctx->width, ctx->height);
+	ctx->out_len = (uint32_t)w * h * 2;
+}
+
+/** @} */
+
+/** @name Filtros y analítica
+ *  @{
+ */
+
+static void setup_y8(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+}
+
+static void run_box3_y8(struct bench_ctx *ctx)
+{
+	filter_box3_y8(ctx->dst, ctx->width, ctx->aux, ctx->width, ctx->width, ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+/** @brief Histograma sobre el plano 0 del formato del kernel; el resultado queda en dst. */
+static void run_histogram(struct bench_ctx *ctx)
+{
+	struct histogram *hist = (struct histogram *)ctx->dst;
+	uint32_t stride = format_stride(ctx->format, 0, ctx->width);
+
+	histogram_reset(hist);
+	histogram_accumulate(hist, ctx->format, ctx->src, stride, ctx->width, ctx->height);
+	ctx->out_len = sizeof(*hist);
+}
+
+/** @brief Histograma de la mitad central del frame a través de una subvista, sin copiarla. */
+static void run_histogram_roi(struct bench_ctx *ctx)
+{
+	struct histogram *hist = (struct histogram *)ctx->dst;
+	struct image_view view, roi;
+
+	image_view_wrap(&view, ctx->format, ctx->src, format_stride(ctx->format, 0, ctx->width), ctx->width,
+			ctx->height);
+	image_view_crop(&roi, &view, ctx->width / 4, ctx->height / 4, ctx->width / 2, ctx->height / 2);
+
+	histogram_reset(hist);
+	histogram_accumulate(hist, roi.format, roi.data, roi.stride, roi.width, roi.height);
+	ctx->out_len = sizeof(*hist);
+}
+
+/** @} */
+
+/** @name Ecualización global y CLAHE
+ *  @{
+ */
+
+#define BENCH_CLAHE_TILES 4   /**< Teselas por eje */
+#define BENCH_CLAHE_CLIP  30  /**< Límite de contraste x10 */
+
+static struct clahe bench_clahe;
+static uint8_t equalize_lut[256];
+
+static void setup_clahe(struct bench_ctx *ctx)
+{
+	clahe_init(&bench_clahe, ctx->width, ctx->height, BENCH_CLAHE_TILES, BENCH_CLAHE_TILES, BENCH_CLAHE_CLIP);
+}
+
+/** @brief Conversión a luma con los histogramas de las teselas en la misma pasada. */
+static void run_clahe_convert(struct bench_ctx *ctx)
+{
+	clahe_reset(&bench_clahe);
+	clahe_convert_rgb565be(&bench_clahe, ctx->dst, ctx->width, ctx->src, ctx->width * 2);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void setup_clahe_apply(struct bench_ctx *ctx)
+{
+	setup_clahe(ctx);
+	clahe_convert_rgb565be(&bench_clahe, ctx->aux, ctx->width, ctx->src, ctx->width * 2);
+}
+
+/** @brief LUT de las teselas y salida interpolada (la parte que depende del frame completo). */
+static void run_clahe_apply(struct bench_ctx *ctx)
+{
+	clahe_build_luts(&bench_clahe);
+	clahe_apply(&bench_clahe, ctx->dst, ctx->width, ctx->aux, ctx->width);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void setup_equalize(struct bench_ctx *ctx)
+{
+	struct histogram hist;
+
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+	histogram_reset(&hist);
+	histogram_accumulate(&hist, FORMAT_YUYV, ctx->src, ctx->width * 2, ctx->width, ctx->height);
+	histogram_equalize_lut(&hist, equalize_lut);
+}
+
+static void run_equalize(struct bench_ctx *ctx)
+{
+	convert_apply_lut8(ctx->dst, ctx->aux, (uint32_t)ctx->width * ctx->height, equalize_lut);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+/** @} */
+
+/** @name Reducción temporal de ruido
+ *
+ * dst es el frame nuevo y aux la referencia: el mismo frame con ruido de
+ * hasta 7 niveles y el primer cuarto de las filas invertido (movimiento). Las
+ * repeticiones de la medida filtran sobre el resultado anterior.
+ *  @{
+ */
+
+#define BENCH_DENOISE_SHIFT  2   /**< Peso del frame nuevo: 1/4 */
+#define BENCH_DENOISE_MOTION 24  /**< Umbral de movimiento */
+
+static void setup_denoise_ref(struct bench_ctx *ctx, uint32_t len)
+{
+	uint32_t moving = len / 4;
+
+	for (uint32_t i = 0; i < len; i++) {
+		ctx->aux[i] = i < moving ? (uint8_t)~ctx->dst[i] : (uint8_t)(ctx->dst[i] ^ (i & 7));
+	}
+}
+
+static void setup_denoise_y8(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_y8(ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height);
+	setup_denoise_ref(ctx, (uint32_t)ctx->width * ctx->height);
+}
+
+static void run_denoise_y8(struct bench_ctx *ctx)
+{
+	denoise_y8(ctx->dst, ctx->aux, (uint32_t)ctx->width * ctx->height, BENCH_DENOISE_SHIFT, BENCH_DENOISE_MOTION);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void setup_denoise_rgb565(struct bench_ctx *ctx)
+{
+	memcpy(ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height * 2);
+	setup_denoise_ref(ctx, (uint32_t)ctx->width * ctx->height * 2);
+}
+
+static void run_denoise_rgb565(struct bench_ctx *ctx)
+{
+	denoise_rgb565be(ctx->dst, ctx->aux, (uint32_t)ctx->width * ctx->height, BENCH_DENOISE_SHIFT,
+			 BENCH_DENOISE_MOTION);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+/** @} */
+
+/** @name Fusión HDR
+ *
+ * El frame largo es src y el corto, en aux, es src con cada canal a la mitad.
+ *  @{
+ */
+
+#define BENCH_HDR_SHORT 100  /**< Exposición del frame corto */
+#define BENCH_HDR_LONG  400  /**< Exposición del frame largo */
+
+static struct hdr_merge bench_hdr;
+
+static void setup_hdr(struct bench_ctx *ctx)
+{
+	uint32_t n = (uint32_t)ctx->width * ctx->height;
+
+	hdr_merge_init(&bench_hdr, BENCH_HDR_LONG, BENCH_HDR_SHORT);
+	for (uint32_t i = 0; i < n; i++) {
+		uint16_t v = (ctx->src[2 * i] << 8) | ctx->src[2 * i + 1];
+		uint16_t s = (v >> 1) & 0x7bef;
+		ctx->aux[2 * i] = s >> 8;
+		ctx->aux[2 * i + 1] = s & 0xff;
+	}
+}
+
+static void run_hdr_merge(struct bench_ctx *ctx)
+{
+	hdr_merge_rgb565be(&bench_hdr, ctx->dst, ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+/** @} */
+
+/** @name Corrección de lente
+ *
+ * Rejilla radial con corrección de barril y viñeteo; en Y8 la entrada es la
+ * luma de src en aux.
+ *  @{
+ */
+
+static struct lens_calib bench_lens;
+
+static void setup_lens(struct bench_ctx *ctx)
+{
+	lens_calib_radial(&bench_lens, ctx->width, ctx->height, -0.12f, 0.01f, 0.5f);
+}
+
+static void setup_lens_y8(struct bench_ctx *ctx)
+{
+	setup_lens(ctx);
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+}
+
+static void run_lens_rgb565(struct bench_ctx *ctx)
+{
+	lens_correct_rgb565be(&bench_lens, ctx->dst, ctx->width * 2, ctx->src, ctx->width * 2);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_lens_y8(struct bench_ctx *ctx)
+{
+	lens_correct_y8(&bench_lens, ctx->dst, ctx->width, ctx->aux, ctx->width);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+/** @} */
+
+/** @name Rectificación de perspectiva
+ *
+ * Un trapecio del frame se lleva a una salida del mismo tamaño, de modo que
+ * el coste por píxel es el de cada píxel de salida.
+ *  @{
+ */
+
+static struct warp bench_warp;
+static struct camera_buffer bench_warp_src;
+
+static void setup_warp(struct bench_ctx *ctx)
+{
+	const float w = ctx->width, h = ctx->height;
+	const float quad[4][2] = {
+		{ 0.20f * w, 0.10f * h },
+		{ 0.85f * w, 0.20f * h },
+		{ 0.95f * w, 0.90f * h },
+		{ 0.05f * w, 0.80f * h },
+	};
+
+	warp_init_quad(&bench_warp, quad, ctx->width, ctx->height);
+	bench_warp_src = (struct camera_buffer){
+		.format = ctx->format,
+		.width = ctx->width,
+		.height = ctx->height,
+		.strides = { format_stride(ctx->format, 0, ctx->width) },
+		.data = { ctx->src },
+	};
+}
+
+static void run_warp_nearest_rgb565(struct bench_ctx *ctx)
+{
+	warp_perspective(&bench_warp, ctx->dst, ctx->width * 2, &bench_warp_src, WARP_NEAREST);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_warp_bilinear_rgb565(struct bench_ctx *ctx)
+{
+	warp_perspective(&bench_warp, ctx->dst, ctx->width * 2, &bench_warp_src, WARP_BILINEAR);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_warp_bilinear_y8(struct bench_ctx *ctx)
+{
+	warp_perspective(&bench_warp, ctx->dst, ctx->width, &bench_warp_src, WARP_BILINEAR);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+/** @} */
+
+/** @name Rotación y trasposición
+ *
+ * naive* es el bucle directo píxel a píxel, para comparar con los kernels por
+ * bloques. El giro en el sitio trabaja sobre el cuadrado de lado el alto del
+ * frame copiado en dst; las repeticiones de la medida giran el resultado
+ * anterior.
+ *  @{
+ */
+
+static void bench_rotate_naive90(uint8_t *dst, const uint8_t *src, uint16_t width, uint16_t height, uint8_t bpp)
+{
+	for (uint16_t y = 0; y < height; y++) {
+		for (uint16_t x = 0; x < width; x++) {
+			uint8_t *d = dst + ((uint32_t)x * height + height - 1 - y) * bpp;
+			const uint8_t *s = src + ((uint32_t)y * width + x) * bpp;
+			memcpy(d, s, bpp);
+		}
+	}
+}
+
+static void run_rotate_naive90_rgb565(struct bench_ctx *ctx)
+{
+	bench_rotate_naive90(ctx->dst, ctx->src, ctx->width, ctx->height, 2);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_rotate_90_rgb565(struct bench_ctx *ctx)
+{
+	rotate_plane16(ctx->dst, ctx->height * 2, ctx->src, ctx->width * 2, ctx->width, ctx->height, ROTATE_90);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_rotate_180_rgb565(struct bench_ctx *ctx)
+{
+	rotate_plane16(ctx->dst, ctx->width * 2, ctx->src, ctx->width * 2, ctx->width, ctx->height, ROTATE_180);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void run_rotate_270_rgb565(struct bench_ctx *ctx)
+{
+	rotate_plane16(ctx->dst, ctx->height * 2, ctx->src, ctx->width * 2, ctx->width, ctx->height, ROTATE_270);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void setup_rotate_y8(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+}
+
+static void run_rotate_naive90_y8(struct bench_ctx *ctx)
+{
+	bench_rotate_naive90(ctx->dst, ctx->aux, ctx->width, ctx->height, 1);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void run_rotate_90_y8(struct bench_ctx *ctx)
+{
+	rotate_plane8(ctx->dst, ctx->height, ctx->aux, ctx->width, ctx->width, ctx->height, ROTATE_90);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height;
+}
+
+static void setup_rotate_inplace(struct bench_ctx *ctx)
+{
+	memcpy(ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height * 2);
+}
+
+static void run_rotate_inplace90_rgb565(struct bench_ctx *ctx)
+{
+	rotate_square16_inplace(ctx->dst, ctx->width * 2, ctx->height, ROTATE_90);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+/** @} */
+
+/** @name Búsqueda de plantillas
+ *
+ * La plantilla es un recorte de 32x32 de la luma del frame (en aux) en una
+ * posición impar, con el contraste reducido; dst recibe el resultado y, a
+ * continuación, los niveles reducidos.
+ *  @{
+ */
+
+#define BENCH_MATCH_SIDE 32  /**< Lado de la plantilla */
+
+static struct match_template bench_match;
+
+static void setup_match(struct bench_ctx *ctx)
+{
+	uint8_t tmpl[BENCH_MATCH_SIDE * BENCH_MATCH_SIDE];
+	uint32_t x0 = (ctx->width - BENCH_MATCH_SIDE) / 2 | 1, y0 = ctx->height / 4 | 1;
+
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+	for (uint32_t y = 0; y < BENCH_MATCH_SIDE; y++) {
+		for (uint32_t x = 0; x < BENCH_MATCH_SIDE; x++) {
+			tmpl[y * BENCH_MATCH_SIDE + x] = ctx->aux[(y0 + y) * ctx->width + x0 + x] * 3 / 4 + 16;
+		}
+	}
+	match_template_init(&bench_match, tmpl, BENCH_MATCH_SIDE, BENCH_MATCH_SIDE, BENCH_MATCH_SIDE);
+}
+
+static void run_match_ncc(struct bench_ctx *ctx)
+{
+	struct match_result result;
+
+	match_find(&bench_match, ctx->aux, ctx->width, ctx->width, ctx->height, ctx->dst + sizeof(result), &result);
+	memcpy(ctx->dst, &result, sizeof(result));
+	ctx->out_len = sizeof(result);
+}
+
+/** @} */
+
+/** @name Lectura de códigos
+ *
+ * La máscara de entrada (en aux) es la luma del frame umbralizada con un
+ * código pegado encima, rodeado de su zona de silencio: un QR 1-M con algo de
+ * perspectiva (escalado con el frame) o una fila de barras de un píxel por
+ * módulo, que a 80x60 no cabe y mide el rechazo. dst recibe los resultados.
+ *  @{
+ */
+
+#define BENCH_CODE_THRESHOLD 128  /**< Umbral de luma de la máscara de fondo */
+#define BENCH_CODE_QUIET     10   /**< Zona de silencio de las barras en píxeles */
+
+/** QR 1-M con "MINIVISION" (máscara 2): bit u de la fila v a 1 = módulo oscuro */
+static const uint32_t bench_code_qr[21] = {
+	0x1fc47f, 0x104e41, 0x17595d, 0x174b5d, 0x17555d, 0x104f41, 0x1fd57f, 0x000500, 0x07ca7d, 0x00f815, 0x04d072,
+	0x1d7905, 0x1b1764, 0x189500, 0x02287f, 0x0e8741, 0x08295d, 0x057b5d, 0x07555d, 0x177e41, 0x00157f,
+};
+
+/** EAN-13 8412345678905: 95 módulos, bit a 1 = barra */
+static const uint32_t bench_code_ean13[3] = { 0x42c99b15, 0x221551ae, 0x5729cb89 };
+
+/** Code 128 "RP2040" (juego B): 101 módulos, bit a 1 = barra */
+static const uint32_t bench_code_128[4] = { 0xdddd184b, 0xc99b94e6, 0xe37166e5, 0x0000001a };
+
+static struct code_reader bench_code_reader;
+
+/**
+ * @brief Pone a claro (1) o a oscuro (0) un píxel de la máscara.
+ */
+static void bench_code_set(uint32_t *mask, uint32_t words, uint32_t x, uint32_t y, bool light)
+{
+	if (light) {
+		mask[y * words + x / 32] |= 1u << (x % 32);
+	} else {
+		mask[y * words + x / 32] &= ~(1u << (x % 32));
+	}
+}
+
+static void setup_code_qr(struct bench_ctx *ctx)
+{
+	const uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width), words = stride / 4;
+	const float sx = ctx->width / 80.0f, sy = ctx->height / 60.0f;
+	const float quad[4][2] = {
+		{ 16 * sx, 7 * sy }, { 62 * sx, 9 * sy }, { 60 * sx, 53 * sy }, { 14 * sx, 50 * sy },
+	};
+	const float modules[4][2] = { { 0, 0 }, { 21, 0 }, { 21, 21 }, { 0, 21 } };
+	uint32_t *mask = (uint32_t *)ctx->aux;
+	struct warp warp;
+
+	mono1_threshold(mask, stride, ctx->format, ctx->src, format_stride(ctx->format, 0, ctx->width), ctx->width,
+			ctx->height, BENCH_CODE_THRESHOLD);
+
+	// Cada píxel del recuadro se lleva a coordenadas de módulo; fuera del
+	// código (hasta 4 módulos) queda claro
+	warp_init_points(&warp, quad, modules, ctx->width, ctx->height);
+	for (uint32_t y = 0; y < ctx->height; y++) {
+		for (uint32_t x = 0; x < ctx->width; x++) {
+			int32_t u, v;
+
+			warp_map(&warp, x, y, &u, &v);
+			u = u < 0 ? -1 - (-u >> 16) : u >> 16;
+			v = v < 0 ? -1 - (-v >> 16) : v >> 16;
+			if (u < -4 || u >= 25 || v < -4 || v >= 25) {
+				continue;
+			}
+			bool dark = u >= 0 && u < 21 && v >= 0 && v < 21 && ((bench_code_qr[v] >> u) & 1);
+			bench_code_set(mask, words, x, y, !dark);
+		}
+	}
+}
+
+/**
+ * @brief Pega una fila de barras centrada en la mitad central del frame, si cabe.
+ */
+static void bench_code_paste_bars(struct bench_ctx *ctx, const uint32_t *bars, uint32_t modules)
+{
+	const uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width), words = stride / 4;
+	uint32_t *mask = (uint32_t *)ctx->aux;
+
+	mono1_threshold(mask, stride, ctx->format, ctx->src, format_stride(ctx->format, 0, ctx->width), ctx->width,
+			ctx->height, BENCH_CODE_THRESHOLD);
+	if (ctx->width < modules + 2 * BENCH_CODE_QUIET) {
+		return;
+	}
+
+	const uint32_t x0 = (ctx->width - modules) / 2;
+	for (uint32_t y = ctx->height / 4; y < ctx->height * 3 / 4; y++) {
+		for (uint32_t x = x0 - BENCH_CODE_QUIET; x < x0 + modules + BENCH_CODE_QUIET; x++) {
+			uint32_t m = x - x0;
+			bool dark = x >= x0 && m < modules && ((bars[m / 32] >> (m % 32)) & 1);
+
+			bench_code_set(mask, words, x, y, !dark);
+		}
+	}
+}
+
+static void setup_code_ean13(struct bench_ctx *ctx)
+{
+	bench_code_paste_bars(ctx, bench_code_ean13, 95);
+}
+
+static void setup_code_128(struct bench_ctx *ctx)
+{
+	bench_code_paste_bars(ctx, bench_code_128, 101);
+}
+
+static void run_code_detect(struct bench_ctx *ctx)
+{
+	const struct code_reader *reader = &bench_code_reader;
+	int32_t *out = (int32_t *)ctx->dst;
+
+	code_detect(&bench_code_reader, (const uint32_t *)ctx->aux, format_stride(FORMAT_MONO1, 0, ctx->width),
+		    ctx->width, ctx->height);
+
+	// Candidatos en enteros (centros y módulos en Q4), sin el relleno de las estructuras
+	*out++ = reader->n_finders;
+	*out++ = reader->n_rows;
+	for (int i = 0; i < reader->n_finders; i++) {
+		*out++ = reader->finders[i].x * 16;
+		*out++ = reader->finders[i].y * 16;
+		*out++ = reader->finders[i].module * 16;
+		*out++ = reader->finders[i].hits;
+	}
+	for (int i = 0; i < reader->n_rows; i++) {
+		*out++ = reader->rows[i].y << 16 | reader->rows[i].x0;
+		*out++ = reader->rows[i].x1;
+	}
+	ctx->out_len = (uint8_t *)out - ctx->dst;
+}
+
+static void run_code_decode(struct bench_ctx *ctx)
+{
+	const uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width);
+	struct code_result *results = (struct code_result *)ctx->dst;
+
+	memset(results, 0, 4 * sizeof(*results));
+	code_detect(&bench_code_reader, (const uint32_t *)ctx->aux, stride, ctx->width, ctx->height);
+	int n = code_decode(&bench_code_reader, (const uint32_t *)ctx->aux, stride, ctx->width, ctx->height, results, 4);
+	ctx->out_len = n * sizeof(*results);
+}
+
+/** @} */
+
+/** @name Flujo óptico
+ *
+ * aux tiene la luma del frame y, a continuación, la misma luma desplazada
+ * (2.5, 1) píxeles. La pirámide del frame anterior y los puntos se preparan
+ * fuera de la medida; track incluye la pirámide del frame nuevo. dst recibe
+ * los puntos o los vectores y, a partir de BENCH_FLOW_WORK, los niveles
+ * reducidos.
+ *  @{
+ */
+
+#define BENCH_FLOW_WORK 1024  /**< Desplazamiento en dst de los niveles reducidos */
+
+static struct flow_pyramid bench_flow_prev;
+static struct flow_point bench_flow_points[FLOW_MAX_POINTS];
+static int bench_flow_n;
+
+static void setup_flow(struct bench_ctx *ctx)
+{
+	const uint32_t n = (uint32_t)ctx->width * ctx->height;
+	uint8_t *next = ctx->aux + n;
+
+	convert_yuyv_to_y8(ctx->aux, ctx->src, n);
+	for (uint32_t y = 0; y < ctx->height; y++) {
+		const uint8_t *row = ctx->aux + (y ? y - 1 : 0) * ctx->width;
+
+		for (uint32_t x = 0; x < ctx->width; x++) {
+			uint32_t x0 = x >= 3 ? x - 3 : 0, x1 = x >= 2 ? x - 2 : 0;
+
+			next[y * ctx->width + x] = (row[x0] + row[x1] + 1) >> 1;
+		}
+	}
+	flow_pyramid_init(&bench_flow_prev, ctx->aux, ctx->width, ctx->width, ctx->height, ctx->dst + BENCH_FLOW_WORK);
+	bench_flow_n = flow_select(&bench_flow_prev, bench_flow_points, FLOW_MAX_POINTS);
+}
+
+static void run_flow_select(struct bench_ctx *ctx)
+{
+	struct flow_point *points = (struct flow_point *)ctx->dst;
+
+	ctx->out_len = flow_select(&bench_flow_prev, points, FLOW_MAX_POINTS) * sizeof(*points);
+}
+
+static void run_flow_track(struct bench_ctx *ctx)
+{
+	const uint32_t n = (uint32_t)ctx->width * ctx->height;
+	struct flow_vector *vectors = (struct flow_vector *)ctx->dst;
+	struct flow_pyramid next;
+
+	flow_pyramid_init(&next, ctx->aux + n, ctx->width, ctx->width, ctx->height,
+			  ctx->dst + BENCH_FLOW_WORK + FLOW_WORK_SIZE(ctx->width, ctx->height));
+	flow_track(&bench_flow_prev, &next, bench_flow_points, bench_flow_n, vectors);
+	ctx->out_len = bench_flow_n * sizeof(*vectors);
+}
+
+/** @} */
+
+/** @name Census y Hamming
+ *
+ * Las transformadas recorren la mitad superior de la luma del frame (en aux),
+ * que es lo que cabe en dst: census_transform() con 5x5 y census_push_row()
+ * fila a fila con 7x7 en damero (el anillo va en aux tras la luma). Para
+ * disparity y search, aux tiene los descriptores 5x5 de una franja de
+ * BENCH_CENSUS_BAND filas de la luma y de la misma luma desplazada
+ * BENCH_CENSUS_SHIFT píxeles a la izquierda y con otro contraste.
+ *  @{
+ */
+
+#define BENCH_CENSUS_BAND  8   /**< Filas de descriptores válidos de la franja */
+#define BENCH_CENSUS_SHIFT 4   /**< Disparidad de la franja derecha */
+#define BENCH_CENSUS_BLOCK 2   /**< Radio del bloque de search */
+#define BENCH_CENSUS_RANGE 6   /**< Radio de la búsqueda de search */
+
+static void setup_census(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+}
+
+static void run_census_5x5(struct bench_ctx *ctx)
+{
+	census_transform((uint32_t *)ctx->dst, ctx->width * 4, ctx->aux, ctx->width, ctx->width, ctx->height / 2,
+			 CENSUS_5X5);
+	ctx->out_len = (uint32_t)ctx->width * (ctx->height / 2) * 4;
+}
+
+static void run_census_7x7_strip(struct bench_ctx *ctx)
+{
+	uint8_t *ring = ctx->aux + (uint32_t)ctx->width * ctx->height;
+	uint32_t *dst = (uint32_t *)ctx->dst;
+	struct census cs;
+	int rows = 0;
+
+	census_init(&cs, CENSUS_7X7_SPARSE, ctx->width, ring);
+	for (uint32_t y = 0; y < ctx->height / 2u; y++) {
+		if (census_push_row(&cs, ctx->aux + y * ctx->width, dst + (uint32_t)rows * ctx->width) >= 0) {
+			rows++;
+		}
+	}
+	ctx->out_len = (uint32_t)rows * ctx->width * 4;
+}
+
+static void setup_census_band(struct bench_ctx *ctx)
+{
+	const uint32_t n = (uint32_t)ctx->width * ctx->height, rows = BENCH_CENSUS_BAND + 4;
+	const uint32_t y0 = (ctx->height - rows) / 2;
+	uint8_t *left = ctx->dst, *right = ctx->dst + n;
+
+	// Las lumas van en dst, que los kernels sobrescriben después
+	convert_yuyv_to_y8(left, ctx->src, n);
+	for (uint32_t y = 0; y < ctx->height; y++) {
+		for (uint32_t x = 0; x < ctx->width; x++) {
+			uint32_t sx = x + BENCH_CENSUS_SHIFT < ctx->width ? x + BENCH_CENSUS_SHIFT : ctx->width - 1u;
+
+			right[y * ctx->width + x] = left[y * ctx->width + sx] * 3 / 4 + 24;
+		}
+	}
+	census_transform((uint32_t *)ctx->aux, ctx->width * 4, left + y0 * ctx->width, ctx->width, ctx->width, rows,
+			 CENSUS_5X5);
+	census_transform((uint32_t *)ctx->aux + rows * ctx->width, ctx->width * 4, right + y0 * ctx->width, ctx->width,
+			 ctx->width, rows, CENSUS_5X5);
+}
+
+static void run_census_disparity(struct bench_ctx *ctx)
+{
+	const uint32_t rows = BENCH_CENSUS_BAND + 4;
+	const uint32_t *left = (const uint32_t *)ctx->aux, *right = left + rows * ctx->width;
+	uint8_t *out = ctx->dst;
+
+	for (uint32_t y = 2; y < rows - 2; y++) {
+		census_disparity_row(left + y * ctx->width, right + y * ctx->width, ctx->width, 16, out,
+				     (uint16_t *)(out + ctx->width));
+		out += 3 * ctx->width;
+	}
+	ctx->out_len = out - ctx->dst;
+}
+
+static void run_census_search(struct bench_ctx *ctx)
+{
+	const uint32_t rows = BENCH_CENSUS_BAND + 4;
+	const uint32_t *left = (const uint32_t *)ctx->aux, *right = left + rows * ctx->width;
+	struct census_match *matches = (struct census_match *)ctx->dst;
+	int n = 0;
+
+	for (uint32_t x = BENCH_CENSUS_BLOCK + 2; x + BENCH_CENSUS_BLOCK + 2 < ctx->width; x += 8) {
+		if (!census_search(left, right, ctx->width * 4, ctx->width, rows, x, rows / 2, BENCH_CENSUS_BLOCK,
+				   BENCH_CENSUS_RANGE, &matches[n])) {
+			n++;
+		}
+	}
+	ctx->out_len = n * sizeof(*matches);
+}
+
+/** @} */
+
+/** @name Detector LBP
+ *
+ * La cascada es sintética (tres etapas, cinco características de 24x24) y
+ * acepta cuadrados claros con el centro oscuro: todas sus características
+ * piden que el bloque central sea el más oscuro. scene recorre la luma del
+ * frame (casi todo se rechaza en el primer clasificador) y rings la misma luma
+ * con dos de esos cuadrados pegados, uno de 24 píxeles y otro de dos quintos
+ * del alto. La luma y el buffer de trabajo van en aux; dst recibe las
+ * detecciones.
+ *  @{
+ */
+
+/** Subconjunto con solo el código 255 (bloque central más oscuro que todos) */
+#define BENCH_LBP_SUBSET { 0, 0, 0, 0, 0, 0, 0, 0x80000000u }
+
+static const struct {
+	struct lbp_header header;
+	struct lbp_stage stages[3];
+	struct lbp_feature features[5];
+	struct lbp_weak weaks[7];
+} __attribute__((aligned(4))) bench_lbp_data = {
+	.header = { LBP_MAGIC, LBP_VERSION, 24, 24, 3, 5, 7, 0 },
+	.stages = {
+		{ 0, 2, LBP_ONE * 2 / 5 },
+		{ 2, 3, LBP_ONE / 2 },
+		{ 5, 2, 0 },
+	},
+	.features = { { 0, 0, 8, 8 }, { 4, 4, 5, 5 }, { 2, 2, 6, 6 }, { 6, 6, 4, 4 }, { 3, 3, 6, 6 } },
+	.weaks = {
+		{ 0, LBP_ONE, -LBP_ONE, 0, LBP_ONE / 2, BENCH_LBP_SUBSET },
+		{ 1, LBP_ONE / 2, -LBP_ONE / 2, 0, 0, BENCH_LBP_SUBSET },
+		{ 2, LBP_ONE * 3 / 4, -LBP_ONE * 3 / 4, 0, LBP_ONE * 3 / 4, BENCH_LBP_SUBSET },
+		{ 3, LBP_ONE / 2, -LBP_ONE / 2, 0, LBP_ONE / 4, BENCH_LBP_SUBSET },
+		{ 4, LBP_ONE / 4, -LBP_ONE / 4, 0, 0, BENCH_LBP_SUBSET },
+		{ 3, LBP_ONE / 2, -LBP_ONE / 2, 0, LBP_ONE / 4, BENCH_LBP_SUBSET },
+		{ 0, LBP_ONE / 4, -LBP_ONE / 4, 0, 0, BENCH_LBP_SUBSET },
+	},
+};
+
+static struct lbp_cascade bench_lbp;
+
+/**
+ * @brief Pega un cuadrado claro de side píxeles con el tercio central oscuro.
+ */
+static void bench_lbp_paste(struct bench_ctx *ctx, uint32_t x0, uint32_t y0, uint32_t side)
+{
+	for (uint32_t y = 0; y < side && y0 + y < ctx->height; y++) {
+		for (uint32_t x = 0; x < side && x0 + x < ctx->width; x++) {
+			bool dark = x >= side / 3 && x < 2 * side / 3 && y >= side / 3 && y < 2 * side / 3;
+
+			ctx->aux[(y0 + y) * ctx->width + x0 + x] = dark ? 40 : 210;
+		}
+	}
+}
+
+static void setup_lbp_scene(struct bench_ctx *ctx)
+{
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+	lbp_cascade_load(&bench_lbp, &bench_lbp_data, sizeof(bench_lbp_data));
+}
+
+static void setup_lbp_rings(struct bench_ctx *ctx)
+{
+	const uint32_t side = ctx->height * 2 / 5;
+
+	setup_lbp_scene(ctx);
+	bench_lbp_paste(ctx, 4, 6, 24);
+	bench_lbp_paste(ctx, ctx->width - side - 5, ctx->height - side - 3, side);
+}
+
+static void run_lbp_detect(struct bench_ctx *ctx)
+{
+	uint8_t *work = ctx->aux + (((uint32_t)ctx->width * ctx->height + 3) & ~3u);
+	struct lbp_detection *detections = (struct lbp_detection *)ctx->dst;
+
+	int n = lbp_detect(&bench_lbp, ctx->aux, ctx->width, ctx->width, ctx->height, work, detections, 4);
+	ctx->out_len = n > 0 ? n * sizeof(*detections) : 0;
+}
+
+/** @} */
+
+/** @name Máscaras binarias empaquetadas
+ *
+ * La máscara de entrada es la luma del frame umbralizada en aux; open y close
+ * usan la segunda mitad de dst como máscara intermedia.
+ *  @{
+ */
+
+#define BENCH_MONO1_THRESHOLD 128  /**< Umbral de luma de las máscaras de prueba */
+
+static void setup_mono1(struct bench_ctx *ctx)
+{
+	mono1_threshold((uint32_t *)ctx->aux, format_stride(FORMAT_MONO1, 0, ctx->width), ctx->format, ctx->src,
+			format_stride(ctx->format, 0, ctx->width), ctx->width, ctx->height, BENCH_MONO1_THRESHOLD);
+}
+
+static void run_mono1_threshold(struct bench_ctx *ctx)
+{
+	uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width);
+
+	mono1_threshold((uint32_t *)ctx->dst, stride, ctx->format, ctx->src, format_stride(ctx->format, 0, ctx->width),
+			ctx->width, ctx->height, BENCH_MONO1_THRESHOLD);
+	ctx->out_len = stride * ctx->height;
+}
+
+static void run_mono1_erode(struct bench_ctx *ctx)
+{
+	uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width);
+
+	mono1_erode((uint32_t *)ctx->dst, (const uint32_t *)ctx->aux, stride, ctx->width, ctx->height);
+	ctx->out_len = stride * ctx->height;
+}
+
+static void run_mono1_dilate(struct bench_ctx *ctx)
+{
+	uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width);
+
+	mono1_dilate((uint32_t *)ctx->dst, (const uint32_t *)ctx->aux, stride, ctx->width, ctx->height);
+	ctx->out_len = stride * ctx->height;
+}
+
+static void run_mono1_open(struct bench_ctx *ctx)
+{
+	uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width);
+	uint32_t *tmp = (uint32_t *)(ctx->dst + (uint32_t)ctx->width * ctx->height);
+
+	mono1_open((uint32_t *)ctx->dst, tmp, (const uint32_t *)ctx->aux, stride, ctx->width, ctx->height);
+	ctx->out_len = stride * ctx->height;
+}
+
+static void run_mono1_close(struct bench_ctx *ctx)
+{
+	uint32_t stride = format_stride(FORMAT_MONO1, 0, ctx->width);
+	uint32_t *tmp = (uint32_t *)(ctx->dst + (uint32_t)ctx->width * ctx->height);
+
+	mono1_close((uint32_t *)ctx->dst, tmp, (const uint32_t *)ctx->aux, stride, ctx->width, ctx->height);
+	ctx->out_len = stride * ctx->height;
+}
+
+static void run_mono1_area(struct bench_ctx *ctx)
+{
+	uint32_t area = mono1_area((const uint32_t *)ctx->aux, format_stride(FORMAT_MONO1, 0, ctx->width), ctx->width,
+				   ctx->height);
+
+	memcpy(ctx->dst, &area, sizeof(area));
+	ctx->out_len = sizeof(area);
+}
+
+/** @} */
+
+/** @name Codecs (serialización del stream hacia dst)
+ *  @{
+ */
+
+/** @brief Sumidero del stream: acumula los paquetes en ctx->dst. */
+static int sink_write(void *handle, const uint8_t *src, size_t len)
+{
+	struct bench_ctx *ctx = handle;
+
+	memcpy(ctx->dst + ctx->out_len, src, len);
+	ctx->out_len += len;
+	return len;
+}
+
+static struct stream_platform_config sink_platform = {
+	.write = sink_write,
+};
+static struct stream bench_stream;
+static struct stream_result bench_result;
+
+static void setup_stream(struct bench_ctx *ctx)
+{
+	sink_platform.handle = ctx;
+	stream_init(&bench_stream, &sink_platform);
+	bench_result = (struct stream_result){
+		.width = ctx->width,
+		.height = ctx->height,
+		.n_blobs = STREAM_MAX_BLOBS,
+		.n_boxes = STREAM_MAX_BOXES,
+		.n_keypoints = STREAM_MAX_KEYPOINTS,
+	};
+}
+
+static void run_stream_result(struct bench_ctx *ctx)
+{
+	ctx->out_len = 0;
+	stream_send_result(&bench_stream, &bench_result);
+}
+
+static void run_stream_thumbnail(struct bench_ctx *ctx)
+{
+	ctx->out_len = 0;
+	stream_send_thumbnail(&bench_stream, 0, ctx->src, ctx->width * 2, ctx->width, ctx->height);
+}
+
+/** @} */
+
+#if PICO_ON_DEVICE
+/** @name Transferencias (solo dispositivo)
+ *  @{
+ */
+
+static int bench_dma_channel = -1;
+
+static void run_cpu_memcpy(struct bench_ctx *ctx)
+{
+	memcpy(ctx->dst, ctx->src, (uint32_t)ctx->width * ctx->height * 2);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void setup_dma_memcpy(struct bench_ctx *ctx)
+{
+	(void)ctx;
+	if (bench_dma_channel < 0) {
+		bench_dma_channel = dma_claim_unused_channel(true);
+	}
+}
+
+static void run_dma_memcpy(struct bench_ctx *ctx)
+{
+	dma_channel_config c = dma_channel_get_default_config(bench_dma_channel);
+	channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+	channel_config_set_read_increment(&c, true);
+	channel_config_set_write_increment(&c, true);
+
+	dma_channel_configure(bench_dma_channel, &c, ctx->dst, ctx->src,
+			      (uint32_t)ctx->width * ctx->height / 2, true);
+	dma_channel_wait_for_finish_blocking(bench_dma_channel);
+	ctx->out_len = (uint32_t)ctx->width * ctx->height * 2;
+}
+
+static void setup_spi(struct bench_ctx *ctx)
+{
+	(void)ctx;
+	spi_init(spi0, 31250000);
+}
+
+static void run_spi_frame(struct bench_ctx *ctx)
+{
+	spi_write_blocking(spi0, ctx->src, (uint32_t)ctx->width * ctx->height * 2);
+	ctx->out_len = 0;
+}
+
+/** @} */
+
+/** @name Contención de bus (solo dispositivo)
+ *
+ * Captura (DMA a la SRAM principal), envío a la pantalla (DMA hacia el SPI) y
+ * un kernel de la CPU a la vez. Si los buffers están bien ubicados el tiempo
+ * total se acerca al de la más lenta de las tres (xfer/spi_frame) en lugar de
+ * a su suma.
+ *  @{
+ */
+
+static int bench_spi_dma_channel = -1;
+
+static void setup_concurrent(struct bench_ctx *ctx)
+{
+	setup_dma_memcpy(ctx);
+	setup_spi(ctx);
+	if (bench_spi_dma_channel < 0) {
+		bench_spi_dma_channel = dma_claim_unused_channel(true);
+	}
+	convert_yuyv_to_y8(ctx->aux, ctx->src, (uint32_t)ctx->width * ctx->height);
+}
+
+/** @brief Arranca la copia "de captura" src -> dst y el envío de src al SPI. */
+static void concurrent_start_dma(struct bench_ctx *ctx)
+{
+	uint32_t len = (uint32_t)ctx->width * ctx->height * 2;
+
+	dma_channel_config c = dma_channel_get_default_config(bench_dma_channel);
+	channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+	channel_config_set_read_increment(&c, true);
+	channel_config_set_write_increment(&c, true);
+	dma_channel_configure(bench_dma_channel, &c, ctx->dst, ctx->src, len / 4, false);
+
+	dma_channel_config s = dma_channel_get_default_config(bench_spi_dma_channel);
+	channel_config_set_transfer_data_size(&s, DMA_SIZE_8);
+	channel_config_set_read_increment(&s, true);
+	channel_config_set_write_increment(&s, false);
+	channel_config_set_dreq(&s, spi_get_dreq(spi0, true));
+	dma_channel_configure(bench_spi_dma_channel, &s, &spi_get_hw(spi0)->dr, ctx->src, len, false);
+
+	dma_start_channel_mask((1u << bench_dma_channel) | (1u << bench_spi_dma_channel));
+}
+
+static void concurrent_wait_dma(void)
+{
+	dma_channel_wait_for_finish_blocking(bench_dma_channel);
+	dma_channel_wait_for_finish_blocking(bench_spi_dma_channel);
+	while (spi_is_busy(spi0)) {
+		tight_loop_contents();
+	}
+}
+
+/** @brief Las tres cargas a la vez; el filtro usa su buffer de línea en SCRATCH_Y. */
+static void run_concurrent(struct bench_ctx *ctx)
+{
+	concurrent_start_dma(ctx);
+	filter_box3_y8(ctx->aux + (uint32_t)ctx->width * ctx->height, ctx->width, ctx->aux, ctx->width,
+		       ctx->width, ctx->height);
+	concurrent_wait_dma();
+	ctx->out_len = 0;
+}
+
+/** @brief Igual que run_concurrent con la prioridad de bus por defecto. */
+static void run_concurrent_no_priority(struct bench_ctx *ctx)
+{
+	placement_bus_priority(false);
+	run_concurrent(ctx);
+	placement_bus_priority(true);
+}
+
+/** @} */
+#endif
+
+/** @brief Registro de kernels, en el orden del informe. */
+const struct bench_kernel bench_kernels[] = {
+	{ "convert/rgb565be_to_native_bytewise", "swar", FORMAT_RGB565, NULL, run_rgb565be_to_native_bytewise },
+	{ "convert/rgb565be_to_native", "swar", FORMAT_RGB565, NULL, run_rgb565be_to_native },
+	{ "convert/yuyv_to_rgb565", "convert", FORMAT_YUYV, NULL, run_yuyv_to_rgb565 },
+	{ "convert/yuyv_to_y8", "convert", FORMAT_YUYV, NULL, run_yuyv_to_y8 },
+	{ "convert/rgb565be_to_y8", "convert", FORMAT_RGB565, NULL, run_rgb565be_to_y8 },
+	{ "convert/scale_nn_half", "convert", FORMAT_RGB565, NULL, run_scale_nn_half },
+	{ "convert/gamma_lut565", "convert", FORMAT_RGB565, setup_gamma_lut565, run_gamma_lut565 },
+	{ "convert/yuyv_to_rgb565_interp", "interp", FORMAT_YUYV, NULL, run_yuyv_to_rgb565_interp },
+	{ "convert/rgb565be_to_y8_interp", "interp", FORMAT_RGB565, NULL, run_rgb565be_to_y8_interp },
+	{ "convert/scale_nn_half_interp", "interp", FORMAT_RGB565, NULL, run_scale_nn_half_interp },
+	{ "convert/gamma_lut565_interp", "interp", FORMAT_RGB565, setup_gamma_lut565, run_gamma_lut565_interp },
+	{ "fuse/unfused_scale_gamma", "fuse", FORMAT_RGB565, setup_gamma_lut565, run_unfused_scale_gamma },
+	{ "fuse/fused_scale_gamma", "fuse", FORMAT_RGB565, setup_gamma_lut565, run_fused_scale_gamma },
+	{ "fuse/fused_scale_gamma_generic", "fuse", FORMAT_RGB565, setup_gamma_lut565, run_fused_scale_gamma_generic },
+	{ "filter/box3_y8", "filter", FORMAT_YUYV, setup_y8, run_box3_y8 },
+	{ "analytics/histogram_rgb565", "analytics", FORMAT_RGB565, NULL, run_histogram },
+	{ "analytics/histogram_yuyv", "analytics", FORMAT_YUYV, NULL, run_histogram },
+	{ "analytics/histogram_yuv422", "analytics", FORMAT_YUV422, NULL, run_histogram },
+	{ "analytics/histogram_roi_rgb565", "analytics", FORMAT_RGB565, NULL, run_histogram_roi },
+	{ "analytics/histogram_roi_yuyv", "analytics", FORMAT_YUYV, NULL, run_histogram_roi },
+	{ "equalize/global", "equalize", FORMAT_YUYV, setup_equalize, run_equalize },
+	{ "equalize/clahe_convert", "equalize", FORMAT_RGB565, setup_clahe, run_clahe_convert },
+	{ "equalize/clahe_apply", "equalize", FORMAT_RGB565, setup_clahe_apply, run_clahe_apply },
+	{ "denoise/y8", "denoise", FORMAT_YUYV, setup_denoise_y8, run_denoise_y8 },
+	{ "denoise/rgb565", "denoise", FORMAT_RGB565, setup_denoise_rgb565, run_denoise_rgb565 },
+	{ "hdr/merge_rgb565", "hdr", FORMAT_RGB565, setup_hdr, run_hdr_merge },
+	{ "lens/correct_rgb565", "lens", FORMAT_RGB565, setup_lens, run_lens_rgb565 },
+	{ "lens/correct_y8", "lens", FORMAT_YUYV, setup_lens_y8, run_lens_y8 },
+	{ "warp/nearest_rgb565", "warp", FORMAT_RGB565, setup_warp, run_warp_nearest_rgb565 },
+	{ "warp/bilinear_rgb565", "warp", FORMAT_RGB565, setup_warp, run_warp_bilinear_rgb565 },
+	{ "warp/bilinear_y8", "warp", FORMAT_YUYV, setup_warp, run_warp_bilinear_y8 },
+	{ "rotate/naive90_rgb565", "rotate", FORMAT_RGB565, NULL, run_rotate_naive90_rgb565 },
+	{ "rotate/90_rgb565", "rotate", FORMAT_RGB565, NULL, run_rotate_90_rgb565 },
+	{ "rotate/180_rgb565", "rotate", FORMAT_RGB565, NULL, run_rotate_180_rgb565 },
+	{ "rotate/270_rgb565", "rotate", FORMAT_RGB565, NULL, run_rotate_270_rgb565 },
+	{ "rotate/naive90_y8", "rotate", FORMAT_YUYV, setup_rotate_y8, run_rotate_naive90_y8 },
+	{ "rotate/90_y8", "rotate", FORMAT_YUYV, setup_rotate_y8, run_rotate_90_y8 },
+	{ "rotate/inplace90_rgb565", "rotate", FORMAT_RGB565, setup_rotate_inplace, run_rotate_inplace90_rgb565 },
+	{ "match/ncc_pyramid", "match", FORMAT_YUYV, setup_match, run_match_ncc },
+	{ "code/detect_qr", "code", FORMAT_YUYV, setup_code_qr, run_code_detect },
+	{ "code/decode_qr", "code", FORMAT_YUYV, setup_code_qr, run_code_decode },
+	{ "code/decode_ean13", "code", FORMAT_YUYV, setup_code_ean13, run_code_decode },
+	{ "code/decode_code128", "code", FORMAT_YUYV, setup_code_128, run_code_decode },
+	{ "flow/select", "flow", FORMAT_YUYV, setup_flow, run_flow_select },
+	{ "flow/track", "flow", FORMAT_YUYV, setup_flow, run_flow_track },
+	{ "census/5x5", "census", FORMAT_YUYV, setup_census, run_census_5x5 },
+	{ "census/7x7_strip", "census", FORMAT_YUYV, setup_census, run_census_7x7_strip },
+	{ "census/disparity", "census", FORMAT_YUYV, setup_census_band, run_census_disparity },
+	{ "census/search", "census", FORMAT_YUYV, setup_census_band, run_census_search },
+	{ "lbp/scene", "lbp", FORMAT_YUYV, setup_lbp_scene, run_lbp_detect },
+	{ "lbp/rings", "lbp", FORMAT_YUYV, setup_lbp_rings, run_lbp_detect },
+	{ "mono1/threshold_yuyv", "mono1", FORMAT_YUYV, NULL, run_mono1_threshold },
+	{ "mono1/threshold_rgb565", "mono1", FORMAT_RGB565, NULL, run_mono1_threshold },
+	{ "mono1/erode", "mono1", FORMAT_YUYV, setup_mono1, run_mono1_erode },
+	{ "mono1/dilate", "mono1", FORMAT_YUYV, setup_mono1, run_mono1_dilate },
+	{ "mono1/open", "mono1", FORMAT_YUYV, setup_mono1, run_mono1_open },
+	{ "mono1/close", "mono1", FORMAT_YUYV, setup_mono1, run_mono1_close },
+	{ "mono1/area", "mono1", FORMAT_YUYV, setup_mono1, run_mono1_area },
+	{ "codec/stream_result", "codec", FORMAT_RGB565, setup_stream, run_stream_result },
+	{ "codec/stream_thumbnail", "codec", FORMAT_RGB565, setup_stream, run_stream_thumbnail },
+#if PICO_ON_DEVICE
+	{ "xfer/cpu_memcpy", "xfer", FORMAT_RGB565, NULL, run_cpu_memcpy },
+	{ "xfer/dma_memcpy", "xfer", FORMAT_RGB565, setup_dma_memcpy, run_dma_memcpy },
+	{ "xfer/spi_frame", "xfer", FORMAT_RGB565, setup_spi, run_spi_frame },
+	{ "xfer/concurrent", "bus", FORMAT_YUYV, setup_concurrent, run_concurrent },
+	{ "xfer/concurrent_no_priority", "bus", FORMAT_YUYV, setup_concurrent, run_concurrent_no_priority },
+#endif
+};
+
+const unsigned int bench_num_kernels = sizeof(bench_kernels) / sizeof(bench_kernels[0]);
@@ -0,0 +1,120 @@
+/**
+ * @file bench_main.c
+ * @brief Firmware (y ejecutable de host) que mide todos los kernels del registro.
+ *
+ * En el dispositivo espera la conexión USB, imprime el informe CSV y después
+ * atiende órdenes por USB: 'r' repite el informe, 'v' verifica los hashes de
+ * referencia y 'p' compara con las líneas base. En el host el modo se elige
+ * con el primer argumento (report, verify, perf, update-golden,
+ * update-baseline) y el código de salida indica el resultado, para ctest.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#if PICO_ON_DEVICE
+#include "pico/stdio_usb.h"
+#endif
+
+#include "runtime/cycles.h"
+#include "runtime/placement.h"
+#include "bench.h"
+#include "golden.h"
+
+#define BENCH_ITERATIONS 16       /**< Repeticiones medidas por kernel y tamaño */
+#define BENCH_PERF_TOLERANCE 25   /**< Empeoramiento admitido (%) frente a las líneas base */
+
+/** @brief Tamaños de frame medidos para cada kernel. */
+static const uint16_t bench_sizes[][2] = {
+	{ 80, 60 },
+	{ 160, 120 },
+};
+
+/**
+ * @brief Mide todos los kernels del registro en todos los tamaños.
+ */
+static void bench_run_all(struct bench_ctx *ctx)
+{
+	struct bench_result result;
+
+	bench_report_header();
+	for (unsigned int k = 0; k < bench_num_kernels; k++) {
+		for (unsigned int s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++) {
+			ctx->width = bench_sizes[s][0];
+			ctx->height = bench_sizes[s][1];
+			bench_fill(ctx->src, (uint32_t)BENCH_MAX_WIDTH * BENCH_MAX_HEIGHT * BENCH_MAX_BPP,
+				   ctx->width * 31 + ctx->height);
+			if (bench_run(&bench_kernels[k], ctx, BENCH_ITERATIONS, &result) == 0) {
+				bench_report(&bench_kernels[k], ctx, &result);
+			}
+		}
+	}
+	bench_report_footer();
+}
+
+int main(int argc, char **argv)
+{
+	stdio_init_all();
+	cycles_init();
+
+	const uint32_t frame_bytes = (uint32_t)BENCH_MAX_WIDTH * BENCH_MAX_HEIGHT * BENCH_MAX_BPP;
+	struct bench_ctx ctx = {
+		.src = malloc(frame_bytes),
+		.dst = malloc(frame_bytes),
+		.aux = malloc(frame_bytes),
+	};
+	if (!ctx.src || !ctx.dst || !ctx.aux) {
+		printf("bench: sin memoria para los frames sintéticos\n");
+		return 1;
+	}
+
+#if PICO_ON_DEVICE
+	while (!stdio_usb_connected()) {
+		sleep_ms(100);
+	}
+	sleep_ms(500);
+
+	// Misma prioridad de bus que el firmware de la aplicación
+	placement_bus_priority(true);
+	bench_run_all(&ctx);
+	while (1) {
+		switch (getchar_timeout_us(1000000)) {
+		case 'r':
+			bench_run_all(&ctx);
+			break;
+		case 'v':
+			golden_verify(&ctx, false);
+			break;
+		case 'p':
+			golden_perf(&ctx, BENCH_PERF_TOLERANCE, false);
+			break;
+		default:
+			tight_loop_contents();
+			break;
+		}
+	}
+#else
+	const char *mode = argc > 1 ? argv[1] : "report";
+	uint32_t tolerance = argc > 2 ? strtoul(argv[2], NULL, 10) : BENCH_PERF_TOLERANCE;
+
+	if (!strcmp(mode, "report")) {
+		bench_run_all(&ctx);
+		return 0;
+	} else if (!strcmp(mode, "verify")) {
+		return golden_verify(&ctx, false) ? 1 : 0;
+	} else if (!strcmp(mode, "perf")) {
+		return golden_perf(&ctx, tolerance, false) ? 1 : 0;
+	} else if (!strcmp(mode, "update-golden")) {
+		golden_verify(&ctx, true);
+		return 0;
+	} else if (!strcmp(mode, "update-baseline")) {
+		golden_perf(&ctx, 0, true);
+		return 0;
+	}
+
+	printf("uso: %s [report|verify|perf [tolerancia %%]|update-golden|update-baseline]\n", argv[0]);
+	return 2;
+#endif
+}
@@ -0,0 +1,73 @@
+/**
+ * @file census_test.c
+ * @brief Comprobación en el host de la transformada census por filas.
+ *
+ * census_push_row() debe devolver el índice de la fila de descriptores que
+ * escribe (la fila n sale con la fila n + radio de la luma) y su contenido
+ * debe coincidir con la misma fila de census_transform() sobre el plano
+ * entero. El código de salida es el número de comprobaciones fallidas, para
+ * ctest.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vision/census.h"
+
+#define TEST_WIDTH  37
+#define TEST_HEIGHT 19
+
+static int failures;
+
+#define CHECK(cond)                                                       \
+	do {                                                              \
+		if (!(cond)) {                                            \
+			printf("FALLO %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			failures++;                                       \
+		}                                                         \
+	} while (0)
+
+static uint8_t luma[TEST_WIDTH * TEST_HEIGHT];
+static uint32_t full[TEST_WIDTH * TEST_HEIGHT];
+static uint32_t row[TEST_WIDTH];
+static uint8_t ring[TEST_WIDTH * 7];
+
+/**
+ * @brief Empuja la luma fila a fila y compara índices y descriptores con la transformada completa.
+ */
+static void test_push_row(enum census_shape shape, int radius)
+{
+	struct census cs;
+
+	CHECK(census_transform(full, TEST_WIDTH * 4, luma, TEST_WIDTH, TEST_WIDTH, TEST_HEIGHT, shape) == 0);
+	CHECK(census_init(&cs, shape, TEST_WIDTH, ring) == 0);
+
+	for (int y = 0; y < TEST_HEIGHT; y++) {
+		int r = census_push_row(&cs, luma + y * TEST_WIDTH, row);
+
+		if (y < 2 * radius) {
+			CHECK(r == -1);
+			continue;
+		}
+		CHECK(r == y - radius);
+		if (r >= 0 && r < TEST_HEIGHT) {
+			CHECK(!memcmp(row, full + r * TEST_WIDTH, sizeof(row)));
+		}
+	}
+}
+
+int main(void)
+{
+	// Ruido determinista con algunas mesetas para que haya empates con el centro
+	uint32_t seed = 12345;
+	for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
+		seed = seed * 1103515245 + 12345;
+		luma[i] = (seed >> 16) & 0xf0;
+	}
+
+	test_push_row(CENSUS_5X5, 2);
+	test_push_row(CENSUS_7X7_SPARSE, 3);
+
+	printf("census: %d fallos\n", failures);
+	return failures;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file clahe_test.c
+ * @brief Comprobación en el host de los histogramas y las LUT del CLAHE.
+ *
+ * Cada tesela debe contar exactamente sus píxeles, también cuando el número
+ * de teselas no divide al tamaño de la imagen, y su LUT debe ser creciente y
+ * terminar en 255. Con una imagen uniforme la salida es uniforme. El código
+ * de salida es el número de comprobaciones fallidas, para ctest.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "vision/clahe.h"
+
+#define TEST_MAX_WIDTH  37
+#define TEST_MAX_HEIGHT 19
+
+static int failures;
+
+#define CHECK(cond)                                                       \
+	do {                                                              \
+		if (!(cond)) {                                            \
+			printf("FALLO %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			failures++;                                       \
+		}                                                         \
+	} while (0)
+
+static struct clahe clahe;
+static uint8_t luma[TEST_MAX_WIDTH * TEST_MAX_HEIGHT];
+static uint8_t rgb[TEST_MAX_WIDTH * TEST_MAX_HEIGHT * 2];
+static uint8_t out[TEST_MAX_WIDTH * TEST_MAX_HEIGHT];
+
+/**
+ * @brief Comprueba las cuentas de cada tesela y la forma de su LUT.
+ */
+static void check_tiles(uint16_t width, uint16_t height, uint8_t tiles_x, uint8_t tiles_y)
+{
+	uint32_t total = 0;
+
+	for (uint8_t ty = 0; ty < tiles_y; ty++) {
+		uint32_t rows = (ty + 1) * height / tiles_y - ty * height / tiles_y;
+
+		for (uint8_t tx = 0; tx < tiles_x; tx++) {
+			uint32_t cols = (tx + 1) * width / tiles_x - tx * width / tiles_x;
+			uint32_t n = 0;
+			bool monotonic = true;
+
+			for (int b = 0; b < CLAHE_BINS; b++) {
+				n += clahe.hist[ty][tx][b];
+				if (b && clahe.lut[ty][tx][b] < clahe.lut[ty][tx][b - 1]) {
+					monotonic = false;
+				}
+			}
+			CHECK(n == rows * cols);
+			CHECK(monotonic);
+			CHECK(clahe.lut[ty][tx][CLAHE_BINS - 1] == 255);
+			total += n;
+		}
+	}
+	CHECK(total == (uint32_t)width * height);
+}
+
+/**
+ * @brief Acumula por filas y convierte desde RGB565 una imagen uniforme y otra con ruido.
+ */
+static void test_tiles(uint16_t width, uint16_t height, uint8_t tiles_x, uint8_t tiles_y, uint16_t clip_x10)
+{
+	uint32_t seed = 12345;
+
+	// Luma uniforme (la de la reproducción del fallo): toda la imagen sale a 255
+	memset(luma, 252, sizeof(luma));
+	CHECK(clahe_init(&clahe, width, height, tiles_x, tiles_y, clip_x10) == 0);
+	for (uint16_t y = 0; y < height; y++) {
+		clahe_accumulate_row(&clahe, y, luma + y * width, 1);
+	}
+	clahe_build_luts(&clahe);
+	check_tiles(width, height, tiles_x, tiles_y);
+
+	clahe_apply(&clahe, out, width, luma, width);
+	bool uniform = true;
+	for (uint32_t i = 0; i < (uint32_t)width * height; i++) {
+		if (out[i] != 255) {
+			uniform = false;
+		}
+	}
+	CHECK(uniform);
+
+	// Ruido en RGB565 por el camino que convierte y acumula a la vez
+	for (uint32_t i = 0; i < sizeof(rgb); i++) {
+		seed = seed * 1103515245 + 12345;
+		rgb[i] = seed >> 16;
+	}
+	clahe_reset(&clahe);
+	clahe_convert_rgb565be(&clahe, luma, width, rgb, width * 2);
+	clahe_build_luts(&clahe);
+	check_tiles(width, height, tiles_x, tiles_y);
+}
+
+int main(void)
+{
+	test_tiles(10, 10, 3, 3, 0);
+	test_tiles(10, 10, 3, 3, 20);
+	test_tiles(TEST_MAX_WIDTH, TEST_MAX_HEIGHT, 8, 7, 0);
+	test_tiles(TEST_MAX_WIDTH, TEST_MAX_HEIGHT, 5, 4, 30);
+	test_tiles(32, 16, 4, 4, 20);
+
+	printf("clahe: %d fallos\n", failures);
+	return failures;
+}
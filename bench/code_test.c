@@ -0,0 +1,420 @@
+/**
+ * @file code_test.c
+ * @brief Comprobación en el host de la lectura de códigos QR, EAN-13 y Code 128.
+ *
+ * Los QR se generan aquí con un codificador mínimo (modo alfanumérico, nivel
+ * M, versiones 1 a 4), que se contrasta con el QR 1-M del banco de pruebas.
+ * Cada código se pinta en una máscara en los cuatro giros y, para los QR,
+ * también con tantas palabras erróneas como puede corregir cada bloque y con
+ * bits de formato cambiados. Las barras se leen de derecha a izquierda (giro
+ * de 180 grados) y con filas rayadas. El texto leído debe ser exactamente el
+ * codificado. El código de salida es el número de comprobaciones fallidas,
+ * para ctest.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "vision/code.h"
+#include "vision/qr.h"
+
+#define TEST_WIDTH  160
+#define TEST_HEIGHT 120
+#define TEST_WORDS  ((TEST_WIDTH + 31) / 32)
+#define TEST_SCALE  3  /**< Píxeles por módulo de los QR */
+
+static int failures;
+
+#define CHECK(cond)                                                       \
+	do {                                                              \
+		if (!(cond)) {                                            \
+			printf("FALLO %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			failures++;                                       \
+		}                                                         \
+	} while (0)
+
+/** QR 1-M con "MINIVISION" (máscara 2) de bench_kernels.c: bit u de la fila v a 1 = módulo oscuro */
+static const uint32_t bench_code_qr[21] = {
+	0x1fc47f, 0x104e41, 0x17595d, 0x174b5d, 0x17555d, 0x104f41, 0x1fd57f, 0x000500, 0x07ca7d, 0x00f815, 0x04d072,
+	0x1d7905, 0x1b1764, 0x189500, 0x02287f, 0x0e8741, 0x08295d, 0x057b5d, 0x07555d, 0x177e41, 0x00157f,
+};
+
+/** EAN-13 8412345678905 de bench_kernels.c: 95 módulos, bit a 1 = barra */
+static const uint32_t bench_code_ean13[3] = { 0x42c99b15, 0x221551ae, 0x5729cb89 };
+
+/** Code 128 "RP2040" (juego B) de bench_kernels.c: 101 módulos, bit a 1 = barra */
+static const uint32_t bench_code_128[4] = { 0xdddd184b, 0xc99b94e6, 0xe37166e5, 0x0000001a };
+
+/** Palabras totales, de datos a nivel M y bloques por versión */
+static const uint8_t qr_total[QR_MAX_VERSION + 1] = { 0, 26, 44, 70, 100 };
+static const uint8_t qr_data_m[QR_MAX_VERSION + 1] = { 0, 16, 28, 44, 64 };
+static const uint8_t qr_blocks_m[QR_MAX_VERSION + 1] = { 0, 1, 1, 1, 2 };
+
+static uint32_t mask[TEST_HEIGHT * TEST_WORDS];
+static struct code_reader reader;
+
+/**
+ * @struct qr_symbol
+ * @brief QR generado: módulos (true = oscuro) y cuáles son de función.
+ */
+struct qr_symbol {
+	int size;
+	bool dark[QR_MAX_SIZE][QR_MAX_SIZE];
+	bool function[QR_MAX_SIZE][QR_MAX_SIZE];
+};
+
+static uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+	uint8_t r = 0;
+
+	while (b) {
+		if (b & 1) {
+			r ^= a;
+		}
+		a = (a << 1) ^ (a & 0x80 ? 0x1d : 0);
+		b >>= 1;
+	}
+	return r;
+}
+
+/**
+ * @brief Palabras de corrección Reed-Solomon de un bloque.
+ */
+static void rs_encode(const uint8_t *data, int n_data, uint8_t *ecc, int n_ecc)
+{
+	uint8_t gen[32] = { 1 };
+	uint8_t root = 1;
+
+	// (x - α^0)(x - α^1)... con el coeficiente de mayor grado primero
+	for (int i = 0; i < n_ecc; i++) {
+		for (int j = i + 1; j > 0; j--) {
+			gen[j] = gf_mul(gen[j], root) ^ gen[j - 1];
+		}
+		gen[0] = gf_mul(gen[0], root);
+		root = gf_mul(root, 2);
+	}
+
+	memset(ecc, 0, n_ecc);
+	for (int i = 0; i < n_data; i++) {
+		uint8_t factor = data[i] ^ ecc[0];
+
+		memmove(ecc, ecc + 1, n_ecc - 1);
+		ecc[n_ecc - 1] = 0;
+		for (int j = 0; j < n_ecc; j++) {
+			ecc[j] ^= gf_mul(gen[n_ecc - 1 - j], factor);
+		}
+	}
+}
+
+static void put_bits(uint8_t *buf, int *pos, uint32_t value, int n)
+{
+	for (int i = n - 1; i >= 0; i--, (*pos)++) {
+		if ((value >> i) & 1) {
+			buf[*pos >> 3] |= 0x80 >> (*pos & 7);
+		}
+	}
+}
+
+static void set_function(struct qr_symbol *qr, int x, int y, bool dark)
+{
+	qr->dark[y][x] = dark;
+	qr->function[y][x] = true;
+}
+
+static bool qr_mask_bit(int mask_id, int x, int y)
+{
+	switch (mask_id) {
+	case 0: return (x + y) % 2 == 0;
+	case 1: return y % 2 == 0;
+	case 2: return x % 3 == 0;
+	case 3: return (x + y) % 3 == 0;
+	case 4: return (x / 3 + y / 2) % 2 == 0;
+	case 5: return x * y % 2 + x * y % 3 == 0;
+	case 6: return (x * y % 2 + x * y % 3) % 2 == 0;
+	default: return ((x + y) % 2 + x * y % 3) % 2 == 0;
+	}
+}
+
+/**
+ * @brief Codifica text en modo alfanumérico con nivel M.
+ *
+ * errors palabras de cada bloque se cambian tras calcular la corrección y
+ * format_errors bits de la primera copia del formato se invierten.
+ */
+static void qr_encode(struct qr_symbol *qr, const char *text, int version, int mask_id, int errors,
+		      int format_errors)
+{
+	static const char alnum[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+	const int size = 17 + 4 * version;
+	const int n_data = qr_data_m[version], n_blocks = qr_blocks_m[version];
+	const int block_data = n_data / n_blocks, block_ecc = (qr_total[version] - n_data) / n_blocks;
+	uint8_t data[QR_MAX_SIZE * 4] = { 0 };
+	uint8_t ecc[4][32];
+	uint8_t codewords[128];
+	int len = strlen(text), pos = 0;
+
+	memset(qr, 0, sizeof(*qr));
+	qr->size = size;
+
+	put_bits(data, &pos, 0x2, 4);
+	put_bits(data, &pos, len, 9);
+	for (int i = 0; i < len; i += 2) {
+		int a = strchr(alnum, text[i]) - alnum;
+		if (i + 1 < len) {
+			put_bits(data, &pos, a * 45 + (strchr(alnum, text[i + 1]) - alnum), 11);
+		} else {
+			put_bits(data, &pos, a, 6);
+		}
+	}
+	pos += 4;
+	pos = (pos + 7) & ~7;
+	for (int i = pos / 8; i < n_data; i++) {
+		data[i] = (i - pos / 8) & 1 ? 0x11 : 0xec;
+	}
+
+	// Bloques intercalados: datos palabra a palabra y después la corrección
+	int n = 0;
+	for (int b = 0; b < n_blocks; b++) {
+		rs_encode(data + b * block_data, block_data, ecc[b], block_ecc);
+	}
+	for (int i = 0; i < block_data; i++) {
+		for (int b = 0; b < n_blocks; b++) {
+			codewords[n++] = data[b * block_data + i];
+		}
+	}
+	for (int i = 0; i < block_ecc; i++) {
+		for (int b = 0; b < n_blocks; b++) {
+			codewords[n++] = ecc[b][i];
+		}
+	}
+	for (int i = 0; i < errors * n_blocks; i++) {
+		codewords[(i * 3) % n] ^= 0x5a + i;
+	}
+
+	// Buscadores con su separador, temporización, alineación y módulo oscuro
+	for (int c = 0; c < 3; c++) {
+		int cx = c == 1 ? size - 4 : 3, cy = c == 2 ? size - 4 : 3;
+		for (int dy = -4; dy <= 4; dy++) {
+			for (int dx = -4; dx <= 4; dx++) {
+				int x = cx + dx, y = cy + dy, d = dx * dx > dy * dy ? dx * dx : dy * dy;
+				if (x >= 0 && x < size && y >= 0 && y < size) {
+					set_function(qr, x, y, d != 4 && d != 16);
+				}
+			}
+		}
+	}
+	for (int i = 8; i < size - 8; i++) {
+		set_function(qr, 6, i, i % 2 == 0);
+		set_function(qr, i, 6, i % 2 == 0);
+	}
+	if (version > 1) {
+		for (int dy = -2; dy <= 2; dy++) {
+			for (int dx = -2; dx <= 2; dx++) {
+				int d = dx * dx > dy * dy ? dx * dx : dy * dy;
+				set_function(qr, size - 7 + dx, size - 7 + dy, d != 1);
+			}
+		}
+	}
+
+	// Formato: nivel M (00) y máscara, BCH(15, 5) y la máscara fija 0x5412
+	uint32_t format = mask_id, rem = format;
+	for (int i = 0; i < 10; i++) {
+		rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+	}
+	uint32_t bits = ((format << 10) | rem) ^ 0x5412;
+	uint32_t first = bits ^ ((1u << format_errors) - 1) << 4;
+	for (int i = 0; i <= 5; i++) {
+		set_function(qr, 8, i, (first >> i) & 1);
+	}
+	set_function(qr, 8, 7, (first >> 6) & 1);
+	set_function(qr, 8, 8, (first >> 7) & 1);
+	set_function(qr, 7, 8, (first >> 8) & 1);
+	for (int i = 9; i < 15; i++) {
+		set_function(qr, 14 - i, 8, (first >> i) & 1);
+	}
+	for (int i = 0; i < 8; i++) {
+		set_function(qr, size - 1 - i, 8, (bits >> i) & 1);
+	}
+	for (int i = 8; i < 15; i++) {
+		set_function(qr, 8, size - 15 + i, (bits >> i) & 1);
+	}
+	set_function(qr, 8, size - 8, true);
+
+	// Zigzag por parejas de columnas desde la esquina inferior derecha
+	int bit = 0;
+	for (int right = size - 1; right >= 1; right -= 2) {
+		if (right == 6) {
+			right = 5;
+		}
+		for (int vert = 0; vert < size; vert++) {
+			for (int j = 0; j < 2; j++) {
+				int x = right - j;
+				int y = ((right + 1) & 2) == 0 ? size - 1 - vert : vert;
+
+				if (qr->function[y][x]) {
+					continue;
+				}
+				if (bit < n * 8) {
+					qr->dark[y][x] = (codewords[bit >> 3] >> (7 - (bit & 7))) & 1;
+					bit++;
+				}
+				qr->dark[y][x] ^= qr_mask_bit(mask_id, x, y);
+			}
+		}
+	}
+}
+
+static void mask_clear(void)
+{
+	memset(mask, 0xff, sizeof(mask));
+}
+
+static void mask_dark(uint32_t x, uint32_t y)
+{
+	mask[y * TEST_WORDS + x / 32] &= ~(1u << (x % 32));
+}
+
+/**
+ * @brief Pinta el QR girado rotation cuartos de vuelta en sentido horario.
+ */
+static void qr_paint(const struct qr_symbol *qr, int rotation)
+{
+	const int size = qr->size;
+	const int x0 = (TEST_WIDTH - size * TEST_SCALE) / 2, y0 = (TEST_HEIGHT - size * TEST_SCALE) / 2;
+
+	mask_clear();
+	for (int v = 0; v < size; v++) {
+		for (int u = 0; u < size; u++) {
+			int x = u, y = v;
+
+			for (int r = 0; r < rotation; r++) {
+				int t = x;
+				x = size - 1 - y;
+				y = t;
+			}
+			if (!qr->dark[v][u]) {
+				continue;
+			}
+			for (int py = 0; py < TEST_SCALE; py++) {
+				for (int px = 0; px < TEST_SCALE; px++) {
+					mask_dark(x0 + x * TEST_SCALE + px, y0 + y * TEST_SCALE + py);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Detecta y lee la máscara; devuelve si sale un único código del tipo y el texto esperados.
+ */
+static bool read_one(enum code_type type, const char *text)
+{
+	struct code_result results[4];
+	const uint32_t stride = TEST_WORDS * 4;
+
+	if (code_detect(&reader, mask, stride, TEST_WIDTH, TEST_HEIGHT) <= 0) {
+		return false;
+	}
+	int n = code_decode(&reader, mask, stride, TEST_WIDTH, TEST_HEIGHT, results, 4);
+
+	return n == 1 && results[0].type == type && results[0].length == strlen(text) &&
+	       !strcmp(results[0].text, text);
+}
+
+/**
+ * @brief El codificador reproduce el QR 1-M del banco de pruebas.
+ */
+static void test_qr_encoder(void)
+{
+	static struct qr_symbol qr;
+	bool same = true;
+
+	qr_encode(&qr, "MINIVISION", 1, 2, 0, 0);
+	for (int v = 0; v < 21; v++) {
+		for (int u = 0; u < 21; u++) {
+			if (qr.dark[v][u] != ((bench_code_qr[v] >> u) & 1)) {
+				same = false;
+			}
+		}
+	}
+	CHECK(same);
+}
+
+/**
+ * @brief Versiones 1 a 4 en los cuatro giros, limpias y con errores corregibles.
+ */
+static void test_qr(void)
+{
+	// Palabras corregibles por bloque a nivel M: la mitad de las de corrección
+	static const int correctable[QR_MAX_VERSION + 1] = { 0, 5, 8, 13, 9 };
+	static struct qr_symbol qr;
+
+	for (int version = 1; version <= QR_MAX_VERSION; version++) {
+		for (int rotation = 0; rotation < 4; rotation++) {
+			int mask_id = (version + rotation) % 8;
+
+			qr_encode(&qr, "MINIVISION", version, mask_id, 0, 0);
+			qr_paint(&qr, rotation);
+			if (!read_one(CODE_QR, "MINIVISION")) {
+				printf("  QR versión %d, giro %d\n", version, rotation * 90);
+				CHECK(false);
+			}
+
+			qr_encode(&qr, "MINIVISION", version, (mask_id + 4) & 7, correctable[version], 2);
+			qr_paint(&qr, rotation);
+			if (!read_one(CODE_QR, "MINIVISION")) {
+				printf("  QR versión %d, giro %d, %d palabras erróneas\n", version, rotation * 90,
+				       correctable[version]);
+				CHECK(false);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Pinta una fila de barras de 1 píxel por módulo, invertida si reversed.
+ *
+ * Las filas múltiplos de scratch (si no es 0) se rayan enteras de oscuro.
+ */
+static void bars_paint(const uint32_t *bars, uint32_t modules, bool reversed, int scratch)
+{
+	const uint32_t x0 = (TEST_WIDTH - modules) / 2;
+
+	mask_clear();
+	for (uint32_t y = TEST_HEIGHT / 4; y < TEST_HEIGHT * 3 / 4; y++) {
+		for (uint32_t m = 0; m < modules; m++) {
+			uint32_t b = reversed ? modules - 1 - m : m;
+
+			if ((bars[b / 32] >> (b % 32)) & 1 || (scratch && y % scratch == 0)) {
+				mask_dark(x0 + m, y);
+			}
+		}
+	}
+}
+
+/**
+ * @brief EAN-13 y Code 128 en los dos sentidos de lectura y con filas dañadas.
+ */
+static void test_bars(void)
+{
+	for (int reversed = 0; reversed < 2; reversed++) {
+		for (int scratch = 0; scratch <= 3; scratch += 3) {
+			bars_paint(bench_code_ean13, 95, reversed, scratch);
+			CHECK(read_one(CODE_EAN13, "8412345678905"));
+
+			bars_paint(bench_code_128, 101, reversed, scratch);
+			CHECK(read_one(CODE_128, "RP2040"));
+		}
+	}
+}
+
+int main(void)
+{
+	test_qr_encoder();
+	test_qr();
+	test_bars();
+
+	printf("code: %d fallos\n", failures);
+	return failures;
+}
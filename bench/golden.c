@@ -0,0 +1,296 @@
+/**
+ * @file golden.c
+ * @brief Generación del corpus, verificación bit a bit y comparación de rendimiento.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "camera/format.h"
+#include "golden.h"
+
+#define GOLDEN_PERF_ITERATIONS 16  /**< Repeticiones por medida de rendimiento */
+
+/** @brief Tamaños de frame del corpus. */
+static const uint16_t golden_sizes[][2] = {
+	{ 80, 60 },
+	{ 160, 120 },
+};
+
+#define GOLDEN_NUM_SIZES (sizeof(golden_sizes) / sizeof(golden_sizes[0]))
+
+static const char *const golden_scene_names[GOLDEN_SCENE_COUNT] = {
+	"gradient", "bars", "checker", "noise", "dark",
+};
+
+/** @brief Colores de las barras (RGB888): blanco, amarillo, cian, verde, magenta, rojo, azul, negro. */
+static const uint8_t golden_bars[8][3] = {
+	{ 255, 255, 255 }, { 255, 255, 0 }, { 0, 255, 255 }, { 0, 255, 0 },
+	{ 255, 0, 255 }, { 255, 0, 0 }, { 0, 0, 255 }, { 0, 0, 0 },
+};
+
+/**
+ * @brief Nombre corto de una escena.
+ */
+const char *golden_scene_name(unsigned int scene)
+{
+	return scene < GOLDEN_SCENE_COUNT ? golden_scene_names[scene] : "?";
+}
+
+/**
+ * @brief Ruido determinista por posición (hash entero), independiente del orden de generación.
+ */
+static uint32_t golden_noise(uint32_t x, uint32_t y, uint32_t salt)
+{
+	uint32_t h = x * 0x9e3779b1u ^ y * 0x85ebca77u ^ salt * 0xc2b2ae3du;
+	h ^= h >> 15;
+	h *= 0x2c1b3c6du;
+	h ^= h >> 12;
+	return h;
+}
+
+/**
+ * @brief Color RGB888 de la escena en un píxel.
+ */
+static void golden_pixel(unsigned int scene, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t rgb[3])
+{
+	uint32_t n = golden_noise(x, y, scene);
+
+	switch (scene) {
+	case GOLDEN_SCENE_GRADIENT:
+		rgb[0] = x * 255 / (w - 1);
+		rgb[1] = y * 255 / (h - 1);
+		rgb[2] = (x + y) * 255 / (w + h - 2);
+		break;
+	case GOLDEN_SCENE_BARS:
+		memcpy(rgb, golden_bars[x * 8 / w], 3);
+		break;
+	case GOLDEN_SCENE_CHECKER:
+		rgb[0] = rgb[1] = rgb[2] = ((x >> 3) ^ (y >> 3)) & 1 ? 255 : 0;
+		break;
+	case GOLDEN_SCENE_NOISE:
+		rgb[0] = n;
+		rgb[1] = n >> 8;
+		rgb[2] = n >> 16;
+		break;
+	case GOLDEN_SCENE_DARK:
+	default:
+		rgb[0] = 8 + (n & 0x0f) + x * 16 / w;
+		rgb[1] = 8 + ((n >> 8) & 0x0f) + y * 16 / h;
+		rgb[2] = 8 + ((n >> 16) & 0x0f);
+		break;
+	}
+}
+
+/**
+ * @brief RGB888 a YCbCr BT.601 de rango completo, en punto fijo Q8.
+ */
+static void golden_rgb_to_yuv(const uint8_t rgb[3], uint8_t yuv[3])
+{
+	int32_t r = rgb[0], g = rgb[1], b = rgb[2];
+	int32_t y = (77 * r + 150 * g + 29 * b + 128) >> 8;
+	int32_t u = ((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128;
+	int32_t v = ((128 * r - 107 * g - 21 * b + 128) >> 8) + 128;
+
+	yuv[0] = y;
+	yuv[1] = u < 0 ? 0 : (u > 255 ? 255 : u);
+	yuv[2] = v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+/**
+ * @brief Genera una escena en el formato pedido, con los planos concatenados.
+ */
+void golden_fill_scene(uint8_t *dst, uint32_t format, uint16_t width, uint16_t height, unsigned int scene)
+{
+	uint8_t *y_plane = dst;
+	uint8_t *u_plane = dst + (uint32_t)width * height;
+	uint8_t *v_plane = u_plane + (uint32_t)width * height / 2;
+
+	for (uint16_t y = 0; y < height; y++) {
+		for (uint16_t x = 0; x < width; x += 2) {
+			uint8_t rgb[2][3], yuv[2][3];
+
+			golden_pixel(scene, x, y, width, height, rgb[0]);
+			golden_pixel(scene, x + 1, y, width, height, rgb[1]);
+			golden_rgb_to_yuv(rgb[0], yuv[0]);
+			golden_rgb_to_yuv(rgb[1], yuv[1]);
+			uint8_t u = (yuv[0][1] + yuv[1][1] + 1) >> 1;
+			uint8_t v = (yuv[0][2] + yuv[1][2] + 1) >> 1;
+			uint32_t i = (uint32_t)y * width + x;
+
+			switch (format) {
+			case FORMAT_RGB565:
+				for (int k = 0; k < 2; k++) {
+					uint16_t p = ((rgb[k][0] & 0xf8) << 8) | ((rgb[k][1] & 0xfc) << 3) | (rgb[k][2] >> 3);
+					dst[2 * (i + k)] = p >> 8;
+					dst[2 * (i + k) + 1] = p & 0xff;
+				}
+				break;
+			case FORMAT_YUYV:
+				dst[2 * i] = yuv[0][0];
+				dst[2 * i + 1] = u;
+				dst[2 * i + 2] = yuv[1][0];
+				dst[2 * i + 3] = v;
+				break;
+			case FORMAT_YUV422:
+				y_plane[i] = yuv[0][0];
+				y_plane[i + 1] = yuv[1][0];
+				u_plane[i / 2] = u;
+				v_plane[i / 2] = v;
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Hash FNV-1a de 32 bits.
+ */
+uint32_t golden_fnv1a(const uint8_t *data, uint32_t len)
+{
+	uint32_t h = 2166136261u;
+
+	while (len--) {
+		h ^= *data++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+/**
+ * @brief Busca el hash esperado de un kernel, escena y tamaño.
+ * @return Entrada de la tabla, o NULL si no existe.
+ */
+static const struct golden_hash *golden_find_hash(const char *kernel, unsigned int scene, uint16_t w, uint16_t h)
+{
+	for (unsigned int i = 0; i < golden_num_hashes; i++) {
+		const struct golden_hash *e = &golden_hashes[i];
+		if (e->scene == scene && e->width == w && e->height == h && !strcmp(e->kernel, kernel)) {
+			return e;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Ejecuta cada kernel una vez sobre cada escena y tamaño y compara el hash de su salida.
+ * @return Número de discrepancias.
+ */
+int golden_verify(struct bench_ctx *ctx, bool update)
+{
+	int failures = 0;
+
+	if (update) {
+		printf("/* Generado con `minivision_bench update-golden`: no editar a mano. */\n\n");
+		printf("#include \"golden.h\"\n\nconst struct golden_hash golden_hashes[] = {\n");
+	}
+
+	for (unsigned int k = 0; k < bench_num_kernels; k++) {
+		const struct bench_kernel *kernel = &bench_kernels[k];
+
+		for (unsigned int s = 0; s < GOLDEN_NUM_SIZES; s++) {
+			for (unsigned int scene = 0; scene < GOLDEN_SCENE_COUNT; scene++) {
+				ctx->width = golden_sizes[s][0];
+				ctx->height = golden_sizes[s][1];
+				ctx->format = kernel->format;
+				ctx->out_len = 0;
+				golden_fill_scene(ctx->src, kernel->format, ctx->width, ctx->height, scene);
+				if (kernel->setup) {
+					kernel->setup(ctx);
+				}
+				kernel->run(ctx);
+
+				if (!ctx->out_len) {
+					continue;
+				}
+
+				uint32_t hash = golden_fnv1a(ctx->dst, ctx->out_len);
+				if (update) {
+					printf("\t{ \"%s\", %u, %u, %u, 0x%08lx },\n", kernel->name, scene,
+					       ctx->width, ctx->height, (unsigned long)hash);
+					continue;
+				}
+
+				const struct golden_hash *expected = golden_find_hash(kernel->name, scene, ctx->width, ctx->height);
+				if (!expected || expected->hash != hash) {
+					printf("FAIL %s %s %ux%u: hash 0x%08lx, esperado %s\n", kernel->name,
+					       golden_scene_name(scene), ctx->width, ctx->height, (unsigned long)hash,
+					       expected ? "otro" : "sin referencia");
+					failures++;
+				}
+			}
+		}
+	}
+
+	if (update) {
+		printf("};\n\nconst unsigned int golden_num_hashes = sizeof(golden_hashes) / sizeof(golden_hashes[0]);\n");
+	} else {
+		printf("golden: %d discrepancias\n", failures);
+	}
+
+	return failures;
+}
+
+/**
+ * @brief Mide cada kernel sobre la escena de ruido y compara el mínimo por píxel con la línea base.
+ * @return Número de regresiones.
+ */
+int golden_perf(struct bench_ctx *ctx, uint32_t tolerance_pct, bool update)
+{
+	int regressions = 0;
+	struct bench_result result;
+
+	if (update) {
+		printf("/* Entradas para la rama de esta plataforma en baselines.c */\n");
+	}
+
+	for (unsigned int k = 0; k < bench_num_kernels; k++) {
+		const struct bench_kernel *kernel = &bench_kernels[k];
+
+		for (unsigned int s = 0; s < GOLDEN_NUM_SIZES; s++) {
+			ctx->width = golden_sizes[s][0];
+			ctx->height = golden_sizes[s][1];
+			golden_fill_scene(ctx->src, kernel->format, ctx->width, ctx->height, GOLDEN_SCENE_NOISE);
+			if (bench_run(kernel, ctx, GOLDEN_PERF_ITERATIONS, &result)) {
+				continue;
+			}
+
+			uint32_t pixels = (uint32_t)ctx->width * ctx->height;
+			uint32_t per_pixel = ((uint64_t)result.min * 100 + pixels / 2) / pixels;
+
+			if (update) {
+				printf("\t{ \"%s\", %u, %u, %lu },\n", kernel->name, ctx->width, ctx->height,
+				       (unsigned long)per_pixel);
+				continue;
+			}
+
+			const struct golden_baseline *base = NULL;
+			for (unsigned int i = 0; i < golden_num_baselines; i++) {
+				const struct golden_baseline *e = &golden_baselines[i];
+				if (e->kernel && e->width == ctx->width && e->height == ctx->height && !strcmp(e->kernel, kernel->name)) {
+					base = e;
+					break;
+				}
+			}
+
+			if (!base) {
+				printf("SKIP %s %ux%u: sin línea base\n", kernel->name, ctx->width, ctx->height);
+				continue;
+			}
+
+			uint32_t limit = base->per_pixel_x100 + (base->per_pixel_x100 * tolerance_pct + 99) / 100;
+			if (per_pixel > limit) {
+				printf("SLOW %s %ux%u: %lu/px x100, referencia %lu (+%lu%% admitido)\n", kernel->name,
+				       ctx->width, ctx->height, (unsigned long)per_pixel,
+				       (unsigned long)base->per_pixel_x100, (unsigned long)tolerance_pct);
+				regressions++;
+			}
+		}
+	}
+
+	if (!update) {
+		printf("perf: %d regresiones\n", regressions);
+	}
+
+	return regressions;
+}
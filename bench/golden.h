@@ -0,0 +1,102 @@
+/**
+ * @file golden.h
+ * @brief Corpus de frames de referencia, hashes de salida y líneas base de rendimiento.
+ *
+ * Cada kernel del registro de bench se ejecuta sobre las escenas del corpus en
+ * su formato de entrada; el hash FNV-1a de su salida debe coincidir bit a bit
+ * con el de golden_hashes.c. El rendimiento se compara con baselines.c
+ * admitiendo una tolerancia.
+ */
+
+#ifndef __GOLDEN_H__
+#define __GOLDEN_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bench.h"
+
+/**
+ * @enum golden_scene
+ * @brief Escenas del corpus. Se generan de forma determinista en cada formato.
+ */
+enum golden_scene {
+    GOLDEN_SCENE_GRADIENT = 0,  /**< Gradientes suaves en los tres canales */
+    GOLDEN_SCENE_BARS,          /**< Barras de color (como el patrón de prueba de la OV7670) */
+    GOLDEN_SCENE_CHECKER,       /**< Tablero 8x8 blanco y negro: bordes duros */
+    GOLDEN_SCENE_NOISE,         /**< Ruido uniforme */
+    GOLDEN_SCENE_DARK,          /**< Poca luz con ruido, como con ganancia alta */
+    GOLDEN_SCENE_COUNT,
+};
+
+/**
+ * @struct golden_hash
+ * @brief Hash esperado de la salida de un kernel para una escena y tamaño.
+ */
+struct golden_hash {
+    const char *kernel;  /**< Nombre del kernel en el registro */
+    uint8_t scene;       /**< Escena (golden_scene) */
+    uint16_t width;      /**< Ancho del frame */
+    uint16_t height;     /**< Alto del frame */
+    uint32_t hash;       /**< FNV-1a de los bytes de salida */
+};
+
+/**
+ * @struct golden_baseline
+ * @brief Rendimiento de referencia de un kernel.
+ */
+struct golden_baseline {
+    const char *kernel;       /**< Nombre del kernel en el registro */
+    uint16_t width;           /**< Ancho del frame */
+    uint16_t height;          /**< Alto del frame */
+    uint32_t per_pixel_x100;  /**< Mínimo por píxel x100 (ciclos o ns según plataforma) */
+};
+
+extern const struct golden_hash golden_hashes[];            /**< Hashes esperados */
+extern const unsigned int golden_num_hashes;                /**< Entradas de golden_hashes */
+extern const struct golden_baseline golden_baselines[];     /**< Referencias de la plataforma actual */
+extern const unsigned int golden_num_baselines;             /**< Entradas de golden_baselines */
+
+/**
+ * @brief Nombre corto de una escena.
+ * @param scene Escena
+ * @return Nombre, o "?" si no existe
+ */
+const char *golden_scene_name(unsigned int scene);
+
+/**
+ * @brief Genera una escena del corpus en el formato pedido (planos concatenados).
+ * @param dst    Buffer destino
+ * @param format FORMAT_RGB565, FORMAT_YUYV o FORMAT_YUV422
+ * @param width  Ancho en píxeles (par)
+ * @param height Alto en píxeles
+ * @param scene  Escena (golden_scene)
+ */
+void golden_fill_scene(uint8_t *dst, uint32_t format, uint16_t width, uint16_t height, unsigned int scene);
+
+/**
+ * @brief Hash FNV-1a de 32 bits.
+ * @param data Bytes
+ * @param len  Longitud
+ * @return Hash
+ */
+uint32_t golden_fnv1a(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Comprueba la salida de todos los kernels contra los hashes esperados.
+ * @param ctx    Contexto con los buffers reservados
+ * @param update Si es true, imprime una nueva tabla golden_hashes.c en lugar de comparar
+ * @return Número de discrepancias (0 si todo coincide)
+ */
+int golden_verify(struct bench_ctx *ctx, bool update);
+
+/**
+ * @brief Compara el rendimiento de todos los kernels con las líneas base.
+ * @param ctx           Contexto con los buffers reservados
+ * @param tolerance_pct Empeoramiento admitido en porcentaje
+ * @param update        Si es true, imprime una nueva tabla de líneas base en lugar de comparar
+ * @return Número de regresiones (0 si todo está dentro de la tolerancia)
+ */
+int golden_perf(struct bench_ctx *ctx, uint32_t tolerance_pct, bool update);
+
+#endif /* __GOLDEN_H__ */
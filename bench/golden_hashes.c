@@ -0,0 +1,582 @@
+/* Generado con `minivision_bench update-golden`: no editar a mano. */
+
+#include "golden.h"
+
+const struct golden_hash golden_hashes[] = {
+	{ "convert/rgb565be_to_native_bytewise", 0, 80, 60, 0xbcc1823c },
+	{ "convert/rgb565be_to_native_bytewise", 1, 80, 60, 0xe65076a5 },
+	{ "convert/rgb565be_to_native_bytewise", 2, 80, 60, 0x35ec9905 },
+	{ "convert/rgb565be_to_native_bytewise", 3, 80, 60, 0xff80a240 },
+	{ "convert/rgb565be_to_native_bytewise", 4, 80, 60, 0xf4ec6392 },
+	{ "convert/rgb565be_to_native_bytewise", 0, 160, 120, 0x5f68464a },
+	{ "convert/rgb565be_to_native_bytewise", 1, 160, 120, 0xc5259145 },
+	{ "convert/rgb565be_to_native_bytewise", 2, 160, 120, 0x6ca7a8c5 },
+	{ "convert/rgb565be_to_native_bytewise", 3, 160, 120, 0xa1cdb815 },
+	{ "convert/rgb565be_to_native_bytewise", 4, 160, 120, 0x99ba1035 },
+	{ "convert/rgb565be_to_native", 0, 80, 60, 0xbcc1823c },
+	{ "convert/rgb565be_to_native", 1, 80, 60, 0xe65076a5 },
+	{ "convert/rgb565be_to_native", 2, 80, 60, 0x35ec9905 },
+	{ "convert/rgb565be_to_native", 3, 80, 60, 0xff80a240 },
+	{ "convert/rgb565be_to_native", 4, 80, 60, 0xf4ec6392 },
+	{ "convert/rgb565be_to_native", 0, 160, 120, 0x5f68464a },
+	{ "convert/rgb565be_to_native", 1, 160, 120, 0xc5259145 },
+	{ "convert/rgb565be_to_native", 2, 160, 120, 0x6ca7a8c5 },
+	{ "convert/rgb565be_to_native", 3, 160, 120, 0xa1cdb815 },
+	{ "convert/rgb565be_to_native", 4, 160, 120, 0x99ba1035 },
+	{ "convert/yuyv_to_rgb565", 0, 80, 60, 0xbddf86dc },
+	{ "convert/yuyv_to_rgb565", 1, 80, 60, 0xe65076a5 },
+	{ "convert/yuyv_to_rgb565", 2, 80, 60, 0x35ec9905 },
+	{ "convert/yuyv_to_rgb565", 3, 80, 60, 0xce9e3de1 },
+	{ "convert/yuyv_to_rgb565", 4, 80, 60, 0x8134ea2d },
+	{ "convert/yuyv_to_rgb565", 0, 160, 120, 0xe7c9ae28 },
+	{ "convert/yuyv_to_rgb565", 1, 160, 120, 0xc5259145 },
+	{ "convert/yuyv_to_rgb565", 2, 160, 120, 0x6ca7a8c5 },
+	{ "convert/yuyv_to_rgb565", 3, 160, 120, 0x2ad1990e },
+	{ "convert/yuyv_to_rgb565", 4, 160, 120, 0xe8bb87b5 },
+	{ "convert/yuyv_to_y8", 0, 80, 60, 0xd6fa7fc9 },
+	{ "convert/yuyv_to_y8", 1, 80, 60, 0x8a47b435 },
+	{ "convert/yuyv_to_y8", 2, 80, 60, 0x0749bb65 },
+	{ "convert/yuyv_to_y8", 3, 80, 60, 0x6f138ac5 },
+	{ "convert/yuyv_to_y8", 4, 80, 60, 0xabb6cae6 },
+	{ "convert/yuyv_to_y8", 0, 160, 120, 0x6c0d9f78 },
+	{ "convert/yuyv_to_y8", 1, 160, 120, 0xda4fe145 },
+	{ "convert/yuyv_to_y8", 2, 160, 120, 0x79719a45 },
+	{ "convert/yuyv_to_y8", 3, 160, 120, 0xf93178a5 },
+	{ "convert/yuyv_to_y8", 4, 160, 120, 0x65cb6b02 },
+	{ "convert/rgb565be_to_y8", 0, 80, 60, 0x2d200aee },
+	{ "convert/rgb565be_to_y8", 1, 80, 60, 0x47d4282d },
+	{ "convert/rgb565be_to_y8", 2, 80, 60, 0x0749bb65 },
+	{ "convert/rgb565be_to_y8", 3, 80, 60, 0xcda5d4fe },
+	{ "convert/rgb565be_to_y8", 4, 80, 60, 0xd3647a5d },
+	{ "convert/rgb565be_to_y8", 0, 160, 120, 0x4f7419f4 },
+	{ "convert/rgb565be_to_y8", 1, 160, 120, 0x27671565 },
+	{ "convert/rgb565be_to_y8", 2, 160, 120, 0x79719a45 },
+	{ "convert/rgb565be_to_y8", 3, 160, 120, 0x6c8bf4cf },
+	{ "convert/rgb565be_to_y8", 4, 160, 120, 0x96a140cc },
+	{ "convert/scale_nn_half", 0, 80, 60, 0xdb21c425 },
+	{ "convert/scale_nn_half", 1, 80, 60, 0x35e83485 },
+	{ "convert/scale_nn_half", 2, 80, 60, 0x84868095 },
+	{ "convert/scale_nn_half", 3, 80, 60, 0x69ccc6a5 },
+	{ "convert/scale_nn_half", 4, 80, 60, 0x25d03ea5 },
+	{ "convert/scale_nn_half", 0, 160, 120, 0x804a1aac },
+	{ "convert/scale_nn_half", 1, 160, 120, 0xe65076a5 },
+	{ "convert/scale_nn_half", 2, 160, 120, 0xfb5c6d05 },
+	{ "convert/scale_nn_half", 3, 160, 120, 0x5bd6bc72 },
+	{ "convert/scale_nn_half", 4, 160, 120, 0x47724f2d },
+	{ "convert/gamma_lut565", 0, 80, 60, 0x174ac17c },
+	{ "convert/gamma_lut565", 1, 80, 60, 0xe65076a5 },
+	{ "convert/gamma_lut565", 2, 80, 60, 0x35ec9905 },
+	{ "convert/gamma_lut565", 3, 80, 60, 0xbbfee73d },
+	{ "convert/gamma_lut565", 4, 80, 60, 0xebaed0ff },
+	{ "convert/gamma_lut565", 0, 160, 120, 0x4ef46cf4 },
+	{ "convert/gamma_lut565", 1, 160, 120, 0xc5259145 },
+	{ "convert/gamma_lut565", 2, 160, 120, 0x6ca7a8c5 },
+	{ "convert/gamma_lut565", 3, 160, 120, 0x8a3d3721 },
+	{ "convert/gamma_lut565", 4, 160, 120, 0xa5186741 },
+	{ "convert/yuyv_to_rgb565_interp", 0, 80, 60, 0xbddf86dc },
+	{ "convert/yuyv_to_rgb565_interp", 1, 80, 60, 0xe65076a5 },
+	{ "convert/yuyv_to_rgb565_interp", 2, 80, 60, 0x35ec9905 },
+	{ "convert/yuyv_to_rgb565_interp", 3, 80, 60, 0xce9e3de1 },
+	{ "convert/yuyv_to_rgb565_interp", 4, 80, 60, 0x8134ea2d },
+	{ "convert/yuyv_to_rgb565_interp", 0, 160, 120, 0xe7c9ae28 },
+	{ "convert/yuyv_to_rgb565_interp", 1, 160, 120, 0xc5259145 },
+	{ "convert/yuyv_to_rgb565_interp", 2, 160, 120, 0x6ca7a8c5 },
+	{ "convert/yuyv_to_rgb565_interp", 3, 160, 120, 0x2ad1990e },
+	{ "convert/yuyv_to_rgb565_interp", 4, 160, 120, 0xe8bb87b5 },
+	{ "convert/rgb565be_to_y8_interp", 0, 80, 60, 0x2d200aee },
+	{ "convert/rgb565be_to_y8_interp", 1, 80, 60, 0x47d4282d },
+	{ "convert/rgb565be_to_y8_interp", 2, 80, 60, 0x0749bb65 },
+	{ "convert/rgb565be_to_y8_interp", 3, 80, 60, 0xcda5d4fe },
+	{ "convert/rgb565be_to_y8_interp", 4, 80, 60, 0xd3647a5d },
+	{ "convert/rgb565be_to_y8_interp", 0, 160, 120, 0x4f7419f4 },
+	{ "convert/rgb565be_to_y8_interp", 1, 160, 120, 0x27671565 },
+	{ "convert/rgb565be_to_y8_interp", 2, 160, 120, 0x79719a45 },
+	{ "convert/rgb565be_to_y8_interp", 3, 160, 120, 0x6c8bf4cf },
+	{ "convert/rgb565be_to_y8_interp", 4, 160, 120, 0x96a140cc },
+	{ "convert/scale_nn_half_interp", 0, 80, 60, 0xdb21c425 },
+	{ "convert/scale_nn_half_interp", 1, 80, 60, 0x35e83485 },
+	{ "convert/scale_nn_half_interp", 2, 80, 60, 0x84868095 },
+	{ "convert/scale_nn_half_interp", 3, 80, 60, 0x69ccc6a5 },
+	{ "convert/scale_nn_half_interp", 4, 80, 60, 0x25d03ea5 },
+	{ "convert/scale_nn_half_interp", 0, 160, 120, 0x804a1aac },
+	{ "convert/scale_nn_half_interp", 1, 160, 120, 0xe65076a5 },
+	{ "convert/scale_nn_half_interp", 2, 160, 120, 0xfb5c6d05 },
+	{ "convert/scale_nn_half_interp", 3, 160, 120, 0x5bd6bc72 },
+	{ "convert/scale_nn_half_interp", 4, 160, 120, 0x47724f2d },
+	{ "convert/gamma_lut565_interp", 0, 80, 60, 0x174ac17c },
+	{ "convert/gamma_lut565_interp", 1, 80, 60, 0xe65076a5 },
+	{ "convert/gamma_lut565_interp", 2, 80, 60, 0x35ec9905 },
+	{ "convert/gamma_lut565_interp", 3, 80, 60, 0xbbfee73d },
+	{ "convert/gamma_lut565_interp", 4, 80, 60, 0xebaed0ff },
+	{ "convert/gamma_lut565_interp", 0, 160, 120, 0x4ef46cf4 },
+	{ "convert/gamma_lut565_interp", 1, 160, 120, 0xc5259145 },
+	{ "convert/gamma_lut565_interp", 2, 160, 120, 0x6ca7a8c5 },
+	{ "convert/gamma_lut565_interp", 3, 160, 120, 0x8a3d3721 },
+	{ "convert/gamma_lut565_interp", 4, 160, 120, 0xa5186741 },
+	{ "fuse/unfused_scale_gamma", 0, 80, 60, 0xbe437b4a },
+	{ "fuse/unfused_scale_gamma", 1, 80, 60, 0x35e83485 },
+	{ "fuse/unfused_scale_gamma", 2, 80, 60, 0x84868095 },
+	{ "fuse/unfused_scale_gamma", 3, 80, 60, 0x9f78da7e },
+	{ "fuse/unfused_scale_gamma", 4, 80, 60, 0x7fd1e171 },
+	{ "fuse/unfused_scale_gamma", 0, 160, 120, 0x091b862e },
+	{ "fuse/unfused_scale_gamma", 1, 160, 120, 0xe65076a5 },
+	{ "fuse/unfused_scale_gamma", 2, 160, 120, 0xfb5c6d05 },
+	{ "fuse/unfused_scale_gamma", 3, 160, 120, 0x0ae5f1ef },
+	{ "fuse/unfused_scale_gamma", 4, 160, 120, 0x9194f128 },
+	{ "fuse/fused_scale_gamma", 0, 80, 60, 0xbe437b4a },
+	{ "fuse/fused_scale_gamma", 1, 80, 60, 0x35e83485 },
+	{ "fuse/fused_scale_gamma", 2, 80, 60, 0x84868095 },
+	{ "fuse/fused_scale_gamma", 3, 80, 60, 0x9f78da7e },
+	{ "fuse/fused_scale_gamma", 4, 80, 60, 0x7fd1e171 },
+	{ "fuse/fused_scale_gamma", 0, 160, 120, 0x091b862e },
+	{ "fuse/fused_scale_gamma", 1, 160, 120, 0xe65076a5 },
+	{ "fuse/fused_scale_gamma", 2, 160, 120, 0xfb5c6d05 },
+	{ "fuse/fused_scale_gamma", 3, 160, 120, 0x0ae5f1ef },
+	{ "fuse/fused_scale_gamma", 4, 160, 120, 0x9194f128 },
+	{ "fuse/fused_scale_gamma_generic", 0, 80, 60, 0xbe437b4a },
+	{ "fuse/fused_scale_gamma_generic", 1, 80, 60, 0x35e83485 },
+	{ "fuse/fused_scale_gamma_generic", 2, 80, 60, 0x84868095 },
+	{ "fuse/fused_scale_gamma_generic", 3, 80, 60, 0x9f78da7e },
+	{ "fuse/fused_scale_gamma_generic", 4, 80, 60, 0x7fd1e171 },
+	{ "fuse/fused_scale_gamma_generic", 0, 160, 120, 0x091b862e },
+	{ "fuse/fused_scale_gamma_generic", 1, 160, 120, 0xe65076a5 },
+	{ "fuse/fused_scale_gamma_generic", 2, 160, 120, 0xfb5c6d05 },
+	{ "fuse/fused_scale_gamma_generic", 3, 160, 120, 0x0ae5f1ef },
+	{ "fuse/fused_scale_gamma_generic", 4, 160, 120, 0x9194f128 },
+	{ "filter/box3_y8", 0, 80, 60, 0x3e57aa02 },
+	{ "filter/box3_y8", 1, 80, 60, 0x822d8435 },
+	{ "filter/box3_y8", 2, 80, 60, 0xca2389f1 },
+	{ "filter/box3_y8", 3, 80, 60, 0x1b5f9e61 },
+	{ "filter/box3_y8", 4, 80, 60, 0x977a5f0a },
+	{ "filter/box3_y8", 0, 160, 120, 0x1444c8dc },
+	{ "filter/box3_y8", 1, 160, 120, 0xf753d005 },
+	{ "filter/box3_y8", 2, 160, 120, 0xce47f43d },
+	{ "filter/box3_y8", 3, 160, 120, 0xbc389b56 },
+	{ "filter/box3_y8", 4, 160, 120, 0x9afbce95 },
+	{ "analytics/histogram_rgb565", 0, 80, 60, 0xbad1f8ad },
+	{ "analytics/histogram_rgb565", 1, 80, 60, 0x26cf004f },
+	{ "analytics/histogram_rgb565", 2, 80, 60, 0xd11cf15f },
+	{ "analytics/histogram_rgb565", 3, 80, 60, 0xea27ad61 },
+	{ "analytics/histogram_rgb565", 4, 80, 60, 0x97728ebc },
+	{ "analytics/histogram_rgb565", 0, 160, 120, 0xe9361106 },
+	{ "analytics/histogram_rgb565", 1, 160, 120, 0x62b34c4c },
+	{ "analytics/histogram_rgb565", 2, 160, 120, 0xfed033cc },
+	{ "analytics/histogram_rgb565", 3, 160, 120, 0xf3c51cd6 },
+	{ "analytics/histogram_rgb565", 4, 160, 120, 0x80713c94 },
+	{ "analytics/histogram_yuyv", 0, 80, 60, 0x70331f07 },
+	{ "analytics/histogram_yuyv", 1, 80, 60, 0x9cadf44f },
+	{ "analytics/histogram_yuyv", 2, 80, 60, 0xd11cf15f },
+	{ "analytics/histogram_yuyv", 3, 80, 60, 0xc30eec61 },
+	{ "analytics/histogram_yuyv", 4, 80, 60, 0xd172621a },
+	{ "analytics/histogram_yuyv", 0, 160, 120, 0x290f450a },
+	{ "analytics/histogram_yuyv", 1, 160, 120, 0x6be337dc },
+	{ "analytics/histogram_yuyv", 2, 160, 120, 0xfed033cc },
+	{ "analytics/histogram_yuyv", 3, 160, 120, 0x8f9e4d5e },
+	{ "analytics/histogram_yuyv", 4, 160, 120, 0x9e8a00ca },
+	{ "analytics/histogram_yuv422", 0, 80, 60, 0x70331f07 },
+	{ "analytics/histogram_yuv422", 1, 80, 60, 0x9cadf44f },
+	{ "analytics/histogram_yuv422", 2, 80, 60, 0xd11cf15f },
+	{ "analytics/histogram_yuv422", 3, 80, 60, 0xc30eec61 },
+	{ "analytics/histogram_yuv422", 4, 80, 60, 0xd172621a },
+	{ "analytics/histogram_yuv422", 0, 160, 120, 0x290f450a },
+	{ "analytics/histogram_yuv422", 1, 160, 120, 0x6be337dc },
+	{ "analytics/histogram_yuv422", 2, 160, 120, 0xfed033cc },
+	{ "analytics/histogram_yuv422", 3, 160, 120, 0x8f9e4d5e },
+	{ "analytics/histogram_yuv422", 4, 160, 120, 0x9e8a00ca },
+	{ "analytics/histogram_roi_rgb565", 0, 80, 60, 0xf3df1f11 },
+	{ "analytics/histogram_roi_rgb565", 1, 80, 60, 0xe7e84589 },
+	{ "analytics/histogram_roi_rgb565", 2, 80, 60, 0x4c1a84a9 },
+	{ "analytics/histogram_roi_rgb565", 3, 80, 60, 0x4bf59aa5 },
+	{ "analytics/histogram_roi_rgb565", 4, 80, 60, 0x2ca34599 },
+	{ "analytics/histogram_roi_rgb565", 0, 160, 120, 0xabf1acdb },
+	{ "analytics/histogram_roi_rgb565", 1, 160, 120, 0x68244a0f },
+	{ "analytics/histogram_roi_rgb565", 2, 160, 120, 0xd11cf15f },
+	{ "analytics/histogram_roi_rgb565", 3, 160, 120, 0xd567ec4f },
+	{ "analytics/histogram_roi_rgb565", 4, 160, 120, 0x64df4741 },
+	{ "analytics/histogram_roi_yuyv", 0, 80, 60, 0xe6758105 },
+	{ "analytics/histogram_roi_yuyv", 1, 80, 60, 0xb4011209 },
+	{ "analytics/histogram_roi_yuyv", 2, 80, 60, 0x4c1a84a9 },
+	{ "analytics/histogram_roi_yuyv", 3, 80, 60, 0xa9985759 },
+	{ "analytics/histogram_roi_yuyv", 4, 80, 60, 0x1681e09f },
+	{ "analytics/histogram_roi_yuyv", 0, 160, 120, 0xbaa7a6b3 },
+	{ "analytics/histogram_roi_yuyv", 1, 160, 120, 0x2cb3980f },
+	{ "analytics/histogram_roi_yuyv", 2, 160, 120, 0xd11cf15f },
+	{ "analytics/histogram_roi_yuyv", 3, 160, 120, 0x990d4415 },
+	{ "analytics/histogram_roi_yuyv", 4, 160, 120, 0x7fff7e74 },
+	{ "equalize/global", 0, 80, 60, 0x02e70462 },
+	{ "equalize/global", 1, 80, 60, 0x2fb16c05 },
+	{ "equalize/global", 2, 80, 60, 0x0749bb65 },
+	{ "equalize/global", 3, 80, 60, 0x3e50e565 },
+	{ "equalize/global", 4, 80, 60, 0x50838172 },
+	{ "equalize/global", 0, 160, 120, 0x468709cc },
+	{ "equalize/global", 1, 160, 120, 0x857aa045 },
+	{ "equalize/global", 2, 160, 120, 0x79719a45 },
+	{ "equalize/global", 3, 160, 120, 0xbb5d2133 },
+	{ "equalize/global", 4, 160, 120, 0x4e5d2517 },
+	{ "equalize/clahe_convert", 0, 80, 60, 0x2d200aee },
+	{ "equalize/clahe_convert", 1, 80, 60, 0x47d4282d },
+	{ "equalize/clahe_convert", 2, 80, 60, 0x0749bb65 },
+	{ "equalize/clahe_convert", 3, 80, 60, 0xcda5d4fe },
+	{ "equalize/clahe_convert", 4, 80, 60, 0xd3647a5d },
+	{ "equalize/clahe_convert", 0, 160, 120, 0x4f7419f4 },
+	{ "equalize/clahe_convert", 1, 160, 120, 0x27671565 },
+	{ "equalize/clahe_convert", 2, 160, 120, 0x79719a45 },
+	{ "equalize/clahe_convert", 3, 160, 120, 0x6c8bf4cf },
+	{ "equalize/clahe_convert", 4, 160, 120, 0x96a140cc },
+	{ "equalize/clahe_apply", 0, 80, 60, 0x013431a5 },
+	{ "equalize/clahe_apply", 1, 80, 60, 0xcba99965 },
+	{ "equalize/clahe_apply", 2, 80, 60, 0x2535bb65 },
+	{ "equalize/clahe_apply", 3, 80, 60, 0x6068ba53 },
+	{ "equalize/clahe_apply", 4, 80, 60, 0x4993bb6e },
+	{ "equalize/clahe_apply", 0, 160, 120, 0x6b4c375a },
+	{ "equalize/clahe_apply", 1, 160, 120, 0xe0c74cc5 },
+	{ "equalize/clahe_apply", 2, 160, 120, 0x09219a45 },
+	{ "equalize/clahe_apply", 3, 160, 120, 0xfcbc96d9 },
+	{ "equalize/clahe_apply", 4, 160, 120, 0xd7b781c9 },
+	{ "denoise/y8", 0, 80, 60, 0xf2efb50f },
+	{ "denoise/y8", 1, 80, 60, 0x8be688b5 },
+	{ "denoise/y8", 2, 80, 60, 0x39be537f },
+	{ "denoise/y8", 3, 80, 60, 0x12dcd6cb },
+	{ "denoise/y8", 4, 80, 60, 0x6f72006b },
+	{ "denoise/y8", 0, 160, 120, 0x9514b6a1 },
+	{ "denoise/y8", 1, 160, 120, 0x17691765 },
+	{ "denoise/y8", 2, 160, 120, 0x18bdedd5 },
+	{ "denoise/y8", 3, 160, 120, 0xbaf4e411 },
+	{ "denoise/y8", 4, 160, 120, 0xcae4685b },
+	{ "denoise/rgb565", 0, 80, 60, 0xb622ed66 },
+	{ "denoise/rgb565", 1, 80, 60, 0x8ccda1a5 },
+	{ "denoise/rgb565", 2, 80, 60, 0xe004e445 },
+	{ "denoise/rgb565", 3, 80, 60, 0x87ea183e },
+	{ "denoise/rgb565", 4, 80, 60, 0x1ec37d18 },
+	{ "denoise/rgb565", 0, 160, 120, 0xe4c2baa8 },
+	{ "denoise/rgb565", 1, 160, 120, 0x91b191e5 },
+	{ "denoise/rgb565", 2, 160, 120, 0x8a6bc3c5 },
+	{ "denoise/rgb565", 3, 160, 120, 0xf591afaf },
+	{ "denoise/rgb565", 4, 160, 120, 0x26fcd3c1 },
+	{ "hdr/merge_rgb565", 0, 80, 60, 0xc8bd7a0d },
+	{ "hdr/merge_rgb565", 1, 80, 60, 0x72b333c5 },
+	{ "hdr/merge_rgb565", 2, 80, 60, 0x0b6d2945 },
+	{ "hdr/merge_rgb565", 3, 80, 60, 0x975a05ff },
+	{ "hdr/merge_rgb565", 4, 80, 60, 0x47221edc },
+	{ "hdr/merge_rgb565", 0, 160, 120, 0x0f09dfba },
+	{ "hdr/merge_rgb565", 1, 160, 120, 0x331d5bc5 },
+	{ "hdr/merge_rgb565", 2, 160, 120, 0x47525fc5 },
+	{ "hdr/merge_rgb565", 3, 160, 120, 0xae314954 },
+	{ "hdr/merge_rgb565", 4, 160, 120, 0x0c713bcc },
+	{ "lens/correct_rgb565", 0, 80, 60, 0xd1a0780a },
+	{ "lens/correct_rgb565", 1, 80, 60, 0xe46b5179 },
+	{ "lens/correct_rgb565", 2, 80, 60, 0xd56ae3fb },
+	{ "lens/correct_rgb565", 3, 80, 60, 0x6da7c8a7 },
+	{ "lens/correct_rgb565", 4, 80, 60, 0x9a76cb32 },
+	{ "lens/correct_rgb565", 0, 160, 120, 0xf83242e9 },
+	{ "lens/correct_rgb565", 1, 160, 120, 0x53371840 },
+	{ "lens/correct_rgb565", 2, 160, 120, 0x939e93a9 },
+	{ "lens/correct_rgb565", 3, 160, 120, 0xf8a91dab },
+	{ "lens/correct_rgb565", 4, 160, 120, 0x2f214757 },
+	{ "lens/correct_y8", 0, 80, 60, 0x2ea9b4f3 },
+	{ "lens/correct_y8", 1, 80, 60, 0x50c61cb5 },
+	{ "lens/correct_y8", 2, 80, 60, 0x30860f86 },
+	{ "lens/correct_y8", 3, 80, 60, 0x9fcd3da5 },
+	{ "lens/correct_y8", 4, 80, 60, 0xf2b57ad2 },
+	{ "lens/correct_y8", 0, 160, 120, 0xac87ad63 },
+	{ "lens/correct_y8", 1, 160, 120, 0x730867be },
+	{ "lens/correct_y8", 2, 160, 120, 0xbac700b1 },
+	{ "lens/correct_y8", 3, 160, 120, 0xdc9a9b77 },
+	{ "lens/correct_y8", 4, 160, 120, 0x2289ee7c },
+	{ "warp/nearest_rgb565", 0, 80, 60, 0x90a6ace0 },
+	{ "warp/nearest_rgb565", 1, 80, 60, 0x38e25395 },
+	{ "warp/nearest_rgb565", 2, 80, 60, 0xc13dd777 },
+	{ "warp/nearest_rgb565", 3, 80, 60, 0x92515aac },
+	{ "warp/nearest_rgb565", 4, 80, 60, 0x6c07acf4 },
+	{ "warp/nearest_rgb565", 0, 160, 120, 0xeb2ba766 },
+	{ "warp/nearest_rgb565", 1, 160, 120, 0xd2babb12 },
+	{ "warp/nearest_rgb565", 2, 160, 120, 0x537dbb91 },
+	{ "warp/nearest_rgb565", 3, 160, 120, 0xa656ce51 },
+	{ "warp/nearest_rgb565", 4, 160, 120, 0xca5df1e9 },
+	{ "warp/bilinear_rgb565", 0, 80, 60, 0x0191b3c7 },
+	{ "warp/bilinear_rgb565", 1, 80, 60, 0xf12fff6e },
+	{ "warp/bilinear_rgb565", 2, 80, 60, 0xe46939a9 },
+	{ "warp/bilinear_rgb565", 3, 80, 60, 0xc81c8a0a },
+	{ "warp/bilinear_rgb565", 4, 80, 60, 0x1abbe2dd },
+	{ "warp/bilinear_rgb565", 0, 160, 120, 0xcf8227dc },
+	{ "warp/bilinear_rgb565", 1, 160, 120, 0x2ee40195 },
+	{ "warp/bilinear_rgb565", 2, 160, 120, 0xd18db126 },
+	{ "warp/bilinear_rgb565", 3, 160, 120, 0x4d7ab96e },
+	{ "warp/bilinear_rgb565", 4, 160, 120, 0xcc89f3b9 },
+	{ "warp/bilinear_y8", 0, 80, 60, 0xc7ce8337 },
+	{ "warp/bilinear_y8", 1, 80, 60, 0x4230528d },
+	{ "warp/bilinear_y8", 2, 80, 60, 0x0d2a5c89 },
+	{ "warp/bilinear_y8", 3, 80, 60, 0x34099500 },
+	{ "warp/bilinear_y8", 4, 80, 60, 0xa67f6b6d },
+	{ "warp/bilinear_y8", 0, 160, 120, 0x671dbfe4 },
+	{ "warp/bilinear_y8", 1, 160, 120, 0xd7d62e19 },
+	{ "warp/bilinear_y8", 2, 160, 120, 0xdd3ea990 },
+	{ "warp/bilinear_y8", 3, 160, 120, 0x737fb874 },
+	{ "warp/bilinear_y8", 4, 160, 120, 0xa08cdd9c },
+	{ "rotate/naive90_rgb565", 0, 80, 60, 0xd31f677a },
+	{ "rotate/naive90_rgb565", 1, 80, 60, 0xf3326345 },
+	{ "rotate/naive90_rgb565", 2, 80, 60, 0xe5aa8d05 },
+	{ "rotate/naive90_rgb565", 3, 80, 60, 0x7a48015a },
+	{ "rotate/naive90_rgb565", 4, 80, 60, 0x43e38498 },
+	{ "rotate/naive90_rgb565", 0, 160, 120, 0x187c2618 },
+	{ "rotate/naive90_rgb565", 1, 160, 120, 0x805115c5 },
+	{ "rotate/naive90_rgb565", 2, 160, 120, 0x8e1888c5 },
+	{ "rotate/naive90_rgb565", 3, 160, 120, 0xfc7e7c05 },
+	{ "rotate/naive90_rgb565", 4, 160, 120, 0x66b12a35 },
+	{ "rotate/90_rgb565", 0, 80, 60, 0xd31f677a },
+	{ "rotate/90_rgb565", 1, 80, 60, 0xf3326345 },
+	{ "rotate/90_rgb565", 2, 80, 60, 0xe5aa8d05 },
+	{ "rotate/90_rgb565", 3, 80, 60, 0x7a48015a },
+	{ "rotate/90_rgb565", 4, 80, 60, 0x43e38498 },
+	{ "rotate/90_rgb565", 0, 160, 120, 0x187c2618 },
+	{ "rotate/90_rgb565", 1, 160, 120, 0x805115c5 },
+	{ "rotate/90_rgb565", 2, 160, 120, 0x8e1888c5 },
+	{ "rotate/90_rgb565", 3, 160, 120, 0xfc7e7c05 },
+	{ "rotate/90_rgb565", 4, 160, 120, 0x66b12a35 },
+	{ "rotate/180_rgb565", 0, 80, 60, 0x6a2edd72 },
+	{ "rotate/180_rgb565", 1, 80, 60, 0x1a9730a5 },
+	{ "rotate/180_rgb565", 2, 80, 60, 0xfa1abd05 },
+	{ "rotate/180_rgb565", 3, 80, 60, 0x90648126 },
+	{ "rotate/180_rgb565", 4, 80, 60, 0x5199f954 },
+	{ "rotate/180_rgb565", 0, 160, 120, 0x076d21e8 },
+	{ "rotate/180_rgb565", 1, 160, 120, 0xe425edc5 },
+	{ "rotate/180_rgb565", 2, 160, 120, 0x5054e8c5 },
+	{ "rotate/180_rgb565", 3, 160, 120, 0x38471bc1 },
+	{ "rotate/180_rgb565", 4, 160, 120, 0x4620bbdd },
+	{ "rotate/270_rgb565", 0, 80, 60, 0xee379a5e },
+	{ "rotate/270_rgb565", 1, 80, 60, 0xe95db745 },
+	{ "rotate/270_rgb565", 2, 80, 60, 0xaef43505 },
+	{ "rotate/270_rgb565", 3, 80, 60, 0x8d2d8312 },
+	{ "rotate/270_rgb565", 4, 80, 60, 0xda9a1a44 },
+	{ "rotate/270_rgb565", 0, 160, 120, 0x8942b1d0 },
+	{ "rotate/270_rgb565", 1, 160, 120, 0x3b6cedc5 },
+	{ "rotate/270_rgb565", 2, 160, 120, 0x1d6e88c5 },
+	{ "rotate/270_rgb565", 3, 160, 120, 0xc67a1c2d },
+	{ "rotate/270_rgb565", 4, 160, 120, 0xd62e8125 },
+	{ "rotate/naive90_y8", 0, 80, 60, 0x6f98d54d },
+	{ "rotate/naive90_y8", 1, 80, 60, 0x444838b5 },
+	{ "rotate/naive90_y8", 2, 80, 60, 0x58b98b65 },
+	{ "rotate/naive90_y8", 3, 80, 60, 0x350dd2f9 },
+	{ "rotate/naive90_y8", 4, 80, 60, 0xad020650 },
+	{ "rotate/naive90_y8", 0, 160, 120, 0x5b34b112 },
+	{ "rotate/naive90_y8", 1, 160, 120, 0xc07af585 },
+	{ "rotate/naive90_y8", 2, 160, 120, 0x04f04245 },
+	{ "rotate/naive90_y8", 3, 160, 120, 0x0dd410d7 },
+	{ "rotate/naive90_y8", 4, 160, 120, 0x6d641c8e },
+	{ "rotate/90_y8", 0, 80, 60, 0x6f98d54d },
+	{ "rotate/90_y8", 1, 80, 60, 0x444838b5 },
+	{ "rotate/90_y8", 2, 80, 60, 0x58b98b65 },
+	{ "rotate/90_y8", 3, 80, 60, 0x350dd2f9 },
+	{ "rotate/90_y8", 4, 80, 60, 0xad020650 },
+	{ "rotate/90_y8", 0, 160, 120, 0x5b34b112 },
+	{ "rotate/90_y8", 1, 160, 120, 0xc07af585 },
+	{ "rotate/90_y8", 2, 160, 120, 0x04f04245 },
+	{ "rotate/90_y8", 3, 160, 120, 0x0dd410d7 },
+	{ "rotate/90_y8", 4, 160, 120, 0x6d641c8e },
+	{ "rotate/inplace90_rgb565", 0, 80, 60, 0xeeaf1ee6 },
+	{ "rotate/inplace90_rgb565", 1, 80, 60, 0xabe368c5 },
+	{ "rotate/inplace90_rgb565", 2, 80, 60, 0xad8a5305 },
+	{ "rotate/inplace90_rgb565", 3, 80, 60, 0x159c13ce },
+	{ "rotate/inplace90_rgb565", 4, 80, 60, 0xd88b5734 },
+	{ "rotate/inplace90_rgb565", 0, 160, 120, 0x4e9e1140 },
+	{ "rotate/inplace90_rgb565", 1, 160, 120, 0x2eff47c5 },
+	{ "rotate/inplace90_rgb565", 2, 160, 120, 0x6ca7a8c5 },
+	{ "rotate/inplace90_rgb565", 3, 160, 120, 0x89f26d49 },
+	{ "rotate/inplace90_rgb565", 4, 160, 120, 0x91134d1d },
+	{ "match/ncc_pyramid", 0, 80, 60, 0x370ad55a },
+	{ "match/ncc_pyramid", 1, 80, 60, 0x8c4757dc },
+	{ "match/ncc_pyramid", 2, 80, 60, 0xd72bae0b },
+	{ "match/ncc_pyramid", 3, 80, 60, 0xad41a01b },
+	{ "match/ncc_pyramid", 4, 80, 60, 0xa800e3db },
+	{ "match/ncc_pyramid", 0, 160, 120, 0x5da67649 },
+	{ "match/ncc_pyramid", 1, 160, 120, 0x3c543b40 },
+	{ "match/ncc_pyramid", 2, 160, 120, 0x61a9a8e4 },
+	{ "match/ncc_pyramid", 3, 160, 120, 0xf9d16998 },
+	{ "match/ncc_pyramid", 4, 160, 120, 0x6b5ad569 },
+	{ "code/detect_qr", 0, 80, 60, 0xea6f7283 },
+	{ "code/detect_qr", 1, 80, 60, 0xea6f7283 },
+	{ "code/detect_qr", 2, 80, 60, 0xea6f7283 },
+	{ "code/detect_qr", 3, 80, 60, 0xea6f7283 },
+	{ "code/detect_qr", 4, 80, 60, 0xea6f7283 },
+	{ "code/detect_qr", 0, 160, 120, 0xb935b7a1 },
+	{ "code/detect_qr", 1, 160, 120, 0xb935b7a1 },
+	{ "code/detect_qr", 2, 160, 120, 0xb935b7a1 },
+	{ "code/detect_qr", 3, 160, 120, 0xb935b7a1 },
+	{ "code/detect_qr", 4, 160, 120, 0xb935b7a1 },
+	{ "code/decode_qr", 0, 80, 60, 0xe25614f8 },
+	{ "code/decode_qr", 1, 80, 60, 0xe25614f8 },
+	{ "code/decode_qr", 2, 80, 60, 0xe25614f8 },
+	{ "code/decode_qr", 3, 80, 60, 0xe25614f8 },
+	{ "code/decode_qr", 4, 80, 60, 0xe25614f8 },
+	{ "code/decode_qr", 0, 160, 120, 0x375a2898 },
+	{ "code/decode_qr", 1, 160, 120, 0x375a2898 },
+	{ "code/decode_qr", 2, 160, 120, 0x375a2898 },
+	{ "code/decode_qr", 3, 160, 120, 0x375a2898 },
+	{ "code/decode_qr", 4, 160, 120, 0x375a2898 },
+	{ "code/decode_ean13", 0, 160, 120, 0x7cc0180e },
+	{ "code/decode_ean13", 1, 160, 120, 0x7cc0180e },
+	{ "code/decode_ean13", 2, 160, 120, 0x7cc0180e },
+	{ "code/decode_ean13", 3, 160, 120, 0x7cc0180e },
+	{ "code/decode_ean13", 4, 160, 120, 0x7cc0180e },
+	{ "code/decode_code128", 0, 160, 120, 0xa604eb6a },
+	{ "code/decode_code128", 1, 160, 120, 0xa604eb6a },
+	{ "code/decode_code128", 2, 160, 120, 0xa604eb6a },
+	{ "code/decode_code128", 3, 160, 120, 0xa604eb6a },
+	{ "code/decode_code128", 4, 160, 120, 0xa604eb6a },
+	{ "flow/select", 2, 80, 60, 0x708fb8f2 },
+	{ "flow/select", 3, 80, 60, 0x6bb08aca },
+	{ "flow/select", 2, 160, 120, 0x20367ff8 },
+	{ "flow/select", 3, 160, 120, 0xfcd4a68a },
+	{ "flow/track", 2, 80, 60, 0xaad2b76a },
+	{ "flow/track", 3, 80, 60, 0xdd3022d4 },
+	{ "flow/track", 2, 160, 120, 0x89541362 },
+	{ "flow/track", 3, 160, 120, 0x134ea320 },
+	{ "census/5x5", 0, 80, 60, 0x3612eec5 },
+	{ "census/5x5", 1, 80, 60, 0xc0a6622d },
+	{ "census/5x5", 2, 80, 60, 0x637d344d },
+	{ "census/5x5", 3, 80, 60, 0xf9ef0959 },
+	{ "census/5x5", 4, 80, 60, 0x6d475473 },
+	{ "census/5x5", 0, 160, 120, 0xff9a4895 },
+	{ "census/5x5", 1, 160, 120, 0x347996e5 },
+	{ "census/5x5", 2, 160, 120, 0x5fbabb79 },
+	{ "census/5x5", 3, 160, 120, 0x1d3632b7 },
+	{ "census/5x5", 4, 160, 120, 0xa61dced2 },
+	{ "census/7x7_strip", 0, 80, 60, 0x59dda77d },
+	{ "census/7x7_strip", 1, 80, 60, 0x5341f605 },
+	{ "census/7x7_strip", 2, 80, 60, 0x500d7c11 },
+	{ "census/7x7_strip", 3, 80, 60, 0x527e7309 },
+	{ "census/7x7_strip", 4, 80, 60, 0x026b569b },
+	{ "census/7x7_strip", 0, 160, 120, 0x81854391 },
+	{ "census/7x7_strip", 1, 160, 120, 0x1e8e15f5 },
+	{ "census/7x7_strip", 2, 160, 120, 0xe408a8cb },
+	{ "census/7x7_strip", 3, 160, 120, 0x13b779d1 },
+	{ "census/7x7_strip", 4, 160, 120, 0x4fad6001 },
+	{ "census/disparity", 0, 80, 60, 0x2ce6e34a },
+	{ "census/disparity", 1, 80, 60, 0x82192f25 },
+	{ "census/disparity", 2, 80, 60, 0xe43d0599 },
+	{ "census/disparity", 3, 80, 60, 0x3a376c87 },
+	{ "census/disparity", 4, 80, 60, 0x2baee92f },
+	{ "census/disparity", 0, 160, 120, 0x1d646454 },
+	{ "census/disparity", 1, 160, 120, 0x662a3085 },
+	{ "census/disparity", 2, 160, 120, 0x975e9e65 },
+	{ "census/disparity", 3, 160, 120, 0x05514afb },
+	{ "census/disparity", 4, 160, 120, 0xbef78c0f },
+	{ "census/search", 0, 80, 60, 0xd430dcbb },
+	{ "census/search", 1, 80, 60, 0xf1c3b888 },
+	{ "census/search", 2, 80, 60, 0x511d058a },
+	{ "census/search", 3, 80, 60, 0x49d503de },
+	{ "census/search", 4, 80, 60, 0x9cb6bc29 },
+	{ "census/search", 0, 160, 120, 0x3c51a33b },
+	{ "census/search", 1, 160, 120, 0xa2960fff },
+	{ "census/search", 2, 160, 120, 0xe733ad15 },
+	{ "census/search", 3, 160, 120, 0x5a9e1926 },
+	{ "census/search", 4, 160, 120, 0xa9f8796b },
+	{ "lbp/scene", 2, 80, 60, 0xf452e3c5 },
+	{ "lbp/scene", 3, 80, 60, 0x4b20f8b9 },
+	{ "lbp/scene", 1, 160, 120, 0xef0d01d5 },
+	{ "lbp/scene", 2, 160, 120, 0xf452e3c5 },
+	{ "lbp/scene", 3, 160, 120, 0xc7c5992d },
+	{ "lbp/scene", 4, 160, 120, 0xa7128da2 },
+	{ "lbp/rings", 0, 80, 60, 0x9535ab4a },
+	{ "lbp/rings", 1, 80, 60, 0xa2f4dd47 },
+	{ "lbp/rings", 2, 80, 60, 0xf0bfb368 },
+	{ "lbp/rings", 3, 80, 60, 0x51e477f4 },
+	{ "lbp/rings", 4, 80, 60, 0xa95d84a1 },
+	{ "lbp/rings", 0, 160, 120, 0xb5c9b3a9 },
+	{ "lbp/rings", 1, 160, 120, 0xc79559c5 },
+	{ "lbp/rings", 2, 160, 120, 0xe7653106 },
+	{ "lbp/rings", 3, 160, 120, 0x05d5a034 },
+	{ "lbp/rings", 4, 160, 120, 0xb5c9b3a9 },
+	{ "mono1/threshold_yuyv", 0, 80, 60, 0xf483745c },
+	{ "mono1/threshold_yuyv", 1, 80, 60, 0x57450925 },
+	{ "mono1/threshold_yuyv", 2, 80, 60, 0xa6a4cda5 },
+	{ "mono1/threshold_yuyv", 3, 80, 60, 0xcd96b612 },
+	{ "mono1/threshold_yuyv", 4, 80, 60, 0xa011a805 },
+	{ "mono1/threshold_yuyv", 0, 160, 120, 0xa86ada74 },
+	{ "mono1/threshold_yuyv", 1, 160, 120, 0xf77189d5 },
+	{ "mono1/threshold_yuyv", 2, 160, 120, 0x88934d05 },
+	{ "mono1/threshold_yuyv", 3, 160, 120, 0xf2b594b1 },
+	{ "mono1/threshold_yuyv", 4, 160, 120, 0x7ab40545 },
+	{ "mono1/threshold_rgb565", 0, 80, 60, 0x14e7f15c },
+	{ "mono1/threshold_rgb565", 1, 80, 60, 0x57450925 },
+	{ "mono1/threshold_rgb565", 2, 80, 60, 0xa6a4cda5 },
+	{ "mono1/threshold_rgb565", 3, 80, 60, 0xd5c2fede },
+	{ "mono1/threshold_rgb565", 4, 80, 60, 0xa011a805 },
+	{ "mono1/threshold_rgb565", 0, 160, 120, 0x522c70b1 },
+	{ "mono1/threshold_rgb565", 1, 160, 120, 0xf77189d5 },
+	{ "mono1/threshold_rgb565", 2, 160, 120, 0x88934d05 },
+	{ "mono1/threshold_rgb565", 3, 160, 120, 0xa27e5aa8 },
+	{ "mono1/threshold_rgb565", 4, 160, 120, 0x7ab40545 },
+	{ "mono1/erode", 0, 80, 60, 0x385304a0 },
+	{ "mono1/erode", 1, 80, 60, 0xb2854c25 },
+	{ "mono1/erode", 2, 80, 60, 0xa024ea54 },
+	{ "mono1/erode", 3, 80, 60, 0xd0abf680 },
+	{ "mono1/erode", 4, 80, 60, 0xa011a805 },
+	{ "mono1/erode", 0, 160, 120, 0xa3b7ce1d },
+	{ "mono1/erode", 1, 160, 120, 0xd94a85d5 },
+	{ "mono1/erode", 2, 160, 120, 0xd353a185 },
+	{ "mono1/erode", 3, 160, 120, 0xf4762a77 },
+	{ "mono1/erode", 4, 160, 120, 0x7ab40545 },
+	{ "mono1/dilate", 0, 80, 60, 0x3a0da565 },
+	{ "mono1/dilate", 1, 80, 60, 0x7fdddb45 },
+	{ "mono1/dilate", 2, 80, 60, 0xd67d4240 },
+	{ "mono1/dilate", 3, 80, 60, 0x4493f9eb },
+	{ "mono1/dilate", 4, 80, 60, 0xa011a805 },
+	{ "mono1/dilate", 0, 160, 120, 0x9d6b8482 },
+	{ "mono1/dilate", 1, 160, 120, 0xc3dd5715 },
+	{ "mono1/dilate", 2, 160, 120, 0x947948d5 },
+	{ "mono1/dilate", 3, 160, 120, 0x9eeefc5d },
+	{ "mono1/dilate", 4, 160, 120, 0x7ab40545 },
+	{ "mono1/open", 0, 80, 60, 0xf80b23dc },
+	{ "mono1/open", 1, 80, 60, 0x57450925 },
+	{ "mono1/open", 2, 80, 60, 0xa6a4cda5 },
+	{ "mono1/open", 3, 80, 60, 0x42bc5fa0 },
+	{ "mono1/open", 4, 80, 60, 0xa011a805 },
+	{ "mono1/open", 0, 160, 120, 0xa86ada74 },
+	{ "mono1/open", 1, 160, 120, 0xf77189d5 },
+	{ "mono1/open", 2, 160, 120, 0x88934d05 },
+	{ "mono1/open", 3, 160, 120, 0x7ad0a9a8 },
+	{ "mono1/open", 4, 160, 120, 0x7ab40545 },
+	{ "mono1/close", 0, 80, 60, 0xf483745c },
+	{ "mono1/close", 1, 80, 60, 0x57450925 },
+	{ "mono1/close", 2, 80, 60, 0xa6a4cda5 },
+	{ "mono1/close", 3, 80, 60, 0xfa8dccd3 },
+	{ "mono1/close", 4, 80, 60, 0xa011a805 },
+	{ "mono1/close", 0, 160, 120, 0xa86ada74 },
+	{ "mono1/close", 1, 160, 120, 0xf77189d5 },
+	{ "mono1/close", 2, 160, 120, 0x88934d05 },
+	{ "mono1/close", 3, 160, 120, 0x56680dcd },
+	{ "mono1/close", 4, 160, 120, 0x7ab40545 },
+	{ "mono1/area", 0, 80, 60, 0x6d2118d1 },
+	{ "mono1/area", 1, 80, 60, 0x0ff1c552 },
+	{ "mono1/area", 2, 80, 60, 0x0ff1c552 },
+	{ "mono1/area", 3, 80, 60, 0xbae80cae },
+	{ "mono1/area", 4, 80, 60, 0x4b95f515 },
+	{ "mono1/area", 0, 160, 120, 0xab967f0f },
+	{ "mono1/area", 1, 160, 120, 0xd7cb557e },
+	{ "mono1/area", 2, 160, 120, 0xd7cb557e },
+	{ "mono1/area", 3, 160, 120, 0x8ddf1884 },
+	{ "mono1/area", 4, 160, 120, 0x4b95f515 },
+	{ "codec/stream_result", 0, 80, 60, 0x7cb8543e },
+	{ "codec/stream_result", 1, 80, 60, 0x7cb8543e },
+	{ "codec/stream_result", 2, 80, 60, 0x7cb8543e },
+	{ "codec/stream_result", 3, 80, 60, 0x7cb8543e },
+	{ "codec/stream_result", 4, 80, 60, 0x7cb8543e },
+	{ "codec/stream_result", 0, 160, 120, 0x557442fa },
+	{ "codec/stream_result", 1, 160, 120, 0x557442fa },
+	{ "codec/stream_result", 2, 160, 120, 0x557442fa },
+	{ "codec/stream_result", 3, 160, 120, 0x557442fa },
+	{ "codec/stream_result", 4, 160, 120, 0x557442fa },
+	{ "codec/stream_thumbnail", 0, 80, 60, 0xd6b44776 },
+	{ "codec/stream_thumbnail", 1, 80, 60, 0xd10c971d },
+	{ "codec/stream_thumbnail", 2, 80, 60, 0x893aa23f },
+	{ "codec/stream_thumbnail", 3, 80, 60, 0x5a444d14 },
+	{ "codec/stream_thumbnail", 4, 80, 60, 0x75218ab9 },
+	{ "codec/stream_thumbnail", 0, 160, 120, 0x8288bce4 },
+	{ "codec/stream_thumbnail", 1, 160, 120, 0x4d727e31 },
+	{ "codec/stream_thumbnail", 2, 160, 120, 0x3b05bf5a },
+	{ "codec/stream_thumbnail", 3, 160, 120, 0x25c1c275 },
+	{ "codec/stream_thumbnail", 4, 160, 120, 0x08d6fd18 },
+};
+
+const unsigned int golden_num_hashes = sizeof(golden_hashes) / sizeof(golden_hashes[0]);
@@ -0,0 +1,151 @@
+/**
+ * @file view_test.cpp
+ * @brief Comprobación en el host de vision/view.hpp: vistas tipadas y subventanas.
+ *
+ * view.hpp no lo incluye ningún otro fuente del árbol, así que este programa
+ * es lo que hace que sus plantillas se compilen. Comprueba el formato en el
+ * tipo, el stride y los desplazamientos de las subvistas y el acceso a
+ * píxeles frente a la memoria original. El código de salida es el número de
+ * comprobaciones fallidas, para ctest.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vision/view.hpp"
+
+using namespace minivision;
+
+static_assert(Rgb565::step == 2 && YuyvLuma::step == 2 && Yuv422Luma::step == 1, "bytes por píxel");
+static_assert(Rgb565::format == FORMAT_RGB565 && YuyvLuma::format == FORMAT_YUYV, "formato en el tipo");
+
+static int failures;
+
+#define CHECK(cond)                                                       \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            printf("FALLO %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+            failures++;                                                   \
+        }                                                                 \
+    } while (0)
+
+static constexpr uint16_t kWidth = 80;
+static constexpr uint16_t kHeight = 60;
+
+static uint8_t frame[kWidth * kHeight * 2];
+
+/**
+ * @brief RGB565: stride, desplazamiento del recorte y lectura big-endian.
+ */
+static void test_rgb565()
+{
+    const uint32_t stride = kWidth * 2;
+    camera_buffer buf = {};
+    buf.format = FORMAT_RGB565;
+    buf.width = kWidth;
+    buf.height = kHeight;
+    buf.strides[0] = stride;
+    buf.data[0] = frame;
+
+    for (uint32_t y = 0; y < kHeight; y++) {
+        for (uint32_t x = 0; x < kWidth; x++) {
+            frame[y * stride + 2 * x] = static_cast<uint8_t>(y);
+            frame[y * stride + 2 * x + 1] = static_cast<uint8_t>(x);
+        }
+    }
+
+    ImageView<Rgb565> view(buf);
+    CHECK(view.valid());
+    CHECK(view.width() == kWidth && view.height() == kHeight && view.stride() == stride);
+    CHECK(view.at(7, 3) == ((3 << 8) | 7));
+
+    ImageView<Rgb565> sub = view.crop(10, 5, 20, 8);
+    CHECK(sub.valid());
+    CHECK(sub.data() == frame + 5 * stride + 10 * 2);
+    CHECK(sub.stride() == stride && sub.width() == 20 && sub.height() == 8);
+    CHECK(sub.at(0, 0) == ((5 << 8) | 10));
+    CHECK(sub.at(19, 7) == ((12 << 8) | 29));
+
+    // Subvista de una subvista: los desplazamientos se suman
+    ImageView<Rgb565> sub2 = sub.crop(3, 2, 4, 4);
+    CHECK(sub2.valid() && sub2.data() == frame + 7 * stride + 13 * 2 && sub2.at(1, 1) == ((8 << 8) | 14));
+
+    // Escritura a través de la subvista en la memoria original
+    sub.set(1, 1, 0xabcd);
+    CHECK(frame[6 * stride + 11 * 2] == 0xab && frame[6 * stride + 11 * 2 + 1] == 0xcd);
+
+    // Filas iterables: tantas como el alto y tantos píxeles como el ancho
+    uint32_t rows = 0, pixels = 0;
+    for (auto row : sub.rows()) {
+        CHECK(row.data() == sub.data() + rows * stride);
+        for (auto v : row) {
+            (void)v;
+            pixels++;
+        }
+        rows++;
+    }
+    CHECK(rows == 8 && pixels == 8 * 20);
+
+    // Ventanas que se salen o quedan vacías
+    CHECK(!view.crop(70, 0, 11, 1).valid());
+    CHECK(!view.crop(0, 59, 1, 2).valid());
+    CHECK(!view.crop(0, 0, 0, 1).valid());
+    CHECK(!ImageView<Rgb565>().crop(0, 0, 1, 1).valid());
+    CHECK(view.contains(79, 59) && !view.contains(80, 0) && !view.contains(0, -1));
+
+    // Un frame de otro formato no da una vista
+    CHECK(!ImageView<YuyvLuma>(buf).valid());
+}
+
+/**
+ * @brief Luma YUYV: paso de 2 bytes y recortes alineados a pares de píxeles.
+ */
+static void test_yuyv()
+{
+    const uint32_t stride = kWidth * 2 + 8;
+
+    memset(frame, 0, sizeof(frame));
+    for (uint32_t x = 0; x < 40; x++) {
+        frame[2 * stride + 2 * x] = static_cast<uint8_t>(100 + x);
+    }
+
+    ImageView<YuyvLuma> view(frame, stride, 40, 4);
+    CHECK(view.valid() && view.stride() == stride);
+    CHECK(view.row(2)[5] == 105);
+
+    // x y ancho impares se redondean hacia abajo al par
+    ImageView<YuyvLuma> sub = view.crop(5, 1, 7, 2);
+    CHECK(sub.valid() && sub.width() == 6 && sub.data() == frame + stride + 4 * 2);
+    CHECK(sub.at(0, 1) == 104 && sub.at(5, 1) == 109);
+
+    // Stride menor que la fila
+    CHECK(!ImageView<YuyvLuma>(frame, 79, 40, 4).valid());
+}
+
+/**
+ * @brief Luma de YUV422 planar: un byte por píxel.
+ */
+static void test_yuv422()
+{
+    const uint32_t stride = kWidth;
+
+    for (uint32_t i = 0; i < stride * kHeight; i++) {
+        frame[i] = static_cast<uint8_t>(i);
+    }
+
+    ImageView<Yuv422Luma> view(frame, stride, kWidth, kHeight);
+    ImageView<Yuv422Luma> sub = view.crop(8, 3, 16, 4);
+    CHECK(sub.valid() && sub.data() == frame + 3 * stride + 8);
+    CHECK(sub.at(2, 1) == static_cast<uint8_t>(4 * stride + 10));
+    CHECK(sub.c_view().width == 16 && sub.c_view().stride == stride);
+}
+
+int main()
+{
+    test_rgb565();
+    test_yuyv();
+    test_yuv422();
+
+    printf("view: %d fallos\n", failures);
+    return failures;
+}
@@ -18,11 +18,18 @@
 #include "camera/camera.h"
 #include "camera/format.h"
 #include "camera/ov7670.h"
+#include "runtime/placement.h"
 
 #include "camera.pio.h"
 
 #define CAMERA_PIO_FRAME_SM  0
 
+/** @brief COM8 de OV7670_begin sin AEC ni AGC, para la exposición manual. */
+#define CAMERA_COM8_MANUAL (OV7670_COM8_FASTAEC | OV7670_COM8_AECSTEP | OV7670_COM8_BANDING | OV7670_COM8_AWB)
+#define CAMERA_COM8_AUTO   (CAMERA_COM8_MANUAL | OV7670_COM8_AGC | OV7670_COM8_AEC)
+
+extern int OV7670_read_register(void *platform, uint8_t reg);
+
 /** @brief Contextos globales para las interrupciones PIO de cada cámara. */
 struct camera *volatile irq_ctxs[2];
 
@@ -37,6 +44,8 @@ static inline void __camera_isr(struct camera *camera)
 		return;
 	}
 
+	camera->done_us = time_us_32();
+
 	if (camera->pending_cb) {
 		camera->pending_cb(camera->pending, camera->cb_data);
 	}
@@ -45,7 +54,7 @@ static inline void __camera_isr(struct camera *camera)
 }
 
 /** @brief ISR específica para PIO0. */
-static void camera_isr_pio0(void)
+static void PLACEMENT_SCRATCH(camera_isr_pio0)(void)
 {
 	struct camera *camera = irq_ctxs[0];
 	__camera_isr(camera);
@@ -54,7 +63,7 @@ static void camera_isr_pio0(void)
 }
 
 /** @brief ISR específica para PIO1. */
-static void camera_isr_pio1(void)
+static void PLACEMENT_SCRATCH(camera_isr_pio1)(void)
 {
 	struct camera *camera = irq_ctxs[1];
 	__camera_isr(camera);
@@ -160,6 +169,9 @@ int camera_init(struct camera *camera, struct camera_platform_config *params)
 		return -1;
 	}
 
+	// Los cambios de exposición solo sustituyen AEC[1:0]
+	camera->com1 = OV7670_read_register(params, OV7670_REG_COM1);
+
 	if (params->base_dma_channel >= 0) {
 		for (int i = 0; i < CAMERA_MAX_N_PLANES; i++) {
 			dma_channel_claim(params->base_dma_channel + i);
@@ -222,66 +234,35 @@ void camera_term(struct camera *camera)
 }
 
 /**
- * @brief Convierte un código de formato a un valor OV7670_colorspace.
- * @param format Código de formato (por ejemplo, FORMAT_RGB565)
- * @return Valor OV7670_colorspace correspondiente.
+ * @struct camera_format
+ * @brief Parte del descriptor de formato propia de la cámara: bucle PIO y espacio de color.
  */
-static OV7670_colorspace ov7670_colorspace_from_format(uint32_t format)
-{
-	switch (format) {
-	case FORMAT_RGB565:
-		return OV7670_COLOR_RGB;
-	case FORMAT_YUYV:
-		/* Fallthrough */
-	case FORMAT_YUV422:
-		return OV7670_COLOR_YUV;
-	}
-
-	return 0;
-}
+struct camera_format {
+    const pio_program_t *pixel_loop;  /**< Bucle PIO de píxeles */
+    OV7670_colorspace colorspace;     /**< Espacio de color del sensor */
+};
+
+#define CAMERA_PIXEL_LOOP_yuyv  (&pixel_loop_yuyv_program)
+#define CAMERA_PIXEL_LOOP_yu16  (&pixel_loop_yu16_program)
+#define CAMERA_PIXEL_LOOP_none  NULL
+#define CAMERA_COLORSPACE_RGB   OV7670_COLOR_RGB
+#define CAMERA_COLORSPACE_YUV   OV7670_COLOR_YUV
+#define CAMERA_COLORSPACE_none  OV7670_COLOR_RGB
+
+/** @brief Tabla de la cámara, indexada como format_table (ver FORMAT_TABLE). */
+static const struct camera_format camera_formats[FORMAT_COUNT] = {
+#define CAMERA_FORMAT_ENTRY(name, code, planes, bpp0, bppn, hsubn, dma0, dman, chunk, xalign, loop, cs) \
+	[FORMAT_INDEX_##name] = { CAMERA_PIXEL_LOOP_##loop, CAMERA_COLORSPACE_##cs },
+	FORMAT_TABLE(CAMERA_FORMAT_ENTRY)
+#undef CAMERA_FORMAT_ENTRY
+};
 
 /**
- * @brief Determina el tamaño de transferencia de DMA según formato y plano.
+ * @brief Tamaño de transferencia DMA a partir de los bytes por transferencia.
  */
-static enum dma_channel_transfer_size camera_transfer_size(uint32_t format, uint8_t plane)
+static inline enum dma_channel_transfer_size camera_dma_size(uint8_t bytes)
 {
-	switch (format) {
-	case FORMAT_YUYV:
-		/* Fallthrough */
-	case FORMAT_RGB565:
-		return DMA_SIZE_32;
-	case FORMAT_YUV422:
-		return plane ? DMA_SIZE_8 : DMA_SIZE_16;
-	default:
-		return 0;
-	}
-}
-
-static uint8_t __dma_transfer_size_to_bytes(enum dma_channel_transfer_size dma)
-{
-	switch (dma) {
-	case DMA_SIZE_8:
-		return 1;
-	case DMA_SIZE_16:
-		return 2;
-	case DMA_SIZE_32:
-		return 4;
-	}
-	return 0;
-}
-
-static const pio_program_t *camera_get_pixel_loop(uint32_t format)
-{
-	switch (format) {
-	case FORMAT_YUYV:
-		return &pixel_loop_yuyv_program;
-	case FORMAT_RGB565:
-		return &pixel_loop_yuyv_program;
-	case FORMAT_YUV422:
-		return &pixel_loop_yu16_program;
-	default:
-		return NULL;
-	}
+	return bytes == 4 ? DMA_SIZE_32 : bytes == 2 ? DMA_SIZE_16 : DMA_SIZE_8;
 }
 
 /**
@@ -299,7 +280,8 @@ static void camera_pio_configure(struct camera *camera)
 		pio_sm_clear_fifos(platform->pio, i);
 	}
 
-	const pio_program_t *pixel_loop = camera_get_pixel_loop(camera->config.format);
+	const struct format_info *info = format_info(camera->config.format);
+	const pio_program_t *pixel_loop = camera_formats[info - format_table].pixel_loop;
 	camera_pio_patch_pixel_loop(platform->pio, camera->frame_offset, pixel_loop);
 
 	uint8_t num_planes = format_num_planes(camera->config.format);
@@ -327,17 +309,23 @@ int camera_configure(struct camera *camera, uint32_t format, uint16_t width, uin
 		return -1;
 	}
 
+	// Los formatos sin bucle PIO (MONO1) solo se generan a partir de otros
+	const struct format_info *info = format_info(format);
+	if (!info || !camera_formats[info - format_table].pixel_loop) {
+		return -1;
+	}
+
 	struct camera_platform_config *platform = camera->driver_host.platform;
 
-	OV7670_set_format(platform, ov7670_colorspace_from_format(format));
+	OV7670_set_format(platform, camera_formats[info - format_table].colorspace);
 	OV7670_set_size(platform, OV7670_SIZE_DIV8);
 
 	camera->config.sm_cfgs[CAMERA_PIO_FRAME_SM] =
 		camera_pio_get_frame_sm_config(platform->pio, CAMERA_PIO_FRAME_SM, camera->frame_offset, platform->base_pin);
 
-	uint8_t num_planes = format_num_planes(format);
-	for (int i = 0; i < num_planes; i++) {
-		enum dma_channel_transfer_size xfer_size = camera_transfer_size(format, i);
+	for (int i = 0; i < info->num_planes; i++) {
+		uint8_t xfer_bytes = info->dma_bytes[i ? 1 : 0];
+		enum dma_channel_transfer_size xfer_size = camera_dma_size(xfer_bytes);
 
 		dma_channel_config c = dma_channel_get_default_config(camera->dma_channels[i]);
 		channel_config_set_transfer_data_size(&c, xfer_size);
@@ -347,7 +335,6 @@ int camera_configure(struct camera *camera, uint32_t format, uint16_t width, uin
 
 		camera->config.dma_cfgs[i] = c;
 
-		uint8_t xfer_bytes = __dma_transfer_size_to_bytes(xfer_size);
 		camera->config.dma_offset[i] = 4 - xfer_bytes,
 		camera->config.dma_transfers[i] = format_plane_size(format, i, width, height) / xfer_bytes,
 
@@ -359,24 +346,79 @@ int camera_configure(struct camera *camera, uint32_t format, uint16_t width, uin
 	camera->config.format = format;
 	camera->config.width = width;
 	camera->config.height = height;
+	camera->config.pixel_loops = width / info->chunk_pixels;
 
 	camera_pio_configure(camera);
 
 	return 0;
 }
 
-static uint8_t camera_pixels_per_chunk(uint32_t format)
+/**
+ * @brief Encola una escritura de registro.
+ * @return 0 en éxito, -1 si la cola está llena.
+ */
+int camera_defer_register(struct camera *camera, uint8_t reg, uint8_t value)
 {
-	switch (format) {
-	case FORMAT_YUYV:
-		/* Fallthrough */
-	case FORMAT_RGB565:
-		return 2;
-	case FORMAT_YUV422:
-		return 2;
-	default:
-		return 1;
+	if (camera->reg_count >= CAMERA_REG_QUEUE_LEN) {
+		return -1;
 	}
+
+	uint8_t slot = (camera->reg_head + camera->reg_count) % CAMERA_REG_QUEUE_LEN;
+	camera->reg_queue[slot] = (struct camera_reg_write){ reg, value };
+	camera->reg_count++;
+
+	return 0;
+}
+
+/**
+ * @brief Encola exposición y ganancia: AECHH, AECH, COM1 y GAIN, más COM8 si cambia el modo.
+ * @return 0 en éxito, -1 si no caben.
+ */
+int camera_defer_exposure(struct camera *camera, const struct camera_exposure *exposure)
+{
+	bool manual = exposure->aec != 0;
+	bool mode_change = manual != (camera->exposure_queued.aec != 0);
+	uint8_t writes = (manual ? 4 : 0) + (mode_change ? 1 : 0);
+
+	if (camera->reg_count + writes > CAMERA_REG_QUEUE_LEN) {
+		return -1;
+	}
+
+	if (mode_change) {
+		camera_defer_register(camera, OV7670_REG_COM8, manual ? CAMERA_COM8_MANUAL : CAMERA_COM8_AUTO);
+	}
+	if (manual) {
+		camera_defer_register(camera, OV7670_REG_AECHH, (exposure->aec >> 10) & 0x3f);
+		camera_defer_register(camera, OV7670_REG_AECH, (exposure->aec >> 2) & 0xff);
+		camera_defer_register(camera, OV7670_REG_COM1, (camera->com1 & ~0x03) | (exposure->aec & 0x03));
+		camera_defer_register(camera, OV7670_REG_GAIN, exposure->gain);
+	}
+
+	camera->exposure_queued = *exposure;
+
+	return 0;
+}
+
+/**
+ * @brief Escribe (con I2C bloqueante) los registros aplazados. Se llama entre frames, antes de disparar el siguiente.
+ * @param camera Puntero a la estructura cámara.
+ */
+static void camera_write_deferred(struct camera *camera)
+{
+	struct camera_platform_config *platform = camera->driver_host.platform;
+
+	while (camera->reg_count) {
+		const struct camera_reg_write *w = &camera->reg_queue[camera->reg_head];
+		platform->i2c_write_blocking(platform->i2c_handle, OV7670_ADDR, (uint8_t[]){ w->reg, w->value }, 2);
+		camera->reg_head = (camera->reg_head + 1) % CAMERA_REG_QUEUE_LEN;
+		camera->reg_count--;
+	}
+
+	// Línea de retardo: la captura que se dispara ahora se toma con la
+	// exposición escrita CAMERA_EXPOSURE_DELAY frames antes
+	camera->exposure = camera->exposure_line[camera->exposure_slot];
+	camera->exposure_line[camera->exposure_slot] = camera->exposure_queued;
+	camera->exposure_slot = (camera->exposure_slot + 1) % CAMERA_EXPOSURE_DELAY;
 }
 
 /**
@@ -408,6 +450,8 @@ static int camera_do_frame(struct camera *camera, struct camera_buffer *buf, cam
 
 	struct camera_platform_config *platform = camera->driver_host.platform;
 
+	camera_write_deferred(camera);
+
 	uint8_t num_planes = format_num_planes(camera->config.format);
 	for (int i = 0; i < num_planes; i++) {
 		dma_channel_configure(camera->dma_channels[i],
@@ -418,13 +462,11 @@ static int camera_do_frame(struct camera *camera, struct camera_buffer *buf, cam
 				true);
 	}
 
-	uint32_t num_loops = buf->width / camera_pixels_per_chunk(buf->format);
-
 	camera->pending = buf;
 	camera->pending_cb = complete_cb;
 	camera->cb_data = cb_data;
 
-	camera_pio_trigger_frame(platform->pio, num_loops, buf->height);
+	camera_pio_trigger_frame(platform->pio, camera->config.pixel_loops, buf->height);
 
 	if (blocking) {
 		while (camera->pending) {
@@ -0,0 +1,33 @@
+/**
+ * @file buffer.h
+ * @brief Descripción de un frame en memoria, independiente del hardware de captura.
+ * @author Brian Starkey
+ * @date 2022
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __CAMERA_BUFFER_H__
+#define __CAMERA_BUFFER_H__
+
+#include <stdint.h>
+
+#define CAMERA_MAX_N_PLANES 3   /**< Máximo número de planos de color */
+
+/**
+ * @struct camera_buffer
+ * @brief Estructura que almacena un frame de la cámara.
+ *
+ * Puede ser asignada dinámicamente usando camera_buffer_alloc/camera_buffer_free,
+ * o de forma estática inicializando manualmente los campos.
+ */
+struct camera_buffer {
+    uint32_t format;                           /**< Formato de imagen (definido en format.h) */
+    uint16_t width;                            /**< Ancho en píxeles */
+    uint16_t height;                           /**< Alto en píxeles */
+    uint32_t strides[CAMERA_MAX_N_PLANES];     /**< Stride en bytes para cada plano */
+    uint32_t sizes[CAMERA_MAX_N_PLANES];       /**< Tamaño en bytes de cada plano */
+    uint8_t *data[CAMERA_MAX_N_PLANES];        /**< Punteros a los datos de cada plano */
+};
+
+#endif /* __CAMERA_BUFFER_H__ */
@@ -13,27 +13,13 @@
 #include <stdint.h>
 #include "hardware/dma.h"
 #include "hardware/pio.h"
+#include "camera/buffer.h"
 #include "camera/ov7670.h"
 
 #define CAMERA_WIDTH_DIV8  80   /**< Ancho de la imagen dividido por 8 */
 #define CAMERA_HEIGHT_DIV8 60   /**< Alto de la imagen dividido por 8 */
-#define CAMERA_MAX_N_PLANES 3   /**< Máximo número de planos de color */
-
-/**
- * @struct camera_buffer
- * @brief Estructura que almacena un frame de la cámara.
- *
- * Puede ser asignada dinámicamente usando camera_buffer_alloc/camera_buffer_free,
- * o de forma estática inicializando manualmente los campos.
- */
-struct camera_buffer {
-    uint32_t format;                           /**< Formato de imagen (definido en format.h) */
-    uint16_t width;                            /**< Ancho en píxeles */
-    uint16_t height;                           /**< Alto en píxeles */
-    uint32_t strides[CAMERA_MAX_N_PLANES];     /**< Stride en bytes para cada plano */
-    uint32_t sizes[CAMERA_MAX_N_PLANES];       /**< Tamaño en bytes de cada plano */
-    uint8_t *data[CAMERA_MAX_N_PLANES];        /**< Punteros a los datos de cada plano */
-};
+#define CAMERA_REG_QUEUE_LEN 8  /**< Escrituras de registro encoladas como máximo */
+#define CAMERA_EXPOSURE_DELAY 1 /**< Frames que tarda el sensor en aplicar AEC/GAIN tras escribirlos */
 
 /**
  * @brief Callback para notificar la finalización de la captura de un frame.
@@ -42,6 +28,24 @@ struct camera_buffer {
  */
 typedef void (*camera_frame_cb)(struct camera_buffer *buf, void *p);
 
+/**
+ * @struct camera_reg_write
+ * @brief Escritura de registro del sensor pendiente.
+ */
+struct camera_reg_write {
+    uint8_t reg;    /**< Registro */
+    uint8_t value;  /**< Valor */
+};
+
+/**
+ * @struct camera_exposure
+ * @brief Exposición manual del sensor.
+ */
+struct camera_exposure {
+    uint16_t aec;  /**< Tiempo de exposición en líneas (AEC[15:0]); 0 = exposición automática */
+    uint8_t gain;  /**< Ganancia analógica (GAIN[7:0], 0 = 1x) */
+};
+
 /**
  * @struct camera_config
  * @brief Configuración dependiente de formato/ancho/alto para PIO y DMA.
@@ -50,6 +54,7 @@ struct camera_config {
     uint32_t format;                              /**< Formato de la imagen */
     uint16_t width;                               /**< Ancho en píxeles */
     uint16_t height;                              /**< Alto en píxeles */
+    uint32_t pixel_loops;                         /**< Iteraciones del bucle PIO por línea */
     uint dma_transfers[CAMERA_MAX_N_PLANES];      /**< Transferencias DMA por plano */
     uint dma_offset[CAMERA_MAX_N_PLANES];         /**< Offset DMA por plano */
     dma_channel_config dma_cfgs[CAMERA_MAX_N_PLANES]; /**< Configuración DMA por plano */
@@ -69,6 +74,15 @@ struct camera {
     struct camera_buffer *volatile pending;          /**< Frame en progreso */
     camera_frame_cb volatile pending_cb;             /**< Callback de frame pendiente */
     void *volatile cb_data;                          /**< Datos de usuario para el callback */
+    volatile uint32_t done_us;                       /**< time_us_32() al completar el último frame en la ISR */
+    struct camera_reg_write reg_queue[CAMERA_REG_QUEUE_LEN]; /**< Escrituras pendientes hasta el próximo frame */
+    uint8_t reg_head;                                /**< Primera escritura pendiente */
+    uint8_t reg_count;                               /**< Escrituras pendientes */
+    struct camera_exposure exposure;                 /**< Exposición con la que se toma la última captura disparada */
+    struct camera_exposure exposure_queued;          /**< Última exposición pedida (la escrita si la cola está vacía) */
+    struct camera_exposure exposure_line[CAMERA_EXPOSURE_DELAY]; /**< Exposiciones escritas que el sensor aún no aplica */
+    uint8_t exposure_slot;                           /**< Entrada más antigua de exposure_line */
+    uint8_t com1;                                    /**< COM1 del sensor tras iniciarlo (AEC[1:0] en sus bits bajos) */
 };
 
 /**
@@ -151,6 +165,39 @@ int camera_capture_blocking(struct camera *camera, struct camera_buffer *into, b
 int camera_capture_with_cb(struct camera *camera, struct camera_buffer *into, bool allow_reconfigure,
                            camera_frame_cb complete_cb, void *cb_data);
 
+/**
+ * @brief Aplaza la escritura de un registro del sensor hasta la próxima captura.
+ *
+ * La llamada solo encola y no usa el bus. Las escrituras encoladas se hacen en
+ * orden entre frames, al arrancar la siguiente captura, de modo que nunca
+ * cambian la configuración a mitad de un frame; son escrituras I2C
+ * bloqueantes (unos 0,3 ms por registro a 100 kHz) que retrasan ese disparo.
+ * Se llama desde las tareas, no desde interrupciones.
+ *
+ * @param camera Puntero a la estructura de cámara
+ * @param reg    Registro
+ * @param value  Valor
+ * @return 0 en caso de éxito, -1 si la cola está llena
+ */
+int camera_defer_register(struct camera *camera, uint8_t reg, uint8_t value);
+
+/**
+ * @brief Aplaza un cambio de exposición y ganancia manuales hasta la próxima captura.
+ *
+ * Desactiva AEC/AGC en el sensor y encola AECHH, AECH, COM1 y GAIN (COM1
+ * conserva sus demás bits, leídos en camera_init()), que se escriben como
+ * camera_defer_register(). El sensor aplica los valores
+ * CAMERA_EXPOSURE_DELAY frames después de la captura que escribe la cola;
+ * camera->exposure sigue esa latencia y da, tras disparar cada captura, la
+ * exposición con la que realmente se toma. Con aec = 0 se vuelve a la
+ * exposición automática.
+ *
+ * @param camera   Puntero a la estructura de cámara
+ * @param exposure Exposición y ganancia
+ * @return 0 en caso de éxito, -1 si no caben todas las escrituras en la cola
+ */
+int camera_defer_exposure(struct camera *camera, const struct camera_exposure *exposure);
+
 /**
  * @brief Asigna un buffer de cámara dinámicamente usando malloc.
  * @param format Formato de imagen
@@ -10,6 +10,7 @@
 #ifndef __FORMAT_H__
 #define __FORMAT_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -25,6 +26,93 @@
 #define FORMAT_YUYV   FORMAT_CODE('Y', 'U', 'Y', 'V')  /**< Formato YUYV */
 #define FORMAT_RGB565 FORMAT_CODE('R', 'G', '1', '6')  /**< Formato RGB565 */
 #define FORMAT_YUV422 FORMAT_CODE('Y', 'U', '1', '6')  /**< Formato YUV422 */
+#define FORMAT_MONO1  FORMAT_CODE('R', '1', ' ', ' ')  /**< Máscara binaria de 1 bit por píxel */
+
+/**
+ * @brief Tabla de formatos: una fila por formato, expandida con una macro X.
+ *
+ * Columnas: nombre, código, planos, bits por píxel del plano 0 y de los demás
+ * planos, submuestreo horizontal de los planos 1+, bytes por transferencia DMA
+ * del plano 0 y de los demás, píxeles por iteración del bucle PIO, alineación
+ * horizontal en píxeles de una subimagen (pares de píxeles que comparten
+ * crominancia), bucle PIO y espacio de color del sensor (none en los formatos
+ * que la cámara no produce).
+ *
+ * FORMAT_MONO1 empaqueta 32 píxeles por palabra, el píxel x en el bit x % 32
+ * de la palabra x / 32; sus filas se alinean a palabra (ver vision/mono1.h).
+ *
+ * Añadir un formato es añadir una fila; format_info() y las constantes
+ * FORMAT_<nombre>_* se derivan de aquí, y camera.c expande la misma tabla para
+ * los programas PIO.
+ */
+#define FORMAT_TABLE(X) \
+	/* nombre  código         planos bpp0 bppN hsubN dma0 dmaN chunk xalign bucle cs */ \
+	X(YUYV,   FORMAT_YUYV,   1,     16,  0,   1,    4,   0,   2,    2,     yuyv, YUV) \
+	X(RGB565, FORMAT_RGB565, 1,     16,  0,   1,    4,   0,   2,    1,     yuyv, RGB) \
+	X(YUV422, FORMAT_YUV422, 3,     8,   8,   2,    2,   1,   2,    2,     yu16, YUV) \
+	X(MONO1,  FORMAT_MONO1,  1,     1,   0,   1,    0,   0,   1,    32,    none, none)
+
+/**
+ * @struct format_info
+ * @brief Descriptor de un formato, generado desde FORMAT_TABLE.
+ *
+ * Los campos con índice [2] distinguen el plano 0 ([0]) de los demás ([1]).
+ */
+struct format_info {
+    uint32_t code;          /**< Código de formato */
+    uint8_t num_planes;     /**< Número de planos */
+    uint8_t bits[2];        /**< Bits por píxel */
+    uint8_t hsub[2];        /**< Submuestreo horizontal */
+    uint8_t dma_bytes[2];   /**< Bytes por transferencia DMA de captura */
+    uint8_t chunk_pixels;   /**< Píxeles por iteración del bucle PIO */
+    uint8_t x_align;        /**< Alineación horizontal de una subimagen */
+};
+
+/** @brief Índice de cada formato en format_table. */
+enum format_index {
+#define FORMAT_INDEX_ENTRY(name, code, planes, bpp0, bppn, hsubn, dma0, dman, chunk, xalign, loop, cs) \
+	FORMAT_INDEX_##name,
+	FORMAT_TABLE(FORMAT_INDEX_ENTRY)
+#undef FORMAT_INDEX_ENTRY
+	FORMAT_COUNT
+};
+
+/** @brief Constantes por formato para especializar kernels en compilación. */
+enum {
+#define FORMAT_CONST_ENTRY(name, code, planes, bpp0, bppn, hsubn, dma0, dman, chunk, xalign, loop, cs) \
+	FORMAT_##name##_PLANES = (planes), \
+	FORMAT_##name##_BPP = (bpp0) / 8, \
+	FORMAT_##name##_CHUNK = (chunk),
+	FORMAT_TABLE(FORMAT_CONST_ENTRY)
+#undef FORMAT_CONST_ENTRY
+};
+
+/** @brief Descriptores de todos los formatos, en el orden de FORMAT_TABLE (válido también en C++). */
+static const struct format_info format_table[FORMAT_COUNT] = {
+#define FORMAT_INFO_ENTRY(name, code, planes, bpp0, bppn, hsubn, dma0, dman, chunk, xalign, loop, cs) \
+	{ (code), (planes), { (bpp0), (bppn) }, { 1, (hsubn) }, { (dma0), (dman) }, (chunk), (xalign) },
+	FORMAT_TABLE(FORMAT_INFO_ENTRY)
+#undef FORMAT_INFO_ENTRY
+};
+
+/**
+ * @brief Busca el descriptor de un formato.
+ *
+ * Con un código constante el compilador resuelve la búsqueda y los campos en
+ * compilación, así que los kernels especializados no pagan ningún despacho.
+ *
+ * @param format Código de formato
+ * @return Descriptor, o NULL si el formato no es reconocido
+ */
+static inline const struct format_info *format_info(uint32_t format)
+{
+	for (int i = 0; i < FORMAT_COUNT; i++) {
+		if (format_table[i].code == format) {
+			return &format_table[i];
+		}
+	}
+	return NULL;
+}
 
 /**
  * @brief Obtiene el número de planos para un formato dado.
@@ -2,7 +2,8 @@
  * @file format.c
  * @brief Implementación de funciones auxiliares para el manejo de formatos de imagen de cámara.
  *
- * Proporciona utilidades para el cálculo de planos, bytes por pixel, stride y tamaño de cada plano.
+ * Proporciona utilidades para el cálculo de planos, bytes por pixel, stride y tamaño de cada plano,
+ * todas derivadas de FORMAT_TABLE.
  */
 
 #include "camera/format.h"
@@ -14,16 +15,9 @@
  */
 uint8_t format_num_planes(uint32_t format)
 {
-	switch (format) {
-	case FORMAT_YUYV:
-		/* Fallthrough */
-	case FORMAT_RGB565:
-		return 1;
-	case FORMAT_YUV422:
-		return 3;
-	default:
-		return 0;
-	}
+	const struct format_info *info = format_info(format);
+
+	return info ? info->num_planes : 0;
 }
 
 /**
@@ -34,16 +28,9 @@ uint8_t format_num_planes(uint32_t format)
  */
 uint8_t format_bytes_per_pixel(uint32_t format, uint8_t plane)
 {
-	switch (format) {
-	case FORMAT_YUYV:
-		/* Fallthrough */
-	case FORMAT_RGB565:
-		return 2;
-	case FORMAT_YUV422:
-		return 1;
-	default:
-		return 0;
-	}
+	const struct format_info *info = format_info(format);
+
+	return info ? info->bits[plane ? 1 : 0] / 8 : 0;
 }
 
 /**
@@ -54,12 +41,9 @@ uint8_t format_bytes_per_pixel(uint32_t format, uint8_t plane)
  */
 uint8_t format_hsub(uint32_t format, uint8_t plane)
 {
-	switch (format) {
-	case FORMAT_YUV422:
-		return plane ? 2 : 1;
-	default:
-		return 1;
-	}
+	const struct format_info *info = format_info(format);
+
+	return info ? info->hsub[plane ? 1 : 0] : 1;
 }
 
 /**
@@ -71,7 +55,18 @@ uint8_t format_hsub(uint32_t format, uint8_t plane)
  */
 uint32_t format_stride(uint32_t format, uint8_t plane, uint16_t width)
 {
-	return format_bytes_per_pixel(format, plane) * width / format_hsub(format, plane);
+	const struct format_info *info = format_info(format);
+
+	if (!info) {
+		return 0;
+	}
+
+	// En bits para admitir formatos de menos de un byte por píxel, cuyas filas
+	// se alinean a palabra para los kernels de 32 píxeles por palabra
+	uint8_t bits = info->bits[plane ? 1 : 0];
+	uint32_t row_bits = (uint32_t)bits * width / info->hsub[plane ? 1 : 0];
+
+	return bits < 8 ? (row_bits + 31) / 32 * 4 : (row_bits + 7) / 8;
 }
 
 /**
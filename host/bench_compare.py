@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Compara informes de minivision_bench lado a lado.
+
+Acepta informes del dispositivo (ciclos) y del host (ns), tal como los imprime
+el runner. Con un solo informe muestra la tabla; con dos, la mediana por píxel
+de cada uno y el cociente entre ambos.
+
+Uso:
+    python3 bench_compare.py dispositivo.csv host.csv
+    python3 bench_compare.py /dev/ttyACM0 host.csv     # lee el informe por USB
+"""
+
+import argparse
+import csv
+import io
+import os
+import sys
+
+
+def read_report(path):
+    """Devuelve (metadatos, {(kernel, ancho, alto): fila}) de un informe."""
+    if os.path.exists(path) and not path.startswith("/dev/"):
+        with open(path) as f:
+            text = f.read()
+    else:
+        import serial  # pyserial
+        port = serial.Serial(path, timeout=5)
+        port.write(b"r")
+        lines = []
+        while True:
+            line = port.readline().decode(errors="replace")
+            if not line:
+                sys.exit("%s: tiempo de espera agotado" % path)
+            lines.append(line)
+            if line.startswith("# end"):
+                break
+        text = "".join(lines)
+
+    meta = {}
+    body = []
+    started = False
+    for line in text.splitlines():
+        if line.startswith("# minivision-bench"):
+            meta = dict(kv.split("=", 1) for kv in line.split()[2:])
+            started = True
+            body = []
+        elif line.startswith("# end"):
+            break
+        elif started:
+            body.append(line)
+    rows = {}
+    for r in csv.DictReader(io.StringIO("\n".join(body))):
+        rows[(r["kernel"], int(r["width"]), int(r["height"]))] = r
+    return meta, rows
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("reports", nargs="+", help="uno o dos informes (fichero o puerto serie)")
+    args = ap.parse_args()
+
+    reports = [read_report(p) for p in args.reports[:2]]
+    keys = sorted(set().union(*(r[1].keys() for r in reports)))
+
+    head = "%-40s %9s" % ("kernel", "tamaño")
+    for meta, _ in reports:
+        head += " %14s" % ("%s %s/px" % (meta.get("platform", "?"), meta.get("unit", "?")))
+    if len(reports) == 2:
+        head += " %9s" % "cociente"
+    head += " %8s" % "xip hit%"
+    print(head)
+
+    for key in keys:
+        line = "%-40s %9s" % (key[0], "%dx%d" % key[1:])
+        values = []
+        for _, rows in reports:
+            r = rows.get(key)
+            v = int(r["per_pixel_x100"]) / 100.0 if r else None
+            values.append(v)
+            line += " %14s" % ("%.2f" % v if v is not None else "-")
+        if len(reports) == 2:
+            a, b = values
+            line += " %9s" % ("%.2f" % (a / b) if a and b else "-")
+        r = reports[0][1].get(key)
+        acc = int(r["xip_acc"]) if r else 0
+        line += " %8s" % ("%.1f" % (100.0 * int(r["xip_hit"]) / acc) if acc else "-")
+        print(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Inyección de frames grabados en el dispositivo para benchmarks deterministas.
+
+Requiere un firmware compilado con -DMINIVISION_FRAME_INJECTION=ON. Cada frame
+del dataset se envía por USB al pool de frames del dispositivo, pasa por el
+mismo pipeline que los frames de la cámara y se recogen el registro de
+resultados y los ciclos por etapa. El dataset puede ser un fichero con frames
+crudos concatenados o una lista de imágenes PPM (convertidas a RGB565).
+
+Uso:
+    python3 inject.py /dev/ttyACM0 dataset.rgb565 --size 80x60 --csv build_a.csv
+    python3 inject.py /dev/ttyACM0 frames/*.ppm --baseline build_a.csv
+"""
+
+import argparse
+import csv
+import statistics
+import sys
+import time
+
+import mvstream
+
+
+def load_frames(paths, fmt, width, height):
+    frame_size = width * height * mvstream.FORMATS[fmt][1]
+    for path in paths:
+        with open(path, "rb") as f:
+            data = f.read()
+        if path.lower().endswith(".ppm"):
+            w, h, pix = mvstream.ppm_to_rgb565be(data)
+            if fmt != "rgb565" or (w, h) != (width, height):
+                sys.exit("%s: se esperaba %dx%d rgb565" % (path, width, height))
+            yield pix
+            continue
+        if len(data) % frame_size:
+            sys.exit("%s: el tamaño no es múltiplo de %d bytes" % (path, frame_size))
+        for off in range(0, len(data), frame_size):
+            yield data[off:off + frame_size]
+
+
+def wait_for(port, parser, seq, timeout):
+    """Espera el registro de resultados y los ciclos por etapa de un frame."""
+    result = stages = None
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline and (result is None or stages is None):
+        for ptype, payload in parser.feed(port.read(port.in_waiting or 1)):
+            if ptype == mvstream.PKT_RESULT:
+                r = mvstream.decode_result(payload)
+                if r["seq"] == seq:
+                    result = r
+            elif ptype == mvstream.PKT_STAGES:
+                s, cycles = mvstream.decode_stages(payload)
+                if s == seq:
+                    stages = cycles
+    return result, stages
+
+
+def result_digest(r):
+    """Resumen determinista de un resultado, para comparar builds."""
+    h = r["hist"]
+    return "%d/%d/%d/%d:%s:b%d:x%d:k%d" % (h["min"], h["max"], h["mean"], h["median"],
+                                           "".join("%02x" % b for b in h["bins"]),
+                                           len(r["blobs"]), len(r["boxes"]), len(r["keypoints"]))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("port", help="puerto serie del dispositivo")
+    ap.add_argument("dataset", nargs="+", help="frames crudos concatenados o imágenes .ppm")
+    ap.add_argument("--format", default="rgb565", choices=sorted(mvstream.FORMATS))
+    ap.add_argument("--size", default="80x60", help="ANCHOxALTO de los frames (debe coincidir con el firmware)")
+    ap.add_argument("--repeat", type=int, default=1, help="veces que se recorre el dataset")
+    ap.add_argument("--timeout", type=float, default=2.0, help="segundos de espera por frame")
+    ap.add_argument("--csv", help="guardar resultados por frame en CSV")
+    ap.add_argument("--baseline", help="CSV de otra build con el que comparar")
+    ap.add_argument("--tolerance", type=float, default=0.05, help="regresión admitida por etapa (fracción)")
+    args = ap.parse_args()
+
+    import serial  # pyserial
+    width, height = (int(v) for v in args.size.lower().split("x"))
+    fmt_code = mvstream.FORMATS[args.format][0]
+    frames = list(load_frames(args.dataset, args.format, width, height))
+    if not frames:
+        sys.exit("dataset vacío")
+
+    port = serial.Serial(args.port, timeout=0.05)
+    parser = mvstream.Parser()
+    rows = []
+    seq = 0
+    for _ in range(args.repeat):
+        for data in frames:
+            port.write(mvstream.encode_inject(seq, fmt_code, width, height, data))
+            result, stages = wait_for(port, parser, seq, args.timeout)
+            if result is None or stages is None:
+                sys.exit("frame %d: sin respuesta del dispositivo" % seq)
+            row = {"seq": seq, "digest": result_digest(result)}
+            row.update({name: stages[i] for i, name in enumerate(mvstream.STAGES) if i < len(stages)})
+            rows.append(row)
+            seq += 1
+
+    print("%d frames inyectados" % len(rows))
+    print("%-10s %12s %12s %12s" % ("etapa", "mediana", "media", "máx"))
+    medians = {}
+    for name in mvstream.STAGES[1:]:
+        values = [r[name] for r in rows if name in r]
+        if values:
+            medians[name] = statistics.median(values)
+            print("%-10s %12d %12d %12d" % (name, medians[name], statistics.mean(values), max(values)))
+
+    fields = ["seq", "digest"] + mvstream.STAGES
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            w = csv.DictWriter(f, fieldnames=fields)
+            w.writeheader()
+            w.writerows(rows)
+
+    if args.baseline:
+        with open(args.baseline, newline="") as f:
+            base = list(csv.DictReader(f))
+        failed = False
+        mismatches = sum(1 for a, b in zip(rows, base) if a["digest"] != b["digest"])
+        if mismatches:
+            print("RESULTADOS DISTINTOS en %d frames respecto a la referencia" % mismatches)
+            failed = True
+        for name, med in medians.items():
+            ref = statistics.median(int(r[name]) for r in base)
+            change = (med - ref) / ref if ref else 0.0
+            verdict = "REGRESIÓN" if change > args.tolerance else "ok"
+            print("%-10s %+7.2f%%  (%d -> %d)  %s" % (name, change * 100, ref, med, verdict))
+            failed |= verdict != "ok"
+        sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
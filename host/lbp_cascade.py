@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+Convierte una cascada LBP de OpenCV (XML) al formato binario de vision/lbp.h.
+
+Admite cascadas de tipo BOOST con características LBP y clasificadores de un
+solo nodo, en el formato nuevo (traincascade, como lbpcascade_frontalface.xml).
+Los valores y umbrales pasan a Q12. Dentro de cada etapa los clasificadores se
+ordenan de mayor a menor diferencia entre sus dos valores y cada uno guarda lo
+máximo que pueden sumar los siguientes, para que el dispositivo rechace la
+ventana en cuanto la etapa ya no puede llegar al umbral.
+
+La salida es un fuente C con el binario en un arreglo constante (queda en
+flash) o, con --bin, el binario tal cual.
+
+Uso:
+    python3 lbp_cascade.py lbpcascade_frontalface.xml -o lbp_cascade_data.c
+    python3 lbp_cascade.py lbpcascade_frontalface.xml --bin -o cascada.bin
+"""
+
+import argparse
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+MAGIC = 0x4350424C      # "LBPC"
+VERSION = 1
+ONE = 4096              # 1.0 en Q12
+MAX_WINDOW = 48
+MAX_BLOCK = 257
+
+
+def q12(value, what):
+    v = int(round(float(value) * ONE))
+    if not -32768 <= v <= 32767:
+        sys.exit("%s fuera del rango de Q12 en 16 bits: %s" % (what, value))
+    return v
+
+
+def find_cascade(root):
+    """Devuelve el nodo que contiene stages y features."""
+    for node in root.iter():
+        if node.find("stages") is not None and node.find("features") is not None:
+            return node
+    sys.exit("no se encuentra ninguna cascada (stages/features)")
+
+
+def parse(path):
+    cascade = find_cascade(ET.parse(path).getroot())
+    if cascade.findtext("stageType", "BOOST").strip() != "BOOST":
+        sys.exit("solo se admiten cascadas BOOST")
+    if cascade.findtext("featureType", "").strip() != "LBP":
+        sys.exit("solo se admiten características LBP")
+    width = int(cascade.findtext("width"))
+    height = int(cascade.findtext("height"))
+    if not (3 <= width <= MAX_WINDOW and 3 <= height <= MAX_WINDOW):
+        sys.exit("ventana de %dx%d fuera de rango (3..%d)" % (width, height, MAX_WINDOW))
+
+    features = []
+    for f in cascade.find("features"):
+        x, y, w, h = (int(v) for v in f.findtext("rect").split())
+        if w * h > MAX_BLOCK or x + 3 * w > width or y + 3 * h > height:
+            sys.exit("característica %d no válida: %d %d %d %d" % (len(features), x, y, w, h))
+        features.append((x, y, w, h))
+
+    stages = []
+    for s in cascade.find("stages"):
+        threshold = float(s.findtext("stageThreshold"))
+        weaks = []
+        for w in s.find("weakClassifiers"):
+            nodes = [int(v) for v in w.findtext("internalNodes").split()]
+            leaves = [float(v) for v in w.findtext("leafValues").split()]
+            if len(nodes) != 11 or len(leaves) != 2:
+                sys.exit("solo se admiten clasificadores de un nodo con subconjunto de 8 palabras")
+            feature = nodes[2]
+            if not 0 <= feature < len(features):
+                sys.exit("característica %d inexistente" % feature)
+            subset = [v & 0xFFFFFFFF for v in nodes[3:]]
+            weaks.append((feature, q12(leaves[0], "valor"), q12(leaves[1], "valor"), subset))
+        if not weaks:
+            sys.exit("etapa %d vacía" % len(stages))
+        # Los más decisivos primero: el máximo de lo que falta cae antes
+        weaks.sort(key=lambda wk: -abs(wk[1] - wk[2]))
+        stages.append((int(round(threshold * ONE)), weaks))
+
+    if not 0 < len(stages) < 256:
+        sys.exit("número de etapas fuera de rango: %d" % len(stages))
+    return width, height, features, stages
+
+
+def pack(width, height, features, stages):
+    n_weaks = sum(len(w) for _, w in stages)
+    out = struct.pack("<IBBBBHHI", MAGIC, VERSION, width, height, len(stages), len(features), n_weaks, 0)
+    first = 0
+    for threshold, weaks in stages:
+        out += struct.pack("<HHi", first, len(weaks), threshold)
+        first += len(weaks)
+    for f in features:
+        out += struct.pack("<BBBB", *f)
+    for _, weaks in stages:
+        for i, (feature, inside, outside, subset) in enumerate(weaks):
+            bound = sum(max(wk[1], wk[2]) for wk in weaks[i + 1:])
+            out += struct.pack("<HhhHi8I", feature, inside, outside, 0, bound, *subset)
+    return out
+
+
+def to_c(data, name, source):
+    lines = [
+        "/* Generado por host/lbp_cascade.py desde %s: no editar */" % source,
+        "",
+        "#include <stdint.h>",
+        "",
+        "const uint8_t __attribute__((aligned(4))) %s[%d] = {" % (name, len(data)),
+    ]
+    for off in range(0, len(data), 16):
+        lines.append("\t" + " ".join("0x%02x," % b for b in data[off:off + 16]))
+    lines += ["};", "", "const uint32_t %s_size = sizeof(%s);" % (name, name), ""]
+    return "\n".join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("xml", help="cascada LBP de OpenCV")
+    ap.add_argument("-o", "--output", required=True, help="fichero de salida")
+    ap.add_argument("--bin", action="store_true", help="escribir el binario en lugar de un fuente C")
+    ap.add_argument("--name", default="lbp_cascade_data", help="nombre del arreglo C")
+    args = ap.parse_args()
+
+    width, height, features, stages = parse(args.xml)
+    data = pack(width, height, features, stages)
+    if args.bin:
+        with open(args.output, "wb") as f:
+            f.write(data)
+    else:
+        with open(args.output, "w") as f:
+            f.write(to_c(data, args.name, args.xml.split("/")[-1]))
+    print("%s: ventana %dx%d, %d etapas, %d características, %d clasificadores, %d bytes"
+          % (args.output, width, height, len(stages), len(features), sum(len(w) for _, w in stages), len(data)),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
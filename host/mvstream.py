@@ -0,0 +1,219 @@
+"""
+Decodificador del protocolo binario de streaming de MiniVision (ver stream/stream.h).
+
+Formato de paquete:
+    'M' 'V' | tipo (1) | versión (1) | longitud (2, LE) | payload | CRC-16 (2, LE)
+"""
+
+import struct
+
+SYNC = b"MV"
+VERSION = 1
+HEADER_SIZE = 6
+
+PKT_RESULT = 0x01
+PKT_THUMBNAIL = 0x02
+PKT_STAGES = 0x03
+PKT_STATS = 0x04
+PKT_MEMORY = 0x05
+PKT_XIP = 0x06
+PKT_INJECT = 0x10
+
+INJECT_CHUNK = 1024
+
+# Códigos de formato (FORMAT_CODE en camera/format.h) y bytes por píxel del frame completo
+FORMATS = {
+    "rgb565": (struct.unpack("<I", b"RG16")[0], 2),
+    "yuyv": (struct.unpack("<I", b"YUYV")[0], 2),
+    "yuv422": (struct.unpack("<I", b"YU16")[0], 2),
+}
+
+# Etapas del pipeline, en el orden de enum profile_stage (runtime/profile.h)
+STAGES = ["input", "analytics", "output"]
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, igual que __crc16_update en stream.c."""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class Parser:
+    """Parser incremental: se alimenta con bytes y devuelve paquetes completos."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.crc_errors = 0
+        self.resyncs = 0
+
+    def feed(self, data):
+        self.buf += data
+        packets = []
+        while True:
+            idx = self.buf.find(SYNC)
+            if idx < 0:
+                # Conservar un posible primer byte de sync
+                del self.buf[:-1]
+                break
+            if idx:
+                self.resyncs += 1
+                del self.buf[:idx]
+            if len(self.buf) < HEADER_SIZE:
+                break
+            ptype, version, length = struct.unpack_from("<BBH", self.buf, 2)
+            total = HEADER_SIZE + length + 2
+            if len(self.buf) < total:
+                break
+            body = bytes(self.buf[2:HEADER_SIZE + length])
+            (crc,) = struct.unpack_from("<H", self.buf, HEADER_SIZE + length)
+            if version != VERSION or crc16(body) != crc:
+                self.crc_errors += 1
+                del self.buf[:2]
+                continue
+            packets.append((ptype, body[4:]))
+            del self.buf[:total]
+        return packets
+
+
+def encode_packet(ptype, payload):
+    """Construye un paquete completo con cabecera y CRC."""
+    body = struct.pack("<BBH", ptype, VERSION, len(payload)) + payload
+    return SYNC + body + struct.pack("<H", crc16(body))
+
+
+def encode_inject(seq, fmt, width, height, data):
+    """Divide un frame en paquetes PKT_INJECT de como máximo INJECT_CHUNK bytes."""
+    out = bytearray()
+    for off in range(0, len(data), INJECT_CHUNK):
+        chunk = data[off:off + INJECT_CHUNK]
+        out += encode_packet(PKT_INJECT, struct.pack("<IIHHI", seq, fmt, width, height, off) + chunk)
+    return bytes(out)
+
+
+def decode_stages(payload):
+    """Decodifica un paquete PKT_STAGES: (seq, [ciclos por etapa])."""
+    seq, n = struct.unpack_from("<IB", payload, 0)
+    return seq, list(struct.unpack_from("<%dI" % n, payload, 5))
+
+
+def decode_stats(payload):
+    """Decodifica un paquete PKT_STATS en un diccionario.
+
+    Los histogramas son "latency" (us) y uno por etapa de STAGES (ciclos a clk_hz);
+    la cubeta i cuenta los valores menores que 2^(i+1).
+    """
+    names = ("window_us", "clk_hz", "frames", "dropped", "total_frames", "total_dropped", "fps_x100")
+    s = dict(zip(names, struct.unpack_from("<7I", payload, 0)))
+    off = 28
+    n = payload[off]
+    s["load"] = [v / 10.0 for v in struct.unpack_from("<%dH" % n, payload, off + 1)]
+    off += 1 + 2 * n
+    n = payload[off]
+    s["busy"] = dict(zip(("dma", "spi"), (v / 10.0 for v in struct.unpack_from("<%dH" % n, payload, off + 1))))
+    off += 1 + 2 * n
+    hists = []
+    for _ in range(payload[off]):
+        count, hmin, hmax, mean, nb = struct.unpack_from("<IIIIB", payload, off + 1)
+        buckets = list(struct.unpack_from("<%dH" % nb, payload, off + 18))
+        hists.append(dict(count=count, min=hmin, max=hmax, mean=mean, buckets=buckets))
+        off += 17 + 2 * nb
+    s["fps"] = s["fps_x100"] / 100.0
+    s["latency"] = hists[0]
+    s["stages"] = dict(zip(STAGES, hists[1:]))
+    return s
+
+
+def decode_memory(payload):
+    """Decodifica un paquete PKT_MEMORY: pila por núcleo y heap, en bytes."""
+    n = payload[0]
+    stacks = [dict(size=size, peak=peak) for size, peak in
+              (struct.unpack_from("<II", payload, 1 + 8 * i) for i in range(n))]
+    size, used, peak, arena = struct.unpack_from("<4I", payload, 1 + 8 * n)
+    return dict(stacks=stacks, heap=dict(size=size, used=used, peak=peak, arena=arena))
+
+
+def decode_xip(payload):
+    """Decodifica un paquete PKT_XIP: [(nombre, llamadas, aciertos, accesos)] por sonda."""
+    probes = []
+    off = 1
+    for _ in range(payload[0]):
+        n = payload[off]
+        name = payload[off + 1:off + 1 + n].decode("ascii")
+        calls, hit, acc = struct.unpack_from("<3I", payload, off + 1 + n)
+        probes.append((name, calls, hit, acc))
+        off += 1 + n + 12
+    return probes
+
+
+def decode_result(payload):
+    """Decodifica un paquete PKT_RESULT en un diccionario."""
+    seq, ts, width, height = struct.unpack_from("<IIHH", payload, 0)
+    hmin, hmax, hmean, hmedian = struct.unpack_from("<BBBB", payload, 12)
+    bins = list(payload[16:32])
+    n_blobs, n_boxes, n_kps, _ = struct.unpack_from("<BBBB", payload, 32)
+    off = 36
+    blobs = []
+    for _ in range(n_blobs):
+        x, y, w, h, cx, cy, area = struct.unpack_from("<HHHHHHI", payload, off)
+        blobs.append(dict(x=x, y=y, w=w, h=h, cx=cx, cy=cy, area=area))
+        off += 16
+    boxes = []
+    for _ in range(n_boxes):
+        x, y, w, h, label, score = struct.unpack_from("<HHHHBB", payload, off)
+        boxes.append(dict(x=x, y=y, w=w, h=h, label=label, score=score))
+        off += 10
+    keypoints = []
+    for _ in range(n_kps):
+        x, y, score = struct.unpack_from("<HHB", payload, off)
+        keypoints.append(dict(x=x, y=y, score=score))
+        off += 5
+    return dict(seq=seq, timestamp_us=ts, width=width, height=height,
+                hist=dict(min=hmin, max=hmax, mean=hmean, median=hmedian, bins=bins),
+                blobs=blobs, boxes=boxes, keypoints=keypoints)
+
+
+def decode_thumbnail(payload):
+    """Decodifica un paquete PKT_THUMBNAIL: (seq, ancho, alto, píxeles RGB565)."""
+    seq, width, height, _fmt = struct.unpack_from("<IHHI", payload, 0)
+    pixels = struct.unpack_from("<%dH" % (width * height), payload, 12)
+    return seq, width, height, pixels
+
+
+def rgb565_to_ppm(width, height, pixels):
+    """Convierte píxeles RGB565 a una imagen PPM binaria."""
+    out = bytearray(b"P6\n%d %d\n255\n" % (width, height))
+    for p in pixels:
+        r, g, b = (p >> 11) & 0x1F, (p >> 5) & 0x3F, p & 0x1F
+        out += bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+    return bytes(out)
+
+
+def ppm_to_rgb565be(data):
+    """Convierte una imagen PPM binaria (P6) a (ancho, alto, bytes RGB565 big-endian)."""
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    if fields[0] != b"P6":
+        raise ValueError("solo se admite PPM binario (P6)")
+    width, height = int(fields[1]), int(fields[2])
+    pix = data[pos + 1:pos + 1 + width * height * 3]
+    out = bytearray()
+    for i in range(0, len(pix), 3):
+        r, g, b = pix[i], pix[i + 1], pix[i + 2]
+        v = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+        out += struct.pack(">H", v)
+    return width, height, bytes(out)
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Receptor del modo de streaming de analítica de MiniVision.
+
+Decodifica los registros enviados por el dispositivo y reporta registros por
+segundo junto con las métricas de ejecución que el dispositivo envía cada
+segundo (fps, perdidos, latencia, carga de CPU y ocupación de DMA/SPI y, con
+XIP_PROFILE, los fallos de la caché XIP por función).
+Opcionalmente guarda las miniaturas como PPM.
+
+Uso:
+    python3 stream_rx.py /dev/ttyACM0 [--thumbs DIR] [--verbose]
+    python3 stream_rx.py captura.bin          # reproduce un volcado guardado
+"""
+
+import argparse
+import os
+import sys
+import time
+
+import mvstream
+
+
+def open_source(path):
+    if os.path.isfile(path) or path == "-":
+        return open(path, "rb") if path != "-" else sys.stdin.buffer
+    import serial  # pyserial
+    return serial.Serial(path, timeout=0.1)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("port", help="puerto serie del dispositivo o fichero con un volcado")
+    ap.add_argument("--thumbs", help="directorio donde guardar las miniaturas")
+    ap.add_argument("--verbose", action="store_true", help="imprimir cada registro")
+    args = ap.parse_args()
+
+    src = open_source(args.port)
+    parser = mvstream.Parser()
+    if args.thumbs:
+        os.makedirs(args.thumbs, exist_ok=True)
+
+    records = thumbs = 0
+    window_start = time.monotonic()
+    window_records = 0
+    last_seq = None
+    lost = 0
+
+    while True:
+        data = src.read(4096)
+        if not data:
+            if not hasattr(src, "in_waiting"):
+                break
+            continue
+
+        for ptype, payload in parser.feed(data):
+            if ptype == mvstream.PKT_RESULT:
+                r = mvstream.decode_result(payload)
+                if last_seq is not None and r["seq"] != last_seq + 1:
+                    lost += (r["seq"] - last_seq - 1) & 0xFFFFFFFF
+                last_seq = r["seq"]
+                records += 1
+                window_records += 1
+                if args.verbose:
+                    h = r["hist"]
+                    print("seq=%d t=%dus %dx%d luma[min=%d max=%d mean=%d med=%d] blobs=%d boxes=%d kps=%d" % (
+                        r["seq"], r["timestamp_us"], r["width"], r["height"],
+                        h["min"], h["max"], h["mean"], h["median"],
+                        len(r["blobs"]), len(r["boxes"]), len(r["keypoints"])))
+            elif ptype == mvstream.PKT_STATS:
+                s = mvstream.decode_stats(payload)
+                mhz = s["clk_hz"] / 1e6 if s["clk_hz"] else 1000.0
+                stages = " ".join("%s=%.0fus" % (name, h["mean"] / mhz) for name, h in s["stages"].items())
+                print("[dispositivo] %.2f fps  perdidos %d (total %d)  latencia max %dus  cpu %s  dma %.1f%%  spi %.1f%%  %s" % (
+                    s["fps"], s["dropped"], s["total_dropped"], s["latency"]["max"],
+                    "/".join("%.1f%%" % l for l in s["load"]), s["busy"]["dma"], s["busy"]["spi"], stages))
+            elif ptype == mvstream.PKT_MEMORY:
+                m = mvstream.decode_memory(payload)
+                print("[dispositivo] pila %s  heap %d (máx %d, arena %d de %d)" % (
+                    " ".join("%d/%d" % (st["peak"], st["size"]) for st in m["stacks"]),
+                    m["heap"]["used"], m["heap"]["peak"], m["heap"]["arena"], m["heap"]["size"]))
+            elif ptype == mvstream.PKT_XIP:
+                for name, calls, hit, acc in mvstream.decode_xip(payload):
+                    if calls:
+                        print("[dispositivo] %-10s xip accesos=%d fallos=%d fallos/ejec=%d" % (
+                            name, acc, acc - hit, (acc - hit) // calls))
+            elif ptype == mvstream.PKT_THUMBNAIL:
+                seq, w, h, pixels = mvstream.decode_thumbnail(payload)
+                thumbs += 1
+                if args.thumbs:
+                    with open(os.path.join(args.thumbs, "thumb_%06d.ppm" % seq), "wb") as f:
+                        f.write(mvstream.rgb565_to_ppm(w, h, pixels))
+
+        now = time.monotonic()
+        if now - window_start >= 1.0:
+            print("%.1f registros/s  (total %d, miniaturas %d, perdidos %d, errores CRC %d)" % (
+                window_records / (now - window_start), records, thumbs, lost, parser.crc_errors))
+            window_start = now
+            window_records = 0
+
+    print("total: %d registros, %d miniaturas, %d perdidos, %d errores CRC" % (
+        records, thumbs, lost, parser.crc_errors))
+
+
+if __name__ == "__main__":
+    main()
@@ -4,6 +4,7 @@
  */
 
 #include "LCD.h"
+#include "runtime/placement.h"
 #include <stdio.h>
 
 #define PIN_DC   16  /**< Pin para Data/Command */
@@ -113,7 +114,7 @@ SSD1283A_status lcd_init(struct LCD *lcd, struct lcd_platform_config *platform)
  * @param pcfg   Puntero a la configuración de plataforma
  * @param command Comando a enviar
  */
-void SSD1283A_write_command(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint8_t command){
+void PLACEMENT_RAM(SSD1283A_write_command)(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint8_t command){
     cs_select(host);
     dc_command(host);
     pcfg->spi_write_blocking(pcfg->spi_handle, &command, 1);
@@ -126,7 +127,7 @@ void SSD1283A_write_command(SSD1283A_host *host, struct lcd_platform_config *pcf
  * @param pcfg   Puntero a la configuración de plataforma
  * @param data   Dato a enviar
  */
-void SSD1283A_write_data(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint8_t data)
+void PLACEMENT_RAM(SSD1283A_write_data)(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint8_t data)
 {
     cs_select(host);
     dc_data(host);
@@ -141,7 +142,7 @@ void SSD1283A_write_data(SSD1283A_host *host, struct lcd_platform_config *pcfg,
  * @param reg    Dirección del registro
  * @param value  Valor de 16 bits a escribir
  */
-void SSD1283A_write_register(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint8_t reg, uint16_t value)
+void PLACEMENT_RAM(SSD1283A_write_register)(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint8_t reg, uint16_t value)
 {
     cs_select(host);
     dc_command(host);
@@ -158,7 +159,7 @@ void SSD1283A_write_register(SSD1283A_host *host, struct lcd_platform_config *pc
  * @param pcfg   Puntero a la configuración de plataforma
  * @param color  Valor de color (16 bits)
  */
-void SSD1283A_write_color_16bit(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint16_t color) {
+void PLACEMENT_RAM(SSD1283A_write_color_16bit)(SSD1283A_host *host, struct lcd_platform_config *pcfg, uint16_t color) {
     uint8_t buf[2] = { color >> 8, color & 0xFF };
 
     cs_select(host);
@@ -199,7 +200,7 @@ void lcd_fill_screen(struct LCD *lcd, uint16_t color) {
  * @param height Alto de la imagen
  * @param color  Arreglo de colores (RGB565)
  */
-void lcd_show_image(struct LCD *lcd, uint16_t width, uint16_t height, uint16_t *color) {
+void PLACEMENT_RAM(lcd_show_image)(struct LCD *lcd, uint16_t width, uint16_t height, uint16_t *color) {
     uint16_t x_start = 30, x_end   = width-1;
     uint16_t y_start = 30, y_end   = height-1;
 
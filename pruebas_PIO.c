@@ -2,20 +2,45 @@
  * @file pruebas_PIO.c
  * @brief Ejemplo de adquisición y despliegue de imágenes usando cámara OV7670 y pantalla LCD con RP2040.
  *
- * Realiza inicialización de hardware (I2C, SPI, PIO, DMA) y ciclo principal de captura y visualización de imágenes.
- * Permite tomar una foto pulsando un botón y la muestra en pantalla.
+ * Realiza inicialización de hardware (I2C, SPI, PIO, DMA) y ejecuta captura, procesamiento,
+ * visualización y streaming como tareas de un planificador por eventos (runtime/sched.h):
+ * la ISR de fin de frame, el botón, un temporizador y la llegada de datos USB publican
+ * eventos, y la captura del siguiente frame se solapa con el procesamiento del anterior.
+ * El botón congela y reanuda la imagen en pantalla.
  * 
  * Copyright (c) 2022 Brian Starkey <stark3y@gmail.com>
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hardware/clocks.h"
 #include "hardware/i2c.h"
 #include "pico/stdio.h"
 #include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
 #include "camera/camera.h"
 #include "camera/format.h"
 #include "pantalla/LCD.h"
+#include "runtime/memory.h"
+#include "runtime/pool.h"
+#include "runtime/profile.h"
+#include "runtime/sched.h"
+#include "runtime/stats.h"
+#include "runtime/xip.h"
+#include "stream/stream.h"
+#include "vision/code.h"
+#include "vision/convert.h"
+#include "vision/denoise.h"
+#include "vision/flow.h"
+#include "vision/fuse.h"
+#include "vision/hdr.h"
+#include "vision/histogram.h"
+#include "vision/lbp.h"
+#include "vision/mono1.h"
+#include "vision/overlay.h"
+#include "vision/view.h"
 
 #define SPI_PORT spi0
 
@@ -38,7 +63,206 @@
 #define CAMERA_SCL      1
 #define BUTTON_PIN      13
 
-bool take_picture = false;
+// Modo de streaming de analítica: 1 envía solo registros binarios por USB
+// (sin píxeles ni printf), 0 muestra las capturas en la pantalla
+#ifndef STREAM_ANALYTICS
+#define STREAM_ANALYTICS    0
+#endif
+#define STREAM_THUMB_PERIOD 30   // Miniatura cada N frames (0 = nunca)
+
+// Inyección de frames desde el host: los frames llegan por USB en lugar de la
+// cámara, pasan por el mismo pipeline y se devuelven resultados y ciclos por etapa
+#ifndef FRAME_INJECTION
+#define FRAME_INJECTION     0
+#endif
+
+// Reducción temporal de ruido: retiene un frame del pool como referencia y
+// promedia cada frame con ella antes de la analítica y la salida
+#ifndef TEMPORAL_DENOISE
+#define TEMPORAL_DENOISE    0
+#endif
+#define DENOISE_SHIFT       2    // Peso del frame nuevo: 1/4
+#define DENOISE_MOTION      24   // Diferencia de luma que se trata como movimiento
+
+// HDR: la cámara alterna una exposición corta y una larga (escritas entre
+// frames desde la cola de registros) y cada pareja se fusiona en una imagen
+// con mapeo de tonos, así que la salida va a la mitad del ritmo del sensor
+#ifndef HDR_CAPTURE
+#define HDR_CAPTURE         0
+#endif
+#define HDR_EXPOSURE_SHORT  96   // AEC en líneas del frame corto
+#define HDR_EXPOSURE_LONG   384  // AEC en líneas del frame largo (4x)
+
+#if HDR_CAPTURE && FRAME_INJECTION
+#error "HDR_CAPTURE necesita la cámara: no es compatible con FRAME_INJECTION"
+#endif
+
+// Lector de códigos: umbraliza la luma en su media, busca candidatos QR y de
+// barras en cada frame y solo intenta leerlos cuando los hay; los contenidos
+// nuevos se imprimen por USB
+#ifndef CODE_READER
+#define CODE_READER         0
+#endif
+
+#if CODE_READER && (STREAM_ANALYTICS || FRAME_INJECTION)
+#error "CODE_READER imprime por la consola USB: solo está disponible en el modo pantalla"
+#endif
+
+// Flujo óptico: sigue puntos con textura de un frame al siguiente (KLT
+// piramidal) y, cuando el movimiento global supera OPTICAL_FLOW_TRIGGER
+// (en Q8), lo imprime por USB; los puntos se renuevan al perder la mitad
+#ifndef OPTICAL_FLOW
+#define OPTICAL_FLOW        0
+#endif
+#define OPTICAL_FLOW_TRIGGER (2 * 256)
+
+#if OPTICAL_FLOW && (STREAM_ANALYTICS || FRAME_INJECTION)
+#error "OPTICAL_FLOW imprime por la consola USB: solo está disponible en el modo pantalla"
+#endif
+
+// Detector de objetos por cascada LBP (lbp_cascade_data, generada al compilar
+// desde la cascada de MINIVISION_LBP_CASCADE): busca cada LBP_DETECTOR_PERIOD
+// frames e imprime por USB las detecciones cuando cambia su número
+#ifndef LBP_DETECTOR
+#define LBP_DETECTOR        0
+#endif
+#define LBP_DETECTOR_WINDOW 24  // Alto máximo de la ventana de la cascada
+#define LBP_DETECTOR_PERIOD 4   // Frames entre búsquedas
+
+#if LBP_DETECTOR && (STREAM_ANALYTICS || FRAME_INJECTION)
+#error "LBP_DETECTOR imprime por la consola USB: solo está disponible en el modo pantalla"
+#endif
+
+// Frames del pool: uno en captura, otro en proceso, la referencia del filtro
+// temporal y el primer frame de la pareja HDR
+#define POOL_FRAMES (2 + TEMPORAL_DENOISE + HDR_CAPTURE)
+
+#define TICK_PERIOD_MS    100     // Periodo del temporizador del planificador
+#define FRAME_DEADLINE_US 200000  // Plazo de procesamiento de un frame desde su llegada
+
+/**
+ * @enum app_event
+ * @brief Eventos del planificador de la aplicación.
+ */
+enum app_event {
+	EV_FRAME   = SCHED_EVENT(0),  // ISR: la cámara completó un frame
+	EV_PROCESS = SCHED_EVENT(1),  // Hay un frame listo para procesar
+	EV_CAPTURE = SCHED_EVENT(2),  // Se liberó un frame: reintentar la captura
+	EV_TICK    = SCHED_EVENT(3),  // Temporizador periódico
+	EV_BUTTON  = SCHED_EVENT(4),  // ISR: pulsación del botón
+	EV_INPUT   = SCHED_EVENT(5),  // Datos disponibles en la consola USB
+};
+
+/**
+ * @struct app
+ * @brief Estado compartido por las tareas de la aplicación.
+ */
+struct app {
+	struct frame_pool pool;       // Frames de captura/inyección
+	struct pool_frame *capturing; // Frame en captura o recepción
+	struct pool_frame *ready;     // Último frame completo pendiente de procesar
+	uint32_t capture_cycles;      // Ciclos de captura del frame en curso
+	uint32_t ready_cycles;        // Ciclos de captura del frame listo
+	uint32_t seq;                 // Secuencia del próximo frame capturado
+	bool paused;                  // Imagen congelada con el botón
+	bool show_stats;              // Métricas superpuestas en la pantalla
+	uint led_pin;                 // LED encendido durante la captura
+#if !FRAME_INJECTION
+	struct camera camera;
+#endif
+	struct LCD lcd;
+#if TEMPORAL_DENOISE
+	struct denoise denoise;
+#endif
+#if HDR_CAPTURE
+	struct hdr_merge hdr;
+	struct pool_frame *hdr_held;  // Primer frame de la pareja, a la espera del segundo
+	bool hdr_long;                // Exposición encolada para la próxima captura
+#endif
+#if STREAM_ANALYTICS || FRAME_INJECTION
+	struct stream stream;
+#endif
+};
+
+static struct app app;
+static struct sched sched;
+
+// Métricas de ejecución: en modo pantalla 's' las imprime por USB y 'o'
+// activa o desactiva su superposición en la imagen; en los modos de stream
+// se envían como paquete STREAM_PKT_STATS al cerrar cada ventana
+static struct stats stats;
+
+#if XIP_PROFILE
+// Sondas XIP de las funciones del camino de proceso: 't' las imprime tras las
+// tareas y en los modos de stream van en un paquete STREAM_PKT_XIP con las
+// métricas; una función con fallos en cada llamada es candidata a PLACEMENT_RAM
+enum app_probe {
+	PROBE_HDR = 0,
+	PROBE_DENOISE,
+	PROBE_HISTOGRAM,
+	PROBE_STREAM,
+	PROBE_CODES,
+	PROBE_FLOW,
+	PROBE_LBP,
+	PROBE_FUSE,
+	PROBE_LCD,
+	PROBE_COUNT,
+};
+
+static struct xip_probe probes[PROBE_COUNT] = {
+	[PROBE_HDR] = { .name = "hdr" },
+	[PROBE_DENOISE] = { .name = "denoise" },
+	[PROBE_HISTOGRAM] = { .name = "histogram" },
+	[PROBE_STREAM] = { .name = "stream" },
+	[PROBE_CODES] = { .name = "codes" },
+	[PROBE_FLOW] = { .name = "flow" },
+	[PROBE_LBP] = { .name = "lbp" },
+	[PROBE_FUSE] = { .name = "fuse" },
+	[PROBE_LCD] = { .name = "lcd" },
+};
+#endif
+
+#if !STREAM_ANALYTICS && !FRAME_INJECTION
+// Imagen compuesta para la pantalla: estática para no ocupar la pila del bucle
+static uint16_t display_image[CAMERA_WIDTH_DIV8 * CAMERA_HEIGHT_DIV8];
+#define DISPLAY_BUFFERS 1
+#else
+#define DISPLAY_BUFFERS 0
+#endif
+
+#if CODE_READER
+// Máscara de la luma umbralizada y candidatos del lector de códigos
+static uint32_t code_mask[CAMERA_HEIGHT_DIV8 * ((CAMERA_WIDTH_DIV8 + 31) / 32)];
+static struct code_reader code_reader;
+#define CODE_READER_BYTES (sizeof(code_mask) + sizeof(code_reader) + sizeof(struct histogram))
+#else
+#define CODE_READER_BYTES 0
+#endif
+
+#if OPTICAL_FLOW
+// Luma y niveles reducidos de los dos últimos frames, alternados
+static uint8_t flow_luma[2][CAMERA_WIDTH_DIV8 * CAMERA_HEIGHT_DIV8];
+static uint8_t flow_work[2][FLOW_WORK_SIZE(CAMERA_WIDTH_DIV8, CAMERA_HEIGHT_DIV8)];
+#define OPTICAL_FLOW_BYTES (sizeof(flow_luma) + sizeof(flow_work))
+#else
+#define OPTICAL_FLOW_BYTES 0
+#endif
+
+#if LBP_DETECTOR
+// Luma del frame y filas de la integral del detector
+extern const uint8_t lbp_cascade_data[];
+extern const uint32_t lbp_cascade_data_size;
+static uint8_t lbp_luma[CAMERA_WIDTH_DIV8 * CAMERA_HEIGHT_DIV8];
+static uint8_t __attribute__((aligned(4))) lbp_work[LBP_WORK_SIZE(CAMERA_WIDTH_DIV8, LBP_DETECTOR_WINDOW)];
+#define LBP_DETECTOR_BYTES (sizeof(lbp_luma) + sizeof(lbp_work))
+#else
+#define LBP_DETECTOR_BYTES 0
+#endif
+
+// Presupuesto de SRAM de la configuración compilada (ver MEMORY_BUDGET_TABLE)
+MEMORY_BUDGET_ASSERT(CAMERA_WIDTH_DIV8, CAMERA_HEIGHT_DIV8, POOL_FRAMES, DISPLAY_BUFFERS,
+		     sizeof(struct stream) + sizeof(struct stats) + sizeof(struct histogram) + CODE_READER_BYTES +
+		     OPTICAL_FLOW_BYTES + LBP_DETECTOR_BYTES);
 
 /**
  * @brief Wrapper para escritura I2C compatible con la plataforma camera_platform_config.
@@ -65,42 +289,578 @@ static inline int8_t __spi_write_blocking(void *spi_handle, const uint8_t *src,
 }
 
 /**
- * @brief Callback de interrupción para la pulsación de botón. Activa la toma de foto.
+ * @brief Escritura binaria directa al CDC USB, sin traducción CRLF, para la plataforma stream_platform_config.
+ */
+static int __stream_write(void *handle, const uint8_t *src, size_t len)
+{
+	stdio_driver_t *driver = (stdio_driver_t *)handle;
+	driver->out_chars((const char *)src, len);
+	return len;
+}
+
+/**
+ * @brief Lectura no bloqueante del CDC USB para la plataforma stream_platform_config.
+ */
+static int __stream_read(void *handle, uint8_t *dst, size_t len)
+{
+	stdio_driver_t *driver = (stdio_driver_t *)handle;
+	int ret = driver->in_chars((char *)dst, len);
+	return ret == PICO_ERROR_NO_DATA ? 0 : ret;
+}
+
+/**
+ * @brief Entrega un frame completo a la tarea de proceso. Si el anterior aún
+ * no se procesó, se descarta y cuenta como perdido.
+ * @param frame  Frame completo.
+ * @param cycles Ciclos de la etapa de entrada.
+ */
+static void app_frame_ready(struct pool_frame *frame, uint32_t cycles)
+{
+	if (app.ready) {
+		frame_pool_release(&app.pool, app.ready);
+		stats_drop(&stats);
+	}
+	app.ready = frame;
+	app.ready_cycles = cycles;
+	sched_post(&sched, EV_PROCESS);
+}
+
+#if !FRAME_INJECTION
+/**
+ * @brief Callback de la ISR de fin de frame de la cámara.
+ */
+static void frame_done_callback(struct camera_buffer *buf, void *data)
+{
+	sched_post(&sched, EV_FRAME);
+}
+
+/**
+ * @brief Arranca la captura del siguiente frame si hay uno libre y no está congelada la imagen.
+ */
+static void app_start_capture(void)
+{
+	if (app.paused || app.capturing) {
+		return;
+	}
+
+	struct pool_frame *frame = frame_pool_acquire(&app.pool);
+	if (!frame) {
+		// Se reintenta con EV_CAPTURE cuando la tarea de proceso libere su frame
+		return;
+	}
+
+	frame->timestamp_us = time_us_32();
+	app.capturing = frame;
+	app.capture_cycles = cycles_now();
+	gpio_put(app.led_pin, 1);
+	stats_busy_begin(&stats, STATS_BUSY_DMA);
+
+	int ret = camera_capture_with_cb(&app.camera, &frame->buf, true, frame_done_callback, NULL);
+	if (ret) {
+		// Se reintenta en el siguiente tick
+		stats_busy_end(&stats, STATS_BUSY_DMA);
+		gpio_put(app.led_pin, 0);
+		frame_pool_release(&app.pool, frame);
+		app.capturing = NULL;
+		stats_drop(&stats);
+		return;
+	}
+
+	// Exposición que el sensor aplica en esta captura: la escrita
+	// CAMERA_EXPOSURE_DELAY frames antes, no la que acaba de salir de la cola
+	frame->exposure = app.camera.exposure;
+
+#if HDR_CAPTURE
+	// La exposición del frame siguiente se encola ya; se escribe al disparar esa captura
+	app.hdr_long = !app.hdr_long;
+	camera_defer_exposure(&app.camera, &(struct camera_exposure){
+		.aec = app.hdr_long ? HDR_EXPOSURE_LONG : HDR_EXPOSURE_SHORT,
+	});
+#endif
+}
+
+/**
+ * @brief Tarea de fin de frame: entrega el frame y arranca enseguida la siguiente captura.
+ */
+static void task_frame(void *ctx, uint32_t events)
+{
+	struct pool_frame *frame = app.capturing;
+
+	stats_busy_end(&stats, STATS_BUSY_DMA);
+	stats_latency(&stats, time_us_32() - app.camera.done_us);
+	gpio_put(app.led_pin, 0);
+	if (!frame) {
+		return;
+	}
+
+	app.capturing = NULL;
+	frame->seq = app.seq++;
+	frame->source = POOL_SOURCE_CAMERA;
+	app_frame_ready(frame, cycles_elapsed(app.capture_cycles, cycles_now()));
+
+	app_start_capture();
+}
+
+/**
+ * @brief Tarea de reintento de captura tras liberarse un frame.
+ */
+static void task_capture(void *ctx, uint32_t events)
+{
+	app_start_capture();
+}
+
+/**
+ * @brief Callback de interrupción del botón: publica EV_BUTTON.
  * @param gpio    Número de pin GPIO.
  * @param events  Tipo de evento.
  */
-static void take_picture_callback(uint gpio, uint32_t events) {
-	printf("gpio %d event: %d\n", gpio, events);
-	if (gpio != BUTTON_PIN) {
-		return; // Ignore other GPIO events
+static void button_callback(uint gpio, uint32_t events)
+{
+	if (gpio == BUTTON_PIN) {
+		sched_post(&sched, EV_BUTTON);
+	}
+}
+
+/**
+ * @brief Tarea del botón: congela o reanuda la imagen.
+ */
+static void task_button(void *ctx, uint32_t events)
+{
+	app.paused = !app.paused;
+	printf(app.paused ? "Imagen congelada\n" : "Captura reanudada\n");
+	app_start_capture();
+}
+#endif
+
+#if HDR_CAPTURE
+/**
+ * @brief Empareja los frames HDR: retiene el primero y fusiona el segundo sobre sí mismo.
+ * @param frame Frame recibido.
+ * @return true si frame contiene ya la fusión de la pareja, false si quedó retenido o se descartó.
+ */
+static bool app_hdr_pair(struct pool_frame *frame)
+{
+	struct pool_frame *held = app.hdr_held;
+
+	// Los primeros frames se toman aún con la exposición automática
+	if (!frame->exposure.aec) {
+		frame_pool_release(&app.pool, frame);
+		return false;
 	}
-	gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_RISE, false, take_picture_callback);
-	take_picture = true;
+
+	// Sin pareja o con dos frames de la misma exposición (se perdió uno): se
+	// retiene el más reciente
+	if (!held || held->exposure.aec == frame->exposure.aec) {
+		if (held) {
+			frame_pool_release(&app.pool, held);
+			stats_drop(&stats);
+		}
+		app.hdr_held = frame;
+		return false;
+	}
+
+	struct pool_frame *short_exp = held->exposure.aec < frame->exposure.aec ? held : frame;
+	struct pool_frame *long_exp = short_exp == held ? frame : held;
+	hdr_merge_rgb565be(&app.hdr, frame->buf.data[0], short_exp->buf.data[0], long_exp->buf.data[0],
+			   (uint32_t)frame->buf.width * frame->buf.height);
+
+	frame_pool_release(&app.pool, held);
+	app.hdr_held = NULL;
+
+	return true;
+}
+#endif
+
+#if STREAM_ANALYTICS || FRAME_INJECTION
+/**
+ * @brief Pipeline de analítica de un frame: calcula los resultados y los envía por el stream.
+ *
+ * Es el mismo para frames capturados y para frames inyectados desde el host.
+ * Solo rellena el resumen del histograma: las listas de blobs, cajas y
+ * keypoints del registro se envían vacías.
+ *
+ * @param stream  Puntero al stream de salida.
+ * @param frame   Frame del pool a procesar.
+ * @param profile Perfil por etapas del frame.
+ * @return 0 en éxito, -1 si no se pudo enviar el registro.
+ */
+static int stream_analytics_frame(struct stream *stream, struct pool_frame *frame, struct profile *profile)
+{
+	static struct histogram hist;
+	struct camera_buffer *buf = &frame->buf;
+	struct stream_result result = {
+		.seq = frame->seq,
+		.timestamp_us = frame->timestamp_us,
+		.width = buf->width,
+		.height = buf->height,
+	};
+
+	int ret;
+
+	histogram_reset(&hist);
+	XIP_PROBE(&probes[PROBE_HISTOGRAM],
+		  histogram_accumulate(&hist, buf->format, buf->data[0], buf->strides[0], buf->width, buf->height));
+	histogram_summarize(&hist, &result.hist);
+	profile_mark(profile, PROFILE_STAGE_ANALYTICS);
+
+	XIP_PROBE(&probes[PROBE_STREAM],
+		  ret = stream_send_frame(stream, &result, buf->format, buf->data[0], buf->strides[0]));
+	profile_mark(profile, PROFILE_STAGE_OUTPUT);
+
+	return ret;
 }
 
+#endif
+
+#if CODE_READER
+
 /**
- * @brief Función principal del ejemplo de adquisición y visualización de imágenes.
+ * @brief Busca códigos en el frame e imprime por USB el leído si cambia.
+ */
+static void app_read_codes(const struct camera_buffer *buf)
+{
+	static const char *const names[] = { "QR", "EAN-13", "Code 128" };
+	static struct histogram hist;
+	static char last[CODE_MAX_TEXT + 1];
+	const uint32_t stride = format_stride(FORMAT_MONO1, 0, buf->width);
+	struct histogram_summary summary;
+	struct code_result result;
+
+	histogram_reset(&hist);
+	histogram_accumulate(&hist, buf->format, buf->data[0], buf->strides[0], buf->width, buf->height);
+	histogram_summarize(&hist, &summary);
+	if (mono1_threshold(code_mask, stride, buf->format, buf->data[0], buf->strides[0], buf->width, buf->height,
+			    summary.mean)) {
+		return;
+	}
+
+	// La detección es barata; la lectura solo se intenta con candidatos
+	if (code_detect(&code_reader, code_mask, stride, buf->width, buf->height) <= 0) {
+		return;
+	}
+	if (code_decode(&code_reader, code_mask, stride, buf->width, buf->height, &result, 1) &&
+	    strcmp(result.text, last)) {
+		printf("%s: %s\n", names[result.type], result.text);
+		strcpy(last, result.text);
+	}
+}
+
+#endif
+
+#if OPTICAL_FLOW
+
+/**
+ * @brief Sigue los puntos del frame anterior e imprime por USB el movimiento global si supera el umbral.
+ */
+static void app_track_motion(const struct camera_buffer *buf)
+{
+	static struct flow_pyramid pyramids[2];
+	static struct flow_point points[FLOW_MAX_POINTS];
+	static int n_points, current;
+	struct flow_vector vectors[FLOW_MAX_POINTS];
+	int32_t dx, dy;
+
+	current ^= 1;
+	for (uint16_t y = 0; y < buf->height; y++) {
+		convert_rgb565be_to_y8(flow_luma[current] + (uint32_t)y * buf->width,
+				       buf->data[0] + (uint32_t)y * buf->strides[0], buf->width);
+	}
+	if (flow_pyramid_init(&pyramids[current], flow_luma[current], buf->width, buf->width, buf->height,
+			      flow_work[current])) {
+		return;
+	}
+
+	int tracked = n_points ? flow_track(&pyramids[current ^ 1], &pyramids[current], points, n_points, vectors) : 0;
+	if (tracked > 0 && flow_global_motion(vectors, n_points, &dx, &dy) &&
+	    abs(dx) + abs(dy) >= OPTICAL_FLOW_TRIGGER) {
+		printf("flujo: %ld %ld centésimas de píxel (%d/%d puntos)\n", (long)(dx * 100 / 256), (long)(dy * 100 / 256),
+		       tracked, n_points);
+	}
+
+	// Los puntos seguidos pasan al frame nuevo; con menos de la mitad se eligen otros
+	if (2 * tracked < n_points || !n_points) {
+		n_points = flow_select(&pyramids[current], points, FLOW_MAX_POINTS);
+		return;
+	}
+	int n = 0;
+	for (int i = 0; i < n_points; i++) {
+		if (vectors[i].status == FLOW_TRACKED) {
+			points[n++] = (struct flow_point){ points[i].x + vectors[i].dx, points[i].y + vectors[i].dy };
+		}
+	}
+	n_points = n;
+}
+
+#endif
+
+#if LBP_DETECTOR
+
+/**
+ * @brief Busca objetos cada LBP_DETECTOR_PERIOD frames e imprime por USB las detecciones si cambia su número.
+ */
+static void app_detect_objects(const struct camera_buffer *buf)
+{
+	static struct lbp_cascade cascade;
+	static int state, frames, last;
+	struct lbp_detection detections[4];
+
+	// La cascada se valida una vez; si no sirve el detector queda apagado
+	if (!state) {
+		bool valid = !lbp_cascade_load(&cascade, lbp_cascade_data, lbp_cascade_data_size) &&
+			     cascade.height <= LBP_DETECTOR_WINDOW;
+
+		state = valid ? 1 : -1;
+		if (!valid) {
+			printf("lbp: cascada no válida o ventana mayor que %d filas\n", LBP_DETECTOR_WINDOW);
+		}
+	}
+	if (state < 0 || frames++ % LBP_DETECTOR_PERIOD) {
+		return;
+	}
+
+	for (uint16_t y = 0; y < buf->height; y++) {
+		convert_rgb565be_to_y8(lbp_luma + (uint32_t)y * buf->width, buf->data[0] + (uint32_t)y * buf->strides[0],
+				       buf->width);
+	}
+	int n = lbp_detect(&cascade, lbp_luma, buf->width, buf->width, buf->height, lbp_work, detections, 4);
+	if (n < 0 || n == last) {
+		return;
+	}
+	last = n;
+	printf("lbp: %d objetos", n);
+	for (int i = 0; i < n; i++) {
+		printf(" (%u,%u %ux%u)", detections[i].x, detections[i].y, detections[i].width, detections[i].height);
+	}
+	printf("\n");
+}
+
+#endif
+
+/**
+ * @brief Tarea de proceso: analítica y salida (stream o pantalla) del frame listo.
+ */
+static void task_process(void *ctx, uint32_t events)
+{
+	struct pool_frame *frame = app.ready;
+	struct profile profile;
+	int ret;
+
+	if (!frame) {
+		return;
+	}
+	app.ready = NULL;
+
+	profile_begin(&profile);
+	profile.cycles[PROFILE_STAGE_INPUT] = app.ready_cycles;
+
+#if HDR_CAPTURE
+	// La fusión se contabiliza en la etapa de analítica del segundo frame
+	bool paired;
+	XIP_PROBE(&probes[PROBE_HDR], paired = app_hdr_pair(frame));
+	if (!paired) {
+		sched_post(&sched, EV_CAPTURE);
+		return;
+	}
+#endif
+
+#if TEMPORAL_DENOISE
+	// Se contabiliza en la etapa de analítica
+	XIP_PROBE(&probes[PROBE_DENOISE], denoise_frame(&app.denoise, &frame->buf));
+#endif
+
+#if STREAM_ANALYTICS || FRAME_INJECTION
+	ret = stream_analytics_frame(&app.stream, frame, &profile);
+#if FRAME_INJECTION
+	stream_send_stages(&app.stream, frame->seq, profile.cycles, PROFILE_STAGE_COUNT);
+#endif
+#else
+	struct camera_buffer *buf = &frame->buf;
+	uint16_t *image = display_image;
+	struct image_view view;
+	image_view_init(&view, buf, 0);
+
+#if CODE_READER
+	XIP_PROBE(&probes[PROBE_CODES], app_read_codes(buf));
+#endif
+#if OPTICAL_FLOW
+	XIP_PROBE(&probes[PROBE_FLOW], app_track_motion(buf));
+#endif
+#if LBP_DETECTOR
+	XIP_PROBE(&probes[PROBE_LBP], app_detect_objects(buf));
+#endif
+
+	// Intercambio de bytes y texto superpuesto en una sola pasada
+	struct fuse_chain chain;
+	struct overlay_text stats_text;
+	char text[48];
+	fuse_init(&chain);
+	if (app.show_stats) {
+		snprintf(text, sizeof(text), "FPS %lu.%lu\nLAT %lu\nCPU %u%%\nSPI %u%%",
+			 (unsigned long)(stats.last.fps_x100 / 100),
+			 (unsigned long)(stats.last.fps_x100 % 100 / 10),
+			 (unsigned long)stats.last.latency.max,
+			 stats.last.load_x1000[0] / 10, stats.last.busy_x1000[STATS_BUSY_SPI] / 10);
+		stats_text = (struct overlay_text){ 1, 1, text, YELLOW, BLACK };
+		fuse_add_line(&chain, overlay_text_line_op, &stats_text);
+	}
+	XIP_PROBE(&probes[PROBE_FUSE], fuse_run_rgb565be(&chain, image, view.width, view.height, view.data,
+							 view.stride, view.width, view.height));
+	profile_mark(&profile, PROFILE_STAGE_ANALYTICS);
+
+	// La captura del siguiente frame sigue por DMA mientras se envía este por SPI
+	stats_busy_begin(&stats, STATS_BUSY_SPI);
+	XIP_PROBE(&probes[PROBE_LCD], lcd_show_image(&app.lcd, buf->width, buf->height, image));
+	stats_busy_end(&stats, STATS_BUSY_SPI);
+	profile_mark(&profile, PROFILE_STAGE_OUTPUT);
+	ret = 0;
+#endif
+
+	if (ret) {
+		stats_drop(&stats);
+	} else {
+		stats_frame(&stats, &profile);
+	}
+
+	frame_pool_release(&app.pool, frame);
+	sched_post(&sched, EV_CAPTURE | EV_INPUT);
+}
+
+/**
+ * @brief Callback del temporizador periódico: publica EV_TICK.
+ */
+static bool tick_callback(struct repeating_timer *timer)
+{
+	sched_post(&sched, EV_TICK);
+	return true;
+}
+
+/**
+ * @brief Tarea periódica: cierra las ventanas de métricas y reintenta lo pendiente.
+ */
+static void task_tick(void *ctx, uint32_t events)
+{
+	if (stats_poll(&stats)) {
+#if STREAM_ANALYTICS || FRAME_INJECTION
+		struct memory_report mem;
+
+		memory_read(&mem);
+		stream_send_stats(&app.stream, &stats.last, clock_get_hz(clk_sys));
+		stream_send_memory(&app.stream, &mem);
+#if XIP_PROFILE
+		stream_send_xip(&app.stream, probes, PROBE_COUNT);
+#endif
+#endif
+	}
+
+	// Por si se perdió una notificación de datos USB o falló una captura
+	sched_post(&sched, EV_INPUT | EV_CAPTURE);
+}
+
+/**
+ * @brief Callback de datos disponibles en la consola USB: publica EV_INPUT.
+ */
+static void input_callback(void *param)
+{
+	sched_post(&sched, EV_INPUT);
+}
+
+/**
+ * @brief Tarea de entrada USB: fragmentos de frames inyectados u órdenes de consola.
+ */
+static void task_input(void *ctx, uint32_t events)
+{
+#if FRAME_INJECTION
+	// Un frame inyectado se procesa siempre antes de recibir el siguiente:
+	// el host espera su paquete de etapas, así que no hay frames perdidos
+	if (app.ready) {
+		return;
+	}
+	if (!app.capturing) {
+		app.capturing = frame_pool_acquire(&app.pool);
+		if (!app.capturing) {
+			return;
+		}
+		app.capture_cycles = cycles_now();
+	}
+
+	struct pool_frame *frame = app.capturing;
+	int ret = stream_receive_frame(&app.stream, &frame->buf, &frame->seq);
+	if (ret == 0) {
+		// La etapa de entrada no se perfila: depende del ritmo del host
+		frame->timestamp_us = time_us_32();
+		frame->source = POOL_SOURCE_INJECTED;
+		app.capturing = NULL;
+		app_frame_ready(frame, 0);
+		sched_post(&sched, EV_INPUT);
+	}
+#elif STREAM_ANALYTICS
+	// En modo streaming la consola USB no admite órdenes
+#else
+	int c;
+
+	while ((c = getchar_timeout_us(0)) >= 0) {
+		switch (c) {
+		case 's':
+			stats_print(&stats.last);
+			break;
+		case 'o':
+			app.show_stats = !app.show_stats;
+			break;
+		case 'm': {
+			struct memory_report mem;
+
+			memory_read(&mem);
+			memory_print(&mem);
+			break;
+		}
+		case 't':
+			sched_print(&sched);
+#if XIP_PROFILE
+			printf("--- funciones ---\n");
+			for (int i = 0; i < PROBE_COUNT; i++) {
+				if (probes[i].site.calls) {
+					xip_site_print(probes[i].name, &probes[i].site);
+				}
+			}
+#endif
+			break;
+		}
+	}
+#endif
+}
+
+/**
+ * @brief Función principal: inicializa el hardware, registra las tareas y cede el control al planificador.
  */
 int main() {
+	memory_init();
 	stdio_init_all();
 
 	// Espera para conexión USB serie
 	sleep_ms(1000);
 
+	cycles_init();
+	stats_init(&stats);
+	// La captura por DMA no debe esperar a los kernels de la CPU
+	placement_bus_priority(true);
+	sched_init(&sched, &stats);
+
+#if !FRAME_INJECTION
 	// Inicializa botón de captura
 	gpio_init(BUTTON_PIN);
     gpio_set_dir(BUTTON_PIN, GPIO_IN);
     gpio_pull_up(BUTTON_PIN);
 
-	gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_RISE, true, take_picture_callback);
+	gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_RISE, true, button_callback);
+#endif
 
 	gpio_init(CAM_RET_PIN);
     gpio_set_dir(CAM_RET_PIN, GPIO_OUT);
     gpio_put(CAM_RET_PIN, 1);
 
-	const uint LED_PIN = PICO_DEFAULT_LED_PIN;
-	gpio_init(LED_PIN);
-	gpio_set_dir(LED_PIN, GPIO_OUT);
+	app.led_pin = PICO_DEFAULT_LED_PIN;
+	gpio_init(app.led_pin);
+	gpio_set_dir(app.led_pin, GPIO_OUT);
 
 	i2c_init(i2c0, 100000);
 	gpio_set_function(CAMERA_SDA, GPIO_FUNC_I2C);
@@ -110,7 +870,10 @@ int main() {
 
 	spi_init(SPI_PORT, 500 * 1000);
 
-	struct camera camera;
+	int ret;
+
+#if !FRAME_INJECTION
+	// Con inyección de frames los datos llegan del host y la cámara no se usa
 	struct camera_platform_config platform_camera = {
 		.i2c_write_blocking = __i2c_write_blocking,
 		.i2c_read_blocking = __i2c_read_blocking,
@@ -123,60 +886,73 @@ int main() {
 		.base_dma_channel = -1,
 	};
 
-	int ret = camera_init(&camera, &platform_camera);
+	ret = camera_init(&app.camera, &platform_camera);
 	if (ret) {
 		printf("camera_init failed: %d\n", ret);
 		return 1;
 	}
+#endif
 
 	const uint16_t width = CAMERA_WIDTH_DIV8;
 	const uint16_t height = CAMERA_HEIGHT_DIV8;
 
-	struct camera_buffer *buf = camera_buffer_alloc(FORMAT_RGB565, width, height);
-	assert(buf);
+	ret = frame_pool_init(&app.pool, POOL_FRAMES, FORMAT_RGB565, width, height, PLACEMENT_REGION_MAIN);
+	assert(ret == 0);
+
+#if TEMPORAL_DENOISE
+	// La referencia no vuelve al pool mientras el filtro está activo
+	struct pool_frame *denoise_ref = frame_pool_acquire(&app.pool);
+	ret = denoise_init(&app.denoise, &denoise_ref->buf, DENOISE_SHIFT, DENOISE_MOTION);
+	assert(ret == 0);
+#endif
 
-	struct LCD lcd;
     struct lcd_platform_config platform_lcd = {
         .spi_handle = SPI_PORT,
         .spi_write_blocking = __spi_write_blocking,
         .base_dma_channel = -1, // No se usa DMA en este ejemplo
     };
 
-    SSD1283A_status status = lcd_init(&lcd, &platform_lcd);
+    SSD1283A_status status = lcd_init(&app.lcd, &platform_lcd);
     if (status != SSD1283A_STATUS_OK) {
         printf("Error initializing LCD: %d\n", status);
         return -1; // Error al inicializar el LCD
     }
 
-	lcd_fill_screen(&lcd, BLACK);
+	lcd_fill_screen(&app.lcd, BLACK);
 
-	while (1) {
-		if(take_picture){
-			take_picture = false;
-			camera_term(&camera);
-		}
+#if STREAM_ANALYTICS || FRAME_INJECTION
+	struct stream_platform_config platform_stream = {
+		.write = __stream_write,
+		.read = __stream_read,
+		.handle = &stdio_usb,
+	};
+	stream_init(&app.stream, &platform_stream);
+	app.stream.thumb_period = FRAME_INJECTION ? 0 : STREAM_THUMB_PERIOD;
+#endif
 
-		printf("Capturing...\n");
-		gpio_put(LED_PIN, 1);
-		ret = camera_capture_blocking(&camera, buf, true);
-		gpio_put(LED_PIN, 0);
-		if (ret != 0) {
-			printf("Capture error: %d\n", ret);
-		} else {
-			printf("Capture success\n");
-			uint8_t y, x;
-			uint16_t image[height * width]; // Matriz completa en memoria
-			printf("Capture success\n");
-			for (y = 0; y < height; y++) {
-				for (x = 0; x < buf->strides[0]; x+=2) {
-					uint32_t idx = buf->strides[0] * y + x;
-					uint16_t pixel = (buf->data[0][idx + 1]) | buf->data[0][idx]<<8;   
-					image[width * y + x/2] = pixel;
-					printf("Pixel at (%d, %d): 0x%04X\n", x, y, pixel);
-				}
-			}
-			lcd_show_image(&lcd, width, height, image);
-			sleep_ms(1000);
-		}
-	}
+	// Prioridades: entregar el frame y rearmar la captura antes que nada,
+	// después la entrada y el tick, y por último el proceso (el más largo)
+#if !FRAME_INJECTION
+	sched_add(&sched, "frame", EV_FRAME, 4, 0, task_frame, NULL);
+	sched_add(&sched, "capture", EV_CAPTURE, 3, 0, task_capture, NULL);
+	sched_add(&sched, "button", EV_BUTTON, 2, 0, task_button, NULL);
+#endif
+	sched_add(&sched, "input", EV_INPUT, 2, 0, task_input, NULL);
+	sched_add(&sched, "tick", EV_TICK, 2, 0, task_tick, NULL);
+	sched_add(&sched, "process", EV_PROCESS, 1, FRAME_DEADLINE_US, task_process, NULL);
+
+	static struct repeating_timer tick_timer;
+	add_repeating_timer_ms(-TICK_PERIOD_MS, tick_callback, NULL, &tick_timer);
+	stdio_set_chars_available_callback(input_callback, NULL);
+
+#if HDR_CAPTURE
+	ret = hdr_merge_init(&app.hdr, HDR_EXPOSURE_LONG, HDR_EXPOSURE_SHORT);
+	assert(ret == 0);
+	camera_defer_exposure(&app.camera, &(struct camera_exposure){ .aec = HDR_EXPOSURE_SHORT });
+#endif
+
+#if !FRAME_INJECTION
+	app_start_capture();
+#endif
+	sched_run(&sched);
 }
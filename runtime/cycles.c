@@ -0,0 +1,39 @@
+/**
+ * @file cycles.c
+ * @brief Extensión por software del SysTick a 32 bits.
+ */
+
+#include "pico/stdlib.h"
+
+#include "runtime/cycles.h"
+
+#if PICO_ON_DEVICE
+
+#include "hardware/exception.h"
+
+#include "runtime/placement.h"
+
+volatile uint32_t cycles_wraps;
+
+/**
+ * @brief Interrupción del SysTick: un desborde más de los 24 bits bajos.
+ */
+static void PLACEMENT_RAM(cycles_isr_systick)(void)
+{
+	cycles_wraps++;
+}
+
+/**
+ * @brief Arranca el SysTick en modo libre con el reloj del procesador.
+ */
+void cycles_init(void)
+{
+	systick_hw->csr = 0;
+	cycles_wraps = 0;
+	exception_set_exclusive_handler(SYSTICK_EXCEPTION, cycles_isr_systick);
+	systick_hw->rvr = CYCLES_SYSTICK;
+	systick_hw->cvr = 0;
+	systick_hw->csr = (1 << 2) | (1 << 1) | (1 << 0); // CLKSOURCE = CPU, TICKINT, ENABLE
+}
+
+#endif
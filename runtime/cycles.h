@@ -0,0 +1,85 @@
+/**
+ * @file cycles.h
+ * @brief Contador de ciclos de CPU para medir etapas y kernels.
+ *
+ * En el dispositivo se usa el SysTick del Cortex-M0+ (24 bits, reloj de CPU)
+ * extendido a 32 bits por software: su interrupción cuenta los desbordes, uno
+ * cada 2^24 ciclos (~134 ms a 125 MHz), y forman los 8 bits altos. Así un
+ * intervalo puede llegar a 2^32 ciclos (~34 s), suficiente para etapas largas
+ * como el envío de un frame por SPI. En el host los "ciclos" son nanosegundos
+ * de CLOCK_MONOTONIC.
+ */
+
+#ifndef __CYCLES_H__
+#define __CYCLES_H__
+
+#include <stdint.h>
+
+#if PICO_ON_DEVICE
+
+#include "hardware/regs/m0plus.h"
+#include "hardware/structs/scb.h"
+#include "hardware/structs/systick.h"
+
+#define CYCLES_MASK    0xffffffffu  /**< Ancho útil del contador */
+#define CYCLES_SYSTICK 0x00ffffffu  /**< Ancho del SysTick */
+
+extern volatile uint32_t cycles_wraps;  /**< Desbordes del SysTick contados por su interrupción */
+
+/**
+ * @brief Arranca el SysTick en modo libre con el reloj del procesador y su interrupción de desborde.
+ */
+void cycles_init(void);
+
+/**
+ * @brief Lectura actual del contador (ascendente).
+ */
+static inline uint32_t cycles_now(void)
+{
+	uint32_t wraps, count, pending;
+
+	do {
+		wraps = cycles_wraps;
+		count = ~systick_hw->cvr & CYCLES_SYSTICK;
+
+		// Desborde aún sin atender (interrupciones deshabilitadas o dentro de otra ISR)
+		pending = scb_hw->icsr & M0PLUS_ICSR_PENDSTSET_BITS ? 1 : 0;
+		if (pending) {
+			count = ~systick_hw->cvr & CYCLES_SYSTICK;
+		}
+	} while (wraps != cycles_wraps);
+
+	return (wraps + pending) << 24 | count;
+}
+
+#else
+
+#include <time.h>
+
+#define CYCLES_MASK 0xffffffffu  /**< Ancho útil del contador */
+
+static inline void cycles_init(void)
+{
+}
+
+static inline uint32_t cycles_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+#endif
+
+/**
+ * @brief Ciclos transcurridos entre dos lecturas, teniendo en cuenta el desborde.
+ * @param start Lectura inicial
+ * @param end   Lectura final
+ * @return Ciclos transcurridos
+ */
+static inline uint32_t cycles_elapsed(uint32_t start, uint32_t end)
+{
+	return (end - start) & CYCLES_MASK;
+}
+
+#endif /* __CYCLES_H__ */
@@ -0,0 +1,107 @@
+/**
+ * @file memory.c
+ * @brief Pintado de pilas, lectura del heap y comprobación del presupuesto de SRAM.
+ */
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+
+#include "runtime/memory.h"
+
+#if PICO_ON_DEVICE
+#include <malloc.h>
+
+// Símbolos del script de enlazado por defecto del SDK
+extern uint32_t __StackBottom, __StackTop;        // Núcleo 0, en SCRATCH_Y
+extern uint32_t __StackOneBottom, __StackOneTop;  // Núcleo 1, en SCRATCH_X
+extern char end, __StackLimit;                    // Zona de heap
+#endif
+
+#define MEMORY_CHECK_BUDGET(name, w, h, frames, display) \
+	MEMORY_BUDGET_ASSERT(w, h, frames, display, MEMORY_BUDGET_FIXED);
+MEMORY_BUDGET_TABLE(MEMORY_CHECK_BUDGET)
+
+static uint32_t heap_peak;
+
+#if PICO_ON_DEVICE
+/**
+ * @brief Rellena con el patrón las palabras de [bottom, top).
+ */
+static void memory_paint(uint32_t *bottom, uint32_t *top)
+{
+	for (volatile uint32_t *p = bottom; p < top; p++) {
+		*p = MEMORY_STACK_PATTERN;
+	}
+}
+
+/**
+ * @brief Bytes de pila usados: desde la primera palabra sin patrón hasta la cima.
+ */
+static uint32_t memory_stack_used(const uint32_t *bottom, const uint32_t *top)
+{
+	const volatile uint32_t *p = bottom;
+
+	while (p < top && *p == MEMORY_STACK_PATTERN) {
+		p++;
+	}
+	return (uint32_t)((const uint8_t *)top - (const uint8_t *)p);
+}
+#endif
+
+/**
+ * @brief Pinta la zona libre de las pilas de ambos núcleos.
+ */
+void memory_init(void)
+{
+#if PICO_ON_DEVICE
+	uint32_t *sp;
+
+	// La pila del núcleo 0 solo se pinta por debajo del marco actual, con margen
+	__asm volatile("mov %0, sp" : "=r"(sp));
+	memory_paint(&__StackBottom, sp - 16);
+	memory_paint(&__StackOneBottom, &__StackOneTop);
+#endif
+	heap_peak = 0;
+}
+
+/**
+ * @brief Lee el uso actual y los máximos de pila y heap.
+ */
+void memory_read(struct memory_report *report)
+{
+#if PICO_ON_DEVICE
+	struct mallinfo info = mallinfo();
+
+	report->stack_size[0] = (uint32_t)((uint8_t *)&__StackTop - (uint8_t *)&__StackBottom);
+	report->stack_peak[0] = memory_stack_used(&__StackBottom, &__StackTop);
+	report->stack_size[1] = (uint32_t)((uint8_t *)&__StackOneTop - (uint8_t *)&__StackOneBottom);
+	report->stack_peak[1] = memory_stack_used(&__StackOneBottom, &__StackOneTop);
+
+	report->heap_size = (uint32_t)(&__StackLimit - &end);
+	report->heap_used = info.uordblks;
+	report->heap_arena = info.arena;
+	if (report->heap_used > heap_peak) {
+		heap_peak = report->heap_used;
+	}
+	report->heap_peak = heap_peak;
+#else
+	*report = (struct memory_report){ 0 };
+#endif
+}
+
+/**
+ * @brief Imprime una lectura en texto por la salida estándar.
+ */
+void memory_print(const struct memory_report *report)
+{
+	printf("--- memoria ---\n");
+	for (int c = 0; c < MEMORY_NUM_CORES; c++) {
+		printf("pila%d      %lu / %lu bytes%s\n", c, (unsigned long)report->stack_peak[c],
+		       (unsigned long)report->stack_size[c],
+		       report->stack_peak[c] >= report->stack_size[c] && report->stack_size[c] ? " (DESBORDADA)" : "");
+	}
+	printf("heap       en uso %lu, máximo %lu, arena %lu / %lu bytes\n", (unsigned long)report->heap_used,
+	       (unsigned long)report->heap_peak, (unsigned long)report->heap_arena,
+	       (unsigned long)report->heap_size);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file memory.h
+ * @brief Uso de pila de ambos núcleos y de heap, con marcas de máximo (high-water).
+ *
+ * La pila se mide por pintado: memory_init() rellena la zona libre de cada pila
+ * con un patrón y memory_read() busca la palabra más profunda que ya no lo
+ * conserva. La pila del núcleo 0 está en SCRATCH_Y y la del núcleo 1 en
+ * SCRATCH_X (mapa de memoria por defecto del SDK). El heap se mide con
+ * mallinfo() de newlib. En el host todos los valores son 0.
+ *
+ * El presupuesto de SRAM por resolución se comprueba al compilar con
+ * MEMORY_BUDGET_ASSERT() y la tabla MEMORY_BUDGET_TABLE.
+ */
+
+#ifndef __MEMORY_H__
+#define __MEMORY_H__
+
+#include <stdint.h>
+
+#define MEMORY_NUM_CORES     2                  /**< Núcleos con pila propia */
+#define MEMORY_STACK_PATTERN 0x5a5aa5a5u        /**< Patrón de pintado de pila */
+
+#define MEMORY_SRAM_MAIN     (256u * 1024)      /**< SRAM0-3 entrelazadas: .data, .bss y heap */
+#define MEMORY_SRAM_SCRATCH  (4u * 1024)        /**< SRAM4/SRAM5 (SCRATCH_X/Y): pilas, ISR y arenas */
+#define MEMORY_RESERVED      (40u * 1024)       /**< SDK, pila USB, drivers y sobrecoste de malloc */
+
+/** @brief Bytes de un frame RGB565 (2 bytes por píxel). */
+#define MEMORY_FRAME_BYTES(w, h) ((uint32_t)(w) * (h) * 2)
+
+/**
+ * @brief SRAM principal que necesita la aplicación para una resolución.
+ * @param w        Ancho de captura
+ * @param h        Alto de captura
+ * @param frames   Frames del pool
+ * @param display  1 si además se compone una imagen para la pantalla
+ * @param fixed    Estructuras de tamaño fijo (stream, métricas, histogramas...)
+ */
+#define MEMORY_APP_BYTES(w, h, frames, display, fixed) \
+	(MEMORY_FRAME_BYTES(w, h) * ((frames) + (display)) + (fixed))
+
+/**
+ * @brief Falla la compilación si la configuración no cabe en la SRAM principal.
+ */
+#define MEMORY_BUDGET_ASSERT(w, h, frames, display, fixed) \
+	_Static_assert(MEMORY_APP_BYTES(w, h, frames, display, fixed) + MEMORY_RESERVED <= MEMORY_SRAM_MAIN, \
+		       "Los buffers de " #w "x" #h " exceden la SRAM principal")
+
+/**
+ * @brief Presupuesto por resolución: nombre, ancho, alto, frames del pool y
+ * si se compone imagen para la pantalla. Cada entrada se comprueba en
+ * memory.c con MEMORY_BUDGET_FIXED como estimación de las estructuras fijas.
+ *
+ * 640x480 (VGA) no aparece: un solo frame RGB565 ya ocupa 600 KiB.
+ */
+#define MEMORY_BUDGET_TABLE(X) \
+	X(DIV8, 80, 60, 4, 1)    /* 9.4 KiB por frame */ \
+	X(DIV4, 160, 120, 4, 1)  /* 37.5 KiB por frame */ \
+	X(DIV2, 320, 240, 1, 0)  /* 150 KiB: un frame y sin copia para la pantalla */
+
+#define MEMORY_BUDGET_FIXED  (8u * 1024)        /**< Estimación de las estructuras fijas */
+
+/**
+ * @struct memory_report
+ * @brief Lectura del uso de memoria.
+ */
+struct memory_report {
+    uint32_t stack_size[MEMORY_NUM_CORES];  /**< Tamaño de la pila de cada núcleo */
+    uint32_t stack_peak[MEMORY_NUM_CORES];  /**< Máximo de pila usado desde memory_init() */
+    uint32_t heap_size;                     /**< Tamaño de la zona de heap */
+    uint32_t heap_used;                     /**< Bytes en uso ahora */
+    uint32_t heap_peak;                     /**< Máximo en uso observado en las lecturas */
+    uint32_t heap_arena;                    /**< Heap obtenido del sistema (sbrk): máximo real */
+};
+
+/**
+ * @brief Pinta la zona libre de las pilas de ambos núcleos.
+ *
+ * Debe llamarse al principio de main() en el núcleo 0 y antes de lanzar el núcleo 1.
+ */
+void memory_init(void);
+
+/**
+ * @brief Lee el uso actual y los máximos de pila y heap.
+ * @param report Lectura destino
+ */
+void memory_read(struct memory_report *report);
+
+/**
+ * @brief Imprime una lectura en texto por la salida estándar.
+ * @param report Lectura
+ */
+void memory_print(const struct memory_report *report);
+
+#endif /* __MEMORY_H__ */
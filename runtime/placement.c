@@ -0,0 +1,105 @@
+/**
+ * @file placement.c
+ * @brief Arenas en SCRATCH_X/SCRATCH_Y y prioridad de bus.
+ */
+
+#include <stdlib.h>
+
+#include "pico/stdlib.h"
+#if PICO_ON_DEVICE
+#include "hardware/structs/bus_ctrl.h"
+#endif
+
+#include "runtime/placement.h"
+
+/**
+ * @struct placement_arena
+ * @brief Arena de pila sobre un banco scratch.
+ */
+struct placement_arena {
+    uint8_t *base;  /**< Inicio del arena */
+    size_t size;    /**< Bytes del arena */
+    size_t used;    /**< Bytes reservados */
+    size_t last;    /**< Desplazamiento del último buffer reservado */
+    uint16_t live;  /**< Buffers sin liberar */
+};
+
+static uint32_t PLACEMENT_SCRATCH_X_DATA("arena") arena_x_data[PLACEMENT_SCRATCH_X_ARENA / 4];
+static uint32_t PLACEMENT_SCRATCH_Y_DATA("arena") arena_y_data[PLACEMENT_SCRATCH_Y_ARENA / 4];
+
+static struct placement_arena arenas[] = {
+	[PLACEMENT_REGION_SCRATCH_X] = { (uint8_t *)arena_x_data, sizeof(arena_x_data), 0, 0, 0 },
+	[PLACEMENT_REGION_SCRATCH_Y] = { (uint8_t *)arena_y_data, sizeof(arena_y_data), 0, 0, 0 },
+};
+
+/**
+ * @brief Prioriza el DMA en el bus o restaura la prioridad por defecto.
+ */
+void placement_bus_priority(bool dma_first)
+{
+#if PICO_ON_DEVICE
+	bus_ctrl_hw->priority = dma_first ? BUSCTRL_BUS_PRIORITY_DMA_W_BITS | BUSCTRL_BUS_PRIORITY_DMA_R_BITS : 0;
+#else
+	(void)dma_first;
+#endif
+}
+
+/**
+ * @brief Reserva en el arena sugerido o, si no cabe, en el heap.
+ * @return Buffer o NULL.
+ */
+void *placement_alloc(size_t size, enum placement_region region)
+{
+	if (region != PLACEMENT_REGION_MAIN) {
+		struct placement_arena *arena = &arenas[region];
+		size_t aligned = (size + 3) & ~(size_t)3;
+
+		if (aligned && aligned <= arena->size - arena->used) {
+			arena->last = arena->used;
+			arena->used += aligned;
+			arena->live++;
+			return arena->base + arena->last;
+		}
+	}
+
+	return malloc(size);
+}
+
+/**
+ * @brief Libera el buffer. En un arena se recupera el espacio si es el último
+ * reservado o si ya no queda ningún buffer vivo.
+ */
+void placement_free(void *ptr)
+{
+	enum placement_region region = placement_region_of(ptr);
+
+	if (region == PLACEMENT_REGION_MAIN) {
+		free(ptr);
+		return;
+	}
+
+	struct placement_arena *arena = &arenas[region];
+	if (!--arena->live) {
+		arena->used = 0;
+	} else if ((uint8_t *)ptr == arena->base + arena->last) {
+		arena->used = arena->last;
+	}
+	arena->last = arena->used;
+}
+
+/**
+ * @brief Busca el arena que contiene el buffer.
+ * @return Región del buffer.
+ */
+enum placement_region placement_region_of(const void *ptr)
+{
+	const uint8_t *p = ptr;
+
+	for (int r = PLACEMENT_REGION_SCRATCH_X; r <= PLACEMENT_REGION_SCRATCH_Y; r++) {
+		if (p >= arenas[r].base && p < arenas[r].base + arenas[r].size) {
+			return r;
+		}
+	}
+
+	return PLACEMENT_REGION_MAIN;
+}
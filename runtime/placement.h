@@ -0,0 +1,113 @@
+/**
+ * @file placement.h
+ * @brief Ubicación del código y las tablas del camino crítico fuera de la flash.
+ *
+ * El código en flash se ejecuta a través de la caché XIP y cada fallo cuesta
+ * decenas de ciclos, lo que añade variación a las ISR y a los bucles por
+ * píxel. Estas macros colocan las funciones y tablas calientes en SRAM, usando
+ * las secciones que el script de enlazado por defecto del SDK ya copia a RAM
+ * al arrancar:
+ *
+ * - PLACEMENT_RAM(f): .time_critical.f, en la SRAM principal entrelazada.
+ * - PLACEMENT_SCRATCH(f): .scratch_x.f, en SRAM4 (SCRATCH_X), un banco que no
+ *   comparte el DMA de la cámara; para ISR cortas. Comparte banco con la pila
+ *   del núcleo 1, así que solo debe usarse para funciones pequeñas.
+ * - PLACEMENT_RAM_DATA(g): tablas constantes que deben leerse desde SRAM.
+ *
+ * Los buffers se reservan con una sugerencia de región (placement_alloc): la
+ * SRAM principal entrelazada (SRAM0-3, heap), donde escriben el DMA de captura
+ * y lee el DMA del SPI, o los arenas de SCRATCH_X/SCRATCH_Y para buffers de
+ * línea pequeños que solo usa la CPU. Un buffer de scratch nunca compite en el
+ * bus con los DMA, que trabajan en la SRAM principal. Si el arena está lleno se
+ * usa el heap.
+ *
+ * Con PLACEMENT_HOT_IN_RAM a 0 (opción MINIVISION_HOT_IN_RAM=OFF) todo queda
+ * en flash, para comparar jitter y tiempos con y sin la ubicación. En el host
+ * las macros no tienen efecto.
+ */
+
+#ifndef __PLACEMENT_H__
+#define __PLACEMENT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "pico/stdlib.h"
+
+#ifndef PLACEMENT_HOT_IN_RAM
+#define PLACEMENT_HOT_IN_RAM 1
+#endif
+
+#if PICO_ON_DEVICE && PLACEMENT_HOT_IN_RAM
+#define PLACEMENT_RAM(func_name)      __not_in_flash_func(func_name)
+#define PLACEMENT_SCRATCH(func_name)  __scratch_x(#func_name) func_name
+#define PLACEMENT_RAM_DATA(group)     __not_in_flash(group)
+#else
+#define PLACEMENT_RAM(func_name)      func_name
+#define PLACEMENT_SCRATCH(func_name)  func_name
+#define PLACEMENT_RAM_DATA(group)
+#endif
+
+#if PICO_ON_DEVICE
+#define PLACEMENT_SCRATCH_X_DATA(group) __scratch_x(group)  /**< Datos en SRAM4 */
+#define PLACEMENT_SCRATCH_Y_DATA(group) __scratch_y(group)  /**< Datos en SRAM5 */
+#else
+#define PLACEMENT_SCRATCH_X_DATA(group)
+#define PLACEMENT_SCRATCH_Y_DATA(group)
+#endif
+
+/*
+ * Cada banco scratch mide 4 KiB y su mitad superior es la pila de un núcleo
+ * (núcleo 1 en SCRATCH_X, núcleo 0 en SCRATCH_Y); en SCRATCH_X quedan además
+ * las ISR ubicadas con PLACEMENT_SCRATCH.
+ */
+#define PLACEMENT_SCRATCH_X_ARENA 1024  /**< Bytes del arena en SCRATCH_X */
+#define PLACEMENT_SCRATCH_Y_ARENA 1024  /**< Bytes del arena en SCRATCH_Y */
+
+/**
+ * @enum placement_region
+ * @brief Región sugerida para un buffer.
+ */
+enum placement_region {
+    PLACEMENT_REGION_MAIN = 0,   /**< SRAM principal entrelazada (heap) */
+    PLACEMENT_REGION_SCRATCH_X,  /**< Arena en SRAM4 */
+    PLACEMENT_REGION_SCRATCH_Y,  /**< Arena en SRAM5 */
+};
+
+/**
+ * @brief Da prioridad en el bus a las lecturas y escrituras del DMA.
+ *
+ * Con la CPU ejecutando kernels sobre la SRAM principal, la captura por DMA
+ * no debe perder ciclos de bus: un retraso del DMA desborda la FIFO del PIO.
+ *
+ * @param dma_first true para priorizar el DMA, false para la prioridad por defecto
+ */
+void placement_bus_priority(bool dma_first);
+
+/**
+ * @brief Reserva un buffer en la región sugerida.
+ *
+ * Los arenas de scratch son de pila: placement_free recupera el último buffer
+ * reservado en cada uno, o el arena entero cuando se liberan todos. Si la región sugerida no tiene sitio se usa
+ * el heap.
+ *
+ * @param size   Bytes
+ * @param region Región sugerida
+ * @return Buffer alineado a 4 bytes, o NULL si no hay memoria
+ */
+void *placement_alloc(size_t size, enum placement_region region);
+
+/**
+ * @brief Libera un buffer de placement_alloc.
+ * @param ptr Buffer (puede ser NULL)
+ */
+void placement_free(void *ptr);
+
+/**
+ * @brief Región en la que está un buffer.
+ * @param ptr Buffer
+ * @return Región del buffer
+ */
+enum placement_region placement_region_of(const void *ptr);
+
+#endif /* __PLACEMENT_H__ */
@@ -0,0 +1,98 @@
+/**
+ * @file pool.c
+ * @brief Implementación del pool fijo de frames.
+ */
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#include "camera/format.h"
+#include "runtime/pool.h"
+
+/**
+ * @brief Reserva los planos de todos los frames del pool.
+ * @return 0 en éxito, -1 en error.
+ */
+int frame_pool_init(struct frame_pool *pool, uint8_t n_frames, uint32_t format, uint16_t width, uint16_t height,
+		    enum placement_region region)
+{
+	*pool = (struct frame_pool){ 0 };
+
+	uint8_t num_planes = format_num_planes(format);
+	if (!n_frames || n_frames > POOL_MAX_FRAMES || !num_planes) {
+		return -1;
+	}
+
+	for (int f = 0; f < n_frames; f++) {
+		struct camera_buffer *buf = &pool->frames[f].buf;
+
+		*buf = (struct camera_buffer){
+			.format = format,
+			.width = width,
+			.height = height,
+		};
+
+		for (int i = 0; i < num_planes; i++) {
+			buf->strides[i] = format_stride(format, i, width);
+			buf->sizes[i] = format_plane_size(format, i, width, height);
+			buf->data[i] = placement_alloc(buf->sizes[i], region);
+			if (!buf->data[i]) {
+				pool->n_frames = f + 1;
+				frame_pool_term(pool);
+				return -1;
+			}
+		}
+	}
+
+	pool->n_frames = n_frames;
+
+	return 0;
+}
+
+/**
+ * @brief Libera los planos de todos los frames del pool.
+ */
+void frame_pool_term(struct frame_pool *pool)
+{
+	for (int f = 0; f < pool->n_frames; f++) {
+		struct camera_buffer *buf = &pool->frames[f].buf;
+		for (int i = 0; i < CAMERA_MAX_N_PLANES; i++) {
+			if (buf->data[i]) {
+				placement_free(buf->data[i]);
+				buf->data[i] = NULL;
+			}
+		}
+	}
+
+	pool->n_frames = 0;
+}
+
+/**
+ * @brief Obtiene el primer frame libre.
+ * @return Frame libre o NULL.
+ */
+struct pool_frame *frame_pool_acquire(struct frame_pool *pool)
+{
+	struct pool_frame *frame = NULL;
+
+	uint32_t irq_state = save_and_disable_interrupts();
+	for (int f = 0; f < pool->n_frames; f++) {
+		if (!pool->frames[f].in_use) {
+			frame = &pool->frames[f];
+			frame->in_use = true;
+			break;
+		}
+	}
+	restore_interrupts(irq_state);
+
+	return frame;
+}
+
+/**
+ * @brief Marca un frame como libre.
+ */
+void frame_pool_release(struct frame_pool *pool, struct pool_frame *frame)
+{
+	(void)pool;
+	frame->in_use = false;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file pool.h
+ * @brief Pool fijo de frames preasignados para captura, inyección y procesamiento.
+ *
+ * Todos los frames de un pool comparten formato y tamaño. Los buffers se
+ * reservan una sola vez en frame_pool_init, de modo que el bucle principal no
+ * asigna memoria ni usa arreglos en la pila. La región de los buffers se
+ * elige con una sugerencia de placement_alloc (ver runtime/placement.h).
+ */
+
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "camera/camera.h"
+#include "runtime/placement.h"
+
+#define POOL_MAX_FRAMES 4  /**< Máximo de frames por pool */
+
+/**
+ * @enum pool_source
+ * @brief Origen de los datos de un frame.
+ */
+enum pool_source {
+    POOL_SOURCE_CAMERA = 0,  /**< Capturado por la cámara */
+    POOL_SOURCE_INJECTED,    /**< Inyectado desde el host por USB */
+};
+
+/**
+ * @struct pool_frame
+ * @brief Frame del pool con sus metadatos.
+ */
+struct pool_frame {
+    struct camera_buffer buf;         /**< Buffer de imagen */
+    uint32_t seq;                     /**< Número de secuencia */
+    uint32_t timestamp_us;            /**< Marca de tiempo de captura/recepción */
+    uint8_t source;                   /**< Origen (pool_source) */
+    struct camera_exposure exposure;  /**< Exposición con la que se capturó (aec = 0: automática o desconocida) */
+    volatile bool in_use;             /**< Frame entregado a un consumidor */
+};
+
+/**
+ * @struct frame_pool
+ * @brief Conjunto de frames reutilizables.
+ */
+struct frame_pool {
+    struct pool_frame frames[POOL_MAX_FRAMES];  /**< Frames del pool */
+    uint8_t n_frames;                           /**< Frames válidos */
+};
+
+/**
+ * @brief Reserva los buffers de un pool.
+ * @param pool     Puntero al pool
+ * @param n_frames Número de frames (<= POOL_MAX_FRAMES)
+ * @param format   Formato de los frames
+ * @param width    Ancho en píxeles
+ * @param height   Alto en píxeles
+ * @param region   Región sugerida para los buffers
+ * @return 0 en éxito, -1 en error (memoria insuficiente o parámetros inválidos)
+ */
+int frame_pool_init(struct frame_pool *pool, uint8_t n_frames, uint32_t format, uint16_t width, uint16_t height,
+                    enum placement_region region);
+
+/**
+ * @brief Libera los buffers de un pool.
+ * @param pool Puntero al pool
+ */
+void frame_pool_term(struct frame_pool *pool);
+
+/**
+ * @brief Obtiene un frame libre del pool.
+ * @param pool Puntero al pool
+ * @return Frame libre, o NULL si todos están en uso
+ */
+struct pool_frame *frame_pool_acquire(struct frame_pool *pool);
+
+/**
+ * @brief Devuelve un frame al pool.
+ * @param pool  Puntero al pool
+ * @param frame Frame a liberar
+ */
+void frame_pool_release(struct frame_pool *pool, struct pool_frame *frame);
+
+#endif /* __POOL_H__ */
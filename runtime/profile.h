@@ -0,0 +1,55 @@
+/**
+ * @file profile.h
+ * @brief Perfilado por etapas del pipeline de procesamiento de frames.
+ */
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include <stdint.h>
+
+#include "runtime/cycles.h"
+
+/**
+ * @enum profile_stage
+ * @brief Etapas del pipeline. El orden es parte del protocolo de stream
+ * (paquete STREAM_PKT_STAGES) y debe coincidir con host/inject.py.
+ */
+enum profile_stage {
+    PROFILE_STAGE_INPUT = 0,   /**< Captura o recepción del frame */
+    PROFILE_STAGE_ANALYTICS,   /**< Kernels de analítica */
+    PROFILE_STAGE_OUTPUT,      /**< Envío de resultados / visualización */
+    PROFILE_STAGE_COUNT,
+};
+
+/**
+ * @struct profile
+ * @brief Ciclos acumulados por etapa para un frame.
+ */
+struct profile {
+    uint32_t last;                          /**< Lectura del contador al cerrar la última etapa */
+    uint32_t cycles[PROFILE_STAGE_COUNT];   /**< Ciclos por etapa */
+};
+
+/**
+ * @brief Reinicia el perfil y marca el comienzo de la primera etapa.
+ * @param profile Puntero al perfil
+ */
+static inline void profile_begin(struct profile *profile)
+{
+	*profile = (struct profile){ .last = cycles_now() };
+}
+
+/**
+ * @brief Cierra una etapa: le atribuye los ciclos desde la marca anterior.
+ * @param profile Puntero al perfil
+ * @param stage   Etapa que termina
+ */
+static inline void profile_mark(struct profile *profile, enum profile_stage stage)
+{
+	uint32_t now = cycles_now();
+	profile->cycles[stage] += cycles_elapsed(profile->last, now);
+	profile->last = now;
+}
+
+#endif /* __PROFILE_H__ */
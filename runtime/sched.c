@@ -0,0 +1,181 @@
+/**
+ * @file sched.c
+ * @brief Implementación del planificador cooperativo por eventos.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#include "runtime/placement.h"
+#include "runtime/sched.h"
+
+/**
+ * @brief Inicializa el planificador.
+ */
+void sched_init(struct sched *sched, struct stats *stats)
+{
+	memset(sched, 0, sizeof(*sched));
+	sched->stats = stats;
+}
+
+/**
+ * @brief Registra una tarea manteniendo el orden por prioridad.
+ * @return 0 en éxito, -1 si no caben más tareas.
+ */
+int sched_add(struct sched *sched, const char *name, uint32_t events, uint8_t priority, uint32_t deadline_us,
+	      sched_task_fn run, void *ctx)
+{
+	if (sched->n_tasks >= SCHED_MAX_TASKS || !run) {
+		return -1;
+	}
+
+	int i = sched->n_tasks++;
+	while (i > 0 && sched->tasks[i - 1].priority < priority) {
+		sched->tasks[i] = sched->tasks[i - 1];
+		i--;
+	}
+
+	sched->tasks[i] = (struct sched_task){
+		.name = name,
+		.run = run,
+		.ctx = ctx,
+		.events = events,
+		.priority = priority,
+		.deadline_us = deadline_us,
+	};
+	sched->handled |= events;
+
+	return 0;
+}
+
+/**
+ * @brief Publica eventos y despierta al núcleo.
+ */
+void PLACEMENT_RAM(sched_post)(struct sched *sched, uint32_t events)
+{
+	events &= sched->handled;
+	if (!events) {
+		return;
+	}
+
+	uint32_t now = time_us_32();
+	uint32_t irq_state = save_and_disable_interrupts();
+
+	// El plazo cuenta desde la primera publicación aún no consumida
+	uint32_t fresh = events & ~sched->pending;
+	for (int e = 0; fresh; e++, fresh >>= 1) {
+		if (fresh & 1) {
+			sched->post_us[e] = now;
+		}
+	}
+	sched->pending |= events;
+
+	restore_interrupts(irq_state);
+	__sev();
+}
+
+/**
+ * @brief Consume atómicamente los eventos pendientes de una máscara.
+ */
+static uint32_t sched_take(struct sched *sched, uint32_t mask, uint32_t *posted_us)
+{
+	uint32_t irq_state = save_and_disable_interrupts();
+	uint32_t events = sched->pending & mask;
+	uint32_t oldest = 0;
+	bool first = true;
+
+	for (int e = 0; e < SCHED_MAX_EVENTS; e++) {
+		if ((events & SCHED_EVENT(e)) && (first || (int32_t)(sched->post_us[e] - oldest) < 0)) {
+			oldest = sched->post_us[e];
+			first = false;
+		}
+	}
+	sched->pending &= ~events;
+
+	restore_interrupts(irq_state);
+	*posted_us = oldest;
+	return events;
+}
+
+/**
+ * @brief Ejecuta las tareas listas o, si no hay ninguna, duerme hasta el próximo evento.
+ *
+ * Tras ejecutar una tarea se vuelve a empezar por la de mayor prioridad, de
+ * modo que los eventos publicados mientras tanto se atienden en orden.
+ */
+void sched_run_once(struct sched *sched)
+{
+	for (int i = 0; i < sched->n_tasks; i++) {
+		struct sched_task *task = &sched->tasks[i];
+		if (!(sched->pending & task->events)) {
+			continue;
+		}
+
+		uint32_t posted_us;
+		uint32_t events = sched_take(sched, task->events, &posted_us);
+		if (!events) {
+			continue;
+		}
+
+		uint32_t start = time_us_32();
+#if XIP_PROFILE
+		xip_site_begin();
+		task->run(task->ctx, events);
+		xip_site_end(&task->xip);
+#else
+		task->run(task->ctx, events);
+#endif
+		uint32_t end = time_us_32();
+
+		task->runs++;
+		if (end - start > task->max_us) {
+			task->max_us = end - start;
+		}
+		if (task->deadline_us && end - posted_us > task->deadline_us) {
+			task->overruns++;
+		}
+		return;
+	}
+
+	// Si una ISR publica entre la comprobación y __wfe(), su __sev() hace que __wfe() vuelva enseguida
+	if (sched->stats) {
+		stats_idle_begin(sched->stats);
+	}
+	if (!(sched->pending & sched->handled)) {
+		__wfe();
+	}
+	if (sched->stats) {
+		stats_idle_end(sched->stats);
+	}
+}
+
+/**
+ * @brief Bucle principal del planificador.
+ */
+void sched_run(struct sched *sched)
+{
+	while (1) {
+		sched_run_once(sched);
+	}
+}
+
+/**
+ * @brief Imprime los contadores de cada tarea.
+ */
+void sched_print(const struct sched *sched)
+{
+	printf("--- tareas ---\n");
+	for (int i = 0; i < sched->n_tasks; i++) {
+		const struct sched_task *task = &sched->tasks[i];
+		printf("%-10s prio=%u ejecuciones=%lu max=%luus plazo=%luus incumplidos=%lu\n", task->name,
+		       task->priority, (unsigned long)task->runs, (unsigned long)task->max_us,
+		       (unsigned long)task->deadline_us, (unsigned long)task->overruns);
+#if XIP_PROFILE
+		// Los fallos de caché señalan código caliente que aún se ejecuta desde la flash
+		xip_site_print("", &task->xip);
+#endif
+	}
+}
@@ -0,0 +1,121 @@
+/**
+ * @file sched.h
+ * @brief Planificador cooperativo por eventos, de ejecución hasta completar.
+ *
+ * Las ISR (fin de frame, botón, temporizadores, datos USB) y las propias
+ * tareas publican eventos con sched_post(), que solo pone un bit y despierta
+ * al núcleo con __sev(). sched_run() ejecuta, por orden de prioridad, las
+ * tareas cuyos eventos están pendientes; cada tarea corre hasta terminar y
+ * recibe los eventos que la activaron. Si no hay nada pendiente el núcleo
+ * duerme en __wfe() y el tiempo dormido se cuenta como ocioso en las métricas.
+ *
+ * Cada tarea puede declarar un plazo: tiempo máximo desde que se publica el
+ * primero de sus eventos hasta que termina. Los incumplimientos se cuentan.
+ * El planificador es de un solo núcleo; sched_post() sí puede llamarse desde
+ * cualquier contexto de ese núcleo.
+ */
+
+#ifndef __SCHED_H__
+#define __SCHED_H__
+
+#include <stdint.h>
+
+#include "runtime/stats.h"
+#include "runtime/xip.h"
+
+#define SCHED_MAX_TASKS  8   /**< Máximo de tareas registradas */
+#define SCHED_MAX_EVENTS 32  /**< Eventos distintos (bits de un uint32_t) */
+
+/** @brief Máscara de un evento a partir de su número. */
+#define SCHED_EVENT(n) (1u << (n))
+
+/**
+ * @brief Cuerpo de una tarea.
+ * @param ctx    Contexto de la tarea
+ * @param events Eventos pendientes que la activaron (ya consumidos)
+ */
+typedef void (*sched_task_fn)(void *ctx, uint32_t events);
+
+/**
+ * @struct sched_task
+ * @brief Tarea registrada con sus contadores.
+ */
+struct sched_task {
+    const char *name;       /**< Nombre para los informes */
+    sched_task_fn run;      /**< Cuerpo */
+    void *ctx;              /**< Contexto */
+    uint32_t events;        /**< Eventos que la activan */
+    uint8_t priority;       /**< Mayor valor, antes se ejecuta */
+    uint32_t deadline_us;   /**< Plazo desde la publicación (0 = sin plazo) */
+    uint32_t runs;          /**< Ejecuciones */
+    uint32_t overruns;      /**< Plazos incumplidos */
+    uint32_t max_us;        /**< Mayor tiempo de ejecución */
+#if XIP_PROFILE
+    struct xip_site xip;    /**< Accesos a la caché XIP durante la tarea */
+#endif
+};
+
+/**
+ * @struct sched
+ * @brief Estado del planificador.
+ */
+struct sched {
+    volatile uint32_t pending;               /**< Eventos publicados sin consumir */
+    uint32_t handled;                        /**< Eventos que activa alguna tarea registrada */
+    uint32_t post_us[SCHED_MAX_EVENTS];      /**< Instante de publicación de cada evento pendiente */
+    struct sched_task tasks[SCHED_MAX_TASKS]; /**< Tareas ordenadas por prioridad */
+    uint8_t n_tasks;                         /**< Tareas registradas */
+    struct stats *stats;                     /**< Métricas donde contar el tiempo ocioso (puede ser NULL) */
+};
+
+/**
+ * @brief Inicializa el planificador.
+ * @param sched Puntero al planificador
+ * @param stats Métricas para la contabilidad de tiempo ocioso (puede ser NULL)
+ */
+void sched_init(struct sched *sched, struct stats *stats);
+
+/**
+ * @brief Registra una tarea.
+ * @param sched       Puntero al planificador
+ * @param name        Nombre de la tarea
+ * @param events      Eventos que la activan
+ * @param priority    Prioridad (mayor valor, antes)
+ * @param deadline_us Plazo en microsegundos (0 = sin plazo)
+ * @param run         Cuerpo de la tarea
+ * @param ctx         Contexto de la tarea
+ * @return 0 en éxito, -1 si no caben más tareas
+ */
+int sched_add(struct sched *sched, const char *name, uint32_t events, uint8_t priority, uint32_t deadline_us,
+              sched_task_fn run, void *ctx);
+
+/**
+ * @brief Publica eventos. Puede llamarse desde una ISR.
+ *
+ * Los eventos que no activa ninguna tarea registrada se descartan: quedarían
+ * pendientes para siempre y el núcleo no volvería a dormir.
+ *
+ * @param sched  Puntero al planificador
+ * @param events Máscara de eventos
+ */
+void sched_post(struct sched *sched, uint32_t events);
+
+/**
+ * @brief Ejecuta las tareas listas o, si no hay ninguna, duerme hasta el próximo evento.
+ * @param sched Puntero al planificador
+ */
+void sched_run_once(struct sched *sched);
+
+/**
+ * @brief Bucle principal: ejecuta sched_run_once() indefinidamente.
+ * @param sched Puntero al planificador
+ */
+void sched_run(struct sched *sched) __attribute__((noreturn));
+
+/**
+ * @brief Imprime los contadores de cada tarea por la salida estándar.
+ * @param sched Puntero al planificador
+ */
+void sched_print(const struct sched *sched);
+
+#endif /* __SCHED_H__ */
@@ -0,0 +1,257 @@
+/**
+ * @file stats.c
+ * @brief Implementación de las métricas de ejecución por ventanas.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#include "runtime/stats.h"
+
+/**
+ * @brief Vacía un histograma.
+ */
+static void stats_hist_reset(struct stats_hist *hist)
+{
+	memset(hist, 0, sizeof(*hist));
+	hist->min = UINT32_MAX;
+}
+
+/**
+ * @brief Vacía los contadores de la ventana en curso.
+ */
+static void stats_window_reset(struct stats *stats, uint32_t now)
+{
+	uint32_t total_frames = stats->cur.total_frames;
+	uint32_t total_dropped = stats->cur.total_dropped;
+
+	memset(&stats->cur, 0, sizeof(stats->cur));
+	stats->cur.total_frames = total_frames;
+	stats->cur.total_dropped = total_dropped;
+	stats_hist_reset(&stats->cur.latency);
+	for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+		stats_hist_reset(&stats->cur.stages[i]);
+	}
+	memset(stats->idle_us, 0, sizeof(stats->idle_us));
+	memset(stats->busy_us, 0, sizeof(stats->busy_us));
+	stats->window_start_us = now;
+}
+
+/**
+ * @brief Inicializa las métricas y abre la primera ventana.
+ */
+void stats_init(struct stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats_window_reset(stats, time_us_32());
+	stats->last = stats->cur;
+}
+
+/**
+ * @brief Tanto por mil de una duración respecto a la ventana, saturado a 1000.
+ */
+static uint16_t stats_permille(uint32_t part_us, uint32_t window_us)
+{
+	uint32_t v = (uint32_t)((uint64_t)part_us * 1000 / window_us);
+	return v > 1000 ? 1000 : v;
+}
+
+/**
+ * @brief Cierra la ventana si ha vencido y publica su instantánea.
+ *
+ * Las esperas y usos abiertos se reparten entre la ventana que se cierra y la
+ * siguiente.
+ *
+ * @return true si se publicó una instantánea nueva.
+ */
+bool stats_poll(struct stats *stats)
+{
+	uint32_t now = time_us_32();
+	uint32_t window_us = now - stats->window_start_us;
+
+	if (window_us < STATS_WINDOW_US) {
+		return false;
+	}
+
+	for (int c = 0; c < STATS_NUM_CORES; c++) {
+		if (stats->idle_active[c]) {
+			stats->idle_us[c] += now - stats->idle_start_us[c];
+			stats->idle_start_us[c] = now;
+		}
+		// Sin trabajo ni esperas registradas el núcleo está parado
+		uint32_t idle = stats->idle_us[c];
+		if (c != get_core_num() && !stats->idle_active[c] && !idle) {
+			idle = window_us;
+		}
+		stats->cur.load_x1000[c] = 1000 - stats_permille(idle, window_us);
+	}
+
+	for (int r = 0; r < STATS_BUSY_COUNT; r++) {
+		if (stats->busy_active[r]) {
+			stats->busy_us[r] += now - stats->busy_start_us[r];
+			stats->busy_start_us[r] = now;
+		}
+		stats->cur.busy_x1000[r] = stats_permille(stats->busy_us[r], window_us);
+	}
+
+	stats->cur.window_us = window_us;
+	stats->cur.fps_x100 = (uint32_t)(((uint64_t)stats->cur.frames * 100000000u + window_us / 2) / window_us);
+	stats->last = stats->cur;
+	stats->windows++;
+
+	stats_window_reset(stats, now);
+	return true;
+}
+
+/**
+ * @brief Añade una muestra a un histograma.
+ */
+void stats_hist_add(struct stats_hist *hist, uint32_t value)
+{
+	int bucket = 0;
+	for (uint32_t v = value >> 1; v && bucket < STATS_HIST_BUCKETS - 1; v >>= 1) {
+		bucket++;
+	}
+
+	if (hist->buckets[bucket] < UINT16_MAX) {
+		hist->buckets[bucket]++;
+	}
+	hist->count++;
+	hist->sum = hist->sum > UINT32_MAX - value ? UINT32_MAX : hist->sum + value;
+	if (value < hist->min) {
+		hist->min = value;
+	}
+	if (value > hist->max) {
+		hist->max = value;
+	}
+}
+
+/**
+ * @brief Media de un histograma.
+ */
+uint32_t stats_hist_mean(const struct stats_hist *hist)
+{
+	return hist->count ? hist->sum / hist->count : 0;
+}
+
+/**
+ * @brief Registra un frame procesado con sus ciclos por etapa.
+ */
+void stats_frame(struct stats *stats, const struct profile *profile)
+{
+	stats->cur.frames++;
+	stats->cur.total_frames++;
+
+	if (profile) {
+		for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+			stats_hist_add(&stats->cur.stages[i], profile->cycles[i]);
+		}
+	}
+}
+
+/**
+ * @brief Registra un frame perdido.
+ */
+void stats_drop(struct stats *stats)
+{
+	stats->cur.dropped++;
+	stats->cur.total_dropped++;
+}
+
+/**
+ * @brief Registra la latencia ISR -> pipeline de un frame.
+ */
+void stats_latency(struct stats *stats, uint32_t latency_us)
+{
+	stats_hist_add(&stats->cur.latency, latency_us);
+}
+
+/**
+ * @brief Marca el comienzo de una espera ociosa del núcleo actual.
+ */
+void stats_idle_begin(struct stats *stats)
+{
+	uint core = get_core_num();
+
+	stats->idle_start_us[core] = time_us_32();
+	stats->idle_active[core] = true;
+}
+
+/**
+ * @brief Marca el fin de la espera ociosa del núcleo actual.
+ */
+void stats_idle_end(struct stats *stats)
+{
+	uint core = get_core_num();
+
+	if (stats->idle_active[core]) {
+		stats->idle_us[core] += time_us_32() - stats->idle_start_us[core];
+		stats->idle_active[core] = false;
+	}
+}
+
+/**
+ * @brief Marca el comienzo del uso de un recurso.
+ */
+void stats_busy_begin(struct stats *stats, enum stats_busy resource)
+{
+	stats->busy_start_us[resource] = time_us_32();
+	stats->busy_active[resource] = true;
+}
+
+/**
+ * @brief Marca el fin del uso de un recurso.
+ */
+void stats_busy_end(struct stats *stats, enum stats_busy resource)
+{
+	if (stats->busy_active[resource]) {
+		stats->busy_us[resource] += time_us_32() - stats->busy_start_us[resource];
+		stats->busy_active[resource] = false;
+	}
+}
+
+/**
+ * @brief Imprime un histograma en una línea: muestras, mínimo, media, máximo y cubetas no vacías.
+ */
+static void stats_print_hist(const char *name, const char *unit, const struct stats_hist *hist)
+{
+	if (!hist->count) {
+		printf("%-10s sin muestras\n", name);
+		return;
+	}
+
+	printf("%-10s n=%lu min=%lu mean=%lu max=%lu %s |", name, (unsigned long)hist->count,
+	       (unsigned long)hist->min, (unsigned long)stats_hist_mean(hist), (unsigned long)hist->max, unit);
+	for (int i = 0; i < STATS_HIST_BUCKETS; i++) {
+		if (hist->buckets[i]) {
+			printf(" <%lu:%u", 2ul << i, hist->buckets[i]);
+		}
+	}
+	printf("\n");
+}
+
+/**
+ * @brief Imprime una instantánea en texto por la salida estándar.
+ */
+void stats_print(const struct stats_snapshot *snap)
+{
+	static const char *const busy_names[STATS_BUSY_COUNT] = { "dma", "spi" };
+
+	printf("--- stats (%lu ms) ---\n", (unsigned long)(snap->window_us / 1000));
+	printf("fps        %lu.%02lu  frames=%lu perdidos=%lu (total %lu/%lu)\n",
+	       (unsigned long)(snap->fps_x100 / 100), (unsigned long)(snap->fps_x100 % 100),
+	       (unsigned long)snap->frames, (unsigned long)snap->dropped,
+	       (unsigned long)snap->total_frames, (unsigned long)snap->total_dropped);
+	for (int c = 0; c < STATS_NUM_CORES; c++) {
+		printf("cpu%d       %u.%u%%\n", c, snap->load_x1000[c] / 10, snap->load_x1000[c] % 10);
+	}
+	for (int r = 0; r < STATS_BUSY_COUNT; r++) {
+		printf("%-10s %u.%u%%\n", busy_names[r], snap->busy_x1000[r] / 10, snap->busy_x1000[r] % 10);
+	}
+	stats_print_hist("latencia", "us", &snap->latency);
+	stats_print_hist("entrada", "ciclos", &snap->stages[PROFILE_STAGE_INPUT]);
+	stats_print_hist("analitica", "ciclos", &snap->stages[PROFILE_STAGE_ANALYTICS]);
+	stats_print_hist("salida", "ciclos", &snap->stages[PROFILE_STAGE_OUTPUT]);
+}
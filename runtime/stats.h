@@ -0,0 +1,163 @@
+/**
+ * @file stats.h
+ * @brief Métricas de ejecución: fps, frames perdidos, latencia, carga de CPU y ocupación de DMA/SPI.
+ *
+ * Los contadores se acumulan en una ventana de STATS_WINDOW_US; al cerrarla,
+ * stats_poll() publica una instantánea (struct stats_snapshot) que puede
+ * consultarse por USB o dibujarse sobre la imagen. Los tiempos son
+ * microsegundos de time_us_32(), salvo las etapas del pipeline, que se
+ * guardan en ciclos de runtime/cycles.h como en runtime/profile.h.
+ *
+ * La carga de CPU se obtiene contando el tiempo que cada núcleo pasa en sus
+ * esperas (stats_idle_begin()/stats_idle_end()); un núcleo que no registra
+ * esperas ni trabajo, como el núcleo 1 mientras no se lanza, cuenta como inactivo.
+ */
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "runtime/profile.h"
+
+#define STATS_WINDOW_US     1000000  /**< Duración de la ventana de métricas */
+#define STATS_NUM_CORES     2        /**< Núcleos del RP2040 */
+#define STATS_HIST_BUCKETS  24       /**< Cubetas log2: [0,1], [2,3], [4,7]... hasta 2^23 o más */
+
+/**
+ * @enum stats_busy
+ * @brief Recursos cuya ocupación se mide.
+ */
+enum stats_busy {
+    STATS_BUSY_DMA = 0,  /**< DMA de captura de la cámara */
+    STATS_BUSY_SPI,      /**< Transferencias SPI a la pantalla */
+    STATS_BUSY_COUNT,
+};
+
+/**
+ * @struct stats_hist
+ * @brief Histograma logarítmico con mínimo, máximo y suma.
+ */
+struct stats_hist {
+    uint32_t count;                         /**< Muestras */
+    uint32_t min;                           /**< Mínimo (UINT32_MAX si no hay muestras) */
+    uint32_t max;                           /**< Máximo */
+    uint32_t sum;                           /**< Suma (satura en UINT32_MAX) */
+    uint16_t buckets[STATS_HIST_BUCKETS];   /**< Cubeta i: valores menores que 2^(i+1) */
+};
+
+/**
+ * @struct stats_snapshot
+ * @brief Métricas de la última ventana completa.
+ */
+struct stats_snapshot {
+    uint32_t window_us;                       /**< Duración real de la ventana */
+    uint32_t frames;                          /**< Frames procesados en la ventana */
+    uint32_t dropped;                         /**< Frames perdidos en la ventana */
+    uint32_t total_frames;                    /**< Frames procesados desde el arranque */
+    uint32_t total_dropped;                   /**< Frames perdidos desde el arranque */
+    uint32_t fps_x100;                        /**< Frames por segundo x100 */
+    uint16_t load_x1000[STATS_NUM_CORES];     /**< Carga de cada núcleo en tanto por mil */
+    uint16_t busy_x1000[STATS_BUSY_COUNT];    /**< Ocupación de cada recurso en tanto por mil */
+    struct stats_hist latency;                /**< Fin de frame en la ISR -> pipeline (us) */
+    struct stats_hist stages[PROFILE_STAGE_COUNT]; /**< Ciclos por etapa del pipeline */
+};
+
+/**
+ * @struct stats
+ * @brief Estado de las métricas: ventana en curso y última instantánea publicada.
+ */
+struct stats {
+    uint32_t window_start_us;                   /**< Inicio de la ventana en curso */
+    uint32_t idle_start_us[STATS_NUM_CORES];    /**< Inicio de la espera en curso por núcleo */
+    uint32_t busy_start_us[STATS_BUSY_COUNT];   /**< Inicio del uso en curso por recurso */
+    bool idle_active[STATS_NUM_CORES];          /**< Núcleo en espera (cada núcleo escribe solo el suyo) */
+    bool busy_active[STATS_BUSY_COUNT];         /**< Recurso ocupado */
+    uint32_t idle_us[STATS_NUM_CORES];          /**< Espera acumulada en la ventana */
+    uint32_t busy_us[STATS_BUSY_COUNT];         /**< Ocupación acumulada en la ventana */
+    struct stats_snapshot cur;                  /**< Contadores de la ventana en curso */
+    struct stats_snapshot last;                 /**< Última ventana completa */
+    uint32_t windows;                           /**< Ventanas publicadas */
+};
+
+/**
+ * @brief Inicializa las métricas y abre la primera ventana.
+ * @param stats Puntero a las métricas
+ */
+void stats_init(struct stats *stats);
+
+/**
+ * @brief Cierra la ventana si ha vencido y publica su instantánea.
+ * @param stats Puntero a las métricas
+ * @return true si se publicó una instantánea nueva en stats->last
+ */
+bool stats_poll(struct stats *stats);
+
+/**
+ * @brief Registra un frame procesado con sus ciclos por etapa.
+ * @param stats   Puntero a las métricas
+ * @param profile Perfil del frame (NULL si no se perfiló)
+ */
+void stats_frame(struct stats *stats, const struct profile *profile);
+
+/**
+ * @brief Registra un frame perdido (error de captura, pool agotado o enlace saturado).
+ * @param stats Puntero a las métricas
+ */
+void stats_drop(struct stats *stats);
+
+/**
+ * @brief Registra la latencia entre el fin de frame señalado por la ISR y su recogida.
+ * @param stats      Puntero a las métricas
+ * @param latency_us Latencia en microsegundos
+ */
+void stats_latency(struct stats *stats, uint32_t latency_us);
+
+/**
+ * @brief Marca el comienzo de una espera ociosa del núcleo actual.
+ * @param stats Puntero a las métricas
+ */
+void stats_idle_begin(struct stats *stats);
+
+/**
+ * @brief Marca el fin de la espera ociosa del núcleo actual.
+ * @param stats Puntero a las métricas
+ */
+void stats_idle_end(struct stats *stats);
+
+/**
+ * @brief Marca el comienzo del uso de un recurso.
+ * @param stats    Puntero a las métricas
+ * @param resource Recurso
+ */
+void stats_busy_begin(struct stats *stats, enum stats_busy resource);
+
+/**
+ * @brief Marca el fin del uso de un recurso.
+ * @param stats    Puntero a las métricas
+ * @param resource Recurso
+ */
+void stats_busy_end(struct stats *stats, enum stats_busy resource);
+
+/**
+ * @brief Añade una muestra a un histograma.
+ * @param hist  Puntero al histograma
+ * @param value Valor
+ */
+void stats_hist_add(struct stats_hist *hist, uint32_t value);
+
+/**
+ * @brief Media de un histograma.
+ * @param hist Puntero al histograma
+ * @return Media entera, 0 si no hay muestras
+ */
+uint32_t stats_hist_mean(const struct stats_hist *hist);
+
+/**
+ * @brief Imprime una instantánea en texto por la salida estándar.
+ * @param snap Instantánea
+ */
+void stats_print(const struct stats_snapshot *snap);
+
+#endif /* __STATS_H__ */
@@ -0,0 +1,21 @@
+/**
+ * @file xip.c
+ * @brief Informe de los accesos a la caché XIP.
+ */
+
+#include <stdio.h>
+
+#include "runtime/xip.h"
+
+/**
+ * @brief Imprime accesos, fallos y fallos por llamada de un acumulado.
+ */
+void xip_site_print(const char *name, const struct xip_site *site)
+{
+	uint32_t misses = site->acc - site->hit;
+
+	printf("%-10s xip accesos=%lu fallos=%lu (%lu.%lu%%) fallos/ejec=%lu\n", name, (unsigned long)site->acc,
+	       (unsigned long)misses, (unsigned long)(site->acc ? 100ull * misses / site->acc : 0),
+	       (unsigned long)(site->acc ? 1000ull * misses / site->acc % 10 : 0),
+	       (unsigned long)(site->calls ? misses / site->calls : 0));
+}
@@ -0,0 +1,148 @@
+/**
+ * @file xip.h
+ * @brief Acceso a los contadores de aciertos/accesos de la caché XIP de la flash.
+ *
+ * En el host no hay caché XIP y los contadores valen siempre 0.
+ *
+ * Los contadores del hardware son de 32 bits con saturación. Las medidas de
+ * tramo (xip_site_begin/end, una por tarea del planificador) los ponen a cero
+ * al empezar y no pueden anidarse. Las sondas (XIP_PROBE) restan lecturas y
+ * pueden ir dentro de un tramo, alrededor de una función concreta: así el
+ * informe dice qué funciones fallan en la caché y conviene mover a SRAM.
+ */
+
+#ifndef __XIP_H__
+#define __XIP_H__
+
+#include <stdint.h>
+
+#if PICO_ON_DEVICE
+#include "hardware/structs/xip_ctrl.h"
+#endif
+
+/**
+ * @struct xip_counters
+ * @brief Lectura de los contadores de la caché XIP.
+ */
+struct xip_counters {
+    uint32_t hit;  /**< Accesos servidos por la caché */
+    uint32_t acc;  /**< Accesos totales cacheables */
+};
+
+/**
+ * @brief Pone a cero los contadores de la caché XIP.
+ */
+static inline void xip_counters_reset(void)
+{
+#if PICO_ON_DEVICE
+	// Cualquier escritura borra el contador
+	xip_ctrl_hw->ctr_hit = 0;
+	xip_ctrl_hw->ctr_acc = 0;
+#endif
+}
+
+/**
+ * @brief Lee los contadores de la caché XIP.
+ * @param counters Lectura destino
+ */
+static inline void xip_counters_read(struct xip_counters *counters)
+{
+#if PICO_ON_DEVICE
+	counters->hit = xip_ctrl_hw->ctr_hit;
+	counters->acc = xip_ctrl_hw->ctr_acc;
+#else
+	counters->hit = 0;
+	counters->acc = 0;
+#endif
+}
+
+/**
+ * @struct xip_site
+ * @brief Acumulado de accesos XIP de un tramo de código medido repetidamente.
+ */
+struct xip_site {
+    uint32_t calls;  /**< Veces medido */
+    uint32_t hit;    /**< Aciertos acumulados */
+    uint32_t acc;    /**< Accesos acumulados */
+};
+
+/**
+ * @brief Empieza la medida de un tramo.
+ */
+static inline void xip_site_begin(void)
+{
+	xip_counters_reset();
+}
+
+/**
+ * @brief Termina la medida de un tramo y la suma a su acumulado.
+ * @param site Acumulado del tramo
+ */
+static inline void xip_site_end(struct xip_site *site)
+{
+	struct xip_counters counters;
+
+	xip_counters_read(&counters);
+	site->calls++;
+	site->hit += counters.hit;
+	site->acc += counters.acc;
+}
+
+/**
+ * @struct xip_probe
+ * @brief Sonda con nombre alrededor de una función.
+ */
+struct xip_probe {
+    const char *name;             /**< Nombre para los informes */
+    struct xip_site site;         /**< Acumulado de la función */
+    struct xip_counters start;    /**< Lectura al entrar */
+};
+
+/**
+ * @brief Empieza la medida de una sonda sin poner a cero los contadores.
+ * @param probe Sonda
+ */
+static inline void xip_probe_begin(struct xip_probe *probe)
+{
+	xip_counters_read(&probe->start);
+}
+
+/**
+ * @brief Termina la medida de una sonda y suma la diferencia a su acumulado.
+ * @param probe Sonda
+ */
+static inline void xip_probe_end(struct xip_probe *probe)
+{
+	struct xip_counters counters;
+
+	xip_counters_read(&counters);
+	probe->site.calls++;
+	probe->site.hit += counters.hit - probe->start.hit;
+	probe->site.acc += counters.acc - probe->start.acc;
+}
+
+/**
+ * @brief Ejecuta una sentencia dentro de una sonda; sin XIP_PROFILE solo la ejecuta.
+ */
+#if XIP_PROFILE
+#define XIP_PROBE(probe, stmt) \
+	do { \
+		xip_probe_begin(probe); \
+		stmt; \
+		xip_probe_end(probe); \
+	} while (0)
+#else
+#define XIP_PROBE(probe, stmt) \
+	do { \
+		stmt; \
+	} while (0)
+#endif
+
+/**
+ * @brief Imprime accesos, fallos y fallos por llamada de un acumulado.
+ * @param name Nombre del tramo o la función
+ * @param site Acumulado
+ */
+void xip_site_print(const char *name, const struct xip_site *site);
+
+#endif /* __XIP_H__ */
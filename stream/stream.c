@@ -0,0 +1,588 @@
+/**
+ * @file stream.c
+ * @brief Implementación del protocolo binario de streaming de resultados.
+ */
+
+#include <string.h>
+
+#include "camera/format.h"
+#include "runtime/placement.h"
+#include "vision/convert.h"
+#include "stream.h"
+
+/** @brief Tabla de 16 entradas para CRC-16/CCITT-FALSE (polinomio 0x1021) por nibbles. */
+static const uint16_t PLACEMENT_RAM_DATA("crc16") crc16_nibble[16] = {
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+	0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+};
+
+static uint16_t PLACEMENT_RAM(__crc16_update)(uint16_t crc, const uint8_t *src, size_t len)
+{
+	while (len--) {
+		crc ^= (uint16_t)(*src++) << 8;
+		crc = (crc << 4) ^ crc16_nibble[crc >> 12];
+		crc = (crc << 4) ^ crc16_nibble[crc >> 12];
+	}
+	return crc;
+}
+
+/**
+ * @brief Vacía el buffer de transmisión en el enlace.
+ * @return 0 en éxito, -1 en error.
+ */
+static int stream_flush(struct stream *stream)
+{
+	if (!stream->tx_len) {
+		return 0;
+	}
+
+	int ret = stream->platform->write(stream->platform->handle, stream->tx, stream->tx_len);
+	stream->tx_len = 0;
+
+	return ret < 0 ? -1 : 0;
+}
+
+/**
+ * @brief Añade bytes al buffer de transmisión sin actualizar el CRC.
+ */
+static int stream_put_raw(struct stream *stream, const uint8_t *src, size_t len)
+{
+	while (len) {
+		size_t n = STREAM_TX_BUF_SIZE - stream->tx_len;
+		if (n > len) {
+			n = len;
+		}
+
+		memcpy(stream->tx + stream->tx_len, src, n);
+		stream->tx_len += n;
+		src += n;
+		len -= n;
+
+		if (stream->tx_len == STREAM_TX_BUF_SIZE && stream_flush(stream)) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/** @brief Añade bytes del payload actualizando el CRC. */
+static int stream_put(struct stream *stream, const void *src, size_t len)
+{
+	stream->crc = __crc16_update(stream->crc, src, len);
+	return stream_put_raw(stream, src, len);
+}
+
+static int stream_put_u8(struct stream *stream, uint8_t v)
+{
+	return stream_put(stream, &v, 1);
+}
+
+static int stream_put_u16(struct stream *stream, uint16_t v)
+{
+	uint8_t b[2] = { v & 0xff, v >> 8 };
+	return stream_put(stream, b, sizeof(b));
+}
+
+static int stream_put_u32(struct stream *stream, uint32_t v)
+{
+	uint8_t b[4] = { v & 0xff, (v >> 8) & 0xff, (v >> 16) & 0xff, v >> 24 };
+	return stream_put(stream, b, sizeof(b));
+}
+
+/**
+ * @brief Escribe la cabecera de un paquete e inicia el cálculo del CRC.
+ * @param stream Puntero al contexto.
+ * @param type   Tipo de paquete.
+ * @param length Longitud del payload en bytes.
+ */
+static int stream_begin_packet(struct stream *stream, uint8_t type, uint16_t length)
+{
+	const uint8_t sync[2] = { STREAM_SYNC0, STREAM_SYNC1 };
+
+	if (stream_put_raw(stream, sync, sizeof(sync))) {
+		return -1;
+	}
+
+	stream->crc = 0xffff;
+	if (stream_put_u8(stream, type) || stream_put_u8(stream, STREAM_VERSION)) {
+		return -1;
+	}
+	return stream_put_u16(stream, length);
+}
+
+/**
+ * @brief Cierra el paquete en curso añadiendo el CRC y vacía el buffer.
+ */
+static int stream_end_packet(struct stream *stream)
+{
+	uint16_t crc = stream->crc;
+	uint8_t b[2] = { crc & 0xff, crc >> 8 };
+
+	if (stream_put_raw(stream, b, sizeof(b))) {
+		return -1;
+	}
+
+	return stream_flush(stream);
+}
+
+/**
+ * @brief Inicializa un stream.
+ * @param stream   Puntero al contexto.
+ * @param platform Enlace de salida.
+ */
+void stream_init(struct stream *stream, struct stream_platform_config *platform)
+{
+	*stream = (struct stream){
+		.platform = platform,
+		.thumb_shift = 2,
+	};
+}
+
+/**
+ * @brief Serializa y envía el registro de analítica de un frame.
+ * @param stream Puntero al contexto.
+ * @param result Resultados a enviar.
+ * @return 0 en éxito, -1 en error.
+ */
+int stream_send_result(struct stream *stream, const struct stream_result *result)
+{
+	uint8_t n_blobs = result->n_blobs < STREAM_MAX_BLOBS ? result->n_blobs : STREAM_MAX_BLOBS;
+	uint8_t n_boxes = result->n_boxes < STREAM_MAX_BOXES ? result->n_boxes : STREAM_MAX_BOXES;
+	uint8_t n_keypoints = result->n_keypoints < STREAM_MAX_KEYPOINTS ? result->n_keypoints : STREAM_MAX_KEYPOINTS;
+
+	uint16_t length = 12 + 4 + HISTOGRAM_SUMMARY_BINS + 4 +
+			  n_blobs * 16 + n_boxes * 10 + n_keypoints * 5;
+
+	if (stream_begin_packet(stream, STREAM_PKT_RESULT, length) ||
+	    stream_put_u32(stream, result->seq) ||
+	    stream_put_u32(stream, result->timestamp_us) ||
+	    stream_put_u16(stream, result->width) ||
+	    stream_put_u16(stream, result->height)) {
+		return -1;
+	}
+
+	if (stream_put_u8(stream, result->hist.min) ||
+	    stream_put_u8(stream, result->hist.max) ||
+	    stream_put_u8(stream, result->hist.mean) ||
+	    stream_put_u8(stream, result->hist.median) ||
+	    stream_put(stream, result->hist.bins, HISTOGRAM_SUMMARY_BINS)) {
+		return -1;
+	}
+
+	if (stream_put_u8(stream, n_blobs) ||
+	    stream_put_u8(stream, n_boxes) ||
+	    stream_put_u8(stream, n_keypoints) ||
+	    stream_put_u8(stream, 0)) {
+		return -1;
+	}
+
+	for (int i = 0; i < n_blobs; i++) {
+		const struct stream_blob *b = &result->blobs[i];
+		if (stream_put_u16(stream, b->x) ||
+		    stream_put_u16(stream, b->y) ||
+		    stream_put_u16(stream, b->w) ||
+		    stream_put_u16(stream, b->h) ||
+		    stream_put_u16(stream, b->cx) ||
+		    stream_put_u16(stream, b->cy) ||
+		    stream_put_u32(stream, b->area)) {
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < n_boxes; i++) {
+		const struct stream_box *b = &result->boxes[i];
+		if (stream_put_u16(stream, b->x) ||
+		    stream_put_u16(stream, b->y) ||
+		    stream_put_u16(stream, b->w) ||
+		    stream_put_u16(stream, b->h) ||
+		    stream_put_u8(stream, b->label) ||
+		    stream_put_u8(stream, b->score)) {
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < n_keypoints; i++) {
+		const struct stream_keypoint *k = &result->keypoints[i];
+		if (stream_put_u16(stream, k->x) ||
+		    stream_put_u16(stream, k->y) ||
+		    stream_put_u8(stream, k->score)) {
+			return -1;
+		}
+	}
+
+	return stream_end_packet(stream);
+}
+
+/**
+ * @brief Envía una miniatura reducida por vecino más cercano.
+ *
+ * La miniatura se genera línea a línea, sin necesidad de un buffer de frame
+ * adicional.
+ *
+ * @return 0 en éxito, -1 en error.
+ */
+int stream_send_thumbnail(struct stream *stream, uint32_t seq, const uint8_t *data, uint32_t stride,
+			  uint16_t width, uint16_t height)
+{
+	uint16_t tw = width >> stream->thumb_shift;
+	uint16_t th = height >> stream->thumb_shift;
+
+	if (!tw || !th || tw > STREAM_THUMB_MAX_WIDTH) {
+		return -1;
+	}
+
+	uint32_t length = 12 + (uint32_t)tw * th * 2;
+	if (length > UINT16_MAX) {
+		return -1;
+	}
+
+	if (stream_begin_packet(stream, STREAM_PKT_THUMBNAIL, length) ||
+	    stream_put_u32(stream, seq) ||
+	    stream_put_u16(stream, tw) ||
+	    stream_put_u16(stream, th) ||
+	    stream_put_u32(stream, FORMAT_RGB565)) {
+		return -1;
+	}
+
+	uint16_t step = 1 << stream->thumb_shift;
+	for (uint16_t y = 0; y < th; y++) {
+		// Una fila de origen por fila de miniatura
+		convert_scale_nn_rgb565be(stream->line, tw, 1, data + (uint32_t)y * step * stride, stride, width, 1);
+		for (uint16_t x = 0; x < tw; x++) {
+			if (stream_put_u16(stream, stream->line[x])) {
+				return -1;
+			}
+		}
+	}
+
+	return stream_end_packet(stream);
+}
+
+/**
+ * @brief Envía el registro de un frame y su miniatura cada thumb_period frames.
+ * @return 0 en éxito, -1 en error.
+ */
+int stream_send_frame(struct stream *stream, const struct stream_result *result, uint32_t format,
+		      const uint8_t *data, uint32_t stride)
+{
+	if (stream_send_result(stream, result)) {
+		return -1;
+	}
+
+	if (!stream->thumb_period || (result->seq % stream->thumb_period) || format != FORMAT_RGB565) {
+		return 0;
+	}
+
+	return stream_send_thumbnail(stream, result->seq, data, stride, result->width, result->height);
+}
+
+/**
+ * @brief Envía los ciclos por etapa de un frame.
+ * @return 0 en éxito, -1 en error.
+ */
+int stream_send_stages(struct stream *stream, uint32_t seq, const uint32_t *cycles, uint8_t n_stages)
+{
+	if (stream_begin_packet(stream, STREAM_PKT_STAGES, 5 + 4 * n_stages) ||
+	    stream_put_u32(stream, seq) ||
+	    stream_put_u8(stream, n_stages)) {
+		return -1;
+	}
+	for (int i = 0; i < n_stages; i++) {
+		if (stream_put_u32(stream, cycles[i])) {
+			return -1;
+		}
+	}
+
+	return stream_end_packet(stream);
+}
+
+/**
+ * @brief Escribe un histograma de métricas: muestras, mínimo, máximo, media y cubetas.
+ */
+static int stream_put_hist(struct stream *stream, const struct stats_hist *hist)
+{
+	if (stream_put_u32(stream, hist->count) ||
+	    stream_put_u32(stream, hist->count ? hist->min : 0) ||
+	    stream_put_u32(stream, hist->max) ||
+	    stream_put_u32(stream, hist->count ? hist->sum / hist->count : 0) ||
+	    stream_put_u8(stream, STATS_HIST_BUCKETS)) {
+		return -1;
+	}
+	for (int i = 0; i < STATS_HIST_BUCKETS; i++) {
+		if (stream_put_u16(stream, hist->buckets[i])) {
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Envía una instantánea de las métricas de ejecución.
+ * @return 0 en éxito, -1 en error.
+ */
+int stream_send_stats(struct stream *stream, const struct stats_snapshot *snap, uint32_t clk_hz)
+{
+	const uint16_t hist_size = 17 + 2 * STATS_HIST_BUCKETS;
+	const uint16_t length = 28 + 1 + 2 * STATS_NUM_CORES + 1 + 2 * STATS_BUSY_COUNT
+				+ 1 + (1 + PROFILE_STAGE_COUNT) * hist_size;
+
+	if (stream_begin_packet(stream, STREAM_PKT_STATS, length) ||
+	    stream_put_u32(stream, snap->window_us) ||
+	    stream_put_u32(stream, clk_hz) ||
+	    stream_put_u32(stream, snap->frames) ||
+	    stream_put_u32(stream, snap->dropped) ||
+	    stream_put_u32(stream, snap->total_frames) ||
+	    stream_put_u32(stream, snap->total_dropped) ||
+	    stream_put_u32(stream, snap->fps_x100)) {
+		return -1;
+	}
+
+	if (stream_put_u8(stream, STATS_NUM_CORES)) {
+		return -1;
+	}
+	for (int i = 0; i < STATS_NUM_CORES; i++) {
+		if (stream_put_u16(stream, snap->load_x1000[i])) {
+			return -1;
+		}
+	}
+	if (stream_put_u8(stream, STATS_BUSY_COUNT)) {
+		return -1;
+	}
+	for (int i = 0; i < STATS_BUSY_COUNT; i++) {
+		if (stream_put_u16(stream, snap->busy_x1000[i])) {
+			return -1;
+		}
+	}
+
+	if (stream_put_u8(stream, 1 + PROFILE_STAGE_COUNT) || stream_put_hist(stream, &snap->latency)) {
+		return -1;
+	}
+	for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+		if (stream_put_hist(stream, &snap->stages[i])) {
+			return -1;
+		}
+	}
+
+	return stream_end_packet(stream);
+}
+
+/**
+ * @brief Envía una lectura del uso de memoria.
+ * @return 0 en éxito, -1 en error.
+ */
+int stream_send_memory(struct stream *stream, const struct memory_report *report)
+{
+	if (stream_begin_packet(stream, STREAM_PKT_MEMORY, 1 + 8 * MEMORY_NUM_CORES + 16) ||
+	    stream_put_u8(stream, MEMORY_NUM_CORES)) {
+		return -1;
+	}
+	for (int i = 0; i < MEMORY_NUM_CORES; i++) {
+		if (stream_put_u32(stream, report->stack_size[i]) || stream_put_u32(stream, report->stack_peak[i])) {
+			return -1;
+		}
+	}
+	if (stream_put_u32(stream, report->heap_size) ||
+	    stream_put_u32(stream, report->heap_used) ||
+	    stream_put_u32(stream, report->heap_peak) ||
+	    stream_put_u32(stream, report->heap_arena)) {
+		return -1;
+	}
+
+	return stream_end_packet(stream);
+}
+
+/**
+ * @brief Envía los acumulados de las sondas XIP.
+ * @return 0 en éxito, -1 en error.
+ */
+int stream_send_xip(struct stream *stream, const struct xip_probe *probes, uint8_t n_probes)
+{
+	uint32_t length = 1;
+
+	for (int i = 0; i < n_probes; i++) {
+		length += 1 + strlen(probes[i].name) + 12;
+	}
+	if (length > 0xffff) {
+		return -1;
+	}
+
+	if (stream_begin_packet(stream, STREAM_PKT_XIP, length) || stream_put_u8(stream, n_probes)) {
+		return -1;
+	}
+	for (int i = 0; i < n_probes; i++) {
+		const struct xip_probe *probe = &probes[i];
+		uint8_t name_len = strlen(probe->name);
+
+		if (stream_put_u8(stream, name_len) ||
+		    stream_put(stream, probe->name, name_len) ||
+		    stream_put_u32(stream, probe->site.calls) ||
+		    stream_put_u32(stream, probe->site.hit) ||
+		    stream_put_u32(stream, probe->site.acc)) {
+			return -1;
+		}
+	}
+
+	return stream_end_packet(stream);
+}
+
+static uint16_t __get_u16(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t __get_u32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Copia un fragmento inyectado en los planos del buffer.
+ *
+ * El offset es relativo a la concatenación de todos los planos.
+ */
+static void stream_copy_chunk(struct camera_buffer *into, uint32_t offset, const uint8_t *src, uint32_t len)
+{
+	uint8_t num_planes = format_num_planes(into->format);
+
+	for (int i = 0; i < num_planes && len; i++) {
+		if (offset >= into->sizes[i]) {
+			offset -= into->sizes[i];
+			continue;
+		}
+
+		uint32_t n = into->sizes[i] - offset;
+		if (n > len) {
+			n = len;
+		}
+
+		memcpy(into->data[i] + offset, src, n);
+		src += n;
+		len -= n;
+		offset = 0;
+	}
+}
+
+/**
+ * @brief Procesa un paquete STREAM_PKT_INJECT ya validado.
+ *
+ * Un fragmento con offset 0 empieza siempre un frame nuevo, aunque el
+ * anterior no se completara. Un fragmento fuera de orden se descarta sin
+ * perder lo ya recibido, de modo que el siguiente fragmento válido (o el
+ * primero del frame siguiente) se sigue aceptando.
+ *
+ * @return 0 si completa el frame, 1 si faltan fragmentos, -1 si el fragmento no es válido.
+ */
+static int stream_handle_inject(struct stream *stream, struct camera_buffer *into, uint32_t *seq,
+				const uint8_t *payload, uint16_t length)
+{
+	if (length < STREAM_INJECT_HEADER_SIZE) {
+		return -1;
+	}
+
+	uint32_t frame_seq = __get_u32(payload);
+	uint32_t format = __get_u32(payload + 4);
+	uint16_t width = __get_u16(payload + 8);
+	uint16_t height = __get_u16(payload + 10);
+	uint32_t offset = __get_u32(payload + 12);
+	uint32_t len = length - STREAM_INJECT_HEADER_SIZE;
+
+	uint32_t total = 0;
+	for (int i = 0; i < format_num_planes(into->format); i++) {
+		total += into->sizes[i];
+	}
+
+	if (format != into->format || width != into->width || height != into->height || offset + len > total) {
+		return -1;
+	}
+
+	if (offset == 0) {
+		stream->rx_frame_bytes = 0;
+	} else if (offset != stream->rx_frame_bytes) {
+		return -1;
+	}
+
+	stream_copy_chunk(into, offset, payload + STREAM_INJECT_HEADER_SIZE, len);
+	stream->rx_frame_bytes += len;
+
+	if (stream->rx_frame_bytes < total) {
+		return 1;
+	}
+
+	stream->rx_frame_bytes = 0;
+	*seq = frame_seq;
+
+	return 0;
+}
+
+/**
+ * @brief Descarta bytes del paquete entrante hasta el siguiente posible inicio de paquete.
+ */
+static void stream_rx_resync(struct stream *stream)
+{
+	uint16_t i;
+
+	for (i = 1; i < stream->rx_len; i++) {
+		if (stream->rx[i] == STREAM_SYNC0 && (i + 1 == stream->rx_len || stream->rx[i + 1] == STREAM_SYNC1)) {
+			break;
+		}
+	}
+
+	memmove(stream->rx, stream->rx + i, stream->rx_len - i);
+	stream->rx_len -= i;
+}
+
+/**
+ * @brief Recibe fragmentos de un frame inyectado sin bloquear.
+ * @return 0 con un frame completo, 1 si falta recibir datos, -1 en error.
+ */
+int stream_receive_frame(struct stream *stream, struct camera_buffer *into, uint32_t *seq)
+{
+	struct stream_platform_config *platform = stream->platform;
+
+	while (1) {
+		uint16_t total = STREAM_HEADER_SIZE;
+
+		if ((stream->rx_len >= 1 && stream->rx[0] != STREAM_SYNC0) ||
+		    (stream->rx_len >= 2 && stream->rx[1] != STREAM_SYNC1)) {
+			stream_rx_resync(stream);
+			continue;
+		}
+
+		if (stream->rx_len >= STREAM_HEADER_SIZE) {
+			uint16_t length = __get_u16(stream->rx + 4);
+			if (stream->rx[2] != STREAM_PKT_INJECT || stream->rx[3] != STREAM_VERSION ||
+			    length > STREAM_RX_BUF_SIZE - STREAM_HEADER_SIZE - 2) {
+				stream_rx_resync(stream);
+				continue;
+			}
+
+			total = STREAM_HEADER_SIZE + length + 2;
+			if (stream->rx_len >= total) {
+				uint16_t crc = __crc16_update(0xffff, stream->rx + 2, STREAM_HEADER_SIZE - 2 + length);
+				if (crc != __get_u16(stream->rx + STREAM_HEADER_SIZE + length)) {
+					stream_rx_resync(stream);
+					continue;
+				}
+
+				int ret = stream_handle_inject(stream, into, seq, stream->rx + STREAM_HEADER_SIZE, length);
+
+				memmove(stream->rx, stream->rx + total, stream->rx_len - total);
+				stream->rx_len -= total;
+
+				if (ret == 0) {
+					return 0;
+				}
+				continue;
+			}
+		}
+
+		int n = platform->read(platform->handle, stream->rx + stream->rx_len, total - stream->rx_len);
+		if (n <= 0) {
+			return n < 0 ? -1 : 1;
+		}
+
+		stream->rx_len += n;
+	}
+}
@@ -0,0 +1,245 @@
+/**
+ * @file stream.h
+ * @brief Protocolo binario de streaming por USB para resultados de analítica.
+ *
+ * Cada paquete tiene la forma:
+ *
+ *   'M' 'V' | tipo (1) | versión (1) | longitud (2, LE) | payload | CRC-16 (2, LE)
+ *
+ * El CRC-16/CCITT-FALSE cubre desde el byte de tipo hasta el final del payload.
+ * Todos los campos multibyte del payload son little-endian.
+ */
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "camera/buffer.h"
+#include "runtime/memory.h"
+#include "runtime/stats.h"
+#include "runtime/xip.h"
+#include "vision/histogram.h"
+
+#define STREAM_SYNC0        'M'  /**< Primer byte de sincronización */
+#define STREAM_SYNC1        'V'  /**< Segundo byte de sincronización */
+#define STREAM_VERSION      1    /**< Versión del protocolo */
+#define STREAM_HEADER_SIZE  6    /**< Sync + tipo + versión + longitud */
+
+#define STREAM_MAX_BLOBS     8   /**< Máximo de blobs por registro */
+#define STREAM_MAX_BOXES     8   /**< Máximo de cajas por registro */
+#define STREAM_MAX_KEYPOINTS 32  /**< Máximo de keypoints por registro */
+
+#define STREAM_THUMB_MAX_WIDTH 160  /**< Ancho máximo de una miniatura */
+#define STREAM_TX_BUF_SIZE     256  /**< Tamaño del buffer de transmisión */
+
+#define STREAM_INJECT_HEADER_SIZE 16    /**< Metadatos al inicio de un paquete de inyección */
+#define STREAM_INJECT_CHUNK       1024  /**< Máximo de bytes de imagen por paquete de inyección */
+#define STREAM_RX_BUF_SIZE        (STREAM_HEADER_SIZE + STREAM_INJECT_HEADER_SIZE + STREAM_INJECT_CHUNK + 2)
+
+/**
+ * @enum stream_packet_type
+ * @brief Tipos de paquete del protocolo.
+ */
+enum stream_packet_type {
+    STREAM_PKT_RESULT    = 0x01, /**< Registro de analítica de un frame */
+    STREAM_PKT_THUMBNAIL = 0x02, /**< Miniatura RGB565 (little-endian) */
+    STREAM_PKT_STAGES    = 0x03, /**< Ciclos por etapa del pipeline para un frame */
+    STREAM_PKT_STATS     = 0x04, /**< Métricas de ejecución de la última ventana */
+    STREAM_PKT_MEMORY    = 0x05, /**< Uso y máximos de pila y heap */
+    STREAM_PKT_XIP       = 0x06, /**< Accesos y aciertos de la caché XIP por función */
+    STREAM_PKT_INJECT    = 0x10, /**< Host -> dispositivo: fragmento de un frame a inyectar */
+};
+
+/**
+ * @struct stream_blob
+ * @brief Región conectada detectada en el frame.
+ */
+struct stream_blob {
+    uint16_t x, y, w, h;  /**< Caja envolvente */
+    uint16_t cx, cy;      /**< Centroide */
+    uint32_t area;        /**< Área en píxeles */
+};
+
+/**
+ * @struct stream_box
+ * @brief Detección genérica con etiqueta y puntuación.
+ */
+struct stream_box {
+    uint16_t x, y, w, h;  /**< Caja envolvente */
+    uint8_t label;        /**< Clase de la detección */
+    uint8_t score;        /**< Confianza (0-255) */
+};
+
+/**
+ * @struct stream_keypoint
+ * @brief Punto característico.
+ */
+struct stream_keypoint {
+    uint16_t x, y;        /**< Posición en píxeles */
+    uint8_t score;        /**< Respuesta del detector (0-255) */
+};
+
+/**
+ * @struct stream_result
+ * @brief Resultados de analítica de un frame.
+ */
+struct stream_result {
+    uint32_t seq;                                       /**< Número de secuencia del frame */
+    uint32_t timestamp_us;                              /**< Marca de tiempo de captura (us) */
+    uint16_t width;                                     /**< Ancho del frame analizado */
+    uint16_t height;                                    /**< Alto del frame analizado */
+    struct histogram_summary hist;                      /**< Resumen del histograma de luma */
+    uint8_t n_blobs;                                    /**< Blobs válidos */
+    uint8_t n_boxes;                                    /**< Cajas válidas */
+    uint8_t n_keypoints;                                /**< Keypoints válidos */
+    struct stream_blob blobs[STREAM_MAX_BLOBS];         /**< Blobs detectados */
+    struct stream_box boxes[STREAM_MAX_BOXES];          /**< Detecciones */
+    struct stream_keypoint keypoints[STREAM_MAX_KEYPOINTS]; /**< Keypoints */
+};
+
+/**
+ * @struct stream_platform_config
+ * @brief Abstracción del enlace de salida (por ejemplo, CDC USB).
+ */
+struct stream_platform_config {
+    /**
+     * @brief Escribe bytes en el enlace.
+     * @param handle Handle del enlace
+     * @param src    Bytes a escribir
+     * @param len    Número de bytes
+     * @return Número de bytes escritos (negativo en error)
+     */
+    int (*write)(void *handle, const uint8_t *src, size_t len);
+
+    /**
+     * @brief Lee los bytes disponibles del enlace, sin bloquear.
+     * @param handle Handle del enlace
+     * @param dst    Buffer destino
+     * @param len    Máximo de bytes a leer
+     * @return Bytes leídos (0 si no hay datos; negativo en error)
+     */
+    int (*read)(void *handle, uint8_t *dst, size_t len);
+
+    void *handle;  /**< Handle del enlace */
+};
+
+/**
+ * @struct stream
+ * @brief Contexto de un stream de resultados.
+ */
+struct stream {
+    struct stream_platform_config *platform;  /**< Enlace de salida */
+    uint32_t thumb_period;                    /**< Enviar miniatura cada N frames (0 = nunca) */
+    uint8_t thumb_shift;                      /**< Reducción de la miniatura (1 << thumb_shift) */
+    uint16_t crc;                             /**< CRC del paquete en curso */
+    uint16_t tx_len;                          /**< Bytes pendientes en tx */
+    uint8_t tx[STREAM_TX_BUF_SIZE];           /**< Buffer de transmisión */
+    uint16_t line[STREAM_THUMB_MAX_WIDTH];    /**< Línea de trabajo para miniaturas */
+    uint16_t rx_len;                          /**< Bytes acumulados del paquete entrante */
+    uint32_t rx_frame_bytes;                  /**< Bytes recibidos del frame inyectado en curso */
+    uint8_t rx[STREAM_RX_BUF_SIZE];           /**< Paquete entrante */
+};
+
+/**
+ * @brief Inicializa un stream.
+ * @param stream   Puntero al contexto
+ * @param platform Enlace de salida (debe mantenerse válido)
+ */
+void stream_init(struct stream *stream, struct stream_platform_config *platform);
+
+/**
+ * @brief Envía el registro de analítica de un frame.
+ * @param stream Puntero al contexto
+ * @param result Resultados a enviar
+ * @return 0 en éxito, -1 en error de enlace
+ */
+int stream_send_result(struct stream *stream, const struct stream_result *result);
+
+/**
+ * @brief Envía una miniatura de un frame RGB565 big-endian.
+ * @param stream Puntero al contexto
+ * @param seq    Número de secuencia del frame
+ * @param data   Plano RGB565 big-endian
+ * @param stride Stride en bytes
+ * @param width  Ancho del frame
+ * @param height Alto del frame
+ * @return 0 en éxito, -1 en error
+ */
+int stream_send_thumbnail(struct stream *stream, uint32_t seq, const uint8_t *data, uint32_t stride,
+                          uint16_t width, uint16_t height);
+
+/**
+ * @brief Envía el registro de un frame y, si toca, su miniatura.
+ * @param stream Puntero al contexto
+ * @param result Resultados del frame
+ * @param format Formato del frame
+ * @param data   Plano 0 del frame
+ * @param stride Stride del plano 0 en bytes
+ * @return 0 en éxito, -1 en error
+ */
+int stream_send_frame(struct stream *stream, const struct stream_result *result, uint32_t format,
+                      const uint8_t *data, uint32_t stride);
+
+/**
+ * @brief Envía los ciclos consumidos por cada etapa del pipeline en un frame.
+ * @param stream   Puntero al contexto
+ * @param seq      Número de secuencia del frame
+ * @param cycles   Ciclos por etapa
+ * @param n_stages Número de etapas
+ * @return 0 en éxito, -1 en error
+ */
+int stream_send_stages(struct stream *stream, uint32_t seq, const uint32_t *cycles, uint8_t n_stages);
+
+/**
+ * @brief Envía una instantánea de las métricas de ejecución.
+ *
+ * Los histogramas van en este orden: latencia (us) y después una por etapa
+ * del pipeline (ciclos a clk_hz).
+ *
+ * @param stream Puntero al contexto
+ * @param snap   Instantánea a enviar
+ * @param clk_hz Frecuencia del contador de ciclos, para convertir las etapas en el host
+ * @return 0 en éxito, -1 en error
+ */
+int stream_send_stats(struct stream *stream, const struct stats_snapshot *snap, uint32_t clk_hz);
+
+/**
+ * @brief Envía una lectura del uso de memoria.
+ * @param stream Puntero al contexto
+ * @param report Lectura a enviar
+ * @return 0 en éxito, -1 en error
+ */
+int stream_send_memory(struct stream *stream, const struct memory_report *report);
+
+/**
+ * @brief Envía los acumulados de las sondas XIP (nombre, llamadas, aciertos y accesos).
+ *
+ * Es el equivalente en los modos de stream del informe de la tecla 't'.
+ *
+ * @param stream   Puntero al contexto
+ * @param probes   Sondas a enviar
+ * @param n_probes Número de sondas
+ * @return 0 en éxito, -1 en error
+ */
+int stream_send_xip(struct stream *stream, const struct xip_probe *probes, uint8_t n_probes);
+
+/**
+ * @brief Recibe un frame inyectado por el host (paquetes STREAM_PKT_INJECT).
+ *
+ * No bloquea: consume los bytes disponibles en el enlace y devuelve 1 mientras
+ * el frame esté incompleto. Los fragmentos deben llegar en orden y coincidir en
+ * formato y tamaño con el buffer destino; los que no encajan se descartan y un
+ * fragmento con offset 0 reinicia el frame. Tras un paquete corrupto se
+ * resincroniza buscando la siguiente palabra de sincronización en los bytes ya
+ * recibidos.
+ *
+ * @param stream Puntero al contexto (platform->read debe estar definido)
+ * @param into   Buffer destino
+ * @param seq    Número de secuencia asignado por el host
+ * @return 0 si se completó un frame, 1 si falta recibir datos, -1 en error
+ */
+int stream_receive_frame(struct stream *stream, struct camera_buffer *into, uint32_t *seq);
+
+#endif /* __STREAM_H__ */
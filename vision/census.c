@@ -0,0 +1,315 @@
+/**
+ * @file census.c
+ * @brief Implementación de la transformada census y la comparación por Hamming.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "runtime/placement.h"
+#include "vision/census.h"
+
+#define CENSUS_MAX_RADIUS 3  /**< Radio de la ventana de 7x7 */
+
+/** @brief Bits a 1 de cada byte. */
+#define B2(n) n, n + 1, n + 1, n + 2
+#define B4(n) B2(n), B2(n + 1), B2(n + 1), B2(n + 2)
+#define B6(n) B4(n), B4(n + 1), B4(n + 1), B4(n + 2)
+static const uint8_t PLACEMENT_RAM_DATA("census") census_popcount[256] = { B6(0), B6(1), B6(1), B6(2) };
+#undef B2
+#undef B4
+#undef B6
+
+/**
+ * @brief Distancia de Hamming de dos descriptores de 24 bits.
+ */
+static inline __attribute__((always_inline)) uint32_t __census_hamming(uint32_t a, uint32_t b)
+{
+	uint32_t v = a ^ b;
+
+	return census_popcount[v & 0xff] + census_popcount[(v >> 8) & 0xff] + census_popcount[v >> 16];
+}
+
+/** Añade al descriptor d el bit de la muestra v (1 si es menor que el centro c) */
+#define CENSUS_BIT(d, v, c) ((d) = ((d) << 1) | ((uint32_t)((int32_t)(v) - (c)) >> 31))
+
+/**
+ * @brief Descriptores 5x5 de una fila; rows son las 5 filas de la ventana.
+ */
+static void PLACEMENT_RAM(__census_row_5x5)(uint32_t *dst, const uint8_t *const rows[], uint16_t width)
+{
+	const uint8_t *r0 = rows[0], *r1 = rows[1], *r2 = rows[2], *r3 = rows[3], *r4 = rows[4];
+
+	for (uint32_t x = 2; x < width - 2u; x++) {
+		const int32_t c = r2[x];
+		uint32_t d = 0;
+
+		CENSUS_BIT(d, r0[x - 2], c); CENSUS_BIT(d, r0[x - 1], c); CENSUS_BIT(d, r0[x], c);
+		CENSUS_BIT(d, r0[x + 1], c); CENSUS_BIT(d, r0[x + 2], c);
+		CENSUS_BIT(d, r1[x - 2], c); CENSUS_BIT(d, r1[x - 1], c); CENSUS_BIT(d, r1[x], c);
+		CENSUS_BIT(d, r1[x + 1], c); CENSUS_BIT(d, r1[x + 2], c);
+		CENSUS_BIT(d, r2[x - 2], c); CENSUS_BIT(d, r2[x - 1], c);
+		CENSUS_BIT(d, r2[x + 1], c); CENSUS_BIT(d, r2[x + 2], c);
+		CENSUS_BIT(d, r3[x - 2], c); CENSUS_BIT(d, r3[x - 1], c); CENSUS_BIT(d, r3[x], c);
+		CENSUS_BIT(d, r3[x + 1], c); CENSUS_BIT(d, r3[x + 2], c);
+		CENSUS_BIT(d, r4[x - 2], c); CENSUS_BIT(d, r4[x - 1], c); CENSUS_BIT(d, r4[x], c);
+		CENSUS_BIT(d, r4[x + 1], c); CENSUS_BIT(d, r4[x + 2], c);
+		dst[x] = d;
+	}
+}
+
+/**
+ * @brief Descriptores 7x7 en damero de una fila; rows son las 7 filas de la ventana.
+ */
+static void PLACEMENT_RAM(__census_row_7x7)(uint32_t *dst, const uint8_t *const rows[], uint16_t width)
+{
+	const uint8_t *r0 = rows[0], *r1 = rows[1], *r2 = rows[2], *r3 = rows[3];
+	const uint8_t *r4 = rows[4], *r5 = rows[5], *r6 = rows[6];
+
+	for (uint32_t x = 3; x < width - 3u; x++) {
+		const int32_t c = r3[x];
+		uint32_t d = 0;
+
+		CENSUS_BIT(d, r0[x - 3], c); CENSUS_BIT(d, r0[x - 1], c); CENSUS_BIT(d, r0[x + 1], c);
+		CENSUS_BIT(d, r0[x + 3], c);
+		CENSUS_BIT(d, r1[x - 2], c); CENSUS_BIT(d, r1[x], c); CENSUS_BIT(d, r1[x + 2], c);
+		CENSUS_BIT(d, r2[x - 3], c); CENSUS_BIT(d, r2[x - 1], c); CENSUS_BIT(d, r2[x + 1], c);
+		CENSUS_BIT(d, r2[x + 3], c);
+		CENSUS_BIT(d, r3[x - 2], c); CENSUS_BIT(d, r3[x + 2], c);
+		CENSUS_BIT(d, r4[x - 3], c); CENSUS_BIT(d, r4[x - 1], c); CENSUS_BIT(d, r4[x + 1], c);
+		CENSUS_BIT(d, r4[x + 3], c);
+		CENSUS_BIT(d, r5[x - 2], c); CENSUS_BIT(d, r5[x], c); CENSUS_BIT(d, r5[x + 2], c);
+		CENSUS_BIT(d, r6[x - 3], c); CENSUS_BIT(d, r6[x - 1], c); CENSUS_BIT(d, r6[x + 1], c);
+		CENSUS_BIT(d, r6[x + 3], c);
+		dst[x] = d;
+	}
+}
+
+#undef CENSUS_BIT
+
+/**
+ * @brief Una fila de descriptores con los bordes a 0.
+ */
+static void __census_row(uint32_t *dst, const uint8_t *const rows[], uint16_t width, uint8_t shape)
+{
+	const uint32_t radius = shape == CENSUS_5X5 ? 2 : 3;
+
+	memset(dst, 0, radius * sizeof(*dst));
+	memset(dst + width - radius, 0, radius * sizeof(*dst));
+	if (shape == CENSUS_5X5) {
+		__census_row_5x5(dst, rows, width);
+	} else {
+		__census_row_7x7(dst, rows, width);
+	}
+}
+
+/**
+ * @brief Prepara la transformada por filas.
+ * @return 0 en éxito, -1 en error.
+ */
+int census_init(struct census *cs, enum census_shape shape, uint16_t width, uint8_t *ring)
+{
+	const uint8_t radius = shape == CENSUS_5X5 ? 2 : 3;
+
+	if ((shape != CENSUS_5X5 && shape != CENSUS_7X7_SPARSE) || width < 2 * radius + 1 || width > CENSUS_MAX_WIDTH ||
+	    !ring) {
+		return -1;
+	}
+
+	cs->shape = shape;
+	cs->radius = radius;
+	cs->width = width;
+	cs->rows = 0;
+	cs->ring = ring;
+	return 0;
+}
+
+/**
+ * @brief Añade una fila de luma al anillo y calcula la fila de descriptores que completa.
+ * @return Índice de la fila escrita, o -1 si aún faltan filas.
+ */
+int census_push_row(struct census *cs, const uint8_t *row, uint32_t *dst)
+{
+	const uint32_t n = 2 * cs->radius + 1;
+	const uint8_t *rows[2 * CENSUS_MAX_RADIUS + 1];
+
+	memcpy(cs->ring + (cs->rows % n) * cs->width, row, cs->width);
+	cs->rows++;
+	if (cs->rows < n) {
+		return -1;
+	}
+
+	// La fila más antigua del anillo es la siguiente a la recién escrita
+	for (uint32_t i = 0, slot = cs->rows % n; i < n; i++, slot = slot + 1 == n ? 0 : slot + 1) {
+		rows[i] = cs->ring + slot * cs->width;
+	}
+	__census_row(dst, rows, cs->width, cs->shape);
+	return cs->rows - 1 - cs->radius;
+}
+
+/**
+ * @brief Transformada de un plano entero.
+ * @return 0 en éxito, -1 en error.
+ */
+int census_transform(uint32_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint16_t width,
+		     uint16_t height, enum census_shape shape)
+{
+	const uint32_t radius = shape == CENSUS_5X5 ? 2 : 3;
+	const uint8_t *rows[2 * CENSUS_MAX_RADIUS + 1];
+
+	if ((shape != CENSUS_5X5 && shape != CENSUS_7X7_SPARSE) || width < 2 * radius + 1 || width > CENSUS_MAX_WIDTH ||
+	    height < 2 * radius + 1 || dst_stride % 4 || dst_stride < width * 4u) {
+		return -1;
+	}
+
+	for (uint32_t y = 0; y < height; y++) {
+		uint32_t *out = (uint32_t *)((uint8_t *)dst + y * dst_stride);
+
+		if (y < radius || y >= height - radius) {
+			memset(out, 0, width * sizeof(*out));
+			continue;
+		}
+		for (uint32_t i = 0; i < 2 * radius + 1; i++) {
+			rows[i] = src + (y - radius + i) * src_stride;
+		}
+		__census_row(out, rows, width, shape);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Distancia de Hamming entre dos descriptores.
+ */
+uint32_t census_hamming(uint32_t a, uint32_t b)
+{
+	return __census_hamming(a, b);
+}
+
+/**
+ * @brief Disparidad estéreo de una fila por el ganador de menor coste.
+ * @return 0 en éxito, -1 en error.
+ */
+int PLACEMENT_RAM(census_disparity_row)(const uint32_t *left, const uint32_t *right, uint16_t width,
+					uint8_t max_disparity, uint8_t *disparity, uint16_t *cost)
+{
+	const uint32_t half = CENSUS_DISPARITY_SUM / 2;
+
+	if (width < CENSUS_DISPARITY_SUM || width > CENSUS_MAX_WIDTH) {
+		return -1;
+	}
+
+	memset(disparity, 0, width);
+	for (uint32_t x = 0; x < width; x++) {
+		cost[x] = UINT16_MAX;
+	}
+
+	for (uint32_t d = 0; d <= max_disparity && d + CENSUS_DISPARITY_SUM <= width; d++) {
+		const uint32_t *l = left + d, *r = right;
+		uint8_t window[CENSUS_DISPARITY_SUM];
+		uint32_t sum = 0, slot = 0;
+
+		// Ventana de la primera columna con esta disparidad: x = d + half
+		for (uint32_t i = 0; i < CENSUS_DISPARITY_SUM; i++) {
+			window[i] = __census_hamming(l[i], r[i]);
+			sum += window[i];
+		}
+		for (uint32_t x = d + half;; x++) {
+			if (sum < cost[x]) {
+				cost[x] = sum;
+				disparity[x] = d;
+			}
+			if (x + half + 1 >= width) {
+				break;
+			}
+
+			// Entra la columna x + half + 1 y sale x - half
+			uint32_t h = __census_hamming(left[x + half + 1], right[x + half + 1 - d]);
+			sum += h - window[slot];
+			window[slot] = h;
+			slot = slot + 1 == CENSUS_DISPARITY_SUM ? 0 : slot + 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Suma de distancias entre dos bloques de (2 * block + 1)².
+ */
+static uint32_t __census_block(const uint32_t *a, const uint32_t *b, uint32_t stride, uint32_t block)
+{
+	uint32_t sum = 0;
+
+	for (uint32_t j = 0; j < 2 * block + 1; j++) {
+		const uint32_t *ra = (const uint32_t *)((const uint8_t *)a + j * stride);
+		const uint32_t *rb = (const uint32_t *)((const uint8_t *)b + j * stride);
+
+		for (uint32_t i = 0; i < 2 * block + 1; i++) {
+			sum += __census_hamming(ra[i], rb[i]);
+		}
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Busca en img el bloque de ref centrado en (x, y).
+ * @return 0 en éxito, -1 en error.
+ */
+int PLACEMENT_RAM(census_search)(const uint32_t *ref, const uint32_t *img, uint32_t stride, uint16_t width,
+				 uint16_t height, uint16_t x, uint16_t y, uint8_t block, uint8_t search,
+				 struct census_match *match)
+{
+	const int32_t side = 2 * search + 1;
+	uint16_t costs[(2 * CENSUS_MAX_SEARCH + 1) * (2 * CENSUS_MAX_SEARCH + 1)];
+	uint32_t best = UINT32_MAX;
+	int32_t best_i = -1, best_j = -1;
+
+	if (!block || block > CENSUS_MAX_BLOCK || search > CENSUS_MAX_SEARCH || x < block || y < block ||
+	    x + block >= width || y + block >= height || stride % 4) {
+		return -1;
+	}
+
+	const uint32_t *a = (const uint32_t *)((const uint8_t *)ref + (y - block) * stride) + x - block;
+	for (int32_t j = 0; j < side; j++) {
+		const int32_t by = y + j - search;
+
+		for (int32_t i = 0; i < side; i++) {
+			const int32_t bx = x + i - search;
+
+			if (bx < block || by < block || bx + block >= width || by + block >= height) {
+				costs[j * side + i] = UINT16_MAX;
+				continue;
+			}
+
+			const uint32_t *b = (const uint32_t *)((const uint8_t *)img + (by - block) * stride) + bx - block;
+			uint32_t sum = __census_block(a, b, stride, block);
+			costs[j * side + i] = sum;
+			if (sum < best) {
+				best = sum;
+				best_i = i;
+				best_j = j;
+			}
+		}
+	}
+	if (best_i < 0) {
+		return -1;
+	}
+
+	// Segundo mínimo fuera del entorno 3x3 del mejor: mide si el mínimo es único
+	uint32_t second = UINT16_MAX;
+	for (int32_t j = 0; j < side; j++) {
+		for (int32_t i = 0; i < side; i++) {
+			if ((abs(i - best_i) > 1 || abs(j - best_j) > 1) && costs[j * side + i] < second) {
+				second = costs[j * side + i];
+			}
+		}
+	}
+
+	match->dx = best_i - search;
+	match->dy = best_j - search;
+	match->cost = best;
+	match->second = second;
+	return 0;
+}
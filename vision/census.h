@@ -0,0 +1,152 @@
+/**
+ * @file census.h
+ * @brief Transformada census de una luma Y8 y comparación por distancia de Hamming.
+ *
+ * El descriptor de un píxel tiene un bit por vecino, a 1 si el vecino es más
+ * oscuro que el centro. Solo depende del orden de las intensidades, así que no
+ * cambia con el brillo ni con el contraste, y se calcula con restas y
+ * desplazamientos, sin multiplicaciones. Dos formas, ambas de 24 bits en una
+ * palabra de 32:
+ *
+ * - CENSUS_5X5: los 24 vecinos de la ventana de 5x5.
+ * - CENSUS_7X7_SPARSE: los 24 vecinos de la ventana de 7x7 en damero (los que
+ *   están a una distancia par en x + y), con más contexto al mismo coste.
+ *
+ * Los descriptores se calculan fila a fila: census_push_row() recibe las filas
+ * de la luma según llegan (por ejemplo, una franja de la cámara), las guarda en
+ * un anillo de 5 o 7 filas y escribe una fila de descriptores en cuanto tiene
+ * las filas de su ventana. census_transform() aplica lo mismo a un plano
+ * entero. Los descriptores a menos del radio del borde valen 0.
+ *
+ * La distancia entre descriptores es el número de bits distintos (popcount
+ * por tabla de 256 entradas: el M0+ no tiene instrucción). Sobre ella se
+ * construyen la disparidad estéreo por filas y la búsqueda de un bloque para
+ * seguimiento.
+ */
+
+#ifndef __CENSUS_H__
+#define __CENSUS_H__
+
+#include <stdint.h>
+
+#define CENSUS_MAX_WIDTH     640   /**< Ancho máximo de la luma */
+#define CENSUS_BITS          24    /**< Bits de un descriptor */
+#define CENSUS_DISPARITY_SUM 5     /**< Descriptores sumados en horizontal por coste de disparidad (impar) */
+#define CENSUS_MAX_BLOCK     4     /**< Radio máximo del bloque de census_search() */
+#define CENSUS_MAX_SEARCH    8     /**< Radio máximo de la búsqueda de census_search() */
+
+/** Bytes del anillo de filas de census_init() */
+#define CENSUS_RING_SIZE(width, shape) ((uint32_t)(width) * ((shape) == CENSUS_5X5 ? 5 : 7))
+
+/**
+ * @enum census_shape
+ * @brief Vecinos que forman el descriptor.
+ */
+enum census_shape {
+    CENSUS_5X5 = 0,     /**< Ventana de 5x5 completa */
+    CENSUS_7X7_SPARSE,  /**< Ventana de 7x7 en damero */
+};
+
+/**
+ * @struct census
+ * @brief Estado de la transformada por filas.
+ */
+struct census {
+    uint8_t shape;      /**< enum census_shape */
+    uint8_t radius;     /**< Radio de la ventana: 2 o 3 */
+    uint16_t width;     /**< Ancho de las filas */
+    uint32_t rows;      /**< Filas recibidas desde census_init() */
+    uint8_t *ring;      /**< Últimas 2 * radius + 1 filas */
+};
+
+/**
+ * @struct census_match
+ * @brief Resultado de census_search().
+ */
+struct census_match {
+    int16_t dx;         /**< Desplazamiento horizontal del mejor bloque */
+    int16_t dy;         /**< Desplazamiento vertical del mejor bloque */
+    uint16_t cost;      /**< Suma de distancias del mejor bloque */
+    uint16_t second;    /**< Menor suma fuera de los vecinos inmediatos del mejor */
+};
+
+/**
+ * @brief Prepara la transformada por filas.
+ * @param cs    Estado
+ * @param shape Forma del descriptor
+ * @param width Ancho de las filas (2 * radio + 1 .. CENSUS_MAX_WIDTH)
+ * @param ring  Buffer de CENSUS_RING_SIZE(width, shape) bytes
+ * @return 0 en éxito, -1 si los parámetros no son válidos
+ */
+int census_init(struct census *cs, enum census_shape shape, uint16_t width, uint8_t *ring);
+
+/**
+ * @brief Añade una fila de luma y calcula la fila de descriptores que completa.
+ *
+ * La fila n de descriptores sale con la fila n + radio de la luma (contando
+ * desde census_init()); las primeras y últimas filas del frame (a menos del
+ * radio) no se calculan.
+ *
+ * @param cs  Estado
+ * @param row Fila de width muestras Y8
+ * @param dst Fila de width descriptores
+ * @return Índice de la fila escrita en dst, o -1 si aún faltan filas
+ */
+int census_push_row(struct census *cs, const uint8_t *row, uint32_t *dst);
+
+/**
+ * @brief Transformada de un plano entero.
+ * @param dst        Descriptores
+ * @param dst_stride Stride de dst en bytes (múltiplo de 4)
+ * @param src        Luma Y8
+ * @param src_stride Stride de src en bytes
+ * @param width      Ancho
+ * @param height     Alto
+ * @param shape      Forma del descriptor
+ * @return 0 en éxito, -1 si el tamaño no es válido
+ */
+int census_transform(uint32_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint16_t width,
+                     uint16_t height, enum census_shape shape);
+
+/**
+ * @brief Distancia de Hamming entre dos descriptores.
+ */
+uint32_t census_hamming(uint32_t a, uint32_t b);
+
+/**
+ * @brief Disparidad estéreo de una fila por el ganador de menor coste.
+ *
+ * El coste de la disparidad d en x es la suma de distancias entre left[x + i]
+ * y right[x + i - d] para |i| <= CENSUS_DISPARITY_SUM / 2, actualizada al
+ * avanzar x con una suma y una resta. Las filas deben estar rectificadas (la
+ * cámara derecha ve los objetos desplazados hacia la izquierda).
+ *
+ * @param left          Descriptores de la fila izquierda
+ * @param right         Descriptores de la misma fila derecha
+ * @param width         Ancho
+ * @param max_disparity Disparidad máxima probada
+ * @param disparity     Disparidad de menor coste por columna (0 donde no se puede probar ninguna)
+ * @param cost          Coste de esa disparidad por columna (UINT16_MAX donde no se puede probar ninguna)
+ * @return 0 en éxito, -1 si los parámetros no son válidos
+ */
+int census_disparity_row(const uint32_t *left, const uint32_t *right, uint16_t width, uint8_t max_disparity,
+                         uint8_t *disparity, uint16_t *cost);
+
+/**
+ * @brief Busca en img el bloque de ref centrado en (x, y) dentro de un radio.
+ * @param ref        Descriptores de referencia
+ * @param img        Descriptores donde buscar (mismo tamaño y stride)
+ * @param stride     Stride de ambos en bytes
+ * @param width      Ancho
+ * @param height     Alto
+ * @param x          Columna del centro del bloque en ref
+ * @param y          Fila del centro del bloque en ref
+ * @param block      Radio del bloque (1..CENSUS_MAX_BLOCK)
+ * @param search     Radio de la búsqueda (<= CENSUS_MAX_SEARCH)
+ * @param match      Mejor desplazamiento
+ * @return 0 en éxito, -1 si el bloque de ref se sale del plano o no hay posiciones válidas
+ */
+int census_search(const uint32_t *ref, const uint32_t *img, uint32_t stride, uint16_t width, uint16_t height,
+                  uint16_t x, uint16_t y, uint8_t block, uint8_t search, struct census_match *match);
+
+#endif /* __CENSUS_H__ */
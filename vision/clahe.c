@@ -0,0 +1,204 @@
+/**
+ * @file clahe.c
+ * @brief Implementación del CLAHE por teselas en punto fijo.
+ */
+
+#include <string.h>
+
+#include "runtime/placement.h"
+#include "vision/clahe.h"
+
+/**
+ * @brief Primera columna (o fila) de una tesela.
+ */
+static inline uint16_t __clahe_tile_start(uint16_t size, uint8_t tiles, uint8_t t)
+{
+	return (uint32_t)t * size / tiles;
+}
+
+/**
+ * @brief Tesela de una columna (o fila): la t con __clahe_tile_start(t) <= pos < __clahe_tile_start(t + 1).
+ *
+ * pos * tiles / size no coincide con esos límites cuando tiles no divide a
+ * size, y una tesela acabaría con más cuentas que píxeles.
+ */
+static inline uint8_t __clahe_tile_of(uint16_t pos, uint16_t size, uint8_t tiles)
+{
+	return ((uint32_t)(pos + 1) * tiles - 1) / size;
+}
+
+/**
+ * @brief Configura tamaño, teselas y límite de contraste.
+ * @return 0 en éxito, -1 en error.
+ */
+int clahe_init(struct clahe *clahe, uint16_t width, uint16_t height, uint8_t tiles_x, uint8_t tiles_y,
+	       uint16_t clip_x10)
+{
+	if (!tiles_x || !tiles_y || tiles_x > CLAHE_MAX_TILES || tiles_y > CLAHE_MAX_TILES ||
+	    width < tiles_x || height < tiles_y) {
+		return -1;
+	}
+
+	// La tesela más grande debe caber en cuentas de 16 bits
+	uint32_t tile_w = (width + tiles_x - 1) / tiles_x;
+	uint32_t tile_h = (height + tiles_y - 1) / tiles_y;
+	if (tile_w * tile_h > UINT16_MAX) {
+		return -1;
+	}
+
+	clahe->width = width;
+	clahe->height = height;
+	clahe->tiles_x = tiles_x;
+	clahe->tiles_y = tiles_y;
+	clahe->clip_x10 = clip_x10;
+	clahe_reset(clahe);
+
+	return 0;
+}
+
+/**
+ * @brief Pone a cero los histogramas.
+ */
+void clahe_reset(struct clahe *clahe)
+{
+	memset(clahe->hist, 0, sizeof(clahe->hist));
+}
+
+/**
+ * @brief Acumula una fila recorriendo las teselas por tramos de columnas.
+ */
+void PLACEMENT_RAM(clahe_accumulate_row)(struct clahe *clahe, uint16_t y, const uint8_t *luma, uint8_t step)
+{
+	uint8_t ty = __clahe_tile_of(y, clahe->height, clahe->tiles_y);
+
+	for (uint8_t tx = 0; tx < clahe->tiles_x; tx++) {
+		uint16_t *hist = clahe->hist[ty][tx];
+		uint16_t x1 = __clahe_tile_start(clahe->width, clahe->tiles_x, tx + 1);
+
+		for (uint16_t x = __clahe_tile_start(clahe->width, clahe->tiles_x, tx); x < x1; x++) {
+			hist[luma[(uint32_t)x * step] >> 2]++;
+		}
+	}
+}
+
+/**
+ * @brief Convierte a luma (BT.601, como convert_rgb565be_to_y8) y acumula en la misma pasada.
+ */
+void PLACEMENT_RAM(clahe_convert_rgb565be)(struct clahe *clahe, uint8_t *dst, uint32_t dst_stride,
+					   const uint8_t *src, uint32_t src_stride)
+{
+	for (uint16_t y = 0; y < clahe->height; y++) {
+		const uint8_t *row = src + (uint32_t)y * src_stride;
+		uint8_t *out = dst + (uint32_t)y * dst_stride;
+		uint8_t ty = __clahe_tile_of(y, clahe->height, clahe->tiles_y);
+
+		for (uint8_t tx = 0; tx < clahe->tiles_x; tx++) {
+			uint16_t *hist = clahe->hist[ty][tx];
+			uint16_t x1 = __clahe_tile_start(clahe->width, clahe->tiles_x, tx + 1);
+
+			for (uint16_t x = __clahe_tile_start(clahe->width, clahe->tiles_x, tx); x < x1; x++) {
+				uint16_t v = (row[2 * x] << 8) | row[2 * x + 1];
+				uint8_t luma = (((v >> 11) & 0x1f) * 634 + ((v >> 5) & 0x3f) * 607 + (v & 0x1f) * 239) >> 8;
+				out[x] = luma;
+				hist[luma >> 2]++;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Recorta cada histograma, reparte el exceso y calcula su LUT acumulada.
+ */
+void clahe_build_luts(struct clahe *clahe)
+{
+	for (uint8_t ty = 0; ty < clahe->tiles_y; ty++) {
+		uint32_t rows = __clahe_tile_start(clahe->height, clahe->tiles_y, ty + 1) -
+				__clahe_tile_start(clahe->height, clahe->tiles_y, ty);
+
+		for (uint8_t tx = 0; tx < clahe->tiles_x; tx++) {
+			uint32_t cols = __clahe_tile_start(clahe->width, clahe->tiles_x, tx + 1) -
+					__clahe_tile_start(clahe->width, clahe->tiles_x, tx);
+			uint32_t n = rows * cols;
+			uint32_t bins[CLAHE_BINS];
+
+			for (int b = 0; b < CLAHE_BINS; b++) {
+				bins[b] = clahe->hist[ty][tx][b];
+			}
+
+			if (clahe->clip_x10) {
+				uint32_t limit = (uint32_t)clahe->clip_x10 * n / (10 * CLAHE_BINS);
+				uint32_t excess = 0;
+
+				if (!limit) {
+					limit = 1;
+				}
+				for (int b = 0; b < CLAHE_BINS; b++) {
+					if (bins[b] > limit) {
+						excess += bins[b] - limit;
+						bins[b] = limit;
+					}
+				}
+				for (int b = 0; b < CLAHE_BINS; b++) {
+					bins[b] += excess / CLAHE_BINS + (b < (int)(excess % CLAHE_BINS));
+				}
+			}
+
+			uint32_t cdf = 0;
+			for (int b = 0; b < CLAHE_BINS; b++) {
+				cdf += bins[b];
+				clahe->lut[ty][tx][b] = n ? (cdf * 255 + n / 2) / n : b * 4u;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Posición de una columna o fila respecto a los centros de las teselas.
+ *
+ * pos está en unidades de tesela en 16.16, con 0 en el centro de la primera.
+ * Devuelve las dos teselas vecinas y el peso de la segunda (0-256).
+ */
+static inline void __clahe_neighbours(int32_t pos, uint8_t tiles, uint8_t *t0, uint8_t *t1, uint32_t *w)
+{
+	if (pos <= 0) {
+		*t0 = *t1 = 0;
+		*w = 0;
+	} else if ((pos >> 16) >= tiles - 1) {
+		*t0 = *t1 = tiles - 1;
+		*w = 0;
+	} else {
+		*t0 = pos >> 16;
+		*t1 = *t0 + 1;
+		*w = (pos >> 8) & 0xff;
+	}
+}
+
+/**
+ * @brief Interpola bilinealmente las LUT de las cuatro teselas vecinas de cada píxel.
+ */
+void PLACEMENT_RAM(clahe_apply)(const struct clahe *clahe, uint8_t *dst, uint32_t dst_stride, const uint8_t *src,
+				uint32_t src_stride)
+{
+	const int32_t x_step = ((uint32_t)clahe->tiles_x << 16) / clahe->width;
+	const int32_t y_step = ((uint32_t)clahe->tiles_y << 16) / clahe->height;
+	int32_t pos_y = y_step / 2 - 0x8000;
+
+	for (uint16_t y = 0; y < clahe->height; y++, pos_y += y_step) {
+		const uint8_t *row = src + (uint32_t)y * src_stride;
+		uint8_t *out = dst + (uint32_t)y * dst_stride;
+		uint8_t ty0, ty1, tx0, tx1;
+		uint32_t wy, wx;
+
+		__clahe_neighbours(pos_y, clahe->tiles_y, &ty0, &ty1, &wy);
+
+		int32_t pos_x = x_step / 2 - 0x8000;
+		for (uint16_t x = 0; x < clahe->width; x++, pos_x += x_step) {
+			__clahe_neighbours(pos_x, clahe->tiles_x, &tx0, &tx1, &wx);
+
+			uint8_t b = row[x] >> 2;
+			uint32_t top = clahe->lut[ty0][tx0][b] * (256 - wx) + clahe->lut[ty0][tx1][b] * wx;
+			uint32_t bottom = clahe->lut[ty1][tx0][b] * (256 - wx) + clahe->lut[ty1][tx1][b] * wx;
+			out[x] = (top * (256 - wy) + bottom * wy + 0x8000) >> 16;
+		}
+	}
+}
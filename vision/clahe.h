@@ -0,0 +1,103 @@
+/**
+ * @file clahe.h
+ * @brief Ecualización adaptativa por teselas con límite de contraste (CLAHE).
+ *
+ * La imagen de luma se divide en tiles_x x tiles_y teselas. Cada tesela tiene
+ * un histograma de CLAHE_BINS niveles que se recorta al límite de contraste,
+ * repartiendo el exceso entre todos los niveles, y su distribución acumulada
+ * da la LUT de la tesela. Cada píxel de salida interpola bilinealmente las
+ * LUT de las cuatro teselas cuyos centros lo rodean.
+ *
+ * El flujo es de dos pasadas sobre el frame, ambas en punto fijo:
+ * - Acumulación: clahe_accumulate_row() por cada fila de luma, llamada desde
+ *   el mismo bucle que convierte la captura (clahe_convert_rgb565be() hace las
+ *   dos cosas a la vez), sin una pasada extra para el histograma.
+ * - Salida: clahe_build_luts() y después clahe_apply(), que escribe cada píxel
+ *   una vez.
+ *
+ * Toda la memoria está en struct clahe (unos 12 KiB con el máximo de teselas);
+ * no hay buffers por columna ni por fila.
+ */
+
+#ifndef __CLAHE_H__
+#define __CLAHE_H__
+
+#include <stdint.h>
+
+#define CLAHE_BINS      64  /**< Niveles del histograma de cada tesela (luma >> 2) */
+#define CLAHE_MAX_TILES 8   /**< Máximo de teselas por eje */
+
+/**
+ * @struct clahe
+ * @brief Histogramas y LUT de todas las teselas.
+ */
+struct clahe {
+    uint16_t width;                                                 /**< Ancho de la imagen */
+    uint16_t height;                                                /**< Alto de la imagen */
+    uint8_t tiles_x;                                                /**< Teselas en horizontal */
+    uint8_t tiles_y;                                                /**< Teselas en vertical */
+    uint16_t clip_x10;                                              /**< Límite de contraste (x10) sobre la cuenta media por nivel */
+    uint16_t hist[CLAHE_MAX_TILES][CLAHE_MAX_TILES][CLAHE_BINS];    /**< Histograma de cada tesela */
+    uint8_t lut[CLAHE_MAX_TILES][CLAHE_MAX_TILES][CLAHE_BINS];      /**< LUT de cada tesela */
+};
+
+/**
+ * @brief Configura el CLAHE para un tamaño de imagen.
+ *
+ * Cada tesela debe tener menos de 65536 píxeles (cuentas de 16 bits).
+ *
+ * @param clahe    Estado
+ * @param width    Ancho de la imagen
+ * @param height   Alto de la imagen
+ * @param tiles_x  Teselas en horizontal (1..CLAHE_MAX_TILES)
+ * @param tiles_y  Teselas en vertical (1..CLAHE_MAX_TILES)
+ * @param clip_x10 Límite de contraste x10 (por ejemplo 30 = 3 veces la cuenta media; 0 = sin límite)
+ * @return 0 en éxito, -1 si los parámetros no son válidos
+ */
+int clahe_init(struct clahe *clahe, uint16_t width, uint16_t height, uint8_t tiles_x, uint8_t tiles_y,
+               uint16_t clip_x10);
+
+/**
+ * @brief Pone a cero los histogramas antes de acumular un frame.
+ * @param clahe Estado
+ */
+void clahe_reset(struct clahe *clahe);
+
+/**
+ * @brief Acumula una fila de luma en los histogramas de sus teselas.
+ * @param clahe Estado
+ * @param y     Fila
+ * @param luma  Primera muestra de luma de la fila
+ * @param step  Bytes entre muestras (1 para un plano Y, 2 para YUYV)
+ */
+void clahe_accumulate_row(struct clahe *clahe, uint16_t y, const uint8_t *luma, uint8_t step);
+
+/**
+ * @brief Convierte RGB565 big-endian a luma y acumula los histogramas en la misma pasada.
+ * @param clahe      Estado
+ * @param dst        Plano de luma destino
+ * @param dst_stride Stride del destino en bytes
+ * @param src        Origen RGB565 big-endian
+ * @param src_stride Stride del origen en bytes
+ */
+void clahe_convert_rgb565be(struct clahe *clahe, uint8_t *dst, uint32_t dst_stride, const uint8_t *src,
+                            uint32_t src_stride);
+
+/**
+ * @brief Recorta los histogramas y calcula la LUT de cada tesela.
+ * @param clahe Estado
+ */
+void clahe_build_luts(struct clahe *clahe);
+
+/**
+ * @brief Aplica las LUT interpoladas a un plano de luma.
+ * @param clahe      Estado
+ * @param dst        Destino (puede coincidir con src)
+ * @param dst_stride Stride del destino en bytes
+ * @param src        Plano de luma de origen
+ * @param src_stride Stride del origen en bytes
+ */
+void clahe_apply(const struct clahe *clahe, uint8_t *dst, uint32_t dst_stride, const uint8_t *src,
+                 uint32_t src_stride);
+
+#endif /* __CLAHE_H__ */
@@ -0,0 +1,621 @@
+/**
+ * @file code.c
+ * @brief Implementación de la detección por tramos y de la lectura de QR, EAN-13 y Code 128.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "runtime/placement.h"
+#include "vision/code.h"
+#include "vision/qr.h"
+
+#define CODE_ROW_SPACING 16  /**< Separación mínima entre filas retenidas de una misma zona de barras */
+
+/** Anchos (claro, oscuro, claro, oscuro) de los dígitos EAN en el juego L */
+static const uint8_t __code_ean_digits[10][4] = {
+	{ 3, 2, 1, 1 }, { 2, 2, 2, 1 }, { 2, 1, 2, 2 }, { 1, 4, 1, 1 }, { 1, 1, 3, 2 },
+	{ 1, 2, 3, 1 }, { 1, 1, 1, 4 }, { 1, 3, 1, 2 }, { 1, 2, 1, 3 }, { 3, 1, 1, 2 },
+};
+
+/** Juegos (bit a 1 = G) de los seis dígitos izquierdos según el primer dígito, el primero en el bit 5 */
+static const uint8_t __code_ean_parity[10] = { 0x00, 0x0b, 0x0d, 0x0e, 0x13, 0x19, 0x1c, 0x15, 0x16, 0x1a };
+
+/** Símbolos Code 128: seis anchos de 1 a 4 módulos, menos 1, en 2 bits cada uno (el primero arriba) */
+static const uint16_t __code_128_symbols[106] = {
+	0x455, 0x545, 0x554, 0x116, 0x125, 0x215, 0x152, 0x161, 0x251, 0x512, 0x521, 0x611, 0x059, 0x149,
+	0x158, 0x095, 0x185, 0x194, 0x590, 0x509, 0x518, 0x491, 0x581, 0x848, 0x815, 0x905, 0x914, 0x851,
+	0x941, 0x950, 0x446, 0x464, 0x644, 0x026, 0x206, 0x224, 0x062, 0x242, 0x260, 0x422, 0x602, 0x620,
+	0x04a, 0x068, 0x248, 0x086, 0x0a4, 0x284, 0x884, 0x428, 0x608, 0x482, 0x4a0, 0x488, 0x806, 0x824,
+	0xa04, 0x842, 0x860, 0xa40, 0x8c0, 0x530, 0xe00, 0x017, 0x035, 0x107, 0x134, 0x305, 0x314, 0x053,
+	0x071, 0x143, 0x170, 0x341, 0x350, 0x710, 0x503, 0xc80, 0x701, 0x2c0, 0x01d, 0x10d, 0x11c, 0x0d1,
+	0x1c1, 0x1d0, 0xc11, 0xd01, 0xd10, 0x44c, 0x4c4, 0xc44, 0x00e, 0x02c, 0x20c, 0x0c2, 0x0e0, 0xc02,
+	0xc20, 0x08c, 0x0c8, 0x80c, 0xc08, 0x431, 0x413, 0x419,
+};
+
+/** Símbolo de parada de Code 128 (13 módulos) */
+static const uint8_t __code_128_stop[7] = { 2, 3, 3, 1, 1, 1, 2 };
+
+/**
+ * @brief Convierte una fila de la máscara en longitudes de tramos.
+ *
+ * El primer tramo es claro (puede medir 0) y después se alternan. Cada
+ * transición se encuentra con un ctz sobre la palabra, así que las zonas
+ * uniformes cuestan una operación por cada 32 píxeles.
+ *
+ * @return Número de tramos.
+ */
+static int __code_runs(const uint32_t *row, uint16_t width, uint16_t *runs)
+{
+	uint32_t start = 0, x = 0;
+	bool light = true;
+	int n = 0;
+
+	while (x < width) {
+		uint32_t word = row[x >> 5];
+		uint32_t diff = (light ? ~word : word) & (~0u << (x & 31));
+
+		if (!diff) {
+			x = (x | 31) + 1;
+			continue;
+		}
+
+		uint32_t end = (x & ~31u) + __builtin_ctz(diff);
+		if (end >= width) {
+			break;
+		}
+		runs[n++] = end - start;
+		start = x = end;
+		light = !light;
+	}
+	runs[n++] = width - start;
+
+	return n;
+}
+
+/**
+ * @brief Bit de la máscara; fuera de la imagen se considera claro.
+ */
+static inline bool __code_light(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, int32_t x,
+				int32_t y)
+{
+	if ((uint32_t)x >= width || (uint32_t)y >= height) {
+		return true;
+	}
+	return (mask[(uint32_t)y * words + (x >> 5)] >> (x & 31)) & 1;
+}
+
+/**
+ * @brief Cuenta los píxeles consecutivos de un color desde (x, y) en la dirección (dx, dy).
+ */
+static int __code_run(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, int32_t x, int32_t y,
+		      int dx, int dy, bool light, int limit)
+{
+	int n = 0;
+
+	while (n < limit && (uint32_t)x < width && (uint32_t)y < height &&
+	       __code_light(mask, words, width, height, x, y) == light) {
+		x += dx;
+		y += dy;
+		n++;
+	}
+
+	return n;
+}
+
+/**
+ * @brief Proporción 1:1:3:1:1 con medio módulo de tolerancia (módulo y medio en el central).
+ */
+static bool __code_finder_ratio(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t e)
+{
+	int32_t t = a + b + c + d + e;
+
+	if (t < 7) {
+		return false;
+	}
+	return 2 * abs(7 * (int32_t)a - t) < t && 2 * abs(7 * (int32_t)b - t) < t && 2 * abs(7 * (int32_t)d - t) < t &&
+	       2 * abs(7 * (int32_t)e - t) < t && 2 * abs(7 * (int32_t)c - 3 * t) < 3 * t;
+}
+
+/**
+ * @brief Comprueba el patrón buscador a lo largo de un eje a través del píxel oscuro (x, y).
+ * @param ref    Longitud del patrón en la fila que lo detectó
+ * @param center Centro del cuadrado central a lo largo del eje
+ * @param total  Longitud del patrón a lo largo del eje
+ */
+static bool __code_finder_cross(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, int32_t x,
+				int32_t y, int dx, int dy, uint32_t ref, float *center, uint32_t *total)
+{
+	const int limit = ref;
+
+	int back = __code_run(mask, words, width, height, x, y, -dx, -dy, false, limit);
+	int fwd = __code_run(mask, words, width, height, x + dx, y + dy, dx, dy, false, limit);
+	int light_back = __code_run(mask, words, width, height, x - back * dx, y - back * dy, -dx, -dy, true, limit);
+	int light_fwd = __code_run(mask, words, width, height, x + (fwd + 1) * dx, y + (fwd + 1) * dy, dx, dy, true,
+				   limit);
+	int dark_back = __code_run(mask, words, width, height, x - (back + light_back) * dx,
+				   y - (back + light_back) * dy, -dx, -dy, false, limit);
+	int dark_fwd = __code_run(mask, words, width, height, x + (fwd + 1 + light_fwd) * dx,
+				  y + (fwd + 1 + light_fwd) * dy, dx, dy, false, limit);
+
+	if (!__code_finder_ratio(dark_back, light_back, back + fwd, light_fwd, dark_fwd)) {
+		return false;
+	}
+
+	*total = dark_back + light_back + back + fwd + light_fwd + dark_fwd;
+	if (5 * abs((int32_t)*total - (int32_t)ref) >= 2 * (int32_t)ref) {
+		return false;
+	}
+
+	// El cuadrado central ocupa [pos - back + 1, pos + fwd]
+	*center = (dx ? x : y) + (fwd - back + 2) / 2.0f;
+	return true;
+}
+
+/**
+ * @brief Confirma un patrón detectado en una fila y lo funde con los ya encontrados.
+ */
+static void __code_add_finder(struct code_reader *reader, const uint32_t *mask, uint32_t words, uint16_t width,
+			      uint16_t height, float x, uint16_t y, uint32_t ref)
+{
+	float cx, cy;
+	uint32_t total_v, total_h;
+
+	if (!__code_finder_cross(mask, words, width, height, x, y, 0, 1, ref, &cy, &total_v) ||
+	    !__code_finder_cross(mask, words, width, height, x, cy, 1, 0, ref, &cx, &total_h)) {
+		return;
+	}
+
+	float module = (total_v + total_h) / 14.0f;
+	for (int i = 0; i < reader->n_finders; i++) {
+		struct code_finder *f = &reader->finders[i];
+
+		if (cx - f->x <= module && f->x - cx <= module && cy - f->y <= module && f->y - cy <= module) {
+			// Media de los impactos, que desplaza el centro hacia el del patrón
+			f->x = (f->x * f->hits + cx) / (f->hits + 1);
+			f->y = (f->y * f->hits + cy) / (f->hits + 1);
+			f->module = (f->module * f->hits + module) / (f->hits + 1);
+			if (f->hits < UINT8_MAX) {
+				f->hits++;
+			}
+			return;
+		}
+	}
+
+	if (reader->n_finders < CODE_MAX_FINDERS) {
+		reader->finders[reader->n_finders++] = (struct code_finder){ cx, cy, module, 1 };
+	}
+}
+
+/**
+ * @brief Busca zonas de barras en los tramos de una fila.
+ *
+ * Una zona empieza en un tramo oscuro tras un claro (la zona de silencio) y
+ * sigue mientras los tramos midan menos de la mitad de ese claro. Acaba en el
+ * primer claro, pasados CODE_MIN_BARS tramos, de al menos vez y media el más
+ * ancho de esos primeros tramos: los elementos de EAN-13 y Code 128 miden de 1
+ * a 4 módulos, su zona de silencio 7 o más, y los primeros tramos ya incluyen
+ * uno de 3 o 4 módulos (las guardas y los símbolos de inicio).
+ */
+static void __code_add_bars(struct code_reader *reader, const uint16_t *runs, int n, uint16_t y)
+{
+	uint32_t x = runs[0];
+
+	for (int i = 1; i < n;) {
+		uint32_t quiet = runs[i - 1], end = x, widest = 0;
+		int j = i;
+
+		while (j < n && 2u * runs[j] < quiet) {
+			if (j - i < CODE_MIN_BARS) {
+				widest = runs[j] > widest ? runs[j] : widest;
+			} else if (((j - i) & 1) && 2 * runs[j] >= 3 * widest) {
+				break;
+			}
+			end += runs[j++];
+		}
+
+		bool found = (j - i) >= CODE_MIN_BARS && ((j - i) & 1) && j < n;
+		if (found) {
+			bool near = false;
+
+			// De una misma zona solo se retienen filas separadas
+			for (int k = 0; k < reader->n_rows; k++) {
+				near |= reader->rows[k].x0 < end && x < reader->rows[k].x1 &&
+					y - reader->rows[k].y < CODE_ROW_SPACING;
+			}
+			if (!near && reader->n_rows < CODE_MAX_ROWS) {
+				reader->rows[reader->n_rows++] = (struct code_bars){ y, x, end };
+			}
+			x = end;
+			i = j;
+		}
+
+		// Siguiente tramo oscuro
+		if (i + 1 >= n) {
+			break;
+		}
+		x += runs[i] + runs[i + 1];
+		i += 2;
+	}
+}
+
+/**
+ * @brief Busca buscadores de QR y zonas de barras en las filas de la máscara.
+ * @return Candidatos, o -1 en error.
+ */
+int PLACEMENT_RAM(code_detect)(struct code_reader *reader, const uint32_t *mask, uint32_t stride, uint16_t width,
+			       uint16_t height)
+{
+	const uint32_t words = stride / 4;
+
+	if (!width || width > CODE_MAX_WIDTH || !height || (stride & 3) || words < (uint32_t)(width + 31) / 32) {
+		return -1;
+	}
+
+	reader->n_finders = 0;
+	reader->n_rows = 0;
+
+	for (uint16_t y = 0; y < height; y += CODE_FINDER_STEP) {
+		const uint16_t *runs = reader->runs;
+		int n = __code_runs(mask + (uint32_t)y * words, width, reader->runs);
+		uint32_t x = runs[0];
+
+		// Tramos oscuros en los índices impares
+		for (int i = 1; i + 4 < n; i += 2) {
+			if (__code_finder_ratio(runs[i], runs[i + 1], runs[i + 2], runs[i + 3], runs[i + 4])) {
+				uint32_t total = runs[i] + runs[i + 1] + runs[i + 2] + runs[i + 3] + runs[i + 4];
+				float cx = x + runs[i] + runs[i + 1] + runs[i + 2] / 2.0f;
+
+				__code_add_finder(reader, mask, words, width, height, cx, y, total);
+			}
+			x += runs[i] + runs[i + 1];
+		}
+
+		if (!(y % CODE_BAR_STEP)) {
+			__code_add_bars(reader, runs, n, y);
+		}
+	}
+
+	return reader->n_finders + reader->n_rows;
+}
+
+/**
+ * @brief Diferencia entre unos tramos y un patrón escalado a su longitud, en 1/modules de módulo.
+ */
+static uint32_t __code_distance(const uint16_t *runs, int step, const uint8_t *widths, int count, uint32_t total,
+				uint32_t modules)
+{
+	uint32_t diff = 0;
+
+	for (int k = 0; k < count; k++) {
+		diff += abs((int32_t)(runs[k * step] * modules) - (int32_t)(widths[k] * total));
+	}
+
+	return diff;
+}
+
+static uint32_t __code_sum(const uint16_t *runs, int step, int count)
+{
+	uint32_t total = 0;
+
+	for (int k = 0; k < count; k++) {
+		total += runs[k * step];
+	}
+
+	return total;
+}
+
+/**
+ * @brief Lee un EAN-13 de 59 tramos que empiezan por la primera barra de guarda.
+ * @return 13, o -1 si no es un EAN-13 válido.
+ */
+static int __code_ean13(const uint16_t *runs, int step, int n, char *text)
+{
+	static const uint8_t guard[5] = { 1, 1, 1, 1, 1 };
+	uint8_t digits[13];
+	uint8_t parity = 0;
+
+	if (n != 59) {
+		return -1;
+	}
+
+	// Guardas de un módulo por elemento, con medio módulo de tolerancia
+	const uint32_t total = __code_sum(runs, step, 59);
+	if (2 * __code_distance(runs, step, guard, 3, total, 95) >= 3 * total ||
+	    2 * __code_distance(runs + 27 * step, step, guard, 5, total, 95) >= 5 * total ||
+	    2 * __code_distance(runs + 56 * step, step, guard, 3, total, 95) >= 3 * total) {
+		return -1;
+	}
+
+	for (int d = 0; d < 12; d++) {
+		const uint16_t *r = runs + (d < 6 ? 3 + 4 * d : 32 + 4 * (d - 6)) * step;
+		const uint32_t sum = __code_sum(r, step, 4);
+		uint32_t best = UINT32_MAX;
+		bool is_g = false;
+
+		// Los dígitos derechos solo usan los anchos de L (el juego R es su complemento)
+		for (int v = 0; v < 10; v++) {
+			const uint8_t *l = __code_ean_digits[v];
+			const uint8_t g[4] = { l[3], l[2], l[1], l[0] };
+			uint32_t dl = __code_distance(r, step, l, 4, sum, 7);
+			uint32_t dg = d < 6 ? __code_distance(r, step, g, 4, sum, 7) : UINT32_MAX;
+
+			if (dl < best) {
+				best = dl;
+				digits[d + 1] = v;
+				is_g = false;
+			}
+			if (dg < best) {
+				best = dg;
+				digits[d + 1] = v;
+				is_g = true;
+			}
+		}
+		if (best >= 2 * sum) {
+			return -1;
+		}
+		if (is_g) {
+			parity |= 1u << (5 - d);
+		}
+	}
+
+	// El primer dígito va codificado en los juegos de los seis izquierdos
+	const uint8_t *first = memchr(__code_ean_parity, parity, sizeof(__code_ean_parity));
+	if (!first) {
+		return -1;
+	}
+	digits[0] = first - __code_ean_parity;
+
+	uint32_t check = 0;
+	for (int d = 0; d < 13; d++) {
+		check += digits[d] * (d & 1 ? 3 : 1);
+	}
+	if (check % 10) {
+		return -1;
+	}
+
+	for (int d = 0; d < 13; d++) {
+		text[d] = '0' + digits[d];
+	}
+	return 13;
+}
+
+/**
+ * @brief Lee un Code 128 de n tramos que empiezan por el símbolo de inicio.
+ * @return Bytes escritos, o -1 si no es un Code 128 válido.
+ */
+static int __code_128(const uint16_t *runs, int step, int n, char *text, uint16_t max_len)
+{
+	if (n < 3 * 6 + 7 || (n - 7) % 6) {
+		return -1;
+	}
+
+	const uint16_t *stop = runs + (n - 7) * step;
+	const uint32_t stop_total = __code_sum(stop, step, 7);
+	if (__code_distance(stop, step, __code_128_stop, 7, stop_total, 13) >= 3 * stop_total) {
+		return -1;
+	}
+
+	const int symbols = (n - 7) / 6;
+	uint32_t check = 0;
+	int set = -1, len = 0;
+	bool shift = false;
+
+	for (int s = 0; s < symbols; s++) {
+		const uint16_t *r = runs + 6 * s * step;
+		const uint32_t sum = __code_sum(r, step, 6);
+		uint32_t best = UINT32_MAX;
+		int value = 0;
+
+		for (int v = 0; v < 106; v++) {
+			uint8_t widths[6];
+
+			for (int k = 0; k < 6; k++) {
+				widths[k] = ((__code_128_symbols[v] >> (2 * (5 - k))) & 3) + 1;
+			}
+			uint32_t d = __code_distance(r, step, widths, 6, sum, 11);
+			if (d < best) {
+				best = d;
+				value = v;
+			}
+		}
+		// Con menos de 2 píxeles por módulo cada elemento puede desviarse medio
+		// módulo; la suma de control descarta las lecturas equivocadas
+		if (best >= 3 * sum) {
+			return -1;
+		}
+
+		if (s == 0) {
+			// Inicio A, B o C
+			if (value < 103) {
+				return -1;
+			}
+			set = value - 103;
+			check = value;
+			continue;
+		}
+		if (s == symbols - 1) {
+			return check % 103 == (uint32_t)value ? len : -1;
+		}
+		check += (uint32_t)s * value;
+
+		if (set == 2) {
+			if (value < 100) {
+				if (len + 2 > max_len) {
+					return -1;
+				}
+				text[len++] = '0' + value / 10;
+				text[len++] = '0' + value % 10;
+			} else if (value == 100 || value == 101) {
+				set = 101 - value;
+			} else if (value != 102) {
+				return -1;
+			}
+			continue;
+		}
+
+		int cur = shift ? !set : set;
+		shift = false;
+		if (value < 96) {
+			if (len + 1 > max_len) {
+				return -1;
+			}
+			text[len++] = cur == 0 && value >= 64 ? value - 64 : value + 32;
+		} else if (value == 98) {
+			shift = true;
+		} else if (value == 99) {
+			set = 2;
+		} else if ((value == 100 && set == 0) || (value == 101 && set == 1)) {
+			set = !set;
+		} else if (value > 102) {
+			return -1;
+		}
+		// FNC1 a FNC4 no producen caracteres
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Añade un código a los resultados si no está ya.
+ */
+static bool __code_emit(struct code_result *results, int *n_results, int max_results, enum code_type type,
+			const char *text, int length, uint16_t x, uint16_t y)
+{
+	for (int i = 0; i < *n_results; i++) {
+		if (results[i].type == type && results[i].length == length && !memcmp(results[i].text, text, length)) {
+			return false;
+		}
+	}
+	if (*n_results >= max_results) {
+		return false;
+	}
+
+	struct code_result *r = &results[(*n_results)++];
+	r->type = type;
+	r->x = x;
+	r->y = y;
+	r->length = length;
+	memcpy(r->text, text, length);
+	r->text[length] = 0;
+	return true;
+}
+
+/**
+ * @brief Comprueba si tres buscadores pueden ser las esquinas de un mismo QR.
+ *
+ * Módulos parecidos, un ángulo casi recto en la esquina opuesta al lado más
+ * largo y unos lados de entre 14 y 26 módulos (versiones 1 a 4) con holgura:
+ * el módulo medido en horizontal y vertical crece hasta √2 con el giro.
+ */
+static bool __code_qr_triple(const struct code_finder *a, const struct code_finder *b, const struct code_finder *c,
+			     float *module)
+{
+	float min = a->module, max = a->module;
+	min = b->module < min ? b->module : min;
+	min = c->module < min ? c->module : min;
+	max = b->module > max ? b->module : max;
+	max = c->module > max ? c->module : max;
+	if (2 * max > 3 * min) {
+		return false;
+	}
+
+	float ab = (a->x - b->x) * (a->x - b->x) + (a->y - b->y) * (a->y - b->y);
+	float bc = (b->x - c->x) * (b->x - c->x) + (b->y - c->y) * (b->y - c->y);
+	float ca = (c->x - a->x) * (c->x - a->x) + (c->y - a->y) * (c->y - a->y);
+	float hyp = ab, leg1 = bc, leg2 = ca;
+	if (bc > hyp) {
+		hyp = bc;
+		leg1 = ab;
+	}
+	if (ca > hyp) {
+		hyp = ca;
+		leg1 = ab;
+		leg2 = bc;
+	}
+
+	float diff = hyp - leg1 - leg2;
+	if (2 * (diff < 0 ? -diff : diff) > leg1 + leg2) {
+		return false;
+	}
+
+	*module = (a->module + b->module + c->module) / 3;
+	float m2 = *module * *module;
+	return leg1 >= 64 * m2 && leg2 >= 64 * m2 && leg1 <= 1024 * m2 && leg2 <= 1024 * m2;
+}
+
+/**
+ * @brief Lee los candidatos de la última detección.
+ * @return Códigos leídos.
+ */
+int code_decode(struct code_reader *reader, const uint32_t *mask, uint32_t stride, uint16_t width, uint16_t height,
+		struct code_result *results, int max_results)
+{
+	const uint32_t words = stride / 4;
+	char text[CODE_MAX_TEXT];
+	uint32_t used = 0;
+	int n_results = 0;
+
+	// QR: cada trío compatible, sin reutilizar buscadores de un código leído
+	for (int a = 0; a < reader->n_finders; a++) {
+		for (int b = a + 1; b < reader->n_finders; b++) {
+			for (int c = b + 1; c < reader->n_finders; c++) {
+				const struct code_finder *f = reader->finders;
+				float module;
+
+				if ((used >> a | used >> b | used >> c) & 1 || !__code_qr_triple(&f[a], &f[b], &f[c], &module)) {
+					continue;
+				}
+
+				const float finders[3][2] = { { f[a].x, f[a].y }, { f[b].x, f[b].y }, { f[c].x, f[c].y } };
+				int len = qr_decode(mask, stride, width, height, finders, module, text, CODE_MAX_TEXT);
+				if (len < 0) {
+					continue;
+				}
+				used |= 1u << a | 1u << b | 1u << c;
+				__code_emit(results, &n_results, max_results, CODE_QR, text, len,
+					    (f[a].x + f[b].x + f[c].x) / 3, (f[a].y + f[b].y + f[c].y) / 3);
+			}
+		}
+	}
+
+	// Barras: los tramos de la fila entre x0 y x1, en los dos sentidos
+	for (int i = 0; i < reader->n_rows; i++) {
+		const struct code_bars *bars = &reader->rows[i];
+		int n = __code_runs(mask + (uint32_t)bars->y * words, width, reader->runs);
+		uint32_t x = 0;
+		int first = 0;
+
+		while (first < n && x < bars->x0) {
+			x += reader->runs[first++];
+		}
+
+		int last = first;
+		while (last < n && x < bars->x1) {
+			x += reader->runs[last++];
+		}
+		if (x != bars->x1 || first == last) {
+			continue;
+		}
+
+		const int count = last - first;
+		const uint16_t cx = (bars->x0 + bars->x1) / 2;
+		for (int dir = 0; dir < 2; dir++) {
+			const uint16_t *runs = dir ? reader->runs + last - 1 : reader->runs + first;
+			const int step = dir ? -1 : 1;
+			int len;
+
+			if ((len = __code_ean13(runs, step, count, text)) >= 0) {
+				__code_emit(results, &n_results, max_results, CODE_EAN13, text, len, cx, bars->y);
+				break;
+			}
+			if ((len = __code_128(runs, step, count, text, CODE_MAX_TEXT)) >= 0) {
+				__code_emit(results, &n_results, max_results, CODE_128, text, len, cx, bars->y);
+				break;
+			}
+		}
+	}
+
+	return n_results;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file code.h
+ * @brief Detección y lectura de códigos QR (versiones 1 a 4), EAN-13 y Code 128 sobre una máscara FORMAT_MONO1.
+ *
+ * La detección recorre filas de la luma umbralizada convertidas en longitudes
+ * de tramos claro/oscuro (las transiciones se buscan 32 píxeles a la vez con
+ * la máscara empaquetada). En ellas busca:
+ *
+ * - Patrones buscadores de QR: cinco tramos en proporción 1:1:3:1:1,
+ *   confirmados con la misma proporción en vertical y otra vez en horizontal
+ *   desde el centro vertical. Los impactos de filas vecinas se funden.
+ * - Zonas de barras: al menos CODE_MIN_BARS tramos estrechos entre dos zonas
+ *   claras anchas.
+ *
+ * Es barato y puede ejecutarse en cada frame; la lectura, mucho más cara, solo
+ * se intenta cuando hay candidatos. Los tríos de buscadores con módulos y
+ * geometría compatibles se leen con vision/qr; las filas de barras se prueban
+ * como EAN-13 y como Code 128 en los dos sentidos.
+ */
+
+#ifndef __CODE_H__
+#define __CODE_H__
+
+#include <stdint.h>
+
+#include "vision/mono1.h"
+
+#define CODE_MAX_WIDTH   MONO1_MAX_WIDTH  /**< Ancho máximo de la máscara */
+#define CODE_MAX_FINDERS 8                /**< Buscadores de QR retenidos por frame */
+#define CODE_MAX_ROWS    8                /**< Filas de barras candidatas retenidas por frame */
+#define CODE_MAX_TEXT    188              /**< Contenido máximo (187 dígitos en un QR 4-L) */
+#define CODE_MIN_BARS    25               /**< Tramos mínimos de un código de barras */
+#define CODE_FINDER_STEP 2                /**< Salto entre filas al buscar buscadores */
+#define CODE_BAR_STEP    4                /**< Salto entre filas al buscar barras */
+
+/**
+ * @enum code_type
+ * @brief Simbología de un código leído.
+ */
+enum code_type {
+    CODE_QR = 0,  /**< QR, versiones 1 a 4 */
+    CODE_EAN13,   /**< EAN-13 (y UPC-A con un 0 delante) */
+    CODE_128,     /**< Code 128, juegos A, B y C */
+};
+
+/**
+ * @struct code_finder
+ * @brief Patrón buscador de QR detectado.
+ */
+struct code_finder {
+    float x;          /**< Columna del centro */
+    float y;          /**< Fila del centro */
+    float module;     /**< Tamaño del módulo en píxeles */
+    uint8_t hits;     /**< Filas que lo han confirmado */
+};
+
+/**
+ * @struct code_bars
+ * @brief Fila con una zona de barras candidata.
+ */
+struct code_bars {
+    uint16_t y;       /**< Fila */
+    uint16_t x0;      /**< Primera columna de la primera barra */
+    uint16_t x1;      /**< Columna siguiente a la última barra */
+};
+
+/**
+ * @struct code_reader
+ * @brief Estado del detector: candidatos del último frame y buffer de tramos.
+ */
+struct code_reader {
+    uint8_t n_finders;                           /**< Buscadores en finders */
+    uint8_t n_rows;                              /**< Filas en rows */
+    struct code_finder finders[CODE_MAX_FINDERS]; /**< Buscadores de QR */
+    struct code_bars rows[CODE_MAX_ROWS];        /**< Filas de barras */
+    uint16_t runs[CODE_MAX_WIDTH + 1];           /**< Tramos de una fila, empezando por uno claro */
+};
+
+/**
+ * @struct code_result
+ * @brief Código leído.
+ */
+struct code_result {
+    enum code_type type;              /**< Simbología */
+    uint16_t x;                       /**< Columna aproximada del centro */
+    uint16_t y;                       /**< Fila aproximada del centro */
+    uint16_t length;                  /**< Bytes de text sin el 0 final */
+    char text[CODE_MAX_TEXT + 1];     /**< Contenido terminado en 0 */
+};
+
+/**
+ * @brief Busca candidatos (buscadores de QR y filas de barras) en una máscara.
+ * @param reader Detector
+ * @param mask   Máscara (bit a 1 = claro), por ejemplo de mono1_threshold()
+ * @param stride Stride de la máscara en bytes (múltiplo de 4)
+ * @param width  Ancho (<= CODE_MAX_WIDTH)
+ * @param height Alto
+ * @return Candidatos encontrados, o -1 si el tamaño no es válido
+ */
+int code_detect(struct code_reader *reader, const uint32_t *mask, uint32_t stride, uint16_t width, uint16_t height);
+
+/**
+ * @brief Lee los códigos de los candidatos de la última code_detect() sobre la misma máscara.
+ * @param reader      Detector
+ * @param mask        Máscara de la detección
+ * @param stride      Stride de la máscara en bytes
+ * @param width       Ancho
+ * @param height      Alto
+ * @param results     Códigos leídos, sin repetidos
+ * @param max_results Capacidad de results
+ * @return Códigos leídos
+ */
+int code_decode(struct code_reader *reader, const uint32_t *mask, uint32_t stride, uint16_t width, uint16_t height,
+                struct code_result *results, int max_results);
+
+#endif /* __CODE_H__ */
@@ -0,0 +1,165 @@
+/**
+ * @file convert.c
+ * @brief Implementación de los kernels de conversión y escalado de píxeles.
+ */
+
+#include <math.h>
+
+#include "runtime/placement.h"
+#include "vision/convert.h"
+
+/**
+ * @brief Intercambia los bytes de los dos píxeles de 16 bits contenidos en una palabra.
+ */
+static inline uint32_t __swap_halfwords(uint32_t w)
+{
+	return ((w & 0x00ff00ff) << 8) | ((w >> 8) & 0x00ff00ff);
+}
+
+/**
+ * @brief Convierte píxeles RGB565 big-endian a uint16_t nativos.
+ * @param dst      Buffer destino.
+ * @param src      Bytes RGB565 big-endian.
+ * @param n_pixels Número de píxeles.
+ */
+void PLACEMENT_RAM(convert_rgb565be_to_native)(uint16_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	uint32_t i = 0;
+
+	// El M0+ no admite accesos de 32 bits desalineados
+	if ((((uintptr_t)dst | (uintptr_t)src) & 3) == 0) {
+		const uint32_t *s = (const uint32_t *)src;
+		uint32_t *d = (uint32_t *)dst;
+		for (; i + 2 <= n_pixels; i += 2) {
+			*d++ = __swap_halfwords(*s++);
+		}
+	}
+
+	for (; i < n_pixels; i++) {
+		dst[i] = (src[2 * i] << 8) | src[2 * i + 1];
+	}
+}
+
+/**
+ * @brief Escala una imagen RGB565 big-endian por vecino más cercano.
+ *
+ * Usa pasos en punto fijo 16.16 para evitar divisiones por píxel.
+ */
+void PLACEMENT_RAM(convert_scale_nn_rgb565be)(uint16_t *dst, uint16_t dst_width, uint16_t dst_height,
+			       const uint8_t *src, uint32_t src_stride, uint16_t src_width, uint16_t src_height)
+{
+	if (!dst_width || !dst_height) {
+		return;
+	}
+
+	uint32_t x_step = ((uint32_t)src_width << 16) / dst_width;
+	uint32_t y_step = ((uint32_t)src_height << 16) / dst_height;
+	uint32_t sy = y_step >> 1;
+
+	for (uint16_t y = 0; y < dst_height; y++, sy += y_step) {
+		const uint8_t *row = src + (sy >> 16) * src_stride;
+		uint32_t sx = x_step >> 1;
+		for (uint16_t x = 0; x < dst_width; x++, sx += x_step) {
+			const uint8_t *p = row + (sx >> 16) * 2;
+			*dst++ = (p[0] << 8) | p[1];
+		}
+	}
+}
+
+static inline uint8_t __clamp_u8(int32_t v)
+{
+	return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+/**
+ * @brief Convierte YUYV a RGB565 con coeficientes BT.601 en punto fijo Q8.
+ *
+ * Los términos de crominancia se calculan una vez por pareja de píxeles.
+ */
+void PLACEMENT_RAM(convert_yuyv_to_rgb565)(uint16_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	for (uint32_t i = 0; i + 2 <= n_pixels; i += 2, src += 4) {
+		int32_t u = src[1] - 128;
+		int32_t v = src[3] - 128;
+		int32_t dr = (359 * v) >> 8;
+		int32_t dg = (88 * u + 183 * v) >> 8;
+		int32_t db = (454 * u) >> 8;
+
+		for (int k = 0; k < 2; k++) {
+			int32_t y = src[2 * k];
+			uint8_t r = __clamp_u8(y + dr);
+			uint8_t g = __clamp_u8(y - dg);
+			uint8_t b = __clamp_u8(y + db);
+			*dst++ = ((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3);
+		}
+	}
+}
+
+/**
+ * @brief Copia las muestras Y de un buffer YUYV.
+ */
+void PLACEMENT_RAM(convert_yuyv_to_y8)(uint8_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	for (uint32_t i = 0; i < n_pixels; i++) {
+		dst[i] = src[2 * i];
+	}
+}
+
+/**
+ * @brief Luma BT.601 de píxeles RGB565 big-endian, coeficientes 77/150/29 escalados a 5/6/5 bits.
+ */
+void PLACEMENT_RAM(convert_rgb565be_to_y8)(uint8_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	for (uint32_t i = 0; i < n_pixels; i++, src += 2) {
+		uint16_t v = (src[0] << 8) | src[1];
+		dst[i] = (((v >> 11) & 0x1f) * 634 + ((v >> 5) & 0x3f) * 607 + (v & 0x1f) * 239) >> 8;
+	}
+}
+
+/**
+ * @brief Genera una LUT de gamma de 8 bits.
+ */
+void convert_gamma_lut8(uint8_t lut[256], float gamma)
+{
+	for (int i = 0; i < 256; i++) {
+		lut[i] = (uint8_t)(255.0f * powf(i / 255.0f, gamma) + 0.5f);
+	}
+}
+
+/**
+ * @brief Deriva la LUT por canal RGB565 de una LUT de 8 bits.
+ */
+void convert_lut565_from_lut8(struct convert_lut565 *lut565, const uint8_t lut8[256])
+{
+	for (int i = 0; i < 32; i++) {
+		uint8_t v = lut8[(i << 3) | (i >> 2)];
+		lut565->r[i] = (v >> 3) << 11;
+		lut565->b[i] = v >> 3;
+	}
+
+	for (int i = 0; i < 64; i++) {
+		uint8_t v = lut8[(i << 2) | (i >> 4)];
+		lut565->g[i] = (v >> 2) << 5;
+	}
+}
+
+/**
+ * @brief Aplica una LUT de 8 bits muestra a muestra.
+ */
+void PLACEMENT_RAM(convert_apply_lut8)(uint8_t *dst, const uint8_t *src, uint32_t n_pixels, const uint8_t lut[256])
+{
+	for (uint32_t i = 0; i < n_pixels; i++) {
+		dst[i] = lut[src[i]];
+	}
+}
+
+/**
+ * @brief Aplica una LUT por canal a píxeles RGB565 nativos.
+ */
+void PLACEMENT_RAM(convert_apply_lut565)(uint16_t *dst, const uint16_t *src, uint32_t n_pixels, const struct convert_lut565 *lut)
+{
+	for (uint32_t i = 0; i < n_pixels; i++) {
+		uint16_t p = src[i];
+		dst[i] = lut->r[p >> 11] | lut->g[(p >> 5) & 0x3f] | lut->b[p & 0x1f];
+	}
+}
@@ -0,0 +1,144 @@
+/**
+ * @file convert.h
+ * @brief Kernels de conversión y escalado de píxeles para los buffers de cámara.
+ *
+ * Los kernels trabajan sobre punteros y strides crudos para poder compilarse
+ * tanto en el dispositivo como en el host.
+ */
+
+#ifndef __CONVERT_H__
+#define __CONVERT_H__
+
+#include <stdint.h>
+
+/**
+ * @brief Convierte píxeles RGB565 big-endian (orden de la OV7670) a uint16_t nativos.
+ *
+ * Procesa dos píxeles por palabra de 32 bits cuando los punteros están alineados.
+ *
+ * @param dst      Buffer destino (n_pixels elementos)
+ * @param src      Bytes RGB565 big-endian
+ * @param n_pixels Número de píxeles a convertir
+ */
+void convert_rgb565be_to_native(uint16_t *dst, const uint8_t *src, uint32_t n_pixels);
+
+/**
+ * @brief Escala una imagen RGB565 big-endian por vecino más cercano.
+ *
+ * La salida queda en uint16_t nativos, lista para la pantalla o para el stream.
+ *
+ * @param dst        Buffer destino (dst_width * dst_height elementos)
+ * @param dst_width  Ancho destino en píxeles
+ * @param dst_height Alto destino en píxeles
+ * @param src        Datos RGB565 big-endian de origen
+ * @param src_stride Stride de origen en bytes
+ * @param src_width  Ancho de origen en píxeles
+ * @param src_height Alto de origen en píxeles
+ */
+void convert_scale_nn_rgb565be(uint16_t *dst, uint16_t dst_width, uint16_t dst_height,
+			       const uint8_t *src, uint32_t src_stride, uint16_t src_width, uint16_t src_height);
+
+/**
+ * @struct convert_lut565
+ * @brief LUT por canal para RGB565, con las entradas ya desplazadas a su posición.
+ *
+ * Un píxel se transforma como r[p >> 11] | g[(p >> 5) & 0x3f] | b[p & 0x1f].
+ */
+struct convert_lut565 {
+    uint16_t r[32];  /**< Canal rojo (bits 15-11) */
+    uint16_t g[64];  /**< Canal verde (bits 10-5) */
+    uint16_t b[32];  /**< Canal azul (bits 4-0) */
+};
+
+/**
+ * @brief Convierte píxeles YUYV (BT.601, rango completo) a RGB565 nativo.
+ * @param dst      Buffer destino (n_pixels elementos)
+ * @param src      Bytes YUYV (Y0 U Y1 V)
+ * @param n_pixels Número de píxeles (par)
+ */
+void convert_yuyv_to_rgb565(uint16_t *dst, const uint8_t *src, uint32_t n_pixels);
+
+/**
+ * @brief Extrae el plano de luma de píxeles YUYV.
+ * @param dst      Buffer destino de luma (n_pixels bytes)
+ * @param src      Bytes YUYV
+ * @param n_pixels Número de píxeles
+ */
+void convert_yuyv_to_y8(uint8_t *dst, const uint8_t *src, uint32_t n_pixels);
+
+/**
+ * @brief Calcula la luma BT.601 de píxeles RGB565 big-endian.
+ * @param dst      Buffer destino de luma (n_pixels bytes)
+ * @param src      Bytes RGB565 big-endian
+ * @param n_pixels Número de píxeles
+ */
+void convert_rgb565be_to_y8(uint8_t *dst, const uint8_t *src, uint32_t n_pixels);
+
+/**
+ * @brief Genera una LUT de 8 bits con la curva de gamma indicada.
+ *
+ * Se ejecuta una vez al configurar; no se usa en el camino por píxel.
+ *
+ * @param lut   LUT destino de 256 entradas
+ * @param gamma Exponente (por ejemplo 0.45 para aclarar, 2.2 para oscurecer)
+ */
+void convert_gamma_lut8(uint8_t lut[256], float gamma);
+
+/**
+ * @brief Construye la LUT RGB565 a partir de una LUT de 8 bits común a los tres canales.
+ * @param lut565 LUT RGB565 destino
+ * @param lut8   LUT de 8 bits (gamma, contraste, etc.)
+ */
+void convert_lut565_from_lut8(struct convert_lut565 *lut565, const uint8_t lut8[256]);
+
+/**
+ * @brief Aplica una LUT por canal a píxeles RGB565 nativos.
+ * @param dst      Buffer destino (puede coincidir con src)
+ * @param src      Píxeles RGB565 nativos
+ * @param n_pixels Número de píxeles
+ * @param lut      LUT por canal
+ */
+void convert_apply_lut565(uint16_t *dst, const uint16_t *src, uint32_t n_pixels, const struct convert_lut565 *lut);
+
+/**
+ * @brief Aplica una LUT de 8 bits a un plano de luma.
+ * @param dst      Buffer destino (puede coincidir con src)
+ * @param src      Muestras de 8 bits
+ * @param n_pixels Número de muestras
+ * @param lut      LUT de 256 entradas
+ */
+void convert_apply_lut8(uint8_t *dst, const uint8_t *src, uint32_t n_pixels, const uint8_t lut[256]);
+
+/*
+ * Variantes con los interpoladores del RP2040 (convert_interp.c). Dan el mismo
+ * resultado bit a bit que las versiones en C; en el host, o si los punteros no
+ * cumplen la alineación que necesitan, llaman a la versión en C.
+ *
+ * Usan interp0 e interp1 del núcleo que las llama y restauran su estado al
+ * terminar, pero no deben llamarse desde una ISR que interrumpa a otra
+ * usuaria de los interpoladores en el mismo núcleo.
+ */
+
+/**
+ * @brief convert_scale_nn_rgb565be() con interp0 generando la dirección de cada píxel origen.
+ */
+void convert_scale_nn_rgb565be_interp(uint16_t *dst, uint16_t dst_width, uint16_t dst_height,
+				      const uint8_t *src, uint32_t src_stride, uint16_t src_width, uint16_t src_height);
+
+/**
+ * @brief convert_yuyv_to_rgb565() con los términos de crominancia en tablas direccionadas por interp0.
+ */
+void convert_yuyv_to_rgb565_interp(uint16_t *dst, const uint8_t *src, uint32_t n_pixels);
+
+/**
+ * @brief convert_rgb565be_to_y8() con los canales extraídos por interp0/interp1 como índices de tablas de pesos.
+ */
+void convert_rgb565be_to_y8_interp(uint8_t *dst, const uint8_t *src, uint32_t n_pixels);
+
+/**
+ * @brief convert_apply_lut565() con interp0/interp1 calculando la dirección de cada canal en la LUT.
+ */
+void convert_apply_lut565_interp(uint16_t *dst, const uint16_t *src, uint32_t n_pixels,
+				 const struct convert_lut565 *lut);
+
+#endif /* __CONVERT_H__ */
@@ -0,0 +1,236 @@
+/**
+ * @file convert_interp.c
+ * @brief Kernels de conversión con los interpoladores del RP2040.
+ *
+ * Cada interpolador toma un acumulador, lo desplaza, lo enmascara y le suma
+ * una base, así que una sola escritura seguida de lecturas PEEK/POP da la
+ * dirección de una entrada de tabla o del siguiente píxel origen. El cambio
+ * de orden de bytes RGB565 no tiene variante: la versión SWAR de convert.c ya
+ * usa menos operaciones por píxel de las que costaría pasar por el interpolador.
+ */
+
+#include "runtime/placement.h"
+#include "vision/convert.h"
+
+#if PICO_ON_DEVICE
+
+#include <stdbool.h>
+
+#include "hardware/interp.h"
+
+// Términos de crominancia de convert_yuyv_to_rgb565() por valor de U y V (centrados en 128)
+static int16_t yuv_u_terms[256][2];  // { (454 * u) >> 8, 88 * u }
+static int16_t yuv_v_terms[256][2];  // { (359 * v) >> 8, 183 * v }
+static bool yuv_terms_ready;
+
+// Pesos de luma de convert_rgb565be_to_y8() por valor de canal
+static uint16_t luma_r[32], luma_g[64], luma_b[32];
+static bool luma_ready;
+
+/**
+ * @brief Configura una línea del interpolador para extraer un campo como índice de tabla.
+ * @param interp    Interpolador
+ * @param lane      Línea (0 o 1)
+ * @param shift     Desplazamiento a la derecha del acumulador
+ * @param mask_lsb  Primer bit del índice ya multiplicado por el tamaño de entrada
+ * @param mask_msb  Último bit del índice
+ * @param cross     La línea 1 lee el acumulador 0
+ */
+static void interp_lane_field(interp_hw_t *interp, uint lane, uint shift, uint mask_lsb, uint mask_msb, bool cross)
+{
+	interp_config cfg = interp_default_config();
+	interp_config_set_shift(&cfg, shift);
+	interp_config_set_mask(&cfg, mask_lsb, mask_msb);
+	interp_config_set_cross_input(&cfg, cross);
+	interp_set_config(interp, lane, &cfg);
+}
+
+/**
+ * @brief Escalado por vecino más cercano: interp0 recorre la fila en punto fijo 16.16.
+ *
+ * Con ADD_RAW en la línea 0, cada POP2 devuelve fila + (sx >> 16) * 2 y suma
+ * el paso al acumulador, así que el bucle interno es una lectura y una copia.
+ */
+void PLACEMENT_RAM(convert_scale_nn_rgb565be_interp)(uint16_t *dst, uint16_t dst_width, uint16_t dst_height,
+				      const uint8_t *src, uint32_t src_stride, uint16_t src_width, uint16_t src_height)
+{
+	if (!dst_width || !dst_height) {
+		return;
+	}
+
+	interp_hw_save_t saved;
+	interp_save(interp0, &saved);
+
+	interp_config cfg = interp_default_config();
+	interp_config_set_add_raw(&cfg, true);
+	interp_config_set_shift(&cfg, 15);
+	interp_config_set_mask(&cfg, 1, 15);
+	interp_set_config(interp0, 0, &cfg);
+	interp_lane_field(interp0, 1, 0, 0, 0, false);
+
+	uint32_t x_step = ((uint32_t)src_width << 16) / dst_width;
+	uint32_t y_step = ((uint32_t)src_height << 16) / dst_height;
+	uint32_t sy = y_step >> 1;
+
+	interp0->base[0] = x_step;
+	interp0->base[1] = 0;
+	interp0->accum[1] = 0;
+	for (uint16_t y = 0; y < dst_height; y++, sy += y_step) {
+		interp0->base[2] = (uintptr_t)(src + (sy >> 16) * src_stride);
+		interp0->accum[0] = x_step >> 1;
+		for (uint16_t x = 0; x < dst_width; x++) {
+			const uint8_t *p = (const uint8_t *)interp0->pop[2];
+			*dst++ = (p[0] << 8) | p[1];
+		}
+	}
+
+	interp_restore(interp0, &saved);
+}
+
+/**
+ * @brief YUYV a RGB565: interp0 convierte la palabra Y0 U Y1 V en las direcciones de los términos de U y V.
+ */
+void PLACEMENT_RAM(convert_yuyv_to_rgb565_interp)(uint16_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	if ((uintptr_t)src & 3) {
+		convert_yuyv_to_rgb565(dst, src, n_pixels);
+		return;
+	}
+
+	if (!yuv_terms_ready) {
+		for (int i = 0; i < 256; i++) {
+			int32_t c = i - 128;
+			yuv_u_terms[i][0] = (454 * c) >> 8;
+			yuv_u_terms[i][1] = 88 * c;
+			yuv_v_terms[i][0] = (359 * c) >> 8;
+			yuv_v_terms[i][1] = 183 * c;
+		}
+		yuv_terms_ready = true;
+	}
+
+	interp_hw_save_t saved;
+	interp_save(interp0, &saved);
+
+	// U en los bits 15:8 y V en los bits 31:24; entradas de 4 bytes
+	interp_lane_field(interp0, 0, 6, 2, 9, false);
+	interp_lane_field(interp0, 1, 22, 2, 9, true);
+	interp0->base[0] = (uintptr_t)yuv_u_terms;
+	interp0->base[1] = (uintptr_t)yuv_v_terms;
+
+	const uint32_t *s = (const uint32_t *)src;
+	for (uint32_t i = 0; i + 2 <= n_pixels; i += 2) {
+		uint32_t w = *s++;
+		interp0->accum[0] = w;
+		const int16_t *tu = (const int16_t *)interp0->peek[0];
+		const int16_t *tv = (const int16_t *)interp0->peek[1];
+		int32_t dr = tv[0];
+		int32_t dg = (tu[1] + tv[1]) >> 8;
+		int32_t db = tu[0];
+
+		for (int k = 0; k < 2; k++, w >>= 16) {
+			int32_t y = w & 0xff;
+			int32_t r = y + dr, g = y - dg, b = y + db;
+			r = r < 0 ? 0 : (r > 255 ? 255 : r);
+			g = g < 0 ? 0 : (g > 255 ? 255 : g);
+			b = b < 0 ? 0 : (b > 255 ? 255 : b);
+			*dst++ = ((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3);
+		}
+	}
+
+	interp_restore(interp0, &saved);
+}
+
+/**
+ * @brief Luma de RGB565: interp0 da las direcciones de los pesos de R y G, interp1 la de B.
+ */
+void PLACEMENT_RAM(convert_rgb565be_to_y8_interp)(uint8_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	if (!luma_ready) {
+		for (int i = 0; i < 32; i++) {
+			luma_r[i] = i * 634;
+			luma_b[i] = i * 239;
+		}
+		for (int i = 0; i < 64; i++) {
+			luma_g[i] = i * 607;
+		}
+		luma_ready = true;
+	}
+
+	interp_hw_save_t saved0, saved1;
+	interp_save(interp0, &saved0);
+	interp_save(interp1, &saved1);
+
+	// Índices ya multiplicados por 2 (entradas uint16_t)
+	interp_lane_field(interp0, 0, 10, 1, 5, false);
+	interp_lane_field(interp0, 1, 4, 1, 6, true);
+	interp_lane_field(interp1, 0, 0, 1, 5, false);
+	interp0->base[0] = (uintptr_t)luma_r;
+	interp0->base[1] = (uintptr_t)luma_g;
+	interp1->base[0] = (uintptr_t)luma_b;
+
+	for (uint32_t i = 0; i < n_pixels; i++, src += 2) {
+		uint32_t v = (src[0] << 8) | src[1];
+		interp0->accum[0] = v;
+		interp1->accum[0] = v << 1;
+		dst[i] = (*(const uint16_t *)interp0->peek[0] + *(const uint16_t *)interp0->peek[1] +
+			  *(const uint16_t *)interp1->peek[0]) >> 8;
+	}
+
+	interp_restore(interp0, &saved0);
+	interp_restore(interp1, &saved1);
+}
+
+/**
+ * @brief LUT RGB565: interp0 da las direcciones de R y G en la LUT, interp1 la de B.
+ */
+void PLACEMENT_RAM(convert_apply_lut565_interp)(uint16_t *dst, const uint16_t *src, uint32_t n_pixels,
+				 const struct convert_lut565 *lut)
+{
+	interp_hw_save_t saved0, saved1;
+	interp_save(interp0, &saved0);
+	interp_save(interp1, &saved1);
+
+	interp_lane_field(interp0, 0, 10, 1, 5, false);
+	interp_lane_field(interp0, 1, 4, 1, 6, true);
+	interp_lane_field(interp1, 0, 0, 1, 5, false);
+	interp0->base[0] = (uintptr_t)lut->r;
+	interp0->base[1] = (uintptr_t)lut->g;
+	interp1->base[0] = (uintptr_t)lut->b;
+
+	for (uint32_t i = 0; i < n_pixels; i++) {
+		uint32_t p = src[i];
+		interp0->accum[0] = p;
+		interp1->accum[0] = p << 1;
+		dst[i] = *(const uint16_t *)interp0->peek[0] | *(const uint16_t *)interp0->peek[1] |
+			 *(const uint16_t *)interp1->peek[0];
+	}
+
+	interp_restore(interp0, &saved0);
+	interp_restore(interp1, &saved1);
+}
+
+#else /* !PICO_ON_DEVICE */
+
+void convert_scale_nn_rgb565be_interp(uint16_t *dst, uint16_t dst_width, uint16_t dst_height,
+				      const uint8_t *src, uint32_t src_stride, uint16_t src_width, uint16_t src_height)
+{
+	convert_scale_nn_rgb565be(dst, dst_width, dst_height, src, src_stride, src_width, src_height);
+}
+
+void convert_yuyv_to_rgb565_interp(uint16_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	convert_yuyv_to_rgb565(dst, src, n_pixels);
+}
+
+void convert_rgb565be_to_y8_interp(uint8_t *dst, const uint8_t *src, uint32_t n_pixels)
+{
+	convert_rgb565be_to_y8(dst, src, n_pixels);
+}
+
+void convert_apply_lut565_interp(uint16_t *dst, const uint16_t *src, uint32_t n_pixels,
+				 const struct convert_lut565 *lut)
+{
+	convert_apply_lut565(dst, src, n_pixels, lut);
+}
+
+#endif
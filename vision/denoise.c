@@ -0,0 +1,213 @@
+/**
+ * @file denoise.c
+ * @brief Implementación del promedio temporal recursivo con SWAR.
+ */
+
+#include <string.h>
+
+#include "camera/format.h"
+#include "runtime/placement.h"
+#include "vision/denoise.h"
+
+/**
+ * @brief Una muestra: el mismo cálculo que un carril de __denoise_lanes.
+ */
+static inline uint8_t __denoise_u8(uint8_t c, uint8_t r, uint8_t shift, uint8_t motion)
+{
+	int32_t diff = (int32_t)c - r;
+
+	if (diff > motion || diff < -(int32_t)motion) {
+		return c;
+	}
+	return r + ((256 + diff + (1 << (shift - 1))) >> shift) - (256 >> shift);
+}
+
+/**
+ * @brief Dos muestras en carriles de 16 bits (bits 0-7 y 16-23 de c y r).
+ *
+ * d = 256 + c - r ocupa 9 bits por carril y nunca toma prestado del vecino.
+ * El movimiento se detecta con el bit 15 de cada carril al sumar o restar d de
+ * una constante, y la media es r + redondeo(d / 2^shift) - 256 / 2^shift.
+ */
+static inline uint32_t __denoise_lanes(uint32_t c, uint32_t r, uint32_t k_above, uint32_t k_below, uint32_t half,
+				       uint32_t keep, uint32_t bias, uint8_t shift)
+{
+	uint32_t d = (c | 0x01000100) - r;
+	uint32_t moving = (((d + k_above) | (k_below - d)) & 0x80008000) >> 15;
+	uint32_t mask = moving * 0xffff;
+	uint32_t avg = r + (((d + half) >> shift) & keep) - bias;
+
+	return (c & mask) | (avg & ~mask);
+}
+
+/**
+ * @brief Promedio recursivo de muestras de 8 bits: cuatro por palabra si los buffers están alineados.
+ */
+void PLACEMENT_RAM(denoise_y8)(uint8_t *frame, uint8_t *ref, uint32_t n, uint8_t shift, uint8_t motion)
+{
+	uint32_t i = 0;
+
+	// El M0+ no admite accesos de 32 bits desalineados
+	if ((((uintptr_t)frame | (uintptr_t)ref) & 3) == 0) {
+		const uint32_t k_above = (0x8000u - 257 - motion) * 0x00010001;
+		const uint32_t k_below = (0x8000u + 255 - motion) * 0x00010001;
+		const uint32_t half = (1u << (shift - 1)) * 0x00010001;
+		const uint32_t keep = (0x3ffu >> shift) * 0x00010001;
+		const uint32_t bias = (256u >> shift) * 0x00010001;
+		uint32_t *f = (uint32_t *)frame;
+		uint32_t *r = (uint32_t *)ref;
+
+		for (; i + 4 <= n; i += 4, f++, r++) {
+			uint32_t c = *f, q = *r;
+			uint32_t even = __denoise_lanes(c & 0x00ff00ff, q & 0x00ff00ff, k_above, k_below, half, keep,
+							bias, shift);
+			uint32_t odd = __denoise_lanes((c >> 8) & 0x00ff00ff, (q >> 8) & 0x00ff00ff, k_above, k_below,
+						       half, keep, bias, shift);
+			uint32_t out = even | (odd << 8);
+			*f = out;
+			*r = out;
+		}
+	}
+
+	for (; i < n; i++) {
+		frame[i] = ref[i] = __denoise_u8(frame[i], ref[i], shift, motion);
+	}
+}
+
+/*
+ * Canales de un píxel RGB565 separados en una palabra: B en los bits 0-4,
+ * R en 11-15 y G en 21-26. Cada canal tiene al menos dos bits libres encima
+ * para el desplazamiento de 2^n y el redondeo.
+ */
+#define DENOISE_565_FIELDS 0x07e0f81fu
+#define DENOISE_565_BIAS   ((1u << 5) | (1u << 16) | (1u << 27))  /**< 2^n encima de cada canal */
+#define DENOISE_565_ONE    ((1u << 0) | (1u << 11) | (1u << 21))  /**< 1 en cada canal */
+
+static inline uint32_t __denoise_565_spread(uint16_t v)
+{
+	return (v | ((uint32_t)v << 16)) & DENOISE_565_FIELDS;
+}
+
+static inline uint16_t __denoise_565_pack(uint32_t x)
+{
+	x &= DENOISE_565_FIELDS;
+	return x | (x >> 16);
+}
+
+/**
+ * @brief Un píxel nativo: media por canal con la decisión de movimiento del verde.
+ */
+static inline uint16_t __denoise_565(uint16_t c, uint16_t r, uint32_t half, uint32_t keep, uint32_t bias,
+				     uint8_t shift, int32_t motion)
+{
+	uint32_t cs = __denoise_565_spread(c);
+	uint32_t rs = __denoise_565_spread(r);
+	int32_t diff = (int32_t)((cs >> 21) & 0x3f) - (int32_t)((rs >> 21) & 0x3f);
+
+	if (diff > motion || diff < -motion) {
+		return c;
+	}
+
+	uint32_t d = (cs | DENOISE_565_BIAS) - rs;
+	return __denoise_565_pack(rs + (((d + half) >> shift) & keep) - bias);
+}
+
+/**
+ * @brief Promedio recursivo de píxeles RGB565 big-endian, dos por palabra si los buffers están alineados.
+ */
+void PLACEMENT_RAM(denoise_rgb565be)(uint8_t *frame, uint8_t *ref, uint32_t n_pixels, uint8_t shift, uint8_t motion)
+{
+	const uint32_t half = (1u << (shift - 1)) * DENOISE_565_ONE;
+	const uint32_t keep = (0x7fu >> shift) | ((0x7fu >> shift) << 11) | ((0xffu >> shift) << 21);
+	const uint32_t bias = DENOISE_565_BIAS >> shift;
+	const int32_t motion_g = motion >> 2;
+	uint32_t i = 0;
+
+	if ((((uintptr_t)frame | (uintptr_t)ref) & 3) == 0) {
+		uint32_t *f = (uint32_t *)frame;
+		uint32_t *r = (uint32_t *)ref;
+
+		for (; i + 2 <= n_pixels; i += 2, f++, r++) {
+			// Intercambio de bytes: el píxel 0 queda en la mitad baja, ya en orden nativo
+			uint32_t c = ((*f & 0x00ff00ff) << 8) | ((*f >> 8) & 0x00ff00ff);
+			uint32_t q = ((*r & 0x00ff00ff) << 8) | ((*r >> 8) & 0x00ff00ff);
+			uint32_t out = __denoise_565(c, q, half, keep, bias, shift, motion_g) |
+				       ((uint32_t)__denoise_565(c >> 16, q >> 16, half, keep, bias, shift, motion_g) << 16);
+			out = ((out & 0x00ff00ff) << 8) | ((out >> 8) & 0x00ff00ff);
+			*f = out;
+			*r = out;
+		}
+	}
+
+	for (; i < n_pixels; i++) {
+		uint8_t *p = frame + 2 * i;
+		uint8_t *q = ref + 2 * i;
+		uint16_t v = __denoise_565((p[0] << 8) | p[1], (q[0] << 8) | q[1], half, keep, bias, shift, motion_g);
+		p[0] = q[0] = v >> 8;
+		p[1] = q[1] = v & 0xff;
+	}
+}
+
+/**
+ * @brief Configura el filtro sobre la referencia.
+ * @return 0 en éxito, -1 en error.
+ */
+int denoise_init(struct denoise *dn, struct camera_buffer *ref, uint8_t shift, uint8_t motion)
+{
+	if (!ref || !shift || shift > DENOISE_MAX_SHIFT) {
+		return -1;
+	}
+
+	*dn = (struct denoise){
+		.ref = ref,
+		.shift = shift,
+		.motion = motion,
+		.primed = false,
+	};
+
+	return 0;
+}
+
+/**
+ * @brief Descarta la referencia.
+ */
+void denoise_reset(struct denoise *dn)
+{
+	dn->primed = false;
+}
+
+/**
+ * @brief Filtra un frame en el sitio; el primero tras init o reset solo se copia.
+ * @return 0 en éxito, -1 si el frame no coincide con la referencia.
+ */
+int denoise_frame(struct denoise *dn, struct camera_buffer *buf)
+{
+	struct camera_buffer *ref = dn->ref;
+	uint8_t num_planes = format_num_planes(buf->format);
+
+	if (buf->format != ref->format || buf->width != ref->width || buf->height != ref->height || !num_planes) {
+		return -1;
+	}
+
+	for (int i = 0; i < num_planes; i++) {
+		if (buf->sizes[i] != ref->sizes[i]) {
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < num_planes; i++) {
+		if (!dn->primed) {
+			memcpy(ref->data[i], buf->data[i], buf->sizes[i]);
+		} else if (buf->format == FORMAT_RGB565) {
+			denoise_rgb565be(buf->data[i], ref->data[i], buf->sizes[i] / 2, dn->shift, dn->motion);
+		} else if (buf->format == FORMAT_MONO1) {
+			// Una máscara no se promedia
+			memcpy(ref->data[i], buf->data[i], buf->sizes[i]);
+		} else {
+			denoise_y8(buf->data[i], ref->data[i], buf->sizes[i], dn->shift, dn->motion);
+		}
+	}
+	dn->primed = true;
+
+	return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file denoise.h
+ * @brief Reducción temporal de ruido por promedio recursivo adaptado al movimiento.
+ *
+ * Cada píxel de la referencia sigue una media exponencial de los frames:
+ * ref += (frame - ref) / 2^shift, con redondeo y en punto fijo. Si la
+ * diferencia entre el frame y la referencia supera el umbral de movimiento, el
+ * píxel se toma del frame sin promediar, de modo que lo que se mueve no deja
+ * estela. El resultado se escribe en el frame (en el sitio) y en la referencia.
+ *
+ * Los kernels trabajan con SWAR: en Y8 dos carriles de 16 bits por palabra
+ * (cuatro muestras en dos pasadas) y en RGB565 los tres canales de un píxel
+ * separados dentro de una palabra, con un bit de margen para la diferencia con
+ * signo. Para YUYV y YUV422 se usa el kernel de Y8 sobre todos los bytes, de
+ * modo que la crominancia también se promedia.
+ *
+ * La referencia es el buffer de un frame del pool que la aplicación retiene
+ * mientras el filtro está activo (frame_pool_acquire() y denoise_init()).
+ */
+
+#ifndef __DENOISE_H__
+#define __DENOISE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "camera/buffer.h"
+
+#define DENOISE_MAX_SHIFT 4  /**< Peso mínimo del frame nuevo: 1/16 */
+
+/**
+ * @struct denoise
+ * @brief Estado del filtro temporal.
+ */
+struct denoise {
+    struct camera_buffer *ref;  /**< Buffer del frame del pool retenido como referencia */
+    uint8_t shift;              /**< Peso del frame nuevo: 1/2^shift */
+    uint8_t motion;             /**< Umbral de movimiento en niveles de 8 bits */
+    bool primed;                /**< La referencia contiene ya un frame */
+};
+
+/**
+ * @brief Configura el filtro sobre un frame de referencia del pool.
+ * @param dn     Estado
+ * @param ref    Buffer de un frame adquirido del pool, del mismo formato y tamaño que los frames a filtrar
+ * @param shift  Peso del frame nuevo como 1/2^shift (1..DENOISE_MAX_SHIFT)
+ * @param motion Diferencia a partir de la cual un píxel se considera en movimiento
+ * @return 0 en éxito, -1 si los parámetros no son válidos
+ */
+int denoise_init(struct denoise *dn, struct camera_buffer *ref, uint8_t shift, uint8_t motion);
+
+/**
+ * @brief Descarta la referencia: el próximo frame se copia sin promediar.
+ * @param dn Estado
+ */
+void denoise_reset(struct denoise *dn);
+
+/**
+ * @brief Filtra un frame en el sitio y actualiza la referencia.
+ * @param dn  Estado
+ * @param buf Frame a filtrar
+ * @return 0 en éxito, -1 si el formato o el tamaño no coinciden con la referencia
+ */
+int denoise_frame(struct denoise *dn, struct camera_buffer *buf);
+
+/**
+ * @brief Promedio recursivo de muestras de 8 bits.
+ * @param frame  Muestras del frame nuevo; recibe el resultado
+ * @param ref    Referencia; recibe el resultado
+ * @param n      Número de muestras
+ * @param shift  Peso del frame nuevo como 1/2^shift (1..DENOISE_MAX_SHIFT)
+ * @param motion Umbral de movimiento
+ */
+void denoise_y8(uint8_t *frame, uint8_t *ref, uint32_t n, uint8_t shift, uint8_t motion);
+
+/**
+ * @brief Promedio recursivo de píxeles RGB565 big-endian, por canal.
+ *
+ * El movimiento se decide con el canal verde (umbral motion / 4 sobre 6 bits).
+ *
+ * @param frame    Píxeles del frame nuevo; recibe el resultado
+ * @param ref      Referencia; recibe el resultado
+ * @param n_pixels Número de píxeles
+ * @param shift    Peso del frame nuevo como 1/2^shift (1..DENOISE_MAX_SHIFT)
+ * @param motion   Umbral de movimiento en niveles de 8 bits
+ */
+void denoise_rgb565be(uint8_t *frame, uint8_t *ref, uint32_t n_pixels, uint8_t shift, uint8_t motion);
+
+#endif /* __DENOISE_H__ */
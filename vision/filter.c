@@ -0,0 +1,45 @@
+/**
+ * @file filter.c
+ * @brief Implementación de filtros espaciales sobre luma de 8 bits.
+ */
+
+#include "runtime/placement.h"
+#include "vision/filter.h"
+
+/**
+ * @brief Filtro de caja 3x3 con sumas de columna deslizantes.
+ * @return 0 en éxito, -1 si el ancho excede FILTER_MAX_WIDTH.
+ */
+int PLACEMENT_RAM(filter_box3_y8)(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+		   uint16_t width, uint16_t height)
+{
+	// Sumas verticales de 3 filas por columna, más una columna replicada a cada lado;
+	// en SCRATCH_Y para no competir en el bus con los DMA de captura y pantalla
+	static uint16_t PLACEMENT_SCRATCH_Y_DATA("filter") col[FILTER_MAX_WIDTH + 2];
+
+	if (width > FILTER_MAX_WIDTH || width < 1 || height < 1) {
+		return -1;
+	}
+
+	for (uint16_t y = 0; y < height; y++) {
+		const uint8_t *above = src + (y ? y - 1 : 0) * src_stride;
+		const uint8_t *row = src + y * src_stride;
+		const uint8_t *below = src + (y + 1 < height ? y + 1 : y) * src_stride;
+
+		for (uint16_t x = 0; x < width; x++) {
+			col[x + 1] = above[x] + row[x] + below[x];
+		}
+		col[0] = col[1];
+		col[width + 1] = col[width];
+
+		uint8_t *out = dst + y * dst_stride;
+		uint32_t sum = col[0] + col[1] + col[2];
+		for (uint16_t x = 0; x < width; x++) {
+			// sum / 9 redondeado, como multiplicación y desplazamiento (exacto para sum <= 2295)
+			out[x] = (sum * 7282 + 0x8000) >> 16;
+			sum += col[x + 3 < width + 2 ? x + 3 : width + 1] - col[x];
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file filter.h
+ * @brief Filtros espaciales sobre planos de luma de 8 bits.
+ */
+
+#ifndef __FILTER_H__
+#define __FILTER_H__
+
+#include <stdint.h>
+
+/**
+ * @brief Filtro de caja 3x3 sobre un plano Y8, con bordes replicados.
+ *
+ * Usa sumas de columna deslizantes: unas 4 sumas y una división por
+ * multiplicación por píxel, independientemente del tamaño del frame.
+ *
+ * @param dst        Plano destino (no puede coincidir con src)
+ * @param dst_stride Stride destino en bytes
+ * @param src        Plano origen
+ * @param src_stride Stride origen en bytes
+ * @param width      Ancho en píxeles (<= FILTER_MAX_WIDTH)
+ * @param height     Alto en píxeles
+ * @return 0 en éxito, -1 si el ancho no está soportado
+ */
+int filter_box3_y8(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+                   uint16_t width, uint16_t height);
+
+#define FILTER_MAX_WIDTH 320  /**< Ancho máximo para los buffers de línea internos */
+
+#endif /* __FILTER_H__ */
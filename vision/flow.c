@@ -0,0 +1,380 @@
+/**
+ * @file flow.c
+ * @brief Implementación del seguimiento KLT piramidal en punto fijo.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "runtime/placement.h"
+#include "vision/flow.h"
+
+#define FLOW_HALF  (FLOW_WINDOW / 2)             /**< Radio de la ventana */
+#define FLOW_AREA  (FLOW_WINDOW * FLOW_WINDOW)   /**< Píxeles de la ventana */
+#define FLOW_PATCH (FLOW_WINDOW + 2)             /**< Lado de la ventana con el margen de los gradientes */
+
+/**
+ * @struct flow_window
+ * @brief Ventana del frame anterior precalculada para un nivel.
+ *
+ * Valores en Q5 y gradientes en Q3: el producto del error por un gradiente
+ * (Q8) acumulado en toda la ventana cabe en 32 bits.
+ */
+struct flow_window {
+    int16_t value[FLOW_AREA];    /**< Muestras bilineales en Q5 */
+    int16_t grad_x[FLOW_AREA];   /**< Gradiente horizontal en Q3 */
+    int16_t grad_y[FLOW_AREA];   /**< Gradiente vertical en Q3 */
+    int64_t inv[3];              /**< Inversa de la matriz de estructura (xx, xy, yy) escalada por 2^32 */
+    uint32_t eigen;              /**< Autovalor mínimo por píxel, en niveles² */
+};
+
+/**
+ * @brief Reduce un plano a la mitad con la media de cada bloque 2x2.
+ */
+static void __flow_halve(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint16_t width,
+			 uint16_t height)
+{
+	for (uint16_t y = 0; y < height; y++) {
+		const uint8_t *a = src + 2 * (uint32_t)y * src_stride;
+		const uint8_t *b = a + src_stride;
+		uint8_t *out = dst + (uint32_t)y * dst_stride;
+
+		for (uint16_t x = 0; x < width; x++, a += 2, b += 2) {
+			out[x] = (a[0] + a[1] + b[0] + b[1] + 2) >> 2;
+		}
+	}
+}
+
+/**
+ * @brief Raíz cuadrada entera (por defecto) de 64 bits.
+ */
+static uint32_t __flow_isqrt(uint64_t value)
+{
+	uint64_t root = 0, bit = 1ull << 62;
+
+	while (bit > value) {
+		bit >>= 2;
+	}
+	while (bit) {
+		if (value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+/**
+ * @brief Pesos bilineales en Q14 de la parte fraccionaria de una posición Q8.
+ */
+static inline void __flow_weights(int32_t x, int32_t y, int32_t w[4])
+{
+	int32_t fx = x & 255, fy = y & 255;
+
+	w[0] = ((256 - fx) * (256 - fy)) >> 2;
+	w[1] = (fx * (256 - fy)) >> 2;
+	w[2] = ((256 - fx) * fy) >> 2;
+	w[3] = (1 << 14) - w[0] - w[1] - w[2];
+}
+
+/**
+ * @brief Muestra bilineal en Q5 con los pesos de __flow_weights().
+ */
+static inline __attribute__((always_inline)) int32_t __flow_sample(const uint8_t *p, uint32_t stride,
+								  const int32_t w[4])
+{
+	return (p[0] * w[0] + p[1] * w[1] + p[stride] * w[2] + p[stride + 1] * w[3] + (1 << 8)) >> 9;
+}
+
+/**
+ * @brief Muestrea la ventana del frame anterior centrada en (px, py) y precalcula gradientes e inversa.
+ * @return false si la ventana se sale del plano o no tiene textura.
+ */
+static bool __flow_window(struct flow_window *win, const uint8_t *plane, uint32_t stride, uint16_t width,
+			  uint16_t height, int32_t px, int32_t py)
+{
+	const int32_t x0 = (px >> 8) - FLOW_HALF - 1, y0 = (py >> 8) - FLOW_HALF - 1;
+	int16_t patch[FLOW_PATCH * FLOW_PATCH];
+	int32_t w[4];
+
+	if (x0 < 0 || y0 < 0 || x0 + FLOW_PATCH >= width || y0 + FLOW_PATCH >= height) {
+		return false;
+	}
+
+	__flow_weights(px, py, w);
+	for (int j = 0; j < FLOW_PATCH; j++) {
+		const uint8_t *row = plane + (uint32_t)(y0 + j) * stride + x0;
+
+		for (int i = 0; i < FLOW_PATCH; i++) {
+			patch[j * FLOW_PATCH + i] = __flow_sample(row + i, stride, w);
+		}
+	}
+
+	// Gradientes centrales: (p[+1] - p[-1]) / 2 en Q5 es >> 3 en Q3
+	int32_t gxx = 0, gxy = 0, gyy = 0;
+	for (int j = 0; j < FLOW_WINDOW; j++) {
+		for (int i = 0; i < FLOW_WINDOW; i++) {
+			const int16_t *c = patch + (j + 1) * FLOW_PATCH + i + 1;
+			const int k = j * FLOW_WINDOW + i;
+			int32_t gx = (c[1] - c[-1]) >> 3, gy = (c[FLOW_PATCH] - c[-FLOW_PATCH]) >> 3;
+
+			win->value[k] = c[0];
+			win->grad_x[k] = gx;
+			win->grad_y[k] = gy;
+			gxx += gx * gx;
+			gxy += gx * gy;
+			gyy += gy * gy;
+		}
+	}
+
+	// Autovalor mínimo de G = [gxx gxy; gxy gyy] (en Q6) por píxel
+	int64_t half_diff = ((int64_t)gxx - gyy) / 2;
+	uint32_t disc = __flow_isqrt(half_diff * half_diff + (int64_t)gxy * gxy);
+	int64_t lambda = ((int64_t)gxx + gyy) / 2 - disc;
+	win->eigen = lambda > 0 ? lambda / (64 * FLOW_AREA) : 0;
+	if (win->eigen < FLOW_MIN_EIGEN) {
+		return false;
+	}
+
+	int64_t det = (int64_t)gxx * gyy - (int64_t)gxy * gxy;
+	win->inv[0] = ((int64_t)gyy << 32) / det;
+	win->inv[1] = -(int64_t)gxy * ((int64_t)1 << 32) / det;
+	win->inv[2] = ((int64_t)gxx << 32) / det;
+	return true;
+}
+
+/**
+ * @brief Una iteración: compara la ventana con el frame nuevo en (qx, qy).
+ * @param bx Σ error · gradiente horizontal (Q8)
+ * @param by Σ error · gradiente vertical (Q8)
+ * @return Σ |error| en Q5, o -1 si la ventana se sale del plano.
+ */
+static inline int32_t __flow_compare(const struct flow_window *win, const uint8_t *plane, uint32_t stride,
+				     uint16_t width, uint16_t height, int32_t qx, int32_t qy, int32_t *bx, int32_t *by)
+{
+	const int32_t x0 = (qx >> 8) - FLOW_HALF, y0 = (qy >> 8) - FLOW_HALF;
+	int32_t w[4], sx = 0, sy = 0, err = 0;
+
+	if (x0 < 0 || y0 < 0 || x0 + FLOW_WINDOW >= width || y0 + FLOW_WINDOW >= height) {
+		return -1;
+	}
+
+	__flow_weights(qx, qy, w);
+	for (int j = 0; j < FLOW_WINDOW; j++) {
+		const uint8_t *row = plane + (uint32_t)(y0 + j) * stride + x0;
+		const int k0 = j * FLOW_WINDOW;
+
+		for (int i = 0; i < FLOW_WINDOW; i++) {
+			int32_t diff = win->value[k0 + i] - __flow_sample(row + i, stride, w);
+
+			sx += diff * win->grad_x[k0 + i];
+			sy += diff * win->grad_y[k0 + i];
+			err += abs(diff);
+		}
+	}
+
+	*bx = sx;
+	*by = sy;
+	return err;
+}
+
+/**
+ * @brief Construye la pirámide de un plano Y8.
+ * @return 0 en éxito, -1 en error.
+ */
+int flow_pyramid_init(struct flow_pyramid *pyr, const uint8_t *plane, uint32_t stride, uint16_t width,
+		      uint16_t height, uint8_t *work)
+{
+	if (width < FLOW_PATCH + 1 || height < FLOW_PATCH + 1) {
+		return -1;
+	}
+
+	pyr->levels = 1;
+	pyr->width[0] = width;
+	pyr->height[0] = height;
+	pyr->stride[0] = stride;
+	pyr->planes[0] = plane;
+	for (int l = 1; l < FLOW_LEVELS; l++) {
+		uint16_t w = pyr->width[l - 1] / 2, h = pyr->height[l - 1] / 2;
+
+		// Un nivel en el que no cabe la ventana no aporta nada
+		if (w < FLOW_PATCH + 1 || h < FLOW_PATCH + 1) {
+			break;
+		}
+		pyr->width[l] = w;
+		pyr->height[l] = h;
+		pyr->stride[l] = w;
+		pyr->planes[l] = work;
+		__flow_halve(work, w, pyr->planes[l - 1], pyr->stride[l - 1], w, h);
+		work += (uint32_t)w * h;
+		pyr->levels++;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Elige un punto con textura por celda.
+ * @return Puntos elegidos.
+ */
+int flow_select(const struct flow_pyramid *pyr, struct flow_point *points, int max_points)
+{
+	const int32_t margin = FLOW_HALF + 2;
+	const int32_t width = pyr->width[0] - 2 * margin, height = pyr->height[0] - 2 * margin;
+	struct flow_window win;
+	int cols = 1, rows, n = 0;
+
+	if (max_points > FLOW_MAX_POINTS) {
+		max_points = FLOW_MAX_POINTS;
+	}
+	if (max_points <= 0 || width <= 0 || height <= 0) {
+		return 0;
+	}
+
+	// Celdas de forma parecida a la del frame
+	while ((cols + 1) * (cols + 1) * height <= max_points * width) {
+		cols++;
+	}
+	rows = max_points / cols;
+
+	for (int r = 0; r < rows; r++) {
+		for (int c = 0; c < cols; c++) {
+			int32_t best = 0, bx = 0, by = 0;
+
+			for (int32_t y = margin + r * height / rows; y < margin + (r + 1) * height / rows; y += 2) {
+				for (int32_t x = margin + c * width / cols; x < margin + (c + 1) * width / cols; x += 2) {
+					if (__flow_window(&win, pyr->planes[0], pyr->stride[0], pyr->width[0], pyr->height[0],
+							  x << 8, y << 8) &&
+					    (int32_t)win.eigen > best) {
+						best = win.eigen;
+						bx = x;
+						by = y;
+					}
+				}
+			}
+			if (best) {
+				points[n++] = (struct flow_point){ bx << 8, by << 8 };
+			}
+		}
+	}
+
+	return n;
+}
+
+/**
+ * @brief Sigue cada punto de grueso a fino.
+ * @return Puntos seguidos, o -1 en error.
+ */
+int PLACEMENT_RAM(flow_track)(const struct flow_pyramid *prev, const struct flow_pyramid *next,
+			      const struct flow_point *points, int n_points, struct flow_vector *vectors)
+{
+	const int levels = prev->levels < next->levels ? prev->levels : next->levels;
+	int tracked = 0;
+
+	if (prev->width[0] != next->width[0] || prev->height[0] != next->height[0] || n_points > FLOW_MAX_POINTS) {
+		return -1;
+	}
+
+	for (int p = 0; p < n_points; p++) {
+		struct flow_vector *v = &vectors[p];
+		int32_t gx = 0, gy = 0;
+
+		*v = (struct flow_vector){ 0, 0, 0, 0, FLOW_LOST };
+
+		for (int l = levels - 1; l >= 0; l--) {
+			// Con medias 2x2 el centro del píxel x del nivel 0 cae en (x + 0.5) / 2^l - 0.5
+			const int32_t px = ((points[p].x + 128) >> l) - 128, py = ((points[p].y + 128) >> l) - 128;
+			struct flow_window win;
+			int32_t dx = 0, dy = 0, err = -1;
+
+			if (l < levels - 1) {
+				gx *= 2;
+				gy *= 2;
+			}
+			if (!__flow_window(&win, prev->planes[l], prev->stride[l], prev->width[l], prev->height[l], px, py)) {
+				continue;
+			}
+
+			for (int it = 0; it < FLOW_MAX_ITERATIONS; it++) {
+				int32_t bx, by;
+
+				err = __flow_compare(&win, next->planes[l], next->stride[l], next->width[l], next->height[l],
+						     px + gx + dx, py + gy + dy, &bx, &by);
+				if (err < 0) {
+					break;
+				}
+
+				// δ = G⁻¹ b: G en Q6 y b en Q8 dan δ en Q8 con la inversa en 2^32 >> 26
+				int32_t ddx = (win.inv[0] * bx + win.inv[1] * by) >> 26;
+				int32_t ddy = (win.inv[1] * bx + win.inv[2] * by) >> 26;
+				dx += ddx;
+				dy += ddy;
+				if (abs(ddx) + abs(ddy) < FLOW_EPSILON) {
+					break;
+				}
+			}
+			if (err < 0) {
+				continue;
+			}
+			gx += dx;
+			gy += dy;
+
+			if (l == 0) {
+				uint32_t residual = err / (FLOW_AREA << 5);
+
+				v->dx = gx;
+				v->dy = gy;
+				v->confidence = win.eigen > UINT16_MAX ? UINT16_MAX : win.eigen;
+				v->residual = residual > UINT8_MAX ? UINT8_MAX : residual;
+				v->status = FLOW_TRACKED;
+				tracked++;
+			}
+		}
+	}
+
+	return tracked;
+}
+
+/**
+ * @brief Mediana de un arreglo pequeño (lo ordena).
+ */
+static int32_t __flow_median(int32_t *values, int n)
+{
+	for (int i = 1; i < n; i++) {
+		int32_t v = values[i];
+		int j = i;
+
+		for (; j > 0 && values[j - 1] > v; j--) {
+			values[j] = values[j - 1];
+		}
+		values[j] = v;
+	}
+
+	return values[n / 2];
+}
+
+/**
+ * @brief Mediana por ejes de los vectores seguidos.
+ * @return Vectores usados.
+ */
+int flow_global_motion(const struct flow_vector *vectors, int n_vectors, int32_t *dx, int32_t *dy)
+{
+	int32_t xs[FLOW_MAX_POINTS], ys[FLOW_MAX_POINTS];
+	int n = 0;
+
+	for (int i = 0; i < n_vectors && i < FLOW_MAX_POINTS; i++) {
+		if (vectors[i].status == FLOW_TRACKED) {
+			xs[n] = vectors[i].dx;
+			ys[n] = vectors[i].dy;
+			n++;
+		}
+	}
+
+	*dx = n ? __flow_median(xs, n) : 0;
+	*dy = n ? __flow_median(ys, n) : 0;
+	return n;
+}
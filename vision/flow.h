@@ -0,0 +1,129 @@
+/**
+ * @file flow.h
+ * @brief Flujo óptico disperso de Lucas-Kanade piramidal (KLT) en punto fijo.
+ *
+ * Cada punto se sigue de grueso a fino por una pirámide de FLOW_LEVELS
+ * niveles reducidos con medias 2x2. En cada nivel la ventana de
+ * FLOW_WINDOW x FLOW_WINDOW píxeles del frame anterior se muestrea una sola
+ * vez (bilineal, en Q5) junto con sus gradientes y la inversa de su matriz de
+ * estructura; las iteraciones solo muestrean el frame nuevo en la posición
+ * actual, acumulan el producto del error por los gradientes y aplican la
+ * inversa precalculada. Los pesos bilineales son los mismos para toda la
+ * ventana, así que cada muestra cuesta cuatro multiplicaciones de 32 bits. Se
+ * sale en cuanto la corrección baja de FLOW_EPSILON.
+ *
+ * Las posiciones y desplazamientos van en Q8 con el centro del píxel (x, y)
+ * en las coordenadas enteras (x, y).
+ */
+
+#ifndef __FLOW_H__
+#define __FLOW_H__
+
+#include <stdint.h>
+
+#define FLOW_LEVELS         3     /**< Niveles de la pirámide, incluido el original */
+#define FLOW_WINDOW         7     /**< Lado de la ventana de seguimiento (impar) */
+#define FLOW_MAX_POINTS     32    /**< Puntos por llamada como máximo */
+#define FLOW_MAX_ITERATIONS 8     /**< Iteraciones por nivel como máximo */
+#define FLOW_EPSILON        4     /**< Corrección (|dx| + |dy| en Q8) por debajo de la cual se converge */
+#define FLOW_MIN_EIGEN      16    /**< Autovalor mínimo por píxel para seguir una ventana (niveles²) */
+
+/** Bytes de trabajo para los niveles reducidos de un plano de width x height (FLOW_LEVELS = 3) */
+#define FLOW_WORK_SIZE(width, height) \
+    (((uint32_t)(width) / 2) * ((height) / 2) + ((uint32_t)(width) / 4) * ((height) / 4))
+
+/**
+ * @enum flow_status
+ * @brief Resultado del seguimiento de un punto.
+ */
+enum flow_status {
+    FLOW_TRACKED = 0,  /**< Seguido */
+    FLOW_LOST,         /**< Ventana fuera del frame o sin textura */
+};
+
+/**
+ * @struct flow_pyramid
+ * @brief Pirámide de un plano Y8; el nivel 0 es el plano del llamante.
+ */
+struct flow_pyramid {
+    uint8_t levels;                          /**< Niveles construidos */
+    uint16_t width[FLOW_LEVELS];             /**< Ancho por nivel */
+    uint16_t height[FLOW_LEVELS];            /**< Alto por nivel */
+    uint32_t stride[FLOW_LEVELS];            /**< Stride por nivel */
+    const uint8_t *planes[FLOW_LEVELS];      /**< Plano de cada nivel */
+};
+
+/**
+ * @struct flow_point
+ * @brief Posición de un punto en Q8.
+ */
+struct flow_point {
+    int32_t x;  /**< Columna en Q8 */
+    int32_t y;  /**< Fila en Q8 */
+};
+
+/**
+ * @struct flow_vector
+ * @brief Movimiento de un punto entre dos frames.
+ */
+struct flow_vector {
+    int32_t dx;           /**< Desplazamiento horizontal en Q8 */
+    int32_t dy;           /**< Desplazamiento vertical en Q8 */
+    uint16_t confidence;  /**< Autovalor mínimo por píxel de la ventana (0 si se perdió) */
+    uint8_t residual;     /**< Diferencia absoluta media final en la ventana, en niveles */
+    uint8_t status;       /**< enum flow_status */
+};
+
+/**
+ * @brief Construye la pirámide de un plano Y8.
+ * @param pyr    Pirámide destino
+ * @param plane  Plano Y8 (nivel 0; debe seguir vivo mientras se use la pirámide)
+ * @param stride Stride del plano en bytes
+ * @param width  Ancho
+ * @param height Alto
+ * @param work   Buffer de FLOW_WORK_SIZE(width, height) bytes para los niveles reducidos
+ * @return 0 en éxito, -1 si el plano es menor que la ventana
+ */
+int flow_pyramid_init(struct flow_pyramid *pyr, const uint8_t *plane, uint32_t stride, uint16_t width,
+                      uint16_t height, uint8_t *work);
+
+/**
+ * @brief Elige hasta max_points puntos con textura, uno por celda de una rejilla.
+ *
+ * En cada celda se evalúan posiciones en pasos de 2 píxeles y se queda la de
+ * mayor autovalor mínimo, si supera FLOW_MIN_EIGEN.
+ *
+ * @param pyr        Pirámide del frame
+ * @param points     Puntos elegidos
+ * @param max_points Capacidad de points (<= FLOW_MAX_POINTS)
+ * @return Puntos elegidos
+ */
+int flow_select(const struct flow_pyramid *pyr, struct flow_point *points, int max_points);
+
+/**
+ * @brief Sigue puntos del frame anterior al nuevo.
+ *
+ * Un punto se pierde si su ventana se sale del frame o no tiene textura en
+ * el nivel 0; en los niveles gruesos esos casos solo se saltan el nivel.
+ *
+ * @param prev     Pirámide del frame anterior
+ * @param next     Pirámide del frame nuevo (mismo tamaño)
+ * @param points   Posiciones en el frame anterior
+ * @param n_points Puntos (<= FLOW_MAX_POINTS)
+ * @param vectors  Movimiento de cada punto
+ * @return Puntos seguidos, o -1 si las pirámides no son compatibles
+ */
+int flow_track(const struct flow_pyramid *prev, const struct flow_pyramid *next, const struct flow_point *points,
+               int n_points, struct flow_vector *vectors);
+
+/**
+ * @brief Movimiento global: mediana de los vectores seguidos en cada eje.
+ * @param vectors   Vectores
+ * @param n_vectors Vectores (<= FLOW_MAX_POINTS)
+ * @param dx        Mediana horizontal en Q8
+ * @param dy        Mediana vertical en Q8
+ * @return Vectores seguidos usados, 0 si no hay ninguno
+ */
+int flow_global_motion(const struct flow_vector *vectors, int n_vectors, int32_t *dx, int32_t *dy);
+
+#endif /* __FLOW_H__ */
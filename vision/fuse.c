@@ -0,0 +1,129 @@
+/**
+ * @file fuse.c
+ * @brief Ejecución de cadenas de conversión fusionadas.
+ */
+
+#include <stdbool.h>
+
+#include "runtime/placement.h"
+#include "vision/fuse.h"
+
+/**
+ * @brief Cadena vacía.
+ */
+void fuse_init(struct fuse_chain *chain)
+{
+	*chain = (struct fuse_chain){ 0 };
+}
+
+/**
+ * @brief Fija la LUT por canal.
+ */
+void fuse_set_lut(struct fuse_chain *chain, const struct convert_lut565 *lut)
+{
+	chain->lut = lut;
+}
+
+/**
+ * @brief Añade una operación por píxel.
+ * @return 0 en éxito, -1 si no caben más.
+ */
+int fuse_add_pixel(struct fuse_chain *chain, fuse_pixel_fn fn, void *ctx)
+{
+	if (chain->n_pixel_ops >= FUSE_MAX_OPS) {
+		return -1;
+	}
+
+	chain->pixel_ops[chain->n_pixel_ops] = fn;
+	chain->pixel_ctx[chain->n_pixel_ops] = ctx;
+	chain->n_pixel_ops++;
+
+	return 0;
+}
+
+/**
+ * @brief Añade una operación por línea.
+ * @return 0 en éxito, -1 si no caben más.
+ */
+int fuse_add_line(struct fuse_chain *chain, fuse_line_fn fn, void *ctx)
+{
+	if (chain->n_line_ops >= FUSE_MAX_OPS) {
+		return -1;
+	}
+
+	chain->line_ops[chain->n_line_ops] = fn;
+	chain->line_ctx[chain->n_line_ops] = ctx;
+	chain->n_line_ops++;
+
+	return 0;
+}
+
+/**
+ * @brief Convierte una línea de destino.
+ *
+ * Se expande en línea con scale, lut y generic constantes, de modo que cada
+ * combinación fija obtiene su propio bucle sin comprobaciones por píxel.
+ */
+static inline __attribute__((always_inline)) void __fuse_line(const struct fuse_chain *chain, uint16_t *line,
+							      uint16_t width, const uint8_t *row, uint32_t x_step,
+							      bool scale, bool lut, bool generic)
+{
+	uint32_t sx = x_step >> 1;
+
+	for (uint16_t x = 0; x < width; x++, sx += x_step) {
+		const uint8_t *p = scale ? row + (sx >> 16) * 2 : row + 2 * x;
+		uint16_t v = (p[0] << 8) | p[1];
+
+		if (lut) {
+			v = chain->lut->r[v >> 11] | chain->lut->g[(v >> 5) & 0x3f] | chain->lut->b[v & 0x1f];
+		}
+		if (generic) {
+			for (int i = 0; i < chain->n_pixel_ops; i++) {
+				v = chain->pixel_ops[i](v, chain->pixel_ctx[i]);
+			}
+		}
+		line[x] = v;
+	}
+}
+
+/**
+ * @brief Ejecuta la cadena línea a línea: una lectura por píxel de origen
+ * usado y una escritura por píxel de destino.
+ */
+void PLACEMENT_RAM(fuse_run_rgb565be)(const struct fuse_chain *chain, uint16_t *dst, uint16_t dst_width,
+				      uint16_t dst_height, const uint8_t *src, uint32_t src_stride,
+				      uint16_t src_width, uint16_t src_height)
+{
+	if (!dst_width || !dst_height) {
+		return;
+	}
+
+	// Mismo muestreo que convert_scale_nn_rgb565be
+	bool scale = dst_width != src_width || dst_height != src_height;
+	uint32_t x_step = ((uint32_t)src_width << 16) / dst_width;
+	uint32_t y_step = ((uint32_t)src_height << 16) / dst_height;
+	uint32_t sy = y_step >> 1;
+
+	for (uint16_t y = 0; y < dst_height; y++, sy += y_step) {
+		const uint8_t *row = src + (sy >> 16) * src_stride;
+		uint16_t *line = dst + (uint32_t)y * dst_width;
+
+		if (chain->n_pixel_ops) {
+			__fuse_line(chain, line, dst_width, row, x_step, scale, chain->lut != NULL, true);
+		} else if (chain->lut) {
+			if (scale) {
+				__fuse_line(chain, line, dst_width, row, x_step, true, true, false);
+			} else {
+				__fuse_line(chain, line, dst_width, row, x_step, false, true, false);
+			}
+		} else if (scale) {
+			__fuse_line(chain, line, dst_width, row, x_step, true, false, false);
+		} else {
+			convert_rgb565be_to_native(line, row, dst_width);
+		}
+
+		for (int i = 0; i < chain->n_line_ops; i++) {
+			chain->line_ops[i](line, dst_width, y, chain->line_ctx[i]);
+		}
+	}
+}
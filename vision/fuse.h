@@ -0,0 +1,107 @@
+/**
+ * @file fuse.h
+ * @brief Fusión de una cadena de operaciones de conversión en una sola pasada.
+ *
+ * Un camino típico hacia la pantalla intercambia bytes, aplica una LUT, escala
+ * y superpone texto; hecho en pasadas separadas, cada una lee y escribe el
+ * frame entero. Una fuse_chain declara la cadena y fuse_run_rgb565be() la
+ * ejecuta leyendo cada píxel de origen una vez y escribiendo cada píxel de
+ * destino una vez.
+ *
+ * Orden de la cadena: lectura RGB565 big-endian, muestreo por vecino más
+ * cercano (si el tamaño de destino difiere), LUT por canal, operaciones por
+ * píxel en el orden añadido y, sobre cada línea de destino recién escrita, las
+ * operaciones por línea. El muestreo va primero porque conmuta con las
+ * operaciones por píxel y así solo se transforman los píxeles que se usan.
+ *
+ * Las cadenas sin operaciones por píxel genéricas (intercambio, LUT y escala en
+ * cualquier combinación) usan bucles especializados; con operaciones genéricas
+ * se llama a cada una por píxel.
+ */
+
+#ifndef __FUSE_H__
+#define __FUSE_H__
+
+#include <stdint.h>
+
+#include "vision/convert.h"
+
+#define FUSE_MAX_OPS 4  /**< Máximo de operaciones por píxel y por línea */
+
+/**
+ * @brief Operación por píxel sobre RGB565 nativo.
+ * @param pixel Píxel de entrada
+ * @param ctx   Contexto de la operación
+ * @return Píxel de salida
+ */
+typedef uint16_t (*fuse_pixel_fn)(uint16_t pixel, void *ctx);
+
+/**
+ * @brief Operación sobre una línea de destino ya convertida.
+ * @param line  Línea RGB565 nativa
+ * @param width Ancho de la línea
+ * @param y     Fila de la línea en la imagen de destino
+ * @param ctx   Contexto de la operación
+ */
+typedef void (*fuse_line_fn)(uint16_t *line, uint16_t width, uint16_t y, void *ctx);
+
+/**
+ * @struct fuse_chain
+ * @brief Cadena de operaciones declarada.
+ */
+struct fuse_chain {
+    const struct convert_lut565 *lut;         /**< LUT por canal (NULL = sin LUT) */
+    fuse_pixel_fn pixel_ops[FUSE_MAX_OPS];    /**< Operaciones por píxel */
+    void *pixel_ctx[FUSE_MAX_OPS];            /**< Contextos de las operaciones por píxel */
+    uint8_t n_pixel_ops;                      /**< Operaciones por píxel añadidas */
+    fuse_line_fn line_ops[FUSE_MAX_OPS];      /**< Operaciones por línea */
+    void *line_ctx[FUSE_MAX_OPS];             /**< Contextos de las operaciones por línea */
+    uint8_t n_line_ops;                       /**< Operaciones por línea añadidas */
+};
+
+/**
+ * @brief Inicializa una cadena vacía (solo intercambio de bytes).
+ * @param chain Cadena
+ */
+void fuse_init(struct fuse_chain *chain);
+
+/**
+ * @brief Añade una LUT por canal a la cadena.
+ * @param chain Cadena
+ * @param lut   LUT (debe seguir viva mientras se use la cadena)
+ */
+void fuse_set_lut(struct fuse_chain *chain, const struct convert_lut565 *lut);
+
+/**
+ * @brief Añade una operación por píxel.
+ * @param chain Cadena
+ * @param fn    Operación
+ * @param ctx   Contexto
+ * @return 0 en éxito, -1 si la cadena está llena
+ */
+int fuse_add_pixel(struct fuse_chain *chain, fuse_pixel_fn fn, void *ctx);
+
+/**
+ * @brief Añade una operación por línea.
+ * @param chain Cadena
+ * @param fn    Operación
+ * @param ctx   Contexto
+ * @return 0 en éxito, -1 si la cadena está llena
+ */
+int fuse_add_line(struct fuse_chain *chain, fuse_line_fn fn, void *ctx);
+
+/**
+ * @brief Ejecuta la cadena en una pasada de RGB565 big-endian a RGB565 nativo.
+ * @param chain      Cadena
+ * @param dst        Destino (dst_width * dst_height píxeles, sin relleno)
+ * @param dst_width  Ancho de destino
+ * @param dst_height Alto de destino
+ * @param src        Origen RGB565 big-endian
+ * @param src_stride Stride del origen en bytes
+ * @param src_width  Ancho de origen
+ * @param src_height Alto de origen
+ */
+void fuse_run_rgb565be(const struct fuse_chain *chain, uint16_t *dst, uint16_t dst_width, uint16_t dst_height,
+                       const uint8_t *src, uint32_t src_stride, uint16_t src_width, uint16_t src_height);
+
+#endif /* __FUSE_H__ */
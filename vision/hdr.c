@@ -0,0 +1,91 @@
+/**
+ * @file hdr.c
+ * @brief Implementación de la fusión de exposiciones en punto fijo.
+ */
+
+#include <math.h>
+
+#include "runtime/placement.h"
+#include "vision/hdr.h"
+
+#define HDR_SENSOR_GAMMA 2.2f  /**< Gamma aproximada de la salida del sensor */
+
+/**
+ * @brief Calcula la ganancia del frame corto, los pesos y la curva de tonos.
+ * @return 0 en éxito, -1 si la relación no es válida.
+ */
+int hdr_merge_init(struct hdr_merge *hdr, uint16_t exposure_long, uint16_t exposure_short)
+{
+	if (!exposure_short || exposure_long < exposure_short ||
+	    exposure_long > (uint32_t)exposure_short * HDR_MAX_RATIO) {
+		return -1;
+	}
+
+	// La salida del sensor tiene gamma: la relación lineal se aplica como ratio^(1/gamma)
+	float gain = powf((float)exposure_long / exposure_short, 1.0f / HDR_SENSOR_GAMMA);
+	hdr->gain_q8 = (uint16_t)(gain * 256.0f + 0.5f);
+
+	for (int i = 0; i < 64; i++) {
+		if (i <= HDR_KNEE) {
+			hdr->weight[i] = 64;
+		} else if (i >= HDR_CLIP) {
+			hdr->weight[i] = 0;
+		} else {
+			hdr->weight[i] = (64 * (HDR_CLIP - i) + (HDR_CLIP - HDR_KNEE) / 2) / (HDR_CLIP - HDR_KNEE);
+		}
+	}
+
+	// Reinhard extendida con el blanco en la radiancia máxima: identidad si gain = 1
+	float white = 255.0f * hdr->gain_q8 / 256.0f;
+	for (int i = 0; i < HDR_TONE_SIZE; i++) {
+		float x = (i < white ? i : white) / 255.0f;
+		float w = white / 255.0f;
+		float y = x * (1.0f + x / (w * w)) / (1.0f + x);
+		hdr->tone[i] = (uint8_t)(255.0f * y + 0.5f);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Fusiona un píxel nativo: mezcla por canal y curva de tonos.
+ */
+static inline uint16_t __hdr_pixel(const struct hdr_merge *hdr, uint16_t s, uint16_t l)
+{
+	// Canales expandidos a 8 bits
+	uint32_t sr = ((s >> 8) & 0xf8) | (s >> 13);
+	uint32_t sg = ((s >> 3) & 0xfc) | ((s >> 9) & 0x03);
+	uint32_t sb = ((s << 3) & 0xf8) | ((s >> 2) & 0x07);
+	uint32_t lr = ((l >> 8) & 0xf8) | (l >> 13);
+	uint32_t lg = ((l >> 3) & 0xfc) | ((l >> 9) & 0x03);
+	uint32_t lb = ((l << 3) & 0xf8) | ((l >> 2) & 0x07);
+
+	uint32_t peak = lr > lg ? lr : lg;
+	peak = peak > lb ? peak : lb;
+
+	// Q14: peso del largo x 256 y peso del corto x ganancia Q8
+	uint32_t wl = (uint32_t)hdr->weight[peak >> 2] << 8;
+	uint32_t ws = (64 - hdr->weight[peak >> 2]) * hdr->gain_q8;
+
+	uint32_t r = hdr->tone[(lr * wl + sr * ws) >> 14];
+	uint32_t g = hdr->tone[(lg * wl + sg * ws) >> 14];
+	uint32_t b = hdr->tone[(lb * wl + sb * ws) >> 14];
+
+	return ((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3);
+}
+
+/**
+ * @brief Fusiona los dos frames píxel a píxel.
+ */
+void PLACEMENT_RAM(hdr_merge_rgb565be)(const struct hdr_merge *hdr, uint8_t *dst, const uint8_t *short_exp,
+				       const uint8_t *long_exp, uint32_t n_pixels)
+{
+	for (uint32_t i = 0; i < n_pixels; i++) {
+		const uint8_t *s = short_exp + 2 * i;
+		const uint8_t *l = long_exp + 2 * i;
+		uint16_t v = __hdr_pixel(hdr, (s[0] << 8) | s[1], (l[0] << 8) | l[1]);
+
+		dst[2 * i] = v >> 8;
+		dst[2 * i + 1] = v & 0xff;
+	}
+}
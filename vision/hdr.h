@@ -0,0 +1,59 @@
+/**
+ * @file hdr.h
+ * @brief Fusión de dos exposiciones RGB565 en una imagen con mapeo de tonos.
+ *
+ * Cada par es un frame corto y uno largo del mismo encuadre. Por canal, el
+ * valor del frame corto se lleva a la escala del largo multiplicándolo por la
+ * relación de exposiciones en el dominio con gamma del sensor, y se mezcla con
+ * el largo según un peso que depende del canal más alto del píxel largo: el
+ * largo se usa entero en sombras y medios tonos y se sustituye por el corto a
+ * medida que se acerca a la saturación. La radiancia resultante (hasta 255
+ * veces la ganancia) pasa por una curva de tonos de Reinhard extendida
+ * precalculada en una LUT, que deja la imagen igual si las dos exposiciones
+ * coinciden.
+ *
+ * El kernel solo usa enteros: dos multiplicaciones y una consulta a la LUT
+ * por canal. Las tablas se calculan en hdr_merge_init().
+ */
+
+#ifndef __HDR_H__
+#define __HDR_H__
+
+#include <stdint.h>
+
+#define HDR_MAX_RATIO 16    /**< Relación máxima entre la exposición larga y la corta */
+#define HDR_TONE_SIZE 1024  /**< Entradas de la curva de tonos (radiancia máxima + 1) */
+#define HDR_KNEE      48    /**< Canal más alto (6 bits) a partir del cual se mezcla el frame corto */
+#define HDR_CLIP      60    /**< Canal más alto (6 bits) a partir del cual solo se usa el frame corto */
+
+/**
+ * @struct hdr_merge
+ * @brief Tablas de la fusión para una relación de exposiciones.
+ */
+struct hdr_merge {
+    uint16_t gain_q8;              /**< Ganancia del frame corto en el dominio con gamma, Q8 */
+    uint8_t weight[64];            /**< Peso del frame largo (0-64) según su canal más alto en 6 bits */
+    uint8_t tone[HDR_TONE_SIZE];   /**< Curva de tonos: radiancia → nivel de 8 bits */
+};
+
+/**
+ * @brief Calcula las tablas para una pareja de exposiciones.
+ * @param hdr            Tablas
+ * @param exposure_long  Exposición del frame largo (cualquier unidad lineal, p. ej. líneas AEC)
+ * @param exposure_short Exposición del frame corto, en la misma unidad
+ * @return 0 en éxito, -1 si la relación no está entre 1 y HDR_MAX_RATIO
+ */
+int hdr_merge_init(struct hdr_merge *hdr, uint16_t exposure_long, uint16_t exposure_short);
+
+/**
+ * @brief Fusiona un frame corto y uno largo RGB565 big-endian.
+ * @param hdr        Tablas
+ * @param dst        Destino RGB565 big-endian (puede coincidir con cualquiera de los orígenes)
+ * @param short_exp  Frame de exposición corta
+ * @param long_exp   Frame de exposición larga
+ * @param n_pixels   Número de píxeles
+ */
+void hdr_merge_rgb565be(const struct hdr_merge *hdr, uint8_t *dst, const uint8_t *short_exp,
+                        const uint8_t *long_exp, uint32_t n_pixels);
+
+#endif /* __HDR_H__ */
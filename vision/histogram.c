@@ -0,0 +1,163 @@
+/**
+ * @file histogram.c
+ * @brief Implementación del histograma de luma y su resumen.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "camera/format.h"
+#include "runtime/placement.h"
+#include "vision/histogram.h"
+
+/**
+ * @brief Luma BT.601 de un píxel RGB565 big-endian, en punto fijo.
+ */
+static inline uint8_t __rgb565be_luma(const uint8_t *p)
+{
+	uint16_t v = (p[0] << 8) | p[1];
+	uint32_t r = (v >> 11) & 0x1f;
+	uint32_t g = (v >> 5) & 0x3f;
+	uint32_t b = v & 0x1f;
+
+	// Coeficientes 77/150/29 (sobre 256) ya escalados a 5/6/5 bits
+	return (r * 634 + g * 607 + b * 239) >> 8;
+}
+
+/**
+ * @brief Acumula la luma de todas las filas con un paso por píxel fijo.
+ *
+ * Se expande en línea con bpp y rgb565 constantes, de modo que cada formato
+ * obtiene su propio bucle sin comparaciones por fila ni por píxel.
+ */
+static inline __attribute__((always_inline)) void __histogram_rows(struct histogram *hist, const uint8_t *data,
+								   uint32_t stride, uint16_t width, uint16_t height,
+								   uint8_t bpp, bool rgb565)
+{
+	for (uint16_t y = 0; y < height; y++) {
+		const uint8_t *row = data + y * stride;
+
+		for (uint16_t x = 0; x < width; x++) {
+			hist->bins[rgb565 ? __rgb565be_luma(row + bpp * x) : row[bpp * x]]++;
+		}
+	}
+}
+
+/**
+ * @brief Pone a cero el histograma.
+ * @param hist Puntero al histograma.
+ */
+void histogram_reset(struct histogram *hist)
+{
+	memset(hist, 0, sizeof(*hist));
+}
+
+/**
+ * @brief Acumula la luma de un plano de imagen en el histograma.
+ * @param hist   Puntero al histograma.
+ * @param format Código de formato.
+ * @param data   Puntero al plano 0.
+ * @param stride Stride en bytes.
+ * @param width  Ancho en píxeles.
+ * @param height Alto en píxeles.
+ * @return 0 en éxito, -1 si el formato no está soportado.
+ */
+int PLACEMENT_RAM(histogram_accumulate)(struct histogram *hist, uint32_t format, const uint8_t *data, uint32_t stride,
+			 uint16_t width, uint16_t height)
+{
+	// Un solo despacho por llamada; cada caso es un bucle especializado con el
+	// paso constante de FORMAT_TABLE
+	switch (format) {
+	case FORMAT_RGB565:
+		__histogram_rows(hist, data, stride, width, height, FORMAT_RGB565_BPP, true);
+		break;
+	case FORMAT_YUYV:
+		__histogram_rows(hist, data, stride, width, height, FORMAT_YUYV_BPP, false);
+		break;
+	case FORMAT_YUV422:
+		__histogram_rows(hist, data, stride, width, height, FORMAT_YUV422_BPP, false);
+		break;
+	default:
+		return -1;
+	}
+
+	hist->count += (uint32_t)width * height;
+
+	return 0;
+}
+
+/**
+ * @brief Calcula mínimo, máximo, media, mediana y los bins reducidos del histograma.
+ * @param hist    Puntero al histograma.
+ * @param summary Puntero al resumen a rellenar.
+ */
+void histogram_summarize(const struct histogram *hist, struct histogram_summary *summary)
+{
+	*summary = (struct histogram_summary){ 0 };
+	if (!hist->count) {
+		return;
+	}
+
+	const uint32_t per_bin = HISTOGRAM_BINS / HISTOGRAM_SUMMARY_BINS;
+	uint64_t sum = 0;
+	uint32_t acc = 0;
+	bool have_min = false, have_median = false;
+
+	for (uint32_t i = 0; i < HISTOGRAM_BINS; i++) {
+		uint32_t n = hist->bins[i];
+		if (!n) {
+			continue;
+		}
+
+		if (!have_min) {
+			summary->min = i;
+			have_min = true;
+		}
+		summary->max = i;
+
+		sum += (uint64_t)n * i;
+		acc += n;
+		if (!have_median && acc * 2 >= hist->count) {
+			summary->median = i;
+			have_median = true;
+		}
+	}
+
+	summary->mean = sum / hist->count;
+
+	for (uint32_t b = 0; b < HISTOGRAM_SUMMARY_BINS; b++) {
+		uint32_t n = 0;
+		for (uint32_t i = 0; i < per_bin; i++) {
+			n += hist->bins[b * per_bin + i];
+		}
+		summary->bins[b] = ((uint64_t)n * 255 + hist->count / 2) / hist->count;
+	}
+}
+
+/**
+ * @brief LUT de ecualización global a partir de la distribución acumulada.
+ * @param hist Puntero al histograma.
+ * @param lut  LUT destino.
+ */
+void histogram_equalize_lut(const struct histogram *hist, uint8_t lut[256])
+{
+	uint32_t cdf_min = 0;
+
+	for (uint32_t i = 0; i < HISTOGRAM_BINS; i++) {
+		if (hist->bins[i]) {
+			cdf_min = hist->bins[i];
+			break;
+		}
+	}
+
+	uint32_t range = hist->count - cdf_min;
+	uint32_t cdf = 0;
+	for (uint32_t i = 0; i < HISTOGRAM_BINS; i++) {
+		cdf += hist->bins[i];
+		if (!range) {
+			lut[i] = i;
+		} else {
+			lut[i] = cdf <= cdf_min ? 0 : ((uint64_t)(cdf - cdf_min) * 255 + range / 2) / range;
+		}
+	}
+}
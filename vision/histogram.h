@@ -0,0 +1,76 @@
+/**
+ * @file histogram.h
+ * @brief Histograma de luminancia de 8 bits y su resumen compacto.
+ */
+
+#ifndef __HISTOGRAM_H__
+#define __HISTOGRAM_H__
+
+#include <stdint.h>
+
+#define HISTOGRAM_BINS         256  /**< Número de bins (uno por nivel de luma) */
+#define HISTOGRAM_SUMMARY_BINS 16   /**< Bins del resumen enviado por el stream */
+
+/**
+ * @struct histogram
+ * @brief Histograma de luma acumulado sobre uno o más frames.
+ */
+struct histogram {
+    uint32_t bins[HISTOGRAM_BINS]; /**< Cuenta de píxeles por nivel */
+    uint32_t count;                /**< Total de píxeles acumulados */
+};
+
+/**
+ * @struct histogram_summary
+ * @brief Resumen de un histograma, pensado para registros compactos.
+ */
+struct histogram_summary {
+    uint8_t min;                           /**< Nivel mínimo presente */
+    uint8_t max;                           /**< Nivel máximo presente */
+    uint8_t mean;                          /**< Nivel medio */
+    uint8_t median;                        /**< Mediana */
+    uint8_t bins[HISTOGRAM_SUMMARY_BINS];  /**< Fracción de píxeles por bin, escalada a 0-255 */
+};
+
+/**
+ * @brief Pone a cero el histograma.
+ * @param hist Puntero al histograma
+ */
+void histogram_reset(struct histogram *hist);
+
+/**
+ * @brief Acumula la luma de un plano de imagen en el histograma.
+ *
+ * Para RGB565 la luma se calcula con coeficientes BT.601 en punto fijo; para
+ * YUYV y YUV422 se usan directamente las muestras Y.
+ *
+ * @param hist   Puntero al histograma
+ * @param format Código de formato (FORMAT_RGB565, FORMAT_YUYV o FORMAT_YUV422)
+ * @param data   Puntero al plano 0 del frame
+ * @param stride Stride del plano en bytes
+ * @param width  Ancho en píxeles
+ * @param height Alto en píxeles
+ * @return 0 en éxito, -1 si el formato no está soportado
+ */
+int histogram_accumulate(struct histogram *hist, uint32_t format, const uint8_t *data, uint32_t stride,
+                         uint16_t width, uint16_t height);
+
+/**
+ * @brief Calcula el resumen compacto de un histograma.
+ * @param hist    Puntero al histograma
+ * @param summary Puntero al resumen a rellenar
+ */
+void histogram_summarize(const struct histogram *hist, struct histogram_summary *summary);
+
+/**
+ * @brief Calcula la LUT de ecualización global del histograma.
+ *
+ * Cada nivel se lleva a su posición en la distribución acumulada, estirada a
+ * 0-255 a partir del primer nivel presente. Solo usa aritmética entera.
+ *
+ * @param hist Puntero al histograma
+ * @param lut  LUT de 256 entradas destino (identidad si el histograma está vacío)
+ */
+void histogram_equalize_lut(const struct histogram *hist, uint8_t lut[256]);
+
+#endif /* __HISTOGRAM_H__ */
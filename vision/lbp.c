@@ -0,0 +1,285 @@
+/**
+ * @file lbp.c
+ * @brief Implementación del detector por cascada MB-LBP.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "runtime/placement.h"
+#include "vision/lbp.h"
+
+/**
+ * @struct lbp_group
+ * @brief Detecciones en bruto parecidas: sumas de sus rectángulos.
+ */
+struct lbp_group {
+    uint32_t x;      /**< Σ columnas */
+    uint32_t y;      /**< Σ filas */
+    uint32_t w;      /**< Σ anchos */
+    uint32_t h;      /**< Σ altos */
+    uint16_t n;      /**< Detecciones */
+};
+
+/**
+ * @brief Valida una cascada binaria y apunta a ella.
+ * @return 0 en éxito, -1 en error.
+ */
+int lbp_cascade_load(struct lbp_cascade *cascade, const void *data, uint32_t size)
+{
+	const struct lbp_header *header = data;
+
+	if (!data || (uintptr_t)data % 4 || size < sizeof(*header) || header->magic != LBP_MAGIC ||
+	    header->version != LBP_VERSION || header->width < 3 || header->height < 3 ||
+	    header->width > LBP_MAX_WINDOW || header->height > LBP_MAX_WINDOW || !header->n_stages) {
+		return -1;
+	}
+
+	const struct lbp_stage *stages = (const struct lbp_stage *)(header + 1);
+	const struct lbp_feature *features = (const struct lbp_feature *)(stages + header->n_stages);
+	const struct lbp_weak *weaks = (const struct lbp_weak *)(features + header->n_features);
+	if ((const uint8_t *)(weaks + header->n_weaks) - (const uint8_t *)data > (ptrdiff_t)size) {
+		return -1;
+	}
+
+	for (uint32_t s = 0; s < header->n_stages; s++) {
+		if (!stages[s].count || stages[s].first + stages[s].count > header->n_weaks) {
+			return -1;
+		}
+	}
+	for (uint32_t f = 0; f < header->n_features; f++) {
+		const struct lbp_feature *feature = &features[f];
+
+		if (!feature->w || !feature->h || feature->x + 3 * feature->w > header->width ||
+		    feature->y + 3 * feature->h > header->height || feature->w * feature->h > LBP_MAX_BLOCK) {
+			return -1;
+		}
+	}
+	for (uint32_t w = 0; w < header->n_weaks; w++) {
+		if (weaks[w].feature >= header->n_features) {
+			return -1;
+		}
+	}
+
+	cascade->width = header->width;
+	cascade->height = header->height;
+	cascade->n_stages = header->n_stages;
+	cascade->stages = stages;
+	cascade->features = features;
+	cascade->weaks = weaks;
+	return 0;
+}
+
+/**
+ * @brief Código LBP de una característica: 16 lecturas de la integral y 8 comparaciones.
+ */
+static inline __attribute__((always_inline)) uint32_t __lbp_code(const struct lbp_feature *feature,
+								  const uint16_t *sum, uint32_t stride)
+{
+	const uint32_t dx = feature->w, dy = feature->h * stride;
+	const uint16_t *p0 = sum + feature->y * stride + feature->x, *p1 = p0 + dy, *p2 = p1 + dy, *p3 = p2 + dy;
+
+	// Esquinas de la rejilla por fila; las restas de 16 bits dan la suma exacta del bloque
+	const uint16_t a0 = p0[0], a1 = p0[dx], a2 = p0[2 * dx], a3 = p0[3 * dx];
+	const uint16_t b0 = p1[0], b1 = p1[dx], b2 = p1[2 * dx], b3 = p1[3 * dx];
+	const uint16_t c0 = p2[0], c1 = p2[dx], c2 = p2[2 * dx], c3 = p2[3 * dx];
+	const uint16_t d0 = p3[0], d1 = p3[dx], d2 = p3[2 * dx], d3 = p3[3 * dx];
+	const uint16_t center = b1 - b2 - c1 + c2;
+
+	return ((uint16_t)(a0 - a1 - b0 + b1) >= center) << 7 |
+	       ((uint16_t)(a1 - a2 - b1 + b2) >= center) << 6 |
+	       ((uint16_t)(a2 - a3 - b2 + b3) >= center) << 5 |
+	       ((uint16_t)(b2 - b3 - c2 + c3) >= center) << 4 |
+	       ((uint16_t)(c2 - c3 - d2 + d3) >= center) << 3 |
+	       ((uint16_t)(c1 - c2 - d1 + d2) >= center) << 2 |
+	       ((uint16_t)(c0 - c1 - d0 + d1) >= center) << 1 |
+	       ((uint16_t)(b0 - b1 - c0 + c1) >= center);
+}
+
+/**
+ * @brief Evalúa la cascada en una ventana.
+ * @return Etapas superadas.
+ */
+int PLACEMENT_RAM(lbp_evaluate)(const struct lbp_cascade *cascade, const uint16_t *sum, uint32_t stride)
+{
+	for (int s = 0; s < cascade->n_stages; s++) {
+		const struct lbp_stage *stage = &cascade->stages[s];
+		const struct lbp_weak *weak = cascade->weaks + stage->first, *end = weak + stage->count;
+		int32_t acc = 0;
+
+		for (; weak < end; weak++) {
+			uint32_t code = __lbp_code(&cascade->features[weak->feature], sum, stride);
+
+			acc += (weak->subset[code >> 5] >> (code & 31)) & 1 ? weak->inside : weak->outside;
+
+			// Ni sumando lo máximo de los que faltan se llega al umbral
+			if (acc + weak->bound < stage->threshold) {
+				return s;
+			}
+		}
+		if (acc < stage->threshold) {
+			return s;
+		}
+	}
+
+	return cascade->n_stages;
+}
+
+/**
+ * @brief Coordenada de origen en Q16 del centro del píxel i con un paso scale (Q16), limitada al plano.
+ */
+static inline int32_t __lbp_source(uint32_t i, uint32_t scale, uint32_t size)
+{
+	int32_t s = (int32_t)(((2 * i + 1) * scale - 65536) / 2);
+
+	if (s < 0) {
+		return 0;
+	}
+	if (s > (int32_t)((size - 1) << 16)) {
+		return (size - 1) << 16;
+	}
+	return s;
+}
+
+/**
+ * @brief Fila y de un nivel reescalado con interpolación bilineal.
+ */
+static void __lbp_resize_row(uint8_t *dst, uint16_t dst_width, uint32_t y, const uint8_t *src, uint32_t stride,
+			     uint16_t width, uint16_t height, uint32_t scale)
+{
+	const int32_t sy = __lbp_source(y, scale, height);
+	const uint32_t y0 = sy >> 16, fy = (sy >> 8) & 255;
+	const uint8_t *r0 = src + y0 * stride, *r1 = y0 + 1 < height ? r0 + stride : r0;
+
+	for (uint32_t x = 0; x < dst_width; x++) {
+		const int32_t sx = __lbp_source(x, scale, width);
+		const uint32_t x0 = sx >> 16, x1 = x0 + 1 < width ? x0 + 1 : x0, fx = (sx >> 8) & 255;
+		uint32_t top = r0[x0] * (256 - fx) + r0[x1] * fx;
+		uint32_t bottom = r1[x0] * (256 - fx) + r1[x1] * fx;
+
+		dst[x] = (top * (256 - fy) + bottom * fy + (1 << 15)) >> 16;
+	}
+}
+
+/**
+ * @brief Fila row (>= 1) de la integral a partir de la anterior, en sus dos copias del anillo.
+ */
+static void PLACEMENT_RAM(__lbp_integral_row)(uint16_t *ring, uint32_t rows, uint32_t stride, uint32_t row,
+					      const uint8_t *src, uint16_t width)
+{
+	const uint32_t slot = row % rows;
+	const uint16_t *above = ring + (slot ? slot - 1 : 2 * rows - 1) * stride;
+	uint16_t *out = ring + slot * stride, *copy = out + rows * stride;
+	uint16_t acc = 0;
+
+	out[0] = copy[0] = 0;
+	for (uint32_t x = 0; x < width; x++) {
+		acc += src[x];
+		out[x + 1] = copy[x + 1] = above[x + 1] + acc;
+	}
+}
+
+/**
+ * @brief Añade una detección en bruto al grupo parecido o a uno nuevo.
+ */
+static void __lbp_group(struct lbp_group *groups, int *n_groups, uint32_t x, uint32_t y, uint32_t w, uint32_t h)
+{
+	for (int i = 0; i < *n_groups; i++) {
+		struct lbp_group *g = &groups[i];
+		const uint32_t gx = g->x / g->n, gy = g->y / g->n, gw = g->w / g->n, gh = g->h / g->n;
+
+		// Mismo criterio que groupRectangles() de OpenCV con eps = 0.2
+		const int32_t delta = ((w < gw ? w : gw) + (h < gh ? h : gh)) / 10;
+		if (abs((int32_t)(x - gx)) <= delta && abs((int32_t)(y - gy)) <= delta &&
+		    abs((int32_t)(x + w - gx - gw)) <= delta && abs((int32_t)(y + h - gy - gh)) <= delta) {
+			g->x += x;
+			g->y += y;
+			g->w += w;
+			g->h += h;
+			g->n++;
+			return;
+		}
+	}
+
+	if (*n_groups < LBP_MAX_GROUPS) {
+		groups[(*n_groups)++] = (struct lbp_group){ x, y, w, h, 1 };
+	}
+}
+
+/**
+ * @brief Busca el objeto en todas las escalas.
+ * @return Grupos escritos, o -1 en error.
+ */
+int lbp_detect(const struct lbp_cascade *cascade, const uint8_t *plane, uint32_t stride, uint16_t width,
+	       uint16_t height, uint8_t *work, struct lbp_detection *detections, int max_detections)
+{
+	const uint32_t rows = cascade->height + 1u;
+	uint16_t *ring = (uint16_t *)work;
+	uint8_t *line = work + 2 * 2 * rows * (width + 1u);
+	struct lbp_group groups[LBP_MAX_GROUPS];
+	int n_groups = 0, n = 0;
+
+	if (width < cascade->width || height < cascade->height) {
+		return -1;
+	}
+
+	for (uint32_t scale = 1 << 16;; scale = scale * LBP_SCALE_STEP >> 8) {
+		const uint32_t level_width = ((uint32_t)width << 16) / scale, level_height = ((uint32_t)height << 16) / scale;
+		const uint32_t sum_stride = level_width + 1, step = scale < 2u << 16 ? LBP_STEP : 1;
+		uint32_t computed = 1;
+
+		if (level_width < cascade->width || level_height < cascade->height) {
+			break;
+		}
+
+		// La fila 0 de la integral es de ceros; las demás se calculan cuando la ventana llega a ellas
+		for (uint32_t x = 0; x < sum_stride; x++) {
+			ring[x] = ring[rows * sum_stride + x] = 0;
+		}
+		for (uint32_t y = 0; y + cascade->height <= level_height; y += step) {
+			for (; computed <= y + cascade->height; computed++) {
+				const uint8_t *src = plane + (computed - 1) * stride;
+
+				if (scale != 1 << 16) {
+					__lbp_resize_row(line, level_width, computed - 1, plane, stride, width, height, scale);
+					src = line;
+				}
+				__lbp_integral_row(ring, rows, sum_stride, computed, src, level_width);
+			}
+
+			const uint16_t *window = ring + (y % rows) * sum_stride;
+			for (uint32_t x = 0; x + cascade->width <= level_width; x += step) {
+				if (lbp_evaluate(cascade, window + x, sum_stride) == cascade->n_stages) {
+					__lbp_group(groups, &n_groups, (x * scale + (1 << 15)) >> 16,
+						    (y * scale + (1 << 15)) >> 16, (cascade->width * scale + (1 << 15)) >> 16,
+						    (cascade->height * scale + (1 << 15)) >> 16);
+				}
+			}
+		}
+	}
+
+	// Grupos aceptados, ordenados por detecciones
+	for (int i = 0; i < n_groups; i++) {
+		struct lbp_group g = groups[i];
+		int j = n;
+
+		if (g.n < LBP_MIN_HITS) {
+			continue;
+		}
+		for (; j > 0 && groups[j - 1].n < g.n; j--) {
+			groups[j] = groups[j - 1];
+		}
+		groups[j] = g;
+		n++;
+	}
+	if (n > max_detections) {
+		n = max_detections;
+	}
+	for (int i = 0; i < n; i++) {
+		const struct lbp_group *g = &groups[i];
+
+		detections[i] = (struct lbp_detection){ g->x / g->n, g->y / g->n, g->w / g->n, g->h / g->n, g->n, 0 };
+	}
+
+	return n;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file lbp.h
+ * @brief Detector de objetos por cascada de características LBP multibloque (MB-LBP).
+ *
+ * Cada característica es una rejilla de 3x3 bloques de w x h píxeles dentro
+ * de la ventana; su código de 8 bits tiene un bit por bloque exterior, a 1 si
+ * su suma es mayor o igual que la del bloque central (el orden de los bits es
+ * el de OpenCV). Cada clasificador débil suma a la etapa uno de sus dos
+ * valores según el código esté o no en su subconjunto de 256 bits, y la
+ * ventana pasa la etapa si la suma llega al umbral. Valores y umbrales van en
+ * Q12, así que la evaluación es entera.
+ *
+ * Las sumas de bloque salen de una imagen integral de 16 bits: con aritmética
+ * modular la suma de un bloque es exacta mientras no pase de 65535, es decir,
+ * con bloques de hasta 257 píxeles, lo que cubre cualquier característica de
+ * una ventana de hasta 48x48. De la integral solo se guardan las alto + 1
+ * filas que cubre la ventana, en un anillo escrito dos veces para que
+ * cualquier tramo de filas consecutivas sea contiguo; cada fila nueva se
+ * calcula (y se reescala) cuando la ventana baja. Con una ventana de 24 filas
+ * a 160x120 son unos 16 KiB, frente a 38 KiB de una integral entera.
+ *
+ * La cascada se guarda en flash en el formato binario de struct lbp_header y
+ * lbp_cascade_load() solo la valida y apunta a ella. host/lbp_cascade.py la
+ * genera desde una cascada LBP de OpenCV (XML) y ordena los clasificadores de
+ * cada etapa de mayor a menor peso, guardando en cada uno lo máximo que
+ * pueden sumar los siguientes: en cuanto la etapa ya no puede llegar al umbral
+ * se rechaza la ventana sin evaluar el resto.
+ *
+ * La búsqueda recorre una pirámide de escalas (LBP_SCALE_STEP entre niveles),
+ * reescalando la luma con interpolación bilineal, y desliza la ventana con un
+ * paso de LBP_STEP píxeles del nivel (1 desde la escala 2). Las detecciones
+ * parecidas se agrupan y solo se devuelven los grupos con LBP_MIN_HITS o más.
+ */
+
+#ifndef __LBP_H__
+#define __LBP_H__
+
+#include <stdint.h>
+
+#define LBP_MAGIC       0x4350424c  /**< "LBPC" en little-endian */
+#define LBP_VERSION     1           /**< Versión del formato binario */
+#define LBP_MAX_WINDOW  48          /**< Lado máximo de la ventana */
+#define LBP_MAX_BLOCK   257         /**< Píxeles máximos de un bloque (suma de 16 bits) */
+#define LBP_ONE         4096        /**< 1.0 en Q12 */
+#define LBP_SCALE_STEP  320         /**< Factor entre escalas en Q8 (1.25) */
+#define LBP_STEP        2           /**< Paso de la ventana en píxeles del nivel, por debajo de la escala 2 */
+#define LBP_MAX_GROUPS  16          /**< Grupos de detecciones en bruto (en la pila) */
+#define LBP_MIN_HITS    3           /**< Detecciones en bruto de un grupo para aceptarlo */
+
+/** Bytes de trabajo de lbp_detect() para un plano de width píxeles y una ventana de window filas */
+#define LBP_WORK_SIZE(width, window) \
+    (2u * 2 * ((window) + 1) * ((uint32_t)(width) + 1) + (width))
+
+/**
+ * @struct lbp_header
+ * @brief Cabecera de una cascada binaria; le siguen las etapas, las características y los clasificadores.
+ */
+struct lbp_header {
+    uint32_t magic;         /**< LBP_MAGIC */
+    uint8_t version;        /**< LBP_VERSION */
+    uint8_t width;          /**< Ancho de la ventana */
+    uint8_t height;         /**< Alto de la ventana */
+    uint8_t n_stages;       /**< Etapas */
+    uint16_t n_features;    /**< Características */
+    uint16_t n_weaks;       /**< Clasificadores débiles de todas las etapas */
+    uint32_t reserved;      /**< A 0 */
+};
+
+/**
+ * @struct lbp_stage
+ * @brief Etapa de la cascada.
+ */
+struct lbp_stage {
+    uint16_t first;         /**< Primer clasificador */
+    uint16_t count;         /**< Clasificadores */
+    int32_t threshold;      /**< Umbral de la suma en Q12 */
+};
+
+/**
+ * @struct lbp_feature
+ * @brief Rejilla de 3x3 bloques.
+ */
+struct lbp_feature {
+    uint8_t x;              /**< Columna de la rejilla en la ventana */
+    uint8_t y;              /**< Fila de la rejilla en la ventana */
+    uint8_t w;              /**< Ancho de un bloque */
+    uint8_t h;              /**< Alto de un bloque */
+};
+
+/**
+ * @struct lbp_weak
+ * @brief Clasificador débil (un solo nodo).
+ */
+struct lbp_weak {
+    uint16_t feature;       /**< Característica */
+    int16_t inside;         /**< Valor en Q12 si el código está en subset */
+    int16_t outside;        /**< Valor en Q12 si no */
+    uint16_t reserved;      /**< A 0 */
+    int32_t bound;          /**< Suma máxima de los clasificadores siguientes de la etapa, en Q12 */
+    uint32_t subset[8];     /**< Bit c a 1 si el código c está en el subconjunto */
+};
+
+/**
+ * @struct lbp_cascade
+ * @brief Cascada cargada: apunta al binario original.
+ */
+struct lbp_cascade {
+    uint8_t width;                      /**< Ancho de la ventana */
+    uint8_t height;                     /**< Alto de la ventana */
+    uint8_t n_stages;                   /**< Etapas */
+    const struct lbp_stage *stages;     /**< Etapas */
+    const struct lbp_feature *features; /**< Características */
+    const struct lbp_weak *weaks;       /**< Clasificadores */
+};
+
+/**
+ * @struct lbp_detection
+ * @brief Grupo de detecciones, en píxeles del plano original.
+ */
+struct lbp_detection {
+    uint16_t x;             /**< Columna */
+    uint16_t y;             /**< Fila */
+    uint16_t width;         /**< Ancho */
+    uint16_t height;        /**< Alto */
+    uint16_t hits;          /**< Detecciones en bruto agrupadas */
+    uint16_t reserved;      /**< A 0 */
+};
+
+/**
+ * @brief Valida una cascada binaria y apunta a ella sin copiarla.
+ * @param cascade Cascada
+ * @param data    Binario alineado a 4 bytes (por ejemplo en flash); debe seguir vivo
+ * @param size    Bytes de data
+ * @return 0 en éxito, -1 si el binario no es válido
+ */
+int lbp_cascade_load(struct lbp_cascade *cascade, const void *data, uint32_t size);
+
+/**
+ * @brief Evalúa la cascada en una ventana de una imagen integral.
+ * @param cascade Cascada
+ * @param sum     Integral de 16 bits (modular, con la primera fila y columna a 0) en la esquina superior izquierda de la ventana
+ * @param stride  Stride de la integral en elementos
+ * @return Etapas superadas; la ventana es positiva si vale n_stages
+ */
+int lbp_evaluate(const struct lbp_cascade *cascade, const uint16_t *sum, uint32_t stride);
+
+/**
+ * @brief Busca el objeto en todas las escalas.
+ * @param cascade        Cascada
+ * @param plane          Plano Y8
+ * @param stride         Stride del plano en bytes
+ * @param width          Ancho
+ * @param height         Alto
+ * @param work           Buffer de LBP_WORK_SIZE(width, cascade->height) bytes, alineado a 2
+ * @param detections     Grupos aceptados, de más a menos detecciones
+ * @param max_detections Capacidad de detections
+ * @return Grupos escritos, o -1 si el plano es menor que la ventana
+ */
+int lbp_detect(const struct lbp_cascade *cascade, const uint8_t *plane, uint32_t stride, uint16_t width,
+               uint16_t height, uint8_t *work, struct lbp_detection *detections, int max_detections);
+
+#endif /* __LBP_H__ */
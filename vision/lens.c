@@ -0,0 +1,153 @@
+/**
+ * @file lens.c
+ * @brief Implementación de la corrección de lente por rejilla dispersa.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "runtime/placement.h"
+#include "vision/lens.h"
+
+/**
+ * @brief Calcula los nodos del modelo radial.
+ * @return 0 en éxito, -1 en error.
+ */
+int lens_calib_radial(struct lens_calib *calib, uint16_t width, uint16_t height, float k1, float k2,
+		      float vignette)
+{
+	if (!width || !height || width > LENS_MAX_WIDTH || height > LENS_MAX_HEIGHT) {
+		return -1;
+	}
+
+	*calib = (struct lens_calib){
+		.width = width,
+		.height = height,
+		.nodes_x = (width + LENS_BLOCK - 1) / LENS_BLOCK + 1,
+		.nodes_y = (height + LENS_BLOCK - 1) / LENS_BLOCK + 1,
+	};
+
+	const float cx = (width - 1) / 2.0f;
+	const float cy = (height - 1) / 2.0f;
+	const float r2_norm = 1.0f / (cx * cx + cy * cy);
+
+	for (int ny = 0; ny < calib->nodes_y; ny++) {
+		for (int nx = 0; nx < calib->nodes_x; nx++) {
+			float px = nx * LENS_BLOCK - cx;
+			float py = ny * LENS_BLOCK - cy;
+			float r2 = (px * px + py * py) * r2_norm;
+			float scale = k1 * r2 + k2 * r2 * r2;
+			long dx = lroundf(px * scale * 4.0f);
+			long dy = lroundf(py * scale * 4.0f);
+			long gain = lroundf((1.0f + vignette * r2) * LENS_GAIN_ONE);
+
+			if (dx < INT8_MIN || dx > INT8_MAX || dy < INT8_MIN || dy > INT8_MAX || gain < 0 || gain > UINT8_MAX) {
+				return -1;
+			}
+			calib->nodes[ny][nx] = (struct lens_node){ dx, dy, gain };
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Vuelca la rejilla como inicializador C.
+ */
+void lens_calib_print(const struct lens_calib *calib, const char *name)
+{
+	printf("const struct lens_calib %s = {\n", name);
+	printf("\t.width = %u,\n\t.height = %u,\n\t.nodes_x = %u,\n\t.nodes_y = %u,\n\t.nodes = {\n", calib->width,
+	       calib->height, calib->nodes_x, calib->nodes_y);
+	for (int ny = 0; ny < calib->nodes_y; ny++) {
+		printf("\t\t{");
+		for (int nx = 0; nx < calib->nodes_x; nx++) {
+			const struct lens_node *n = &calib->nodes[ny][nx];
+			printf(" { %d, %d, %u },", n->dx, n->dy, n->gain);
+		}
+		printf(" },\n");
+	}
+	printf("\t},\n};\n");
+}
+
+/**
+ * @brief Recorre el frame de salida por bloques de nodos (expandida por formato).
+ *
+ * Por fila, los nodos de las dos filas de la rejilla que la rodean se mezclan
+ * en vertical (x LENS_BLOCK); dentro de cada bloque el valor a la izquierda se
+ * escala por LENS_BLOCK y se le suma la diferencia con el nodo derecho en cada
+ * píxel. Desplazamientos en Q2 + 2 * LENS_BLOCK_SHIFT y ganancia en Q6 + 2 * LENS_BLOCK_SHIFT.
+ */
+static inline __attribute__((always_inline)) void __lens_correct(const struct lens_calib *calib, uint8_t *dst,
+								 uint32_t dst_stride, const uint8_t *src,
+								 uint32_t src_stride, bool rgb565)
+{
+	const int32_t w = calib->width;
+	const int32_t h = calib->height;
+	const int pos_shift = 2 + 2 * LENS_BLOCK_SHIFT;
+	const int gain_shift = 6 + 2 * LENS_BLOCK_SHIFT;
+	int32_t row_dx[LENS_MAX_NODES_X];
+	int32_t row_dy[LENS_MAX_NODES_X];
+	int32_t row_gain[LENS_MAX_NODES_X];
+
+	for (int32_t y = 0; y < h; y++) {
+		const struct lens_node *top = calib->nodes[y >> LENS_BLOCK_SHIFT];
+		const struct lens_node *bottom = calib->nodes[(y >> LENS_BLOCK_SHIFT) + 1];
+		int32_t fy = y & (LENS_BLOCK - 1);
+		uint8_t *out = dst + (uint32_t)y * dst_stride;
+
+		for (int n = 0; n < calib->nodes_x; n++) {
+			row_dx[n] = top[n].dx * (LENS_BLOCK - fy) + bottom[n].dx * fy;
+			row_dy[n] = top[n].dy * (LENS_BLOCK - fy) + bottom[n].dy * fy;
+			row_gain[n] = top[n].gain * (LENS_BLOCK - fy) + bottom[n].gain * fy;
+		}
+
+		for (int32_t bx = 0, x = 0; x < w; bx++) {
+			int32_t dx = row_dx[bx] * LENS_BLOCK, ddx = row_dx[bx + 1] - row_dx[bx];
+			int32_t dy = row_dy[bx] * LENS_BLOCK, ddy = row_dy[bx + 1] - row_dy[bx];
+			int32_t g = row_gain[bx] * LENS_BLOCK, dg = row_gain[bx + 1] - row_gain[bx];
+			int32_t x_end = x + LENS_BLOCK < w ? x + LENS_BLOCK : w;
+
+			for (; x < x_end; x++, dx += ddx, dy += ddy, g += dg) {
+				int32_t sx = x + ((dx + (1 << (pos_shift - 1))) >> pos_shift);
+				int32_t sy = y + ((dy + (1 << (pos_shift - 1))) >> pos_shift);
+				sx = sx < 0 ? 0 : (sx >= w ? w - 1 : sx);
+				sy = sy < 0 ? 0 : (sy >= h ? h - 1 : sy);
+
+				const uint8_t *row = src + (uint32_t)sy * src_stride;
+				if (rgb565) {
+					const uint8_t *p = row + 2 * sx;
+					uint32_t v = (p[0] << 8) | p[1];
+					uint32_t r = ((v >> 11) * g) >> gain_shift;
+					uint32_t gr = (((v >> 5) & 0x3f) * g) >> gain_shift;
+					uint32_t b = ((v & 0x1f) * g) >> gain_shift;
+					v = ((r > 31 ? 31 : r) << 11) | ((gr > 63 ? 63 : gr) << 5) | (b > 31 ? 31 : b);
+					out[2 * x] = v >> 8;
+					out[2 * x + 1] = v & 0xff;
+				} else {
+					uint32_t v = (row[sx] * g) >> gain_shift;
+					out[x] = v > 255 ? 255 : v;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Corrige un frame RGB565 big-endian.
+ */
+void PLACEMENT_RAM(lens_correct_rgb565be)(const struct lens_calib *calib, uint8_t *dst, uint32_t dst_stride,
+					  const uint8_t *src, uint32_t src_stride)
+{
+	__lens_correct(calib, dst, dst_stride, src, src_stride, true);
+}
+
+/**
+ * @brief Corrige un plano Y8.
+ */
+void PLACEMENT_RAM(lens_correct_y8)(const struct lens_calib *calib, uint8_t *dst, uint32_t dst_stride,
+				    const uint8_t *src, uint32_t src_stride)
+{
+	__lens_correct(calib, dst, dst_stride, src, src_stride, false);
+}
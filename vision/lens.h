@@ -0,0 +1,102 @@
+/**
+ * @file lens.h
+ * @brief Corrección de sombreado (viñeteo) y distorsión de la lente con una tabla dispersa.
+ *
+ * La calibración es una rejilla de nodos cada LENS_BLOCK píxeles. Cada nodo
+ * guarda en 3 bytes el desplazamiento hasta el píxel de origen (en cuartos de
+ * píxel) y la ganancia de sombreado (Q6), de modo que un frame de 320x240
+ * necesita 21x16 nodos (1 KiB) en lugar de un mapa por píxel.
+ *
+ * La corrección es una sola pasada por el frame de salida: desplazamiento y
+ * ganancia se interpolan bilinealmente entre los cuatro nodos del bloque con
+ * sumas incrementales (una por magnitud y píxel) y el origen se muestrea por
+ * vecino más cercano. No hay trigonometría ni divisiones por píxel.
+ *
+ * lens_calib_radial() calcula la rejilla para un modelo radial una vez por
+ * calibración; lens_calib_print() la vuelca como inicializador C para dejarla
+ * en flash como const struct lens_calib.
+ */
+
+#ifndef __LENS_H__
+#define __LENS_H__
+
+#include <stdint.h>
+
+#define LENS_BLOCK_SHIFT 4                          /**< Separación entre nodos: 2^n píxeles */
+#define LENS_BLOCK       (1 << LENS_BLOCK_SHIFT)    /**< Separación entre nodos en píxeles */
+#define LENS_MAX_WIDTH   320                        /**< Ancho máximo de la imagen */
+#define LENS_MAX_HEIGHT  240                        /**< Alto máximo de la imagen */
+#define LENS_MAX_NODES_X (LENS_MAX_WIDTH / LENS_BLOCK + 1)
+#define LENS_MAX_NODES_Y (LENS_MAX_HEIGHT / LENS_BLOCK + 1)
+#define LENS_GAIN_ONE    64                         /**< Ganancia unidad (Q6) */
+
+/**
+ * @struct lens_node
+ * @brief Nodo de la rejilla.
+ */
+struct lens_node {
+    int8_t dx;     /**< Desplazamiento horizontal al origen, en cuartos de píxel */
+    int8_t dy;     /**< Desplazamiento vertical al origen, en cuartos de píxel */
+    uint8_t gain;  /**< Ganancia de sombreado, Q6 (LENS_GAIN_ONE = 1) */
+};
+
+/**
+ * @struct lens_calib
+ * @brief Rejilla de calibración para un tamaño de imagen.
+ */
+struct lens_calib {
+    uint16_t width;                                           /**< Ancho de la imagen */
+    uint16_t height;                                          /**< Alto de la imagen */
+    uint8_t nodes_x;                                          /**< Nodos por fila */
+    uint8_t nodes_y;                                          /**< Filas de nodos */
+    struct lens_node nodes[LENS_MAX_NODES_Y][LENS_MAX_NODES_X]; /**< Nodos, fila a fila */
+};
+
+/**
+ * @brief Calcula la rejilla para un modelo radial de distorsión y viñeteo.
+ *
+ * Con r la distancia al centro normalizada a la semidiagonal, el píxel de
+ * salida p toma el origen c + (p - c)(1 + k1 r^2 + k2 r^4) (k1 < 0 corrige el
+ * barril) y se multiplica por 1 + vignette r^2.
+ *
+ * @param calib    Rejilla destino
+ * @param width    Ancho de la imagen (<= LENS_MAX_WIDTH)
+ * @param height   Alto de la imagen (<= LENS_MAX_HEIGHT)
+ * @param k1       Coeficiente radial de segundo orden
+ * @param k2       Coeficiente radial de cuarto orden
+ * @param vignette Ganancia extra en las esquinas (0 = sin sombreado)
+ * @return 0 en éxito, -1 si el tamaño no es válido o algún nodo se sale del rango representable
+ */
+int lens_calib_radial(struct lens_calib *calib, uint16_t width, uint16_t height, float k1, float k2,
+                      float vignette);
+
+/**
+ * @brief Imprime la rejilla como inicializador C de una const struct lens_calib.
+ * @param calib Rejilla
+ * @param name  Nombre de la variable
+ */
+void lens_calib_print(const struct lens_calib *calib, const char *name);
+
+/**
+ * @brief Corrige un frame RGB565 big-endian.
+ * @param calib      Rejilla del tamaño del frame
+ * @param dst        Destino (distinto de src)
+ * @param dst_stride Stride del destino en bytes
+ * @param src        Origen
+ * @param src_stride Stride del origen en bytes
+ */
+void lens_correct_rgb565be(const struct lens_calib *calib, uint8_t *dst, uint32_t dst_stride, const uint8_t *src,
+                           uint32_t src_stride);
+
+/**
+ * @brief Corrige un plano Y8.
+ * @param calib      Rejilla del tamaño del plano
+ * @param dst        Destino (distinto de src)
+ * @param dst_stride Stride del destino en bytes
+ * @param src        Origen
+ * @param src_stride Stride del origen en bytes
+ */
+void lens_correct_y8(const struct lens_calib *calib, uint8_t *dst, uint32_t dst_stride, const uint8_t *src,
+                     uint32_t src_stride);
+
+#endif /* __LENS_H__ */
@@ -0,0 +1,293 @@
+/**
+ * @file match.c
+ * @brief Implementación de la búsqueda de plantillas por NCC de grueso a fino.
+ */
+
+#include "runtime/placement.h"
+#include "vision/match.h"
+
+/**
+ * @brief Reduce un plano a la mitad con la media de cada bloque 2x2.
+ */
+static void __match_halve(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint16_t width,
+			  uint16_t height)
+{
+	for (uint16_t y = 0; y < height; y++) {
+		const uint8_t *a = src + 2 * (uint32_t)y * src_stride;
+		const uint8_t *b = a + src_stride;
+		uint8_t *out = dst + (uint32_t)y * dst_stride;
+
+		for (uint16_t x = 0; x < width; x++, a += 2, b += 2) {
+			out[x] = (a[0] + a[1] + b[0] + b[1] + 2) >> 2;
+		}
+	}
+}
+
+/**
+ * @brief Raíz cuadrada entera (por defecto) de un valor de hasta 64 bits.
+ *
+ * Por encima de 32 bits el valor se reduce por potencias de 4 antes de la
+ * raíz, así que el resultado conserva 16 bits significativos.
+ */
+static uint32_t __match_isqrt(uint64_t value)
+{
+	int shift = 0;
+
+	while (value >> 32) {
+		value >>= 2;
+		shift++;
+	}
+
+	uint32_t v = value, root = 0, bit = 1u << 30;
+	while (bit > v) {
+		bit >>= 2;
+	}
+	while (bit) {
+		if (v >= root + bit) {
+			v -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root << shift;
+}
+
+/**
+ * @brief Puntuación Q15 a partir del numerador, la varianza de la ventana y la norma de la plantilla.
+ */
+static int32_t __match_score(int64_t num, uint64_t var, uint32_t norm)
+{
+	uint64_t den = (uint64_t)__match_isqrt(var) * norm;
+
+	// |num| <= den: se reducen ambos hasta que den quepa en 15 bits y la
+	// división sea de 32 bits
+	while (den >= (1u << 15)) {
+		den >>= 1;
+		num >>= 1;
+	}
+	if (!den) {
+		return 0;
+	}
+
+	int32_t score = ((int32_t)num << 15) / (int32_t)den;
+	return score > MATCH_SCORE_ONE ? MATCH_SCORE_ONE : score;
+}
+
+/**
+ * @brief Carga la plantilla y precalcula ΣT y la norma de cada nivel.
+ * @return 0 en éxito, -1 en error.
+ */
+int match_template_init(struct match_template *tmpl, const uint8_t *pixels, uint32_t stride, uint8_t width,
+			uint8_t height)
+{
+	if (width < MATCH_MIN_SIDE || height < MATCH_MIN_SIDE || width > MATCH_MAX_TEMPLATE ||
+	    height > MATCH_MAX_TEMPLATE) {
+		return -1;
+	}
+
+	tmpl->levels = 1;
+	tmpl->width[0] = width;
+	tmpl->height[0] = height;
+	tmpl->offset[0] = 0;
+	for (uint8_t y = 0; y < height; y++) {
+		for (uint8_t x = 0; x < width; x++) {
+			tmpl->pixels[(uint32_t)y * width + x] = pixels[(uint32_t)y * stride + x];
+		}
+	}
+
+	for (int l = 1; l < MATCH_LEVELS; l++) {
+		uint8_t w = tmpl->width[l - 1] / 2, h = tmpl->height[l - 1] / 2;
+
+		if (w < MATCH_MIN_SIDE || h < MATCH_MIN_SIDE) {
+			break;
+		}
+		tmpl->width[l] = w;
+		tmpl->height[l] = h;
+		tmpl->offset[l] = tmpl->offset[l - 1] + tmpl->width[l - 1] * tmpl->height[l - 1];
+		__match_halve(tmpl->pixels + tmpl->offset[l], w, tmpl->pixels + tmpl->offset[l - 1], tmpl->width[l - 1], w,
+			      h);
+		tmpl->levels++;
+	}
+
+	for (int l = 0; l < tmpl->levels; l++) {
+		const uint8_t *t = tmpl->pixels + tmpl->offset[l];
+		uint32_t n = tmpl->width[l] * tmpl->height[l];
+		uint32_t sum = 0;
+		uint64_t sum_sq = 0;
+
+		for (uint32_t i = 0; i < n; i++) {
+			sum += t[i];
+			sum_sq += t[i] * t[i];
+		}
+
+		uint64_t var = n * sum_sq - (uint64_t)sum * sum;
+		if (!var) {
+			return -1;
+		}
+		tmpl->sum[l] = sum;
+		tmpl->norm[l] = __match_isqrt(var);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief NCC de la plantilla de un nivel con la ventana en (x, y).
+ */
+static inline int32_t __match_window(const struct match_template *tmpl, int level, const uint8_t *frame,
+				     uint32_t stride, uint16_t x, uint16_t y)
+{
+	const uint8_t *t = tmpl->pixels + tmpl->offset[level];
+	const uint8_t *row = frame + (uint32_t)y * stride + x;
+	const uint8_t w = tmpl->width[level], h = tmpl->height[level];
+	const uint32_t n = w * h;
+	uint32_t sum = 0, sum_sq = 0, cross = 0;
+
+	// Con plantillas de hasta 32x32, ΣI² y ΣIT caben en 32 bits
+	for (uint8_t j = 0; j < h; j++, row += stride, t += w) {
+		for (uint8_t i = 0; i < w; i++) {
+			uint32_t p = row[i];
+			sum += p;
+			sum_sq += p * p;
+			cross += p * t[i];
+		}
+	}
+
+	int64_t num = (int64_t)n * cross - (int64_t)sum * tmpl->sum[level];
+	if (num <= 0) {
+		// Correlación nula o negativa: se ahorra la raíz
+		return 0;
+	}
+
+	uint64_t var = (uint64_t)n * sum_sq - (uint64_t)sum * sum;
+	if (!var) {
+		return 0;
+	}
+
+	return __match_score(num, var, tmpl->norm[level]);
+}
+
+/**
+ * @brief Mejor ventana en un rectángulo de posiciones [x0, x1] x [y0, y1].
+ */
+static void __match_search(const struct match_template *tmpl, int level, const uint8_t *frame, uint32_t stride,
+			   uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, struct match_result *best)
+{
+	best->score = -1;
+
+	for (uint16_t y = y0; y <= y1; y++) {
+		for (uint16_t x = x0; x <= x1; x++) {
+			int32_t score = __match_window(tmpl, level, frame, stride, x, y);
+
+			if (score > best->score) {
+				*best = (struct match_result){ x, y, score };
+			}
+		}
+	}
+}
+
+/**
+ * @brief Inserta una ventana del nivel grueso en la lista de candidatos (ordenada de mayor a menor).
+ *
+ * Las ventanas a MATCH_REFINE o menos de un candidato son el mismo pico: solo
+ * se conserva la mejor.
+ */
+static void __match_candidate(struct match_result *cands, int *n_cands, struct match_result cand)
+{
+	int i, n = *n_cands;
+
+	for (i = 0; i < n; i++) {
+		int dx = cands[i].x - cand.x, dy = cands[i].y - cand.y;
+
+		if (dx >= -MATCH_REFINE && dx <= MATCH_REFINE && dy >= -MATCH_REFINE && dy <= MATCH_REFINE) {
+			if (cands[i].score >= cand.score) {
+				return;
+			}
+			// Se quita el candidato vecino y se reinserta el nuevo en su sitio
+			for (; i + 1 < n; i++) {
+				cands[i] = cands[i + 1];
+			}
+			n--;
+			break;
+		}
+	}
+
+	if (n == MATCH_CANDIDATES) {
+		if (cands[n - 1].score >= cand.score) {
+			*n_cands = n;
+			return;
+		}
+		n--;
+	}
+	for (i = n; i > 0 && cands[i - 1].score < cand.score; i--) {
+		cands[i] = cands[i - 1];
+	}
+	cands[i] = cand;
+	*n_cands = n + 1;
+}
+
+/**
+ * @brief Busca la plantilla de grueso a fino.
+ * @return 0 en éxito, -1 en error.
+ */
+int PLACEMENT_RAM(match_find)(const struct match_template *tmpl, const uint8_t *frame, uint32_t stride,
+			      uint16_t width, uint16_t height, uint8_t *work, struct match_result *result)
+{
+	const uint8_t *planes[MATCH_LEVELS];
+	uint32_t strides[MATCH_LEVELS];
+	uint16_t widths[MATCH_LEVELS], heights[MATCH_LEVELS];
+	struct match_result cands[MATCH_CANDIDATES];
+	int n_cands = 0;
+
+	if (width < tmpl->width[0] || height < tmpl->height[0]) {
+		return -1;
+	}
+
+	planes[0] = frame;
+	strides[0] = stride;
+	widths[0] = width;
+	heights[0] = height;
+	for (int l = 1; l < tmpl->levels; l++) {
+		widths[l] = widths[l - 1] / 2;
+		heights[l] = heights[l - 1] / 2;
+		strides[l] = widths[l];
+		__match_halve(work, strides[l], planes[l - 1], strides[l - 1], widths[l], heights[l]);
+		planes[l] = work;
+		work += (uint32_t)widths[l] * heights[l];
+	}
+
+	// Nivel más grueso: todas las posiciones
+	const int top = tmpl->levels - 1;
+	for (uint16_t y = 0; y <= heights[top] - tmpl->height[top]; y++) {
+		for (uint16_t x = 0; x <= widths[top] - tmpl->width[top]; x++) {
+			int32_t score = __match_window(tmpl, top, planes[top], strides[top], x, y);
+
+			__match_candidate(cands, &n_cands, (struct match_result){ x, y, score });
+		}
+	}
+
+	// Niveles finos: cada candidato se refina alrededor de su posición proyectada
+	result->score = -1;
+	for (int c = 0; c < n_cands; c++) {
+		struct match_result best = cands[c];
+
+		for (int l = top - 1; l >= 0; l--) {
+			int32_t x_max = widths[l] - tmpl->width[l], y_max = heights[l] - tmpl->height[l];
+			int32_t cx = 2 * best.x, cy = 2 * best.y;
+			int32_t x0 = cx - MATCH_REFINE < 0 ? 0 : cx - MATCH_REFINE;
+			int32_t y0 = cy - MATCH_REFINE < 0 ? 0 : cy - MATCH_REFINE;
+			int32_t x1 = cx + MATCH_REFINE > x_max ? x_max : cx + MATCH_REFINE;
+			int32_t y1 = cy + MATCH_REFINE > y_max ? y_max : cy + MATCH_REFINE;
+
+			__match_search(tmpl, l, planes[l], strides[l], x0, x1, y0, y1, &best);
+		}
+		if (best.score > result->score) {
+			*result = best;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file match.h
+ * @brief Búsqueda de una plantilla Y8 por correlación cruzada normalizada (NCC) en pirámide.
+ *
+ * La NCC entre la plantilla T y la ventana I del frame, con n píxeles, es
+ *
+ *     (n ΣIT - ΣI ΣT) / sqrt((n ΣI² - (ΣI)²)(n ΣT² - (ΣT)²))
+ *
+ * y no depende del brillo ni del contraste de la ventana. Se calcula en
+ * enteros: las sumas en 32/64 bits, una raíz entera por ventana y una
+ * división de 32 bits para dar la puntuación en Q15. Los términos de la
+ * plantilla (ΣT y la raíz de su varianza) se calculan al cargarla.
+ *
+ * La búsqueda es de grueso a fino: frame y plantilla se reducen a la mitad
+ * (media 2x2) hasta MATCH_LEVELS niveles y el nivel más grueso se recorre
+ * entero. Sus MATCH_CANDIDATES mejores picos (el submuestreo puede desfasar la
+ * plantilla y dejar el verdadero por detrás de otro parecido) se refinan
+ * nivel a nivel probando solo las posiciones a MATCH_REFINE píxeles de la
+ * proyección del anterior. Con 3 niveles el recorrido completo cuesta 1/256
+ * del de la búsqueda directa y el refinado un número fijo de ventanas,
+ * independiente del tamaño del frame.
+ */
+
+#ifndef __MATCH_H__
+#define __MATCH_H__
+
+#include <stdint.h>
+
+#define MATCH_LEVELS       3      /**< Niveles de la pirámide, incluido el original */
+#define MATCH_MAX_TEMPLATE 32     /**< Lado máximo de la plantilla */
+#define MATCH_MIN_SIDE     8      /**< Lado mínimo de la plantilla en cualquier nivel */
+#define MATCH_REFINE       2      /**< Radio de búsqueda alrededor del candidato en los niveles finos */
+#define MATCH_CANDIDATES   4      /**< Picos del nivel grueso que se refinan */
+#define MATCH_SCORE_ONE    32768  /**< Puntuación de una coincidencia perfecta (Q15) */
+
+/** Píxeles de la plantilla en todos los niveles */
+#define MATCH_TEMPLATE_PIXELS (MATCH_MAX_TEMPLATE * MATCH_MAX_TEMPLATE * 4 / 3 + 1)
+
+/** Bytes de trabajo para los niveles reducidos de un frame de width x height (MATCH_LEVELS = 3) */
+#define MATCH_WORK_SIZE(width, height) \
+    (((uint32_t)(width) / 2) * ((height) / 2) + ((uint32_t)(width) / 4) * ((height) / 4))
+
+/**
+ * @struct match_template
+ * @brief Plantilla con su pirámide y los términos precalculados de la NCC.
+ */
+struct match_template {
+    uint8_t levels;                           /**< Niveles utilizables */
+    uint8_t width[MATCH_LEVELS];              /**< Ancho por nivel */
+    uint8_t height[MATCH_LEVELS];             /**< Alto por nivel */
+    uint16_t offset[MATCH_LEVELS];            /**< Inicio de cada nivel en pixels */
+    uint32_t sum[MATCH_LEVELS];               /**< ΣT por nivel */
+    uint32_t norm[MATCH_LEVELS];              /**< sqrt(n ΣT² - (ΣT)²) por nivel */
+    uint8_t pixels[MATCH_TEMPLATE_PIXELS];    /**< Niveles consecutivos, fila a fila */
+};
+
+/**
+ * @struct match_result
+ * @brief Mejor posición encontrada.
+ */
+struct match_result {
+    uint16_t x;       /**< Columna de la esquina superior izquierda en el frame */
+    uint16_t y;       /**< Fila de la esquina superior izquierda en el frame */
+    int32_t score;    /**< NCC en Q15 (MATCH_SCORE_ONE = 1; las correlaciones negativas valen 0) */
+};
+
+/**
+ * @brief Carga una plantilla: construye su pirámide y precalcula sus términos.
+ * @param tmpl   Plantilla destino
+ * @param pixels Plantilla Y8
+ * @param stride Stride de la plantilla en bytes
+ * @param width  Ancho (MATCH_MIN_SIDE..MATCH_MAX_TEMPLATE)
+ * @param height Alto (MATCH_MIN_SIDE..MATCH_MAX_TEMPLATE)
+ * @return 0 en éxito, -1 si el tamaño no es válido o la plantilla es uniforme
+ */
+int match_template_init(struct match_template *tmpl, const uint8_t *pixels, uint32_t stride, uint8_t width,
+                        uint8_t height);
+
+/**
+ * @brief Busca la plantilla en un frame Y8.
+ * @param tmpl   Plantilla cargada
+ * @param frame  Frame Y8
+ * @param stride Stride del frame en bytes
+ * @param width  Ancho del frame
+ * @param height Alto del frame
+ * @param work   Buffer de MATCH_WORK_SIZE(width, height) bytes para los niveles reducidos
+ * @param result Mejor posición y su puntuación
+ * @return 0 en éxito, -1 si la plantilla no cabe en el frame
+ */
+int match_find(const struct match_template *tmpl, const uint8_t *frame, uint32_t stride, uint16_t width,
+               uint16_t height, uint8_t *work, struct match_result *result);
+
+#endif /* __MATCH_H__ */
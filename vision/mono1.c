@@ -0,0 +1,251 @@
+/**
+ * @file mono1.c
+ * @brief Implementación de las máscaras empaquetadas y su morfología por palabras.
+ */
+
+#include <stdbool.h>
+
+#include "camera/format.h"
+#include "runtime/placement.h"
+#include "vision/mono1.h"
+
+/**
+ * @brief Bits válidos de la última palabra de una fila.
+ */
+static inline uint32_t __mono1_tail_mask(uint16_t width)
+{
+	return width % 32 ? (1u << (width % 32)) - 1 : ~0u;
+}
+
+/**
+ * @brief Comprueba el tamaño y el stride de una máscara.
+ * @return 0 si son válidos, -1 si no.
+ */
+static inline int __mono1_check(uint32_t stride, uint16_t width, uint16_t height)
+{
+	if (!width || !height || width > MONO1_MAX_WIDTH || stride % 4 || stride < (width + 31u) / 32 * 4) {
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Cuenta los bits a 1 de una palabra (el M0+ no tiene instrucción de popcount).
+ */
+static inline uint32_t __mono1_popcount(uint32_t v)
+{
+	v = v - ((v >> 1) & 0x55555555);
+	v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+	v = (v + (v >> 4)) & 0x0f0f0f0f;
+	return (v * 0x01010101) >> 24;
+}
+
+/**
+ * @brief Luma BT.601 de un píxel RGB565 big-endian, en punto fijo.
+ */
+static inline uint8_t __mono1_rgb565be_luma(const uint8_t *p)
+{
+	uint16_t v = (p[0] << 8) | p[1];
+
+	return (((v >> 11) & 0x1f) * 634 + ((v >> 5) & 0x3f) * 607 + (v & 0x1f) * 239) >> 8;
+}
+
+/**
+ * @brief Umbraliza las filas con un paso por píxel fijo (expandida por formato).
+ */
+static inline __attribute__((always_inline)) void __mono1_threshold_rows(uint32_t *dst, uint32_t dst_stride,
+									 const uint8_t *src, uint32_t src_stride,
+									 uint16_t width, uint16_t height,
+									 uint8_t threshold, uint8_t step, bool rgb565)
+{
+	for (uint16_t y = 0; y < height; y++) {
+		const uint8_t *row = src + (uint32_t)y * src_stride;
+		uint32_t *out = (uint32_t *)((uint8_t *)dst + (uint32_t)y * dst_stride);
+
+		for (uint16_t x0 = 0; x0 < width; x0 += 32) {
+			uint16_t n = width - x0 < 32 ? width - x0 : 32;
+			uint32_t word = 0;
+
+			for (uint16_t i = 0; i < n; i++) {
+				const uint8_t *p = row + (uint32_t)(x0 + i) * step;
+				uint8_t luma = rgb565 ? __mono1_rgb565be_luma(p) : p[0];
+				word |= (uint32_t)(luma > threshold) << i;
+			}
+			*out++ = word;
+		}
+	}
+}
+
+/**
+ * @brief Umbraliza la luma a una máscara empaquetada.
+ * @return 0 en éxito, -1 si el formato o el tamaño no son válidos.
+ */
+int PLACEMENT_RAM(mono1_threshold)(uint32_t *dst, uint32_t dst_stride, uint32_t format, const uint8_t *src,
+				   uint32_t src_stride, uint16_t width, uint16_t height, uint8_t threshold)
+{
+	if (__mono1_check(dst_stride, width, height)) {
+		return -1;
+	}
+
+	switch (format) {
+	case FORMAT_RGB565:
+		__mono1_threshold_rows(dst, dst_stride, src, src_stride, width, height, threshold, FORMAT_RGB565_BPP, true);
+		break;
+	case FORMAT_YUYV:
+		__mono1_threshold_rows(dst, dst_stride, src, src_stride, width, height, threshold, FORMAT_YUYV_BPP, false);
+		break;
+	case FORMAT_YUV422:
+		__mono1_threshold_rows(dst, dst_stride, src, src_stride, width, height, threshold, FORMAT_YUV422_BPP, false);
+		break;
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Pasada horizontal de una fila: cada bit con sus vecinos izquierdo y derecho.
+ *
+ * Los vecinos se obtienen desplazando la palabra un bit y trayendo el bit del
+ * extremo de la palabra contigua. Los bits fuera de la imagen valen fill.
+ */
+static inline __attribute__((always_inline)) void __mono1_hpass(uint32_t *out, const uint32_t *row, uint16_t n_words,
+								uint32_t tail, bool erode)
+{
+	const uint32_t fill = erode ? ~0u : 0;
+	uint32_t prev = fill;
+	uint32_t cur = n_words == 1 ? (erode ? row[0] | ~tail : row[0] & tail) : row[0];
+
+	for (uint16_t i = 0; i < n_words; i++) {
+		uint32_t next = fill;
+		if (i + 1 < n_words) {
+			next = row[i + 1];
+			if (i + 2 == n_words) {
+				next = erode ? next | ~tail : next & tail;
+			}
+		}
+
+		uint32_t left = (cur << 1) | (prev >> 31);
+		uint32_t right = (cur >> 1) | (next << 31);
+		out[i] = erode ? cur & left & right : cur | left | right;
+
+		prev = cur;
+		cur = next;
+	}
+}
+
+/**
+ * @brief Erosión o dilatación 3x3 separable sobre filas de palabras.
+ */
+static inline __attribute__((always_inline)) int __mono1_morph(uint32_t *dst, const uint32_t *src, uint32_t stride,
+							       uint16_t width, uint16_t height, bool erode)
+{
+	// Tres filas de la pasada horizontal: anterior, actual y siguiente
+	static uint32_t lines[3][MONO1_MAX_WORDS];
+
+	if (__mono1_check(stride, width, height)) {
+		return -1;
+	}
+
+	const uint32_t fill = erode ? ~0u : 0;
+	const uint32_t tail = __mono1_tail_mask(width);
+	const uint16_t n_words = (width + 31) / 32;
+	const uint32_t words_stride = stride / 4;
+	uint32_t *above = lines[0], *cur = lines[1], *below = lines[2];
+
+	for (uint16_t i = 0; i < n_words; i++) {
+		above[i] = fill;
+	}
+	__mono1_hpass(cur, src, n_words, tail, erode);
+
+	for (uint16_t y = 0; y < height; y++) {
+		if (y + 1 < height) {
+			__mono1_hpass(below, src + (uint32_t)(y + 1) * words_stride, n_words, tail, erode);
+		} else {
+			for (uint16_t i = 0; i < n_words; i++) {
+				below[i] = fill;
+			}
+		}
+
+		uint32_t *out = dst + (uint32_t)y * words_stride;
+		for (uint16_t i = 0; i < n_words; i++) {
+			out[i] = erode ? above[i] & cur[i] & below[i] : above[i] | cur[i] | below[i];
+		}
+		out[n_words - 1] &= tail;
+
+		uint32_t *t = above;
+		above = cur;
+		cur = below;
+		below = t;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Erosión 3x3.
+ * @return 0 en éxito, -1 en error.
+ */
+int PLACEMENT_RAM(mono1_erode)(uint32_t *dst, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height)
+{
+	return __mono1_morph(dst, src, stride, width, height, true);
+}
+
+/**
+ * @brief Dilatación 3x3.
+ * @return 0 en éxito, -1 en error.
+ */
+int PLACEMENT_RAM(mono1_dilate)(uint32_t *dst, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height)
+{
+	return __mono1_morph(dst, src, stride, width, height, false);
+}
+
+/**
+ * @brief Apertura: erosión seguida de dilatación.
+ * @return 0 en éxito, -1 en error.
+ */
+int mono1_open(uint32_t *dst, uint32_t *tmp, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height)
+{
+	if (mono1_erode(tmp, src, stride, width, height)) {
+		return -1;
+	}
+	return mono1_dilate(dst, tmp, stride, width, height);
+}
+
+/**
+ * @brief Cierre: dilatación seguida de erosión.
+ * @return 0 en éxito, -1 en error.
+ */
+int mono1_close(uint32_t *dst, uint32_t *tmp, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height)
+{
+	if (mono1_dilate(tmp, src, stride, width, height)) {
+		return -1;
+	}
+	return mono1_erode(dst, tmp, stride, width, height);
+}
+
+/**
+ * @brief Cuenta los píxeles a 1, ignorando los bits más allá del ancho.
+ * @return Área en píxeles.
+ */
+uint32_t PLACEMENT_RAM(mono1_area)(const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height)
+{
+	if (__mono1_check(stride, width, height)) {
+		return 0;
+	}
+
+	const uint32_t tail = __mono1_tail_mask(width);
+	const uint16_t n_words = (width + 31) / 32;
+	uint32_t area = 0;
+
+	for (uint16_t y = 0; y < height; y++) {
+		const uint32_t *row = src + (uint32_t)y * (stride / 4);
+		for (uint16_t i = 0; i + 1 < n_words; i++) {
+			area += __mono1_popcount(row[i]);
+		}
+		area += __mono1_popcount(row[n_words - 1] & tail);
+	}
+
+	return area;
+}
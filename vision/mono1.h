@@ -0,0 +1,95 @@
+/**
+ * @file mono1.h
+ * @brief Máscaras binarias empaquetadas (FORMAT_MONO1) y morfología de 32 píxeles por palabra.
+ *
+ * Cada fila es un arreglo de palabras de 32 bits; el píxel x está en el bit
+ * x % 32 de la palabra x / 32 y los bits más allá del ancho valen 0. El stride
+ * (en bytes) debe ser múltiplo de 4, como el que da format_stride().
+ *
+ * Erosión y dilatación usan un elemento estructurante de 3x3 y se calculan por
+ * separado en horizontal (desplazamientos de la palabra con acarreo desde las
+ * vecinas) y en vertical (AND/OR de tres filas), de modo que cada operación
+ * procesa 32 píxeles a la vez. Fuera de la imagen se supone 1 al erosionar y
+ * 0 al dilatar, así que los bordes no alteran el resultado.
+ */
+
+#ifndef __MONO1_H__
+#define __MONO1_H__
+
+#include <stdint.h>
+
+#define MONO1_MAX_WIDTH 640                          /**< Ancho máximo de las máscaras */
+#define MONO1_MAX_WORDS ((MONO1_MAX_WIDTH + 31) / 32) /**< Palabras por fila como máximo */
+
+/**
+ * @brief Umbraliza la luma de un frame a una máscara: bit a 1 si la luma supera el umbral.
+ * @param dst        Máscara destino
+ * @param dst_stride Stride de la máscara en bytes (múltiplo de 4)
+ * @param format     Formato de origen (FORMAT_RGB565, FORMAT_YUYV o plano 0 de FORMAT_YUV422)
+ * @param src        Plano 0 del origen
+ * @param src_stride Stride del origen en bytes
+ * @param width      Ancho en píxeles (<= MONO1_MAX_WIDTH)
+ * @param height     Alto en píxeles
+ * @param threshold  Umbral de luma
+ * @return 0 en éxito, -1 si el formato o el tamaño no son válidos
+ */
+int mono1_threshold(uint32_t *dst, uint32_t dst_stride, uint32_t format, const uint8_t *src, uint32_t src_stride,
+                    uint16_t width, uint16_t height, uint8_t threshold);
+
+/**
+ * @brief Erosión 3x3.
+ * @param dst    Máscara destino (distinta de src)
+ * @param src    Máscara de origen
+ * @param stride Stride de ambas en bytes
+ * @param width  Ancho en píxeles
+ * @param height Alto en píxeles
+ * @return 0 en éxito, -1 si el tamaño o el stride no son válidos
+ */
+int mono1_erode(uint32_t *dst, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height);
+
+/**
+ * @brief Dilatación 3x3.
+ * @param dst    Máscara destino (distinta de src)
+ * @param src    Máscara de origen
+ * @param stride Stride de ambas en bytes
+ * @param width  Ancho en píxeles
+ * @param height Alto en píxeles
+ * @return 0 en éxito, -1 si el tamaño o el stride no son válidos
+ */
+int mono1_dilate(uint32_t *dst, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height);
+
+/**
+ * @brief Apertura 3x3 (erosión y dilatación): elimina manchas pequeñas.
+ * @param dst    Máscara destino
+ * @param tmp    Máscara intermedia del mismo tamaño
+ * @param src    Máscara de origen
+ * @param stride Stride de las tres en bytes
+ * @param width  Ancho en píxeles
+ * @param height Alto en píxeles
+ * @return 0 en éxito, -1 si el tamaño o el stride no son válidos
+ */
+int mono1_open(uint32_t *dst, uint32_t *tmp, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height);
+
+/**
+ * @brief Cierre 3x3 (dilatación y erosión): rellena huecos pequeños.
+ * @param dst    Máscara destino
+ * @param tmp    Máscara intermedia del mismo tamaño
+ * @param src    Máscara de origen
+ * @param stride Stride de las tres en bytes
+ * @param width  Ancho en píxeles
+ * @param height Alto en píxeles
+ * @return 0 en éxito, -1 si el tamaño o el stride no son válidos
+ */
+int mono1_close(uint32_t *dst, uint32_t *tmp, const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height);
+
+/**
+ * @brief Área de la máscara: número de bits a 1.
+ * @param src    Máscara
+ * @param stride Stride en bytes
+ * @param width  Ancho en píxeles
+ * @param height Alto en píxeles
+ * @return Píxeles a 1
+ */
+uint32_t mono1_area(const uint32_t *src, uint32_t stride, uint16_t width, uint16_t height);
+
+#endif /* __MONO1_H__ */
@@ -0,0 +1,109 @@
+/**
+ * @file overlay.c
+ * @brief Implementación del texto superpuesto con fuente de 3x5 píxeles.
+ */
+
+#include <stdbool.h>
+
+#include "vision/overlay.h"
+
+/**
+ * @brief Glifos de 3x5: 15 bits, fila superior en los bits 14-12 y columna
+ * izquierda en el bit más alto de cada fila.
+ */
+static const uint16_t overlay_font[36] = {
+	0x7b6f, 0x2c97, 0x73e7, 0x73cf, 0x5bc9, 0x79cf, 0x79ef, 0x7249, 0x7bef, 0x7bcf,  /* 0-9 */
+	0x2bed, 0x6bae, 0x3923, 0x6b6e, 0x79a7, 0x79a4, 0x396b, 0x5bed, 0x7497,  /* A-I */
+	0x126a, 0x5bad, 0x4927, 0x5fed, 0x6b6d, 0x2b6a, 0x6ba4, 0x2b73, 0x6bad,  /* J-R */
+	0x388e, 0x7492, 0x5b6f, 0x5b6a, 0x5bfd, 0x5aad, 0x5a92, 0x72a7,  /* S-Z */
+};
+
+/**
+ * @brief Glifo de un carácter (0 para los que no tienen representación).
+ */
+static uint16_t overlay_glyph(char c)
+{
+	if (c >= '0' && c <= '9') {
+		return overlay_font[c - '0'];
+	}
+	if (c >= 'a' && c <= 'z') {
+		c -= 'a' - 'A';
+	}
+	if (c >= 'A' && c <= 'Z') {
+		return overlay_font[10 + c - 'A'];
+	}
+
+	switch (c) {
+	case '.':
+		return 0x0002;
+	case ':':
+		return 0x0410;
+	case '%':
+		return 0x52a5;
+	case '/':
+		return 0x12a4;
+	case '-':
+		return 0x01c0;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Dibuja la fila line_y del texto sobre una línea RGB565 nativa.
+ */
+void overlay_text_rgb565_line(uint16_t *line, uint16_t width, uint16_t line_y, uint16_t x, uint16_t y,
+			      const char *text, uint16_t fg, uint16_t bg)
+{
+	uint16_t cx = x;
+
+	for (; *text; text++) {
+		if (*text == '\n') {
+			cx = x;
+			y += OVERLAY_CELL_HEIGHT;
+			continue;
+		}
+
+		if (line_y >= y && line_y < y + OVERLAY_CELL_HEIGHT) {
+			int row = line_y - y;
+			uint16_t glyph = overlay_glyph(*text);
+			for (int col = 0; col < OVERLAY_CELL_WIDTH; col++) {
+				if (cx + col >= width) {
+					break;
+				}
+				bool on = row < OVERLAY_GLYPH_HEIGHT && col < OVERLAY_GLYPH_WIDTH &&
+					  (glyph >> (14 - row * OVERLAY_GLYPH_WIDTH - col)) & 1;
+				line[cx + col] = on ? fg : bg;
+			}
+		}
+		cx += OVERLAY_CELL_WIDTH;
+	}
+}
+
+/**
+ * @brief Dibuja texto sobre una imagen RGB565 nativa, recortando en los bordes.
+ */
+void overlay_text_rgb565(uint16_t *image, uint16_t width, uint16_t height, uint16_t x, uint16_t y,
+			 const char *text, uint16_t fg, uint16_t bg)
+{
+	uint32_t lines = 1;
+
+	for (const char *c = text; *c; c++) {
+		lines += *c == '\n';
+	}
+
+	uint32_t end = y + lines * OVERLAY_CELL_HEIGHT;
+	for (uint32_t ly = y; ly < height && ly < end; ly++) {
+		overlay_text_rgb565_line(image + ly * width, width, ly, x, y, text, fg, bg);
+	}
+}
+
+/**
+ * @brief Operación por línea para una cadena fusionada (ver vision/fuse.h).
+ */
+void overlay_text_line_op(uint16_t *line, uint16_t width, uint16_t y, void *ctx)
+{
+	const struct overlay_text *t = ctx;
+
+	overlay_text_rgb565_line(line, width, y, t->x, t->y, t->text, t->fg, t->bg);
+}
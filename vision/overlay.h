@@ -0,0 +1,73 @@
+/**
+ * @file overlay.h
+ * @brief Texto superpuesto sobre imágenes RGB565 con una fuente de 3x5 píxeles.
+ */
+
+#ifndef __OVERLAY_H__
+#define __OVERLAY_H__
+
+#include <stdint.h>
+
+#define OVERLAY_GLYPH_WIDTH  3  /**< Ancho de un carácter */
+#define OVERLAY_GLYPH_HEIGHT 5  /**< Alto de un carácter */
+#define OVERLAY_CELL_WIDTH   4  /**< Avance horizontal (carácter + separación) */
+#define OVERLAY_CELL_HEIGHT  6  /**< Avance vertical entre líneas */
+
+/**
+ * @brief Dibuja texto sobre una imagen RGB565 nativa, recortando en los bordes.
+ *
+ * La fuente cubre dígitos, letras (las minúsculas se muestran como mayúsculas)
+ * y los signos ". : % / -"; el resto se dibuja como espacio. Cada celda se
+ * rellena con el color de fondo para que el texto sea legible sobre la escena.
+ *
+ * @param image  Imagen (width * height píxeles, sin relleno entre filas)
+ * @param width  Ancho de la imagen
+ * @param height Alto de la imagen
+ * @param x      Columna de la esquina superior izquierda del texto
+ * @param y      Fila de la esquina superior izquierda del texto
+ * @param text   Texto terminado en cero ('\n' salta de línea)
+ * @param fg     Color del texto
+ * @param bg     Color de fondo de las celdas
+ */
+void overlay_text_rgb565(uint16_t *image, uint16_t width, uint16_t height, uint16_t x, uint16_t y,
+                         const char *text, uint16_t fg, uint16_t bg);
+
+/**
+ * @brief Dibuja solo una fila del texto sobre una línea de la imagen.
+ *
+ * Permite superponer texto mientras se genera la imagen línea a línea.
+ *
+ * @param line   Línea RGB565 nativa
+ * @param width  Ancho de la línea
+ * @param line_y Fila de la línea en la imagen
+ * @param x      Columna de la esquina superior izquierda del texto
+ * @param y      Fila de la esquina superior izquierda del texto
+ * @param text   Texto terminado en cero
+ * @param fg     Color del texto
+ * @param bg     Color de fondo de las celdas
+ */
+void overlay_text_rgb565_line(uint16_t *line, uint16_t width, uint16_t line_y, uint16_t x, uint16_t y,
+                              const char *text, uint16_t fg, uint16_t bg);
+
+/**
+ * @struct overlay_text
+ * @brief Texto y posición para superponerlo como operación por línea.
+ */
+struct overlay_text {
+    uint16_t x;        /**< Columna de la esquina superior izquierda */
+    uint16_t y;        /**< Fila de la esquina superior izquierda */
+    const char *text;  /**< Texto terminado en cero */
+    uint16_t fg;       /**< Color del texto */
+    uint16_t bg;       /**< Color de fondo */
+};
+
+/**
+ * @brief Operación por línea (fuse_line_fn) que superpone un overlay_text.
+ * @param line  Línea RGB565 nativa
+ * @param width Ancho de la línea
+ * @param y     Fila de la línea
+ * @param ctx   struct overlay_text
+ */
+void overlay_text_line_op(uint16_t *line, uint16_t width, uint16_t y, void *ctx);
+
+#endif /* __OVERLAY_H__ */
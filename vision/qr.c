@@ -0,0 +1,689 @@
+/**
+ * @file qr.c
+ * @brief Implementación de la lectura de códigos QR (versiones 1 a 4).
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vision/qr.h"
+#include "vision/warp.h"
+
+#define QR_MAX_CODEWORDS     100  /**< Palabras de la versión 4 */
+#define QR_MAX_ECC           30   /**< Palabras de corrección por bloque como máximo (28 en 2-H) */
+#define QR_MAX_FORMAT_ERRORS 3    /**< Bits erróneos corregibles en la información de formato */
+#define QR_NUDGE_RING        2    /**< Desplazamiento máximo del cuarto punto sin alineación, en medios módulos */
+
+/** Potencias de α en GF(256) con el polinomio 0x11d */
+static const uint8_t __qr_gf_exp[256] = {
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1d, 0x3a, 0x74, 0xe8, 0xcd, 0x87, 0x13, 0x26,
+	0x4c, 0x98, 0x2d, 0x5a, 0xb4, 0x75, 0xea, 0xc9, 0x8f, 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0xc0,
+	0x9d, 0x27, 0x4e, 0x9c, 0x25, 0x4a, 0x94, 0x35, 0x6a, 0xd4, 0xb5, 0x77, 0xee, 0xc1, 0x9f, 0x23,
+	0x46, 0x8c, 0x05, 0x0a, 0x14, 0x28, 0x50, 0xa0, 0x5d, 0xba, 0x69, 0xd2, 0xb9, 0x6f, 0xde, 0xa1,
+	0x5f, 0xbe, 0x61, 0xc2, 0x99, 0x2f, 0x5e, 0xbc, 0x65, 0xca, 0x89, 0x0f, 0x1e, 0x3c, 0x78, 0xf0,
+	0xfd, 0xe7, 0xd3, 0xbb, 0x6b, 0xd6, 0xb1, 0x7f, 0xfe, 0xe1, 0xdf, 0xa3, 0x5b, 0xb6, 0x71, 0xe2,
+	0xd9, 0xaf, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0d, 0x1a, 0x34, 0x68, 0xd0, 0xbd, 0x67, 0xce,
+	0x81, 0x1f, 0x3e, 0x7c, 0xf8, 0xed, 0xc7, 0x93, 0x3b, 0x76, 0xec, 0xc5, 0x97, 0x33, 0x66, 0xcc,
+	0x85, 0x17, 0x2e, 0x5c, 0xb8, 0x6d, 0xda, 0xa9, 0x4f, 0x9e, 0x21, 0x42, 0x84, 0x15, 0x2a, 0x54,
+	0xa8, 0x4d, 0x9a, 0x29, 0x52, 0xa4, 0x55, 0xaa, 0x49, 0x92, 0x39, 0x72, 0xe4, 0xd5, 0xb7, 0x73,
+	0xe6, 0xd1, 0xbf, 0x63, 0xc6, 0x91, 0x3f, 0x7e, 0xfc, 0xe5, 0xd7, 0xb3, 0x7b, 0xf6, 0xf1, 0xff,
+	0xe3, 0xdb, 0xab, 0x4b, 0x96, 0x31, 0x62, 0xc4, 0x95, 0x37, 0x6e, 0xdc, 0xa5, 0x57, 0xae, 0x41,
+	0x82, 0x19, 0x32, 0x64, 0xc8, 0x8d, 0x07, 0x0e, 0x1c, 0x38, 0x70, 0xe0, 0xdd, 0xa7, 0x53, 0xa6,
+	0x51, 0xa2, 0x59, 0xb2, 0x79, 0xf2, 0xf9, 0xef, 0xc3, 0x9b, 0x2b, 0x56, 0xac, 0x45, 0x8a, 0x09,
+	0x12, 0x24, 0x48, 0x90, 0x3d, 0x7a, 0xf4, 0xf5, 0xf7, 0xf3, 0xfb, 0xeb, 0xcb, 0x8b, 0x0b, 0x16,
+	0x2c, 0x58, 0xb0, 0x7d, 0xfa, 0xe9, 0xcf, 0x83, 0x1b, 0x36, 0x6c, 0xd8, 0xad, 0x47, 0x8e, 0x01,
+};
+
+/** Logaritmos en base α (el de 0 no se usa) */
+static const uint8_t __qr_gf_log[256] = {
+	0x00, 0x00, 0x01, 0x19, 0x02, 0x32, 0x1a, 0xc6, 0x03, 0xdf, 0x33, 0xee, 0x1b, 0x68, 0xc7, 0x4b,
+	0x04, 0x64, 0xe0, 0x0e, 0x34, 0x8d, 0xef, 0x81, 0x1c, 0xc1, 0x69, 0xf8, 0xc8, 0x08, 0x4c, 0x71,
+	0x05, 0x8a, 0x65, 0x2f, 0xe1, 0x24, 0x0f, 0x21, 0x35, 0x93, 0x8e, 0xda, 0xf0, 0x12, 0x82, 0x45,
+	0x1d, 0xb5, 0xc2, 0x7d, 0x6a, 0x27, 0xf9, 0xb9, 0xc9, 0x9a, 0x09, 0x78, 0x4d, 0xe4, 0x72, 0xa6,
+	0x06, 0xbf, 0x8b, 0x62, 0x66, 0xdd, 0x30, 0xfd, 0xe2, 0x98, 0x25, 0xb3, 0x10, 0x91, 0x22, 0x88,
+	0x36, 0xd0, 0x94, 0xce, 0x8f, 0x96, 0xdb, 0xbd, 0xf1, 0xd2, 0x13, 0x5c, 0x83, 0x38, 0x46, 0x40,
+	0x1e, 0x42, 0xb6, 0xa3, 0xc3, 0x48, 0x7e, 0x6e, 0x6b, 0x3a, 0x28, 0x54, 0xfa, 0x85, 0xba, 0x3d,
+	0xca, 0x5e, 0x9b, 0x9f, 0x0a, 0x15, 0x79, 0x2b, 0x4e, 0xd4, 0xe5, 0xac, 0x73, 0xf3, 0xa7, 0x57,
+	0x07, 0x70, 0xc0, 0xf7, 0x8c, 0x80, 0x63, 0x0d, 0x67, 0x4a, 0xde, 0xed, 0x31, 0xc5, 0xfe, 0x18,
+	0xe3, 0xa5, 0x99, 0x77, 0x26, 0xb8, 0xb4, 0x7c, 0x11, 0x44, 0x92, 0xd9, 0x23, 0x20, 0x89, 0x2e,
+	0x37, 0x3f, 0xd1, 0x5b, 0x95, 0xbc, 0xcf, 0xcd, 0x90, 0x87, 0x97, 0xb2, 0xdc, 0xfc, 0xbe, 0x61,
+	0xf2, 0x56, 0xd3, 0xab, 0x14, 0x2a, 0x5d, 0x9e, 0x84, 0x3c, 0x39, 0x53, 0x47, 0x6d, 0x41, 0xa2,
+	0x1f, 0x2d, 0x43, 0xd8, 0xb7, 0x7b, 0xa4, 0x76, 0xc4, 0x17, 0x49, 0xec, 0x7f, 0x0c, 0x6f, 0xf6,
+	0x6c, 0xa1, 0x3b, 0x52, 0x29, 0x9d, 0x55, 0xaa, 0xfb, 0x60, 0x86, 0xb1, 0xbb, 0xcc, 0x3e, 0x5a,
+	0xcb, 0x59, 0x5f, 0xb0, 0x9c, 0xa9, 0xa0, 0x51, 0x0b, 0xf5, 0x16, 0xeb, 0x7a, 0x75, 0x2c, 0xd7,
+	0x4f, 0xae, 0xd5, 0xe9, 0xe6, 0xe7, 0xad, 0xe8, 0x74, 0xd6, 0xf4, 0xea, 0xa8, 0x50, 0x58, 0xaf,
+};
+
+/** Palabras totales por versión */
+static const uint8_t __qr_total[QR_MAX_VERSION + 1] = { 0, 26, 44, 70, 100 };
+
+/**
+ * @brief Bloques y palabras de datos por bloque, por versión y por nivel de
+ *        corrección en el orden de sus bits de formato (M, L, H, Q).
+ */
+static const uint8_t __qr_blocks[QR_MAX_VERSION + 1][4][2] = {
+	{ { 0, 0 } },
+	{ { 1, 16 }, { 1, 19 }, { 1, 9 }, { 1, 13 } },
+	{ { 1, 28 }, { 1, 34 }, { 1, 16 }, { 1, 22 } },
+	{ { 1, 44 }, { 1, 55 }, { 2, 13 }, { 2, 17 } },
+	{ { 2, 32 }, { 1, 80 }, { 4, 9 }, { 2, 24 } },
+};
+
+static const char __qr_alnum[45] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+static inline uint8_t __qr_mul(uint8_t a, uint8_t b)
+{
+	return a && b ? __qr_gf_exp[(__qr_gf_log[a] + __qr_gf_log[b]) % 255] : 0;
+}
+
+static inline uint8_t __qr_div(uint8_t a, uint8_t b)
+{
+	return a ? __qr_gf_exp[(__qr_gf_log[a] + 255 - __qr_gf_log[b]) % 255] : 0;
+}
+
+/**
+ * @brief Corrige un bloque de Reed-Solomon en el sitio.
+ *
+ * El código tiene raíces α^0 .. α^(n_ecc - 1) y el primer byte es el
+ * coeficiente de mayor grado.
+ *
+ * @return Errores corregidos, o -1 si el bloque no es corregible.
+ */
+static int __qr_rs_correct(uint8_t *block, int n, int n_ecc)
+{
+	uint8_t syn[QR_MAX_ECC], omega[QR_MAX_ECC];
+	uint8_t lambda[QR_MAX_ECC + 1] = { 1 }, prev[QR_MAX_ECC + 1] = { 1 }, tmp[QR_MAX_ECC + 1];
+	bool error = false;
+
+	for (int i = 0; i < n_ecc; i++) {
+		uint8_t s = 0;
+		for (int j = 0; j < n; j++) {
+			s = __qr_mul(s, __qr_gf_exp[i]) ^ block[j];
+		}
+		syn[i] = s;
+		error |= s != 0;
+	}
+	if (!error) {
+		return 0;
+	}
+
+	// Berlekamp-Massey: polinomio localizador de errores
+	int errors = 0, m = 1;
+	uint8_t b = 1;
+	for (int r = 0; r < n_ecc; r++) {
+		uint8_t d = syn[r];
+		for (int i = 1; i <= errors; i++) {
+			d ^= __qr_mul(lambda[i], syn[r - i]);
+		}
+		if (!d) {
+			m++;
+			continue;
+		}
+
+		uint8_t coef = __qr_div(d, b);
+		memcpy(tmp, lambda, sizeof(tmp));
+		for (int i = 0; i + m <= n_ecc; i++) {
+			lambda[i + m] ^= __qr_mul(coef, prev[i]);
+		}
+		if (2 * errors <= r) {
+			errors = r + 1 - errors;
+			memcpy(prev, tmp, sizeof(prev));
+			b = d;
+			m = 1;
+		} else {
+			m++;
+		}
+	}
+	if (2 * errors > n_ecc) {
+		return -1;
+	}
+
+	// Evaluador de errores: Ω = S Λ mod x^n_ecc
+	for (int i = 0; i < n_ecc; i++) {
+		uint8_t v = 0;
+		for (int j = 0; j <= i && j <= errors; j++) {
+			v ^= __qr_mul(lambda[j], syn[i - j]);
+		}
+		omega[i] = v;
+	}
+
+	// Chien y Forney: el byte j tiene grado n - 1 - j, X = α^grado
+	int found = 0;
+	for (int j = 0; j < n; j++) {
+		int deg = (n - 1 - j) % 255;
+		uint8_t x_inv = __qr_gf_exp[(255 - deg) % 255];
+		uint8_t value = lambda[0], deriv = 0, pw = 1;
+
+		for (int i = 1; i <= errors; i++) {
+			if (i & 1) {
+				deriv ^= __qr_mul(lambda[i], pw);
+			}
+			pw = __qr_mul(pw, x_inv);
+			value ^= __qr_mul(lambda[i], pw);
+		}
+		if (value) {
+			continue;
+		}
+		if (!deriv) {
+			return -1;
+		}
+
+		uint8_t om = 0;
+		pw = 1;
+		for (int i = 0; i < n_ecc; i++) {
+			om ^= __qr_mul(omega[i], pw);
+			pw = __qr_mul(pw, x_inv);
+		}
+		block[j] ^= __qr_mul(__qr_gf_exp[deg], __qr_div(om, deriv));
+		found++;
+	}
+
+	return found == errors ? found : -1;
+}
+
+/**
+ * @brief Palabra de formato (15 bits, con la máscara 0x5412) de un nivel y una máscara.
+ */
+static uint16_t __qr_format_word(uint8_t format)
+{
+	uint32_t rem = format;
+
+	for (int i = 0; i < 10; i++) {
+		rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+	}
+
+	return (((uint32_t)format << 10) | rem) ^ 0x5412;
+}
+
+/**
+ * @brief Patrón de máscara de datos: 1 si el módulo (x, y) se invierte.
+ */
+static bool __qr_mask(uint8_t mask, int x, int y)
+{
+	switch (mask) {
+	case 0:
+		return (x + y) % 2 == 0;
+	case 1:
+		return y % 2 == 0;
+	case 2:
+		return x % 3 == 0;
+	case 3:
+		return (x + y) % 3 == 0;
+	case 4:
+		return (x / 3 + y / 2) % 2 == 0;
+	case 5:
+		return x * y % 2 + x * y % 3 == 0;
+	case 6:
+		return (x * y % 2 + x * y % 3) % 2 == 0;
+	default:
+		return ((x + y) % 2 + x * y % 3) % 2 == 0;
+	}
+}
+
+/**
+ * @brief Módulos de función (buscadores, separadores, formato, temporización y alineación).
+ */
+static bool __qr_is_function(int x, int y, int dim)
+{
+	if ((x < 9 && y < 9) || (x >= dim - 8 && y < 9) || (x < 9 && y >= dim - 8)) {
+		return true;
+	}
+	if (x == 6 || y == 6) {
+		return true;
+	}
+	return dim > 21 && x >= dim - 9 && x <= dim - 5 && y >= dim - 9 && y <= dim - 5;
+}
+
+/**
+ * @brief Bit de la máscara; fuera de la imagen se considera claro.
+ */
+static inline bool __qr_light(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, int32_t x,
+			      int32_t y)
+{
+	if ((uint32_t)x >= width || (uint32_t)y >= height) {
+		return true;
+	}
+	return (mask[(uint32_t)y * words + (x >> 5)] >> (x & 31)) & 1;
+}
+
+/**
+ * @brief Cuenta los píxeles consecutivos de un color desde (x, y) en la dirección (dx, dy).
+ */
+static int __qr_run(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, int32_t x, int32_t y,
+		    int dx, int dy, bool light, int limit)
+{
+	int n = 0;
+
+	while (n < limit && (uint32_t)x < width && (uint32_t)y < height &&
+	       __qr_light(mask, words, width, height, x, y) == light) {
+		x += dx;
+		y += dy;
+		n++;
+	}
+
+	return n;
+}
+
+/**
+ * @brief Comprueba oscuro-claro-oscuro-claro-oscuro de un módulo cada uno a través de (x, y).
+ * @return true si el patrón cuadra; en center queda el centro del oscuro central a lo largo del eje.
+ */
+static bool __qr_alignment_cross(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, int32_t x,
+				 int32_t y, int dx, int dy, float module, float *center)
+{
+	const int limit = (int)(2 * module) + 2;
+	const float lo = module / 2, hi = module * 3 / 2 + 1;
+
+	int back = __qr_run(mask, words, width, height, x, y, -dx, -dy, false, limit);
+	int fwd = __qr_run(mask, words, width, height, x + dx, y + dy, dx, dy, false, limit);
+	int core = back + fwd;
+	int light_back = __qr_run(mask, words, width, height, x - back * dx, y - back * dy, -dx, -dy, true, limit);
+	int light_fwd = __qr_run(mask, words, width, height, x + (fwd + 1) * dx, y + (fwd + 1) * dy, dx, dy, true, limit);
+	int ring_back = __qr_run(mask, words, width, height, x - (back + light_back) * dx, y - (back + light_back) * dy,
+				 -dx, -dy, false, limit);
+	int ring_fwd = __qr_run(mask, words, width, height, x + (fwd + 1 + light_fwd) * dx,
+				y + (fwd + 1 + light_fwd) * dy, dx, dy, false, limit);
+
+	if (core < lo || core > hi || light_back < lo || light_back > hi || light_fwd < lo || light_fwd > hi ||
+	    ring_back < lo || ring_fwd < lo) {
+		return false;
+	}
+
+	// Centro del oscuro central: del primer al último píxel, más medio píxel
+	*center = (dx ? x : y) + (fwd - (back - 1)) / 2.0f + 0.5f;
+	return true;
+}
+
+/**
+ * @brief Busca el patrón de alineación más cercano a la posición estimada.
+ */
+static bool __qr_find_alignment(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, float ex,
+				float ey, float module, float *ax, float *ay)
+{
+	const int radius = (int)(4 * module) + 1;
+	float best = INFINITY;
+
+	for (int32_t y = (int32_t)ey - radius; y <= (int32_t)ey + radius; y++) {
+		for (int32_t x = (int32_t)ex - radius; x <= (int32_t)ex + radius; x++) {
+			float cx, cy;
+
+			// Solo el primer píxel oscuro de cada tramo
+			if (__qr_light(mask, words, width, height, x, y) || !__qr_light(mask, words, width, height, x - 1, y)) {
+				continue;
+			}
+			if (!__qr_alignment_cross(mask, words, width, height, x, y, 1, 0, module, &cx) ||
+			    !__qr_alignment_cross(mask, words, width, height, (int32_t)cx, y, 0, 1, module, &cy) ||
+			    !__qr_alignment_cross(mask, words, width, height, (int32_t)cx, (int32_t)cy, 1, 0, module, &cx)) {
+				continue;
+			}
+
+			float d = (cx - ex) * (cx - ex) + (cy - ey) * (cy - ey);
+			if (d < best) {
+				best = d;
+				*ax = cx;
+				*ay = cy;
+			}
+		}
+	}
+
+	return best < INFINITY;
+}
+
+/**
+ * @brief Lector de bits de los datos, del más significativo al menos.
+ */
+struct qr_bits {
+    const uint8_t *data;
+    int pos;
+    int len;
+};
+
+static int32_t __qr_read(struct qr_bits *bits, int n)
+{
+	int32_t v = 0;
+
+	if (bits->pos + n > bits->len) {
+		return -1;
+	}
+	for (int i = 0; i < n; i++, bits->pos++) {
+		v = (v << 1) | ((bits->data[bits->pos >> 3] >> (7 - (bits->pos & 7))) & 1);
+	}
+
+	return v;
+}
+
+/**
+ * @brief Interpreta los segmentos de los datos.
+ * @return Bytes escritos, o -1 si los datos no son válidos o no caben.
+ */
+static int __qr_parse(const uint8_t *data, int n_data, char *text, uint16_t max_len)
+{
+	struct qr_bits bits = { data, 0, n_data * 8 };
+	int len = 0;
+
+	while (bits.len - bits.pos >= 4) {
+		int32_t mode = __qr_read(&bits, 4);
+		int32_t count;
+
+		switch (mode) {
+		case 0:
+			return len;
+		case 1:
+			count = __qr_read(&bits, 10);
+			if (count < 0 || len + count > max_len) {
+				return -1;
+			}
+			for (; count >= 3; count -= 3) {
+				int32_t v = __qr_read(&bits, 10);
+				if (v < 0 || v > 999) {
+					return -1;
+				}
+				text[len++] = '0' + v / 100;
+				text[len++] = '0' + v / 10 % 10;
+				text[len++] = '0' + v % 10;
+			}
+			if (count) {
+				int32_t v = __qr_read(&bits, count == 2 ? 7 : 4);
+				if (v < 0 || v > (count == 2 ? 99 : 9)) {
+					return -1;
+				}
+				if (count == 2) {
+					text[len++] = '0' + v / 10;
+				}
+				text[len++] = '0' + v % 10;
+			}
+			break;
+		case 2:
+			count = __qr_read(&bits, 9);
+			if (count < 0 || len + count > max_len) {
+				return -1;
+			}
+			for (; count >= 2; count -= 2) {
+				int32_t v = __qr_read(&bits, 11);
+				if (v < 0 || v >= 45 * 45) {
+					return -1;
+				}
+				text[len++] = __qr_alnum[v / 45];
+				text[len++] = __qr_alnum[v % 45];
+			}
+			if (count) {
+				int32_t v = __qr_read(&bits, 6);
+				if (v < 0 || v >= 45) {
+					return -1;
+				}
+				text[len++] = __qr_alnum[v];
+			}
+			break;
+		case 4:
+			count = __qr_read(&bits, 8);
+			if (count < 0 || len + count > max_len) {
+				return -1;
+			}
+			while (count--) {
+				int32_t v = __qr_read(&bits, 8);
+				if (v < 0) {
+					return -1;
+				}
+				text[len++] = v;
+			}
+			break;
+		case 7: {
+			// ECI: designador de 1, 2 o 3 bytes, sin efecto en la salida
+			int32_t first = __qr_read(&bits, 8);
+			if (first < 0 || ((first & 0x80) && __qr_read(&bits, (first & 0x40) ? 16 : 8) < 0)) {
+				return -1;
+			}
+			break;
+		}
+		case 3:
+			// Anexo estructurado: posición, total y paridad
+			if (__qr_read(&bits, 16) < 0) {
+				return -1;
+			}
+			break;
+		case 5:
+			break;
+		case 9:
+			if (__qr_read(&bits, 8) < 0) {
+				return -1;
+			}
+			break;
+		default:
+			return -1;
+		}
+	}
+
+	return len;
+}
+
+/**
+ * @brief Muestrea la rejilla con la homografía de out a src y decodifica el símbolo.
+ * @return Bytes escritos, o -1 si no se pudo leer.
+ */
+static int __qr_sample(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height, const float out[4][2],
+		       const float src[4][2], int version, char *text, uint16_t max_len)
+{
+	const int dim = 17 + 4 * version;
+	uint32_t grid[QR_MAX_SIZE][(QR_MAX_SIZE + 31) / 32] = { { 0 } };
+	struct warp warp;
+	if (warp_init_points(&warp, out, src, dim, dim)) {
+		return -1;
+	}
+
+	for (int v = 0; v < dim; v++) {
+		for (int u = 0; u < dim; u++) {
+			int32_t x, y;
+
+			warp_map(&warp, u, v, &x, &y);
+			if (!__qr_light(mask, words, width, height, x >> 16, y >> 16)) {
+				grid[v][u >> 5] |= 1u << (u & 31);
+			}
+		}
+	}
+#define QR_DARK(x, y) ((grid[y][(x) >> 5] >> ((x) & 31)) & 1)
+
+	// Formato: las dos copias, corregidas por distancia mínima
+	uint32_t copy1 = 0, copy2 = 0;
+	for (int i = 0; i < 15; i++) {
+		int x1 = i < 8 ? 8 : (i == 8 ? 7 : 14 - i);
+		int y1 = i < 6 ? i : (i < 8 ? i + 1 : 8);
+		int x2 = i < 8 ? dim - 1 - i : 8;
+		int y2 = i < 8 ? 8 : dim - 15 + i;
+
+		copy1 |= (uint32_t)QR_DARK(x1, y1) << i;
+		copy2 |= (uint32_t)QR_DARK(x2, y2) << i;
+	}
+
+	int format = -1, best = QR_MAX_FORMAT_ERRORS + 1;
+	for (int f = 0; f < 32; f++) {
+		uint32_t word = __qr_format_word(f);
+		int d1 = __builtin_popcount(word ^ copy1), d2 = __builtin_popcount(word ^ copy2);
+		int d = d1 < d2 ? d1 : d2;
+
+		if (d < best) {
+			best = d;
+			format = f;
+		}
+	}
+	if (format < 0) {
+		return -1;
+	}
+
+	// Palabras en zigzag desde la esquina inferior derecha, sin la máscara
+	const uint8_t mask_id = format & 7;
+	const int total = __qr_total[version];
+	uint8_t raw[QR_MAX_CODEWORDS] = { 0 };
+	int bit = 0;
+
+	for (int right = dim - 1; right >= 1; right -= 2) {
+		if (right == 6) {
+			right = 5;
+		}
+		bool up = ((right + 1) & 2) == 0;
+
+		for (int vert = 0; vert < dim; vert++) {
+			int y = up ? dim - 1 - vert : vert;
+
+			for (int j = 0; j < 2; j++) {
+				int x = right - j;
+
+				if (__qr_is_function(x, y, dim) || bit >= total * 8) {
+					continue;
+				}
+				if (QR_DARK(x, y) ^ __qr_mask(mask_id, x, y)) {
+					raw[bit >> 3] |= 0x80 >> (bit & 7);
+				}
+				bit++;
+			}
+		}
+	}
+#undef QR_DARK
+
+	// Bloques entrelazados: primero los datos y después la corrección
+	const uint8_t n_blocks = __qr_blocks[version][format >> 3][0];
+	const uint8_t n_data = __qr_blocks[version][format >> 3][1];
+	const int n = total / n_blocks, n_ecc = n - n_data;
+	uint8_t data[QR_MAX_CODEWORDS];
+
+	for (int b = 0; b < n_blocks; b++) {
+		uint8_t block[QR_MAX_CODEWORDS];
+
+		for (int i = 0; i < n_data; i++) {
+			block[i] = raw[i * n_blocks + b];
+		}
+		for (int i = 0; i < n_ecc; i++) {
+			block[n_data + i] = raw[n_data * n_blocks + i * n_blocks + b];
+		}
+		if (__qr_rs_correct(block, n, n_ecc) < 0) {
+			return -1;
+		}
+		memcpy(data + b * n_data, block, n_data);
+	}
+
+	return __qr_parse(data, n_blocks * n_data, text, max_len);
+}
+
+/**
+ * @brief Lee el símbolo suponiendo una versión.
+ * @return Bytes escritos, o -1 si no se pudo leer.
+ */
+static int __qr_decode_version(const uint32_t *mask, uint32_t words, uint16_t width, uint16_t height,
+			       const float tl[2], const float tr[2], const float bl[2], float module, int version,
+			       char *text, uint16_t max_len)
+{
+	const int dim = 17 + 4 * version;
+	float out[4][2] = {
+		{ 3.5f, 3.5f },
+		{ dim - 3.5f, 3.5f },
+		{ dim - 3.5f, dim - 3.5f },
+		{ 3.5f, dim - 3.5f },
+	};
+	float src[4][2] = {
+		{ tl[0], tl[1] },
+		{ tr[0], tr[1] },
+		{ tr[0] + bl[0] - tl[0], tr[1] + bl[1] - tl[1] },
+		{ bl[0], bl[1] },
+	};
+
+	// Desde la versión 2 el cuarto punto es el patrón de alineación
+	if (version > 1) {
+		float f = (dim - 10.0f) / (dim - 7.0f);
+		float ex = tl[0] + (tr[0] - tl[0]) * f + (bl[0] - tl[0]) * f;
+		float ey = tl[1] + (tr[1] - tl[1]) * f + (bl[1] - tl[1]) * f;
+
+		out[2][0] = out[2][1] = dim - 6.5f;
+		src[2][0] = ex;
+		src[2][1] = ey;
+		if (__qr_find_alignment(mask, words, width, height, ex, ey, module, &src[2][0], &src[2][1])) {
+			int len = __qr_sample(mask, words, width, height, out, src, version, text, max_len);
+			if (len >= 0) {
+				return len;
+			}
+			src[2][0] = ex;
+			src[2][1] = ey;
+		}
+	}
+
+	// Sin patrón de alineación el cuarto punto es una estimación afín que la
+	// perspectiva desvía: se prueba desplazado hasta un módulo en cada eje, en
+	// pasos de medio módulo y de más cerca a más lejos
+	const float ux = (tr[0] - tl[0]) / (dim - 7), uy = (tr[1] - tl[1]) / (dim - 7);
+	const float vx = (bl[0] - tl[0]) / (dim - 7), vy = (bl[1] - tl[1]) / (dim - 7);
+	const float cx = src[2][0], cy = src[2][1];
+
+	for (int ring = 0; ring <= QR_NUDGE_RING; ring++) {
+		for (int j = -ring; j <= ring; j++) {
+			for (int i = -ring; i <= ring; i++) {
+				if (abs(i) != ring && abs(j) != ring) {
+					continue;
+				}
+				src[2][0] = cx + (i * ux + j * vx) / 2;
+				src[2][1] = cy + (i * uy + j * vy) / 2;
+
+				int len = __qr_sample(mask, words, width, height, out, src, version, text, max_len);
+				if (len >= 0) {
+					return len;
+				}
+			}
+		}
+	}
+
+	return -1;
+}
+
+
+/**
+ * @brief Orienta los buscadores, estima la versión y lee el símbolo.
+ * @return Bytes escritos, o -1 si no se pudo leer.
+ */
+int qr_decode(const uint32_t *mask, uint32_t stride, uint16_t width, uint16_t height, const float finders[3][2],
+	      float module, char *text, uint16_t max_len)
+{
+	const uint32_t words = stride / 4;
+	float d[3];
+
+	if (module <= 0.0f) {
+		return -1;
+	}
+
+	// La esquina superior izquierda es la opuesta al lado más largo
+	for (int i = 0; i < 3; i++) {
+		const float *a = finders[(i + 1) % 3], *b = finders[(i + 2) % 3];
+		d[i] = hypotf(a[0] - b[0], a[1] - b[1]);
+	}
+	int corner = d[0] > d[1] ? (d[0] > d[2] ? 0 : 2) : (d[1] > d[2] ? 1 : 2);
+	const float *tl = finders[corner], *tr = finders[(corner + 1) % 3], *bl = finders[(corner + 2) % 3];
+
+	// Con el eje y hacia abajo, de la derecha a la de abajo se gira en sentido horario
+	if ((tr[0] - tl[0]) * (bl[1] - tl[1]) - (tr[1] - tl[1]) * (bl[0] - tl[0]) < 0) {
+		const float *t = tr;
+		tr = bl;
+		bl = t;
+	}
+
+	// Los tramos horizontales y verticales cruzan un buscador girado en
+	// diagonal: con el código girado θ miden 7 módulos / max(|cos θ|, |sin θ|)
+	float dx = tr[0] - tl[0], dy = tr[1] - tl[1];
+	float side = (hypotf(dx, dy) + hypotf(bl[0] - tl[0], bl[1] - tl[1])) / 2;
+	module *= fmaxf(fabsf(dx), fabsf(dy)) / hypotf(dx, dy);
+
+	int estimate = (int)lroundf((side / module + 7 - 17) / 4);
+
+	// La estimación puede fallar por un paso con perspectiva: se prueban las vecinas
+	static const int8_t tries[3] = { 0, 1, -1 };
+	for (int i = 0; i < 3; i++) {
+		int version = estimate + tries[i];
+
+		if (version < 1 || version > QR_MAX_VERSION) {
+			continue;
+		}
+		int len = __qr_decode_version(mask, words, width, height, tl, tr, bl, module, version, text, max_len);
+		if (len >= 0) {
+			return len;
+		}
+	}
+
+	return -1;
+}
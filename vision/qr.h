@@ -0,0 +1,41 @@
+/**
+ * @file qr.h
+ * @brief Lectura de códigos QR de las versiones 1 a 4 sobre una máscara FORMAT_MONO1.
+ *
+ * A partir de los centros de los tres patrones buscadores (los localiza
+ * vision/code) se identifica la esquina superior izquierda y la orientación,
+ * se estima la versión por la distancia entre buscadores y, desde la versión
+ * 2, se busca el patrón de alineación para corregir la perspectiva. Los
+ * módulos se muestrean en sus centros con una homografía de vision/warp
+ * (una división por módulo, sin rectificar la imagen).
+ *
+ * La información de formato se corrige por distancia mínima a las 32
+ * palabras válidas y cada bloque de datos por Reed-Solomon (Berlekamp-Massey
+ * y Forney sobre GF(256)). Se interpretan los modos numérico, alfanumérico y
+ * de bytes; ECI y los indicadores FNC1 se saltan y kanji no se admite.
+ */
+
+#ifndef __QR_H__
+#define __QR_H__
+
+#include <stdint.h>
+
+#define QR_MAX_VERSION 4                          /**< Versión máxima admitida */
+#define QR_MAX_SIZE    (17 + 4 * QR_MAX_VERSION)  /**< Lado máximo en módulos */
+
+/**
+ * @brief Decodifica el QR cuyos buscadores están en los puntos dados.
+ * @param mask    Máscara (bit a 1 = claro)
+ * @param stride  Stride de la máscara en bytes (múltiplo de 4)
+ * @param width   Ancho de la máscara
+ * @param height  Alto de la máscara
+ * @param finders Centros de los tres buscadores en píxeles, en cualquier orden
+ * @param module  Tamaño del módulo en píxeles medido en horizontal o vertical (se corrige según el giro)
+ * @param text    Destino del contenido (sin terminar en 0)
+ * @param max_len Capacidad de text
+ * @return Bytes escritos en text, o -1 si no se pudo leer
+ */
+int qr_decode(const uint32_t *mask, uint32_t stride, uint16_t width, uint16_t height, const float finders[3][2],
+              float module, char *text, uint16_t max_len);
+
+#endif /* __QR_H__ */
@@ -0,0 +1,279 @@
+/**
+ * @file rotate.c
+ * @brief Implementación de las rotaciones y trasposiciones por bloques.
+ */
+
+#include <stdbool.h>
+
+#include "runtime/placement.h"
+#include "vision/rotate.h"
+
+/**
+ * @brief Lee o escribe un píxel de 8 o 16 bits (bpp constante tras la expansión).
+ */
+static inline __attribute__((always_inline)) uint32_t __rotate_load(const uint8_t *p, uint8_t bpp)
+{
+	return bpp == 2 ? *(const uint16_t *)p : *p;
+}
+
+static inline __attribute__((always_inline)) void __rotate_store(uint8_t *p, uint32_t v, uint8_t bpp)
+{
+	if (bpp == 2) {
+		*(uint16_t *)p = v;
+	} else {
+		*p = v;
+	}
+}
+
+static inline __attribute__((always_inline)) void __rotate_swap(uint8_t *a, uint8_t *b, uint8_t bpp)
+{
+	uint32_t t = __rotate_load(a, bpp);
+	__rotate_store(a, __rotate_load(b, bpp), bpp);
+	__rotate_store(b, t, bpp);
+}
+
+/**
+ * @brief Copia un bloque; con el tamaño completo constante el bucle se desenrolla.
+ */
+static inline __attribute__((always_inline)) void __rotate_tile(uint8_t *d_row, int32_t step_x, int32_t step_y,
+								const uint8_t *s_row, uint32_t src_stride, uint16_t tw,
+								uint16_t th, uint8_t bpp)
+{
+	for (uint16_t y = 0; y < th; y++, s_row += src_stride, d_row += step_y) {
+		const uint8_t *s = s_row;
+		uint8_t *d = d_row;
+
+		for (uint16_t x = 0; x < tw; x++, s += bpp, d += step_x) {
+			__rotate_store(d, __rotate_load(s, bpp), bpp);
+		}
+	}
+}
+
+/**
+ * @brief Copia un bloque completo juntando en una palabra los 4 / bpp píxeles
+ *        que quedan contiguos en la fila de destino.
+ *
+ * Sirve para 90, 270 y la trasposición: los píxeles de filas consecutivas del
+ * origen en una misma columna acaban uno junto a otro en el destino, en orden
+ * creciente (reverse a 0) o decreciente (90 grados, reverse a 1). Requiere
+ * palabras de destino alineadas; la palabra se compone en little-endian.
+ */
+static inline __attribute__((always_inline)) void __rotate_tile_packed(uint8_t *d_row, int32_t step_x, int32_t step_y,
+								       const uint8_t *s_row, uint32_t src_stride,
+								       uint8_t bpp, bool reverse)
+{
+	const int pack = 4 / bpp;
+
+	if (reverse) {
+		d_row -= (pack - 1) * bpp;
+	}
+
+	for (int y = 0; y < ROTATE_TILE; y += pack, s_row += pack * src_stride, d_row += pack * step_y) {
+		const uint8_t *s = s_row;
+		uint8_t *d = d_row;
+
+		for (int x = 0; x < ROTATE_TILE; x++, s += bpp, d += step_x) {
+			uint32_t word;
+
+			if (bpp == 2) {
+				uint32_t p0 = __rotate_load(s, 2), p1 = __rotate_load(s + src_stride, 2);
+				word = reverse ? (p0 << 16) | p1 : p0 | (p1 << 16);
+			} else {
+				uint32_t p0 = s[0], p1 = s[src_stride], p2 = s[2 * src_stride], p3 = s[3 * src_stride];
+				word = reverse ? (p0 << 24) | (p1 << 16) | (p2 << 8) | p3 : p0 | (p1 << 8) | (p2 << 16) | (p3 << 24);
+			}
+			*(uint32_t *)d = word;
+		}
+	}
+}
+
+/**
+ * @brief Copia el plano bloque a bloque (expandida por bpp).
+ *
+ * El píxel (x, y) del origen va al byte x * step_x + y * step_y del destino,
+ * desde la posición del píxel (0, 0); cada transformación es un par de pasos.
+ */
+static inline __attribute__((always_inline)) void __rotate_tiled(uint8_t *dst, uint32_t dst_stride, const uint8_t *src,
+								 uint32_t src_stride, uint16_t width, uint16_t height,
+								 enum rotate_op op, uint8_t bpp)
+{
+	int32_t step_x, step_y;
+
+	// Las palabras empaquetadas caen alineadas si lo están el destino, su
+	// stride y (a 90 grados) el final de cada fila de destino
+	bool packed = op != ROTATE_180 && !(((uintptr_t)dst | dst_stride) & 3) &&
+		      (op != ROTATE_90 || !(((uint32_t)height * bpp) & 3));
+
+	switch (op) {
+	case ROTATE_90:
+		step_x = dst_stride;
+		step_y = -bpp;
+		dst += (uint32_t)(height - 1) * bpp;
+		break;
+	case ROTATE_180:
+		step_x = -bpp;
+		step_y = -(int32_t)dst_stride;
+		dst += (uint32_t)(height - 1) * dst_stride + (uint32_t)(width - 1) * bpp;
+		break;
+	case ROTATE_270:
+		step_x = -(int32_t)dst_stride;
+		step_y = bpp;
+		dst += (uint32_t)(width - 1) * dst_stride;
+		break;
+	default:
+		step_x = dst_stride;
+		step_y = bpp;
+		break;
+	}
+
+	for (uint16_t ty = 0; ty < height; ty += ROTATE_TILE) {
+		uint16_t th = height - ty < ROTATE_TILE ? height - ty : ROTATE_TILE;
+
+		for (uint16_t tx = 0; tx < width; tx += ROTATE_TILE) {
+			uint16_t tw = width - tx < ROTATE_TILE ? width - tx : ROTATE_TILE;
+			const uint8_t *s_row = src + (uint32_t)ty * src_stride + (uint32_t)tx * bpp;
+			uint8_t *d_row = dst + tx * step_x + ty * step_y;
+
+			if (tw == ROTATE_TILE && th == ROTATE_TILE && packed) {
+				if (op == ROTATE_90) {
+					__rotate_tile_packed(d_row, step_x, step_y, s_row, src_stride, bpp, true);
+				} else {
+					__rotate_tile_packed(d_row, step_x, step_y, s_row, src_stride, bpp, false);
+				}
+			} else if (tw == ROTATE_TILE && th == ROTATE_TILE) {
+				__rotate_tile(d_row, step_x, step_y, s_row, src_stride, ROTATE_TILE, ROTATE_TILE, bpp);
+			} else {
+				__rotate_tile(d_row, step_x, step_y, s_row, src_stride, tw, th, bpp);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Trasposición en el sitio: intercambia cada bloque con su simétrico.
+ */
+static inline __attribute__((always_inline)) void __rotate_transpose_inplace(uint8_t *data, uint32_t stride,
+									     uint16_t size, uint8_t bpp)
+{
+	for (uint16_t ty = 0; ty < size; ty += ROTATE_TILE) {
+		uint16_t th = size - ty < ROTATE_TILE ? size - ty : ROTATE_TILE;
+
+		for (uint16_t tx = ty; tx < size; tx += ROTATE_TILE) {
+			uint16_t tw = size - tx < ROTATE_TILE ? size - tx : ROTATE_TILE;
+
+			for (uint16_t y = 0; y < th; y++) {
+				// En el bloque de la diagonal solo se recorre el triángulo superior
+				uint16_t x = tx == ty ? y + 1 : 0;
+				uint8_t *a = data + (uint32_t)(ty + y) * stride + (uint32_t)(tx + x) * bpp;
+				uint8_t *b = data + (uint32_t)(tx + x) * stride + (uint32_t)(ty + y) * bpp;
+
+				for (; x < tw; x++, a += bpp, b += stride) {
+					__rotate_swap(a, b, bpp);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Invierte el orden de los píxeles de una fila.
+ */
+static inline __attribute__((always_inline)) void __rotate_reverse_row(uint8_t *row, uint16_t width, uint8_t bpp)
+{
+	uint8_t *a = row;
+	uint8_t *b = row + (uint32_t)(width - 1) * bpp;
+
+	for (; a < b; a += bpp, b -= bpp) {
+		__rotate_swap(a, b, bpp);
+	}
+}
+
+/**
+ * @brief Transformación en el sitio de un plano cuadrado (expandida por bpp).
+ */
+static inline __attribute__((always_inline)) void __rotate_inplace(uint8_t *data, uint32_t stride, uint16_t size,
+								   enum rotate_op op, uint8_t bpp)
+{
+	if (!size) {
+		return;
+	}
+
+	switch (op) {
+	case ROTATE_90:
+		// Trasponer y reflejar en horizontal
+		__rotate_transpose_inplace(data, stride, size, bpp);
+		for (uint16_t y = 0; y < size; y++) {
+			__rotate_reverse_row(data + (uint32_t)y * stride, size, bpp);
+		}
+		break;
+	case ROTATE_180:
+		// Intercambiar la fila y invertida con la fila size - 1 - y invertida
+		for (uint16_t y = 0; y < size / 2; y++) {
+			uint8_t *a = data + (uint32_t)y * stride;
+			uint8_t *b = data + (uint32_t)(size - 1 - y) * stride + (uint32_t)(size - 1) * bpp;
+
+			for (uint16_t x = 0; x < size; x++, a += bpp, b -= bpp) {
+				__rotate_swap(a, b, bpp);
+			}
+		}
+		if (size & 1) {
+			__rotate_reverse_row(data + (uint32_t)(size / 2) * stride, size, bpp);
+		}
+		break;
+	case ROTATE_270:
+		// Trasponer y reflejar en vertical
+		__rotate_transpose_inplace(data, stride, size, bpp);
+		for (uint16_t y = 0; y < size / 2; y++) {
+			uint8_t *a = data + (uint32_t)y * stride;
+			uint8_t *b = data + (uint32_t)(size - 1 - y) * stride;
+
+			for (uint16_t x = 0; x < size; x++, a += bpp, b += bpp) {
+				__rotate_swap(a, b, bpp);
+			}
+		}
+		break;
+	default:
+		__rotate_transpose_inplace(data, stride, size, bpp);
+		break;
+	}
+}
+
+/**
+ * @brief Gira o traspone un plano de 16 bits por píxel.
+ */
+void PLACEMENT_RAM(rotate_plane16)(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+				   uint16_t width, uint16_t height, enum rotate_op op)
+{
+	if (!width || !height) {
+		return;
+	}
+	__rotate_tiled(dst, dst_stride, src, src_stride, width, height, op, 2);
+}
+
+/**
+ * @brief Gira o traspone un plano de 8 bits por píxel.
+ */
+void PLACEMENT_RAM(rotate_plane8)(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride,
+				  uint16_t width, uint16_t height, enum rotate_op op)
+{
+	if (!width || !height) {
+		return;
+	}
+	__rotate_tiled(dst, dst_stride, src, src_stride, width, height, op, 1);
+}
+
+/**
+ * @brief Gira o traspone en el sitio un plano cuadrado de 16 bits por píxel.
+ */
+void PLACEMENT_RAM(rotate_square16_inplace)(uint8_t *data, uint32_t stride, uint16_t size, enum rotate_op op)
+{
+	__rotate_inplace(data, stride, size, op, 2);
+}
+
+/**
+ * @brief Gira o traspone en el sitio un plano cuadrado de 8 bits por píxel.
+ */
+void PLACEMENT_RAM(rotate_square8_inplace)(uint8_t *data, uint32_t stride, uint16_t size, enum rotate_op op)
+{
+	__rotate_inplace(data, stride, size, op, 1);
+}
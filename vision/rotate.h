@@ -0,0 +1,86 @@
+/**
+ * @file rotate.h
+ * @brief Rotaciones de 90/180/270 grados y trasposición por bloques para planos de 8 y 16 bits.
+ *
+ * Para grabar o transmitir un frame girado no sirven los trucos de dirección
+ * de escritura del panel, así que la rotación se hace en memoria. Girar 90
+ * grados recorre el origen por filas y escribe el destino por columnas: un
+ * bucle ingenuo salta una fila completa del destino en cada píxel. Aquí el
+ * plano se recorre en bloques de ROTATE_TILE x ROTATE_TILE píxeles, de modo
+ * que las filas de origen y de destino que se tocan a la vez son pocas y
+ * caben en la caché (la de XIP si el origen está en flash) y en los bancos de
+ * SRAM que se están usando.
+ *
+ * Los giros son en sentido horario. Un frame de width x height girado 90 o
+ * 270 grados (o traspuesto) tiene height x width píxeles. Los planos de 16
+ * bits (RGB565) deben estar alineados a 2 bytes.
+ */
+
+#ifndef __ROTATE_H__
+#define __ROTATE_H__
+
+#include <stdint.h>
+
+#define ROTATE_TILE 8  /**< Lado del bloque en píxeles */
+
+/**
+ * @enum rotate_op
+ * @brief Transformación a aplicar.
+ */
+enum rotate_op {
+    ROTATE_90 = 0,     /**< 90 grados en sentido horario */
+    ROTATE_180,        /**< 180 grados */
+    ROTATE_270,        /**< 270 grados en sentido horario (90 antihorario) */
+    ROTATE_TRANSPOSE,  /**< Trasposición (simetría respecto a la diagonal principal) */
+};
+
+/**
+ * @brief Gira o traspone un plano de 16 bits por píxel.
+ * @param dst        Destino (distinto de src)
+ * @param dst_stride Stride del destino en bytes
+ * @param src        Origen
+ * @param src_stride Stride del origen en bytes
+ * @param width      Ancho del origen en píxeles
+ * @param height     Alto del origen en píxeles
+ * @param op         Transformación
+ */
+void rotate_plane16(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint16_t width,
+                    uint16_t height, enum rotate_op op);
+
+/**
+ * @brief Gira o traspone un plano de 8 bits por píxel.
+ * @param dst        Destino (distinto de src)
+ * @param dst_stride Stride del destino en bytes
+ * @param src        Origen
+ * @param src_stride Stride del origen en bytes
+ * @param width      Ancho del origen en píxeles
+ * @param height     Alto del origen en píxeles
+ * @param op         Transformación
+ */
+void rotate_plane8(uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint16_t width,
+                   uint16_t height, enum rotate_op op);
+
+/**
+ * @brief Gira o traspone en el sitio un plano cuadrado de 16 bits por píxel.
+ *
+ * Sin buffer auxiliar: la trasposición intercambia bloques simétricos respecto
+ * a la diagonal y los giros de 90 y 270 grados añaden una simetría horizontal
+ * o vertical.
+ *
+ * @param data   Plano
+ * @param stride Stride en bytes
+ * @param size   Lado en píxeles
+ * @param op     Transformación
+ */
+void rotate_square16_inplace(uint8_t *data, uint32_t stride, uint16_t size, enum rotate_op op);
+
+/**
+ * @brief Gira o traspone en el sitio un plano cuadrado de 8 bits por píxel.
+ * @param data   Plano
+ * @param stride Stride en bytes
+ * @param size   Lado en píxeles
+ * @param op     Transformación
+ */
+void rotate_square8_inplace(uint8_t *data, uint32_t stride, uint16_t size, enum rotate_op op);
+
+#endif /* __ROTATE_H__ */
@@ -0,0 +1,86 @@
+/**
+ * @file view.c
+ * @brief Creación y recorte de vistas de imagen.
+ */
+
+#include "vision/view.h"
+
+/**
+ * @brief Rellena los campos de la vista que dependen del formato y del plano.
+ * @return 0 en éxito, -1 si el formato o el plano no son válidos.
+ */
+static int image_view_set_format(struct image_view *view, uint32_t format, uint8_t plane)
+{
+	const struct format_info *info = format_info(format);
+
+	if (!info || plane >= info->num_planes) {
+		return -1;
+	}
+
+	view->format = format;
+	view->plane = plane;
+	view->bits = info->bits[plane ? 1 : 0];
+	view->hsub = info->hsub[plane ? 1 : 0];
+	view->x_align = info->x_align;
+
+	return 0;
+}
+
+/**
+ * @brief Vista sobre un plano completo del frame.
+ * @return 0 en éxito, -1 en error.
+ */
+int image_view_init(struct image_view *view, const struct camera_buffer *buf, uint8_t plane)
+{
+	if (plane >= CAMERA_MAX_N_PLANES || image_view_set_format(view, buf->format, plane)) {
+		return -1;
+	}
+
+	view->data = buf->data[plane];
+	view->stride = buf->strides[plane];
+	view->width = buf->width;
+	view->height = buf->height;
+
+	return view->data ? 0 : -1;
+}
+
+/**
+ * @brief Vista sobre memoria propia (plano 0 del formato).
+ * @return 0 en éxito, -1 en error.
+ */
+int image_view_wrap(struct image_view *view, uint32_t format, uint8_t *data, uint32_t stride, uint16_t width,
+		    uint16_t height)
+{
+	if (!data || image_view_set_format(view, format, 0)) {
+		return -1;
+	}
+
+	view->data = data;
+	view->stride = stride;
+	view->width = width;
+	view->height = height;
+
+	return stride >= image_view_row_bytes(view) ? 0 : -1;
+}
+
+/**
+ * @brief Subventana que comparte memoria con la vista.
+ * @return 0 en éxito, -1 si queda vacía o se sale de la vista.
+ */
+int image_view_crop(struct image_view *sub, const struct image_view *view, uint16_t x, uint16_t y, uint16_t width,
+		    uint16_t height)
+{
+	x -= x % view->x_align;
+	width -= width % view->x_align;
+
+	if (!width || !height || (uint32_t)x + width > view->width || (uint32_t)y + height > view->height) {
+		return -1;
+	}
+
+	*sub = *view;
+	sub->data = image_view_pixel(view, x, y);
+	sub->width = width;
+	sub->height = height;
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file view.h
+ * @brief Vistas tipadas sin copia sobre un plano de imagen y subventanas (ROI).
+ *
+ * Una vista describe una ventana rectangular de un plano: puntero al primer
+ * píxel, stride y tamaño. Recortar una vista solo desplaza el puntero y reduce
+ * el tamaño, así que la subvista comparte memoria con el frame y los kernels
+ * que reciben (datos, stride, ancho, alto) trabajan sobre la ROI sin copiarla.
+ *
+ * Los accesos por píxel no comprueban límites; image_view_contains() y
+ * image_view_crop() los validan una vez antes del bucle.
+ *
+ * vision/view.hpp ofrece la misma interfaz con tipos de C++17.
+ */
+
+#ifndef __VIEW_H__
+#define __VIEW_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "camera/buffer.h"
+#include "camera/format.h"
+
+/**
+ * @struct image_view
+ * @brief Ventana sobre un plano de un frame.
+ */
+struct image_view {
+    uint8_t *data;      /**< Primer byte de la ventana */
+    uint32_t stride;    /**< Bytes entre filas del plano original */
+    uint16_t width;     /**< Ancho en píxeles de imagen */
+    uint16_t height;    /**< Alto en píxeles */
+    uint32_t format;    /**< Formato del frame */
+    uint8_t plane;      /**< Plano del frame */
+    uint8_t bits;       /**< Bits por muestra del plano */
+    uint8_t hsub;       /**< Submuestreo horizontal del plano */
+    uint8_t x_align;    /**< Alineación horizontal para recortes */
+};
+
+/**
+ * @brief Crea una vista sobre un plano completo de un frame.
+ * @param view  Vista destino
+ * @param buf   Frame
+ * @param plane Plano
+ * @return 0 en éxito, -1 si el formato o el plano no son válidos
+ */
+int image_view_init(struct image_view *view, const struct camera_buffer *buf, uint8_t plane);
+
+/**
+ * @brief Crea una vista sobre memoria propia (por ejemplo un buffer de salida).
+ * @param view   Vista destino
+ * @param format Formato
+ * @param data   Primer byte
+ * @param stride Bytes entre filas
+ * @param width  Ancho en píxeles
+ * @param height Alto en píxeles
+ * @return 0 en éxito, -1 si el formato no es válido o el stride es menor que una fila
+ */
+int image_view_wrap(struct image_view *view, uint32_t format, uint8_t *data, uint32_t stride, uint16_t width,
+                    uint16_t height);
+
+/**
+ * @brief Recorta una subventana que comparte memoria con la vista.
+ *
+ * x y width se redondean hacia abajo a la alineación del formato (pares de
+ * píxeles en YUYV y YUV422) para no partir una muestra de crominancia.
+ *
+ * @param sub    Subvista destino
+ * @param view   Vista de origen
+ * @param x      Columna inicial (relativa a la vista)
+ * @param y      Fila inicial
+ * @param width  Ancho
+ * @param height Alto
+ * @return 0 en éxito, -1 si la ventana queda vacía o se sale de la vista
+ */
+int image_view_crop(struct image_view *sub, const struct image_view *view, uint16_t x, uint16_t y, uint16_t width,
+                    uint16_t height);
+
+/**
+ * @brief Indica si un píxel cae dentro de la vista.
+ */
+static inline bool image_view_contains(const struct image_view *view, int32_t x, int32_t y)
+{
+	return x >= 0 && y >= 0 && x < view->width && y < view->height;
+}
+
+/**
+ * @brief Bytes de una fila de la vista.
+ */
+static inline uint32_t image_view_row_bytes(const struct image_view *view)
+{
+	return ((uint32_t)view->bits * view->width / view->hsub + 7) / 8;
+}
+
+/**
+ * @brief Primer byte de una fila.
+ * @param view Vista
+ * @param y    Fila (< height)
+ */
+static inline uint8_t *image_view_row(const struct image_view *view, uint16_t y)
+{
+	return view->data + (uint32_t)y * view->stride;
+}
+
+/**
+ * @brief Primer byte de la muestra de un píxel (en MONO1, el byte que contiene el bit).
+ * @param view Vista
+ * @param x    Columna (< width)
+ * @param y    Fila (< height)
+ */
+static inline uint8_t *image_view_pixel(const struct image_view *view, uint16_t x, uint16_t y)
+{
+	return image_view_row(view, y) + (uint32_t)x / view->hsub * view->bits / 8;
+}
+
+/**
+ * @brief Píxel RGB565 (big-endian en memoria) en orden nativo.
+ */
+static inline uint16_t image_view_get_rgb565(const struct image_view *view, uint16_t x, uint16_t y)
+{
+	const uint8_t *p = image_view_pixel(view, x, y);
+
+	return (p[0] << 8) | p[1];
+}
+
+/**
+ * @brief Escribe un píxel RGB565 nativo como big-endian.
+ */
+static inline void image_view_set_rgb565(const struct image_view *view, uint16_t x, uint16_t y, uint16_t value)
+{
+	uint8_t *p = image_view_pixel(view, x, y);
+
+	p[0] = value >> 8;
+	p[1] = value;
+}
+
+/**
+ * @brief Luma de un píxel YUYV (primer byte de cada par Y/C).
+ */
+static inline uint8_t image_view_get_yuyv_y(const struct image_view *view, uint16_t x, uint16_t y)
+{
+	return image_view_pixel(view, x, y)[0];
+}
+
+/**
+ * @brief Muestra de un plano de 8 bits (Y, U o V de YUV422).
+ */
+static inline uint8_t image_view_get_u8(const struct image_view *view, uint16_t x, uint16_t y)
+{
+	return image_view_pixel(view, x, y)[0];
+}
+
+#endif /* __VIEW_H__ */
@@ -0,0 +1,182 @@
+/**
+ * @file view.hpp
+ * @brief Vistas de imagen tipadas para C++17 sobre vision/view.h.
+ *
+ * ImageView<Pixel> fija el formato en el tipo: el acceso a píxeles se resuelve
+ * en compilación y una vista solo se construye sobre un frame del formato
+ * correcto. Las filas se recorren con un rango (for (auto row : view.rows())),
+ * y crop() devuelve una subvista que comparte memoria con la original.
+ *
+ * Solo cabeceras; no añade dependencias de la biblioteca estándar de C++.
+ */
+
+#ifndef __VIEW_HPP__
+#define __VIEW_HPP__
+
+#include <stdint.h>
+
+extern "C" {
+#include "vision/view.h"
+}
+
+namespace minivision {
+
+/** @brief Píxel RGB565 big-endian en memoria, leído en orden nativo. */
+struct Rgb565 {
+    using value_type = uint16_t;
+    static constexpr uint32_t format = FORMAT_RGB565;
+    static constexpr uint8_t plane = 0;
+    static constexpr uint8_t step = FORMAT_RGB565_BPP;
+
+    static value_type load(const uint8_t *p) { return static_cast<value_type>((p[0] << 8) | p[1]); }
+    static void store(uint8_t *p, value_type v)
+    {
+        p[0] = static_cast<uint8_t>(v >> 8);
+        p[1] = static_cast<uint8_t>(v);
+    }
+};
+
+/** @brief Luma de un frame YUYV (cada píxel ocupa 2 bytes, la luma es el primero). */
+struct YuyvLuma {
+    using value_type = uint8_t;
+    static constexpr uint32_t format = FORMAT_YUYV;
+    static constexpr uint8_t plane = 0;
+    static constexpr uint8_t step = FORMAT_YUYV_BPP;
+
+    static value_type load(const uint8_t *p) { return p[0]; }
+    static void store(uint8_t *p, value_type v) { p[0] = v; }
+};
+
+/** @brief Plano de luma de un frame YUV422 planar. */
+struct Yuv422Luma {
+    using value_type = uint8_t;
+    static constexpr uint32_t format = FORMAT_YUV422;
+    static constexpr uint8_t plane = 0;
+    static constexpr uint8_t step = FORMAT_YUV422_BPP;
+
+    static value_type load(const uint8_t *p) { return p[0]; }
+    static void store(uint8_t *p, value_type v) { p[0] = v; }
+};
+
+/**
+ * @brief Fila de una vista: acceso por índice e iteración por píxeles.
+ */
+template <typename Pixel>
+class ImageRow {
+public:
+    using value_type = typename Pixel::value_type;
+
+    /** @brief Iterador de píxeles de la fila (solo lectura). */
+    class iterator {
+    public:
+        explicit iterator(const uint8_t *p) : p_(p) {}
+        value_type operator*() const { return Pixel::load(p_); }
+        iterator &operator++()
+        {
+            p_ += Pixel::step;
+            return *this;
+        }
+        bool operator!=(const iterator &other) const { return p_ != other.p_; }
+
+    private:
+        const uint8_t *p_;
+    };
+
+    ImageRow(uint8_t *data, uint16_t width) : data_(data), width_(width) {}
+
+    uint16_t size() const { return width_; }
+    uint8_t *data() const { return data_; }
+    value_type operator[](uint16_t x) const { return Pixel::load(data_ + x * Pixel::step); }
+    void set(uint16_t x, value_type v) const { Pixel::store(data_ + x * Pixel::step, v); }
+    iterator begin() const { return iterator(data_); }
+    iterator end() const { return iterator(data_ + width_ * Pixel::step); }
+
+private:
+    uint8_t *data_;
+    uint16_t width_;
+};
+
+/**
+ * @brief Vista tipada sobre un plano de imagen.
+ *
+ * Una vista construida con un frame de otro formato queda vacía (valid() es
+ * false), igual que image_view_init() devuelve -1.
+ */
+template <typename Pixel>
+class ImageView {
+public:
+    using value_type = typename Pixel::value_type;
+
+    /** @brief Rango de filas para for basado en rangos. */
+    class Rows {
+    public:
+        class iterator {
+        public:
+            iterator(const image_view *view, uint16_t y) : view_(view), y_(y) {}
+            ImageRow<Pixel> operator*() const
+            {
+                return ImageRow<Pixel>(image_view_row(view_, y_), view_->width);
+            }
+            iterator &operator++()
+            {
+                y_++;
+                return *this;
+            }
+            bool operator!=(const iterator &other) const { return y_ != other.y_; }
+
+        private:
+            const image_view *view_;
+            uint16_t y_;
+        };
+
+        explicit Rows(const image_view *view) : view_(view) {}
+        iterator begin() const { return iterator(view_, 0); }
+        iterator end() const { return iterator(view_, view_->height); }
+
+    private:
+        const image_view *view_;
+    };
+
+    ImageView() : view_(), valid_(false) {}
+
+    explicit ImageView(const camera_buffer &buf) : view_(), valid_(false)
+    {
+        valid_ = buf.format == Pixel::format && image_view_init(&view_, &buf, Pixel::plane) == 0;
+    }
+
+    ImageView(uint8_t *data, uint32_t stride, uint16_t width, uint16_t height) : view_(), valid_(false)
+    {
+        valid_ = image_view_wrap(&view_, Pixel::format, data, stride, width, height) == 0;
+    }
+
+    bool valid() const { return valid_; }
+    uint16_t width() const { return view_.width; }
+    uint16_t height() const { return view_.height; }
+    uint32_t stride() const { return view_.stride; }
+    uint8_t *data() const { return view_.data; }
+
+    /** @brief Vista de C equivalente, para llamar a los kernels de la librería. */
+    const image_view &c_view() const { return view_; }
+
+    bool contains(int32_t x, int32_t y) const { return image_view_contains(&view_, x, y); }
+    ImageRow<Pixel> row(uint16_t y) const { return ImageRow<Pixel>(image_view_row(&view_, y), view_.width); }
+    Rows rows() const { return Rows(&view_); }
+    value_type at(uint16_t x, uint16_t y) const { return row(y)[x]; }
+    void set(uint16_t x, uint16_t y, value_type v) const { row(y).set(x, v); }
+
+    /** @brief Subvista que comparte memoria; vacía si la ventana no es válida. */
+    ImageView crop(uint16_t x, uint16_t y, uint16_t width, uint16_t height) const
+    {
+        ImageView sub;
+        sub.valid_ = valid_ && image_view_crop(&sub.view_, &view_, x, y, width, height) == 0;
+        return sub;
+    }
+
+private:
+    image_view view_;
+    bool valid_;
+};
+
+}  // namespace minivision
+
+#endif /* __VIEW_HPP__ */
@@ -0,0 +1,354 @@
+/**
+ * @file warp.c
+ * @brief Implementación de la rectificación por homografía en punto fijo.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+
+#include "camera/format.h"
+#include "runtime/placement.h"
+#include "vision/warp.h"
+
+#define WARP_MAX_W_RATIO 64       /**< Relación máxima entre el mayor y el menor W de la salida */
+#define WARP_MAX_COORD   16000.0f /**< Coordenada de origen máxima representable con margen en Q16 */
+
+/**
+ * @brief Pasa la matriz a punto fijo, con W normalizada y los centros de píxel incluidos.
+ * @return 0 en éxito, -1 en error.
+ */
+int warp_init(struct warp *warp, const float h[9], uint16_t width, uint16_t height)
+{
+	if (!width || !height) {
+		return -1;
+	}
+
+	// Centros de píxel: se evalúa en (u + 0.5, v + 0.5)
+	float m[9];
+	for (int r = 0; r < 3; r++) {
+		m[3 * r] = h[3 * r];
+		m[3 * r + 1] = h[3 * r + 1];
+		m[3 * r + 2] = h[3 * r + 2] + 0.5f * (h[3 * r] + h[3 * r + 1]);
+	}
+
+	// W es afín: sus extremos están en las esquinas. Los tramos pueden pasar
+	// del borde derecho hasta WARP_SPAN píxeles.
+	const float us[2] = { 0.0f, (float)width + WARP_SPAN };
+	const float vs[2] = { 0.0f, (float)height };
+	float w_min = INFINITY, w_max = -INFINITY, coord_max = 0.0f;
+
+	for (int i = 0; i < 4; i++) {
+		float u = us[i & 1], v = vs[i >> 1];
+		float w = m[6] * u + m[7] * v + m[8];
+		w_min = fminf(w_min, w);
+		w_max = fmaxf(w_max, w);
+	}
+
+	// Todo W con el mismo signo; si es negativo se cambia el signo de la matriz
+	if (w_max <= 0.0f) {
+		for (int i = 0; i < 9; i++) {
+			m[i] = -m[i];
+		}
+		float t = w_min;
+		w_min = -w_max;
+		w_max = -t;
+	}
+	if (w_min <= 0.0f || w_max > w_min * WARP_MAX_W_RATIO) {
+		return -1;
+	}
+
+	for (int i = 0; i < 9; i++) {
+		m[i] /= w_max;
+	}
+	for (int i = 0; i < 4; i++) {
+		float u = us[i & 1], v = vs[i >> 1];
+		float w = m[6] * u + m[7] * v + m[8];
+		coord_max = fmaxf(coord_max, fabsf((m[0] * u + m[1] * v + m[2]) / w));
+		coord_max = fmaxf(coord_max, fabsf((m[3] * u + m[4] * v + m[5]) / w));
+	}
+	if (coord_max > WARP_MAX_COORD) {
+		return -1;
+	}
+
+	*warp = (struct warp){
+		.width = width,
+		.height = height,
+		.x_u = lroundf(m[0] * 65536.0f),
+		.x_v = lroundf(m[1] * 65536.0f),
+		.x_0 = lroundf(m[2] * 65536.0f),
+		.y_u = lroundf(m[3] * 65536.0f),
+		.y_v = lroundf(m[4] * 65536.0f),
+		.y_0 = lroundf(m[5] * 65536.0f),
+		.w_u = lroundf(m[6] * 1073741824.0f),
+		.w_v = lroundf(m[7] * 1073741824.0f),
+		.w_0 = lroundf(m[8] * 1073741824.0f),
+	};
+
+	return 0;
+}
+
+/**
+ * @brief Homografía del cuadrado unidad al cuadrilátero (Heckbert), por filas.
+ * @return 0 en éxito, -1 si el cuadrilátero es degenerado.
+ */
+static int __warp_square_to_quad(const float quad[4][2], float m[9])
+{
+	const float x0 = quad[0][0], y0 = quad[0][1];
+	const float x1 = quad[1][0], y1 = quad[1][1];
+	const float x2 = quad[2][0], y2 = quad[2][1];
+	const float x3 = quad[3][0], y3 = quad[3][1];
+	const float dx1 = x1 - x2, dx2 = x3 - x2, dx3 = x0 - x1 + x2 - x3;
+	const float dy1 = y1 - y2, dy2 = y3 - y2, dy3 = y0 - y1 + y2 - y3;
+	float g = 0.0f, k = 0.0f;
+
+	if (dx3 != 0.0f || dy3 != 0.0f) {
+		float det = dx1 * dy2 - dx2 * dy1;
+		if (det == 0.0f) {
+			return -1;
+		}
+		g = (dx3 * dy2 - dx2 * dy3) / det;
+		k = (dx1 * dy3 - dx3 * dy1) / det;
+	}
+
+	m[0] = x1 - x0 + g * x1;
+	m[1] = x3 - x0 + k * x3;
+	m[2] = x0;
+	m[3] = y1 - y0 + g * y1;
+	m[4] = y3 - y0 + k * y3;
+	m[5] = y0;
+	m[6] = g;
+	m[7] = k;
+	m[8] = 1.0f;
+
+	return 0;
+}
+
+/**
+ * @brief Homografía del cuadrado unidad al cuadrilátero, escalada a la salida.
+ * @return 0 en éxito, -1 en error.
+ */
+int warp_init_quad(struct warp *warp, const float quad[4][2], uint16_t width, uint16_t height)
+{
+	float h[9];
+
+	if (!width || !height || __warp_square_to_quad(quad, h)) {
+		return -1;
+	}
+
+	// (s, t) en el cuadrado unidad es (u / width, v / height)
+	for (int r = 0; r < 3; r++) {
+		h[3 * r] /= width;
+		h[3 * r + 1] /= height;
+	}
+
+	return warp_init(warp, h, width, height);
+}
+
+/**
+ * @brief Homografía entre dos cuadriláteros: origen <- cuadrado unidad <- salida.
+ * @return 0 en éxito, -1 en error.
+ */
+int warp_init_points(struct warp *warp, const float out[4][2], const float src[4][2], uint16_t width,
+		     uint16_t height)
+{
+	float a[9], b[9], inv[9], h[9];
+
+	if (__warp_square_to_quad(src, a) || __warp_square_to_quad(out, b)) {
+		return -1;
+	}
+
+	// Adjunta de b: su inversa salvo escala, que la homografía no distingue
+	inv[0] = b[4] * b[8] - b[5] * b[7];
+	inv[1] = b[2] * b[7] - b[1] * b[8];
+	inv[2] = b[1] * b[5] - b[2] * b[4];
+	inv[3] = b[5] * b[6] - b[3] * b[8];
+	inv[4] = b[0] * b[8] - b[2] * b[6];
+	inv[5] = b[2] * b[3] - b[0] * b[5];
+	inv[6] = b[3] * b[7] - b[4] * b[6];
+	inv[7] = b[1] * b[6] - b[0] * b[7];
+	inv[8] = b[0] * b[4] - b[1] * b[3];
+
+	for (int r = 0; r < 3; r++) {
+		for (int c = 0; c < 3; c++) {
+			h[3 * r + c] = a[3 * r] * inv[c] + a[3 * r + 1] * inv[3 + c] + a[3 * r + 2] * inv[6 + c];
+		}
+	}
+
+	return warp_init(warp, h, width, height);
+}
+
+/**
+ * @brief Posición de origen en Q16 de la columna u de una fila (X, Y y W de la fila en u = 0).
+ *
+ * W se normaliza a [2^29, 2^30) con a lo sumo log2(WARP_MAX_W_RATIO)
+ * desplazamientos, de modo que su recíproco de 32 bits conserva 16 bits
+ * significativos.
+ */
+static inline void __warp_point(const struct warp *warp, int32_t xr, int32_t yr, int32_t wr, int32_t u, int32_t *x,
+				int32_t *y)
+{
+	int32_t w = wr + warp->w_u * u;
+	int s = 0;
+
+	while (w < (1 << 29)) {
+		w <<= 1;
+		s++;
+	}
+
+	// recip = 2^32 / (W 2^(16 + s)), redondeado hacia arriba
+	uint32_t recip = 0xffffffffu / (uint32_t)(w >> 14) + 1;
+	*x = ((int64_t)(xr + warp->x_u * u) * recip) >> (16 - s);
+	*y = ((int64_t)(yr + warp->y_u * u) * recip) >> (16 - s);
+}
+
+/**
+ * @brief Posición de origen del centro de un píxel de salida.
+ */
+void warp_map(const struct warp *warp, uint16_t u, uint16_t v, int32_t *x, int32_t *y)
+{
+	__warp_point(warp, warp->x_v * v + warp->x_0, warp->y_v * v + warp->y_0, warp->w_v * v + warp->w_0, u, x, y);
+}
+
+static inline uint16_t __warp_rgb565be_at(const uint8_t *src, uint32_t stride, int32_t x, int32_t y)
+{
+	const uint8_t *p = src + (uint32_t)y * stride + 2 * x;
+	return (p[0] << 8) | p[1];
+}
+
+/**
+ * @brief Mezcla de dos píxeles RGB565 con un peso de 5 bits, con los canales separados en una palabra.
+ */
+static inline uint32_t __warp_lerp565(uint32_t a, uint32_t b, uint32_t f)
+{
+	return ((a * (32 - f) + b * f) >> 5) & 0x07e0f81f;
+}
+
+static inline uint32_t __warp_spread565(uint16_t v)
+{
+	return (v | ((uint32_t)v << 16)) & 0x07e0f81f;
+}
+
+/**
+ * @brief Recorre la salida por tramos (expandida por formato y filtro).
+ */
+static inline __attribute__((always_inline)) void __warp_rows(const struct warp *warp, uint8_t *dst,
+							      uint32_t dst_stride, const struct camera_buffer *src,
+							      uint8_t step, bool rgb565, bool bilinear)
+{
+	const int32_t sw = src->width;
+	const int32_t sh = src->height;
+	const uint32_t stride = src->strides[0];
+	const uint8_t *data = src->data[0];
+
+	for (int32_t v = 0; v < warp->height; v++) {
+		const int32_t xr = warp->x_v * v + warp->x_0;
+		const int32_t yr = warp->y_v * v + warp->y_0;
+		const int32_t wr = warp->w_v * v + warp->w_0;
+		uint8_t *out = dst + (uint32_t)v * dst_stride;
+		int32_t x0, y0, x1, y1;
+
+		__warp_point(warp, xr, yr, wr, 0, &x0, &y0);
+
+		for (int32_t u = 0; u < warp->width;) {
+			int32_t u_end = u + WARP_SPAN < warp->width ? u + WARP_SPAN : warp->width;
+
+			__warp_point(warp, xr, yr, wr, u + WARP_SPAN, &x1, &y1);
+			int32_t dx = (x1 - x0) >> WARP_SPAN_SHIFT;
+			int32_t dy = (y1 - y0) >> WARP_SPAN_SHIFT;
+			int32_t x = x0, y = y0;
+
+			for (; u < u_end; u++, x += dx, y += dy) {
+				int32_t sx = x >> 16, sy = y >> 16;
+
+				if ((uint32_t)sx >= (uint32_t)sw || (uint32_t)sy >= (uint32_t)sh) {
+					if (rgb565) {
+						out[2 * u] = out[2 * u + 1] = 0;
+					} else {
+						out[u] = 0;
+					}
+					continue;
+				}
+
+				if (!bilinear) {
+					if (rgb565) {
+						const uint8_t *p = data + (uint32_t)sy * stride + 2 * sx;
+						out[2 * u] = p[0];
+						out[2 * u + 1] = p[1];
+					} else {
+						out[u] = data[(uint32_t)sy * stride + (uint32_t)sx * step];
+					}
+					continue;
+				}
+
+				// Vecinos alrededor de (x - 0.5, y - 0.5), replicando el borde
+				int32_t bx = x - (1 << 15), by = y - (1 << 15);
+				int32_t xa = bx >> 16, ya = by >> 16;
+				int32_t xb = xa + 1, yb = ya + 1;
+				xa = xa < 0 ? 0 : xa;
+				ya = ya < 0 ? 0 : ya;
+				xb = xb >= sw ? sw - 1 : xb;
+				yb = yb >= sh ? sh - 1 : yb;
+
+				if (rgb565) {
+					uint32_t fx = (bx >> 11) & 0x1f, fy = (by >> 11) & 0x1f;
+					uint32_t top = __warp_lerp565(__warp_spread565(__warp_rgb565be_at(data, stride, xa, ya)),
+								      __warp_spread565(__warp_rgb565be_at(data, stride, xb, ya)), fx);
+					uint32_t bottom = __warp_lerp565(__warp_spread565(__warp_rgb565be_at(data, stride, xa, yb)),
+									 __warp_spread565(__warp_rgb565be_at(data, stride, xb, yb)), fx);
+					uint32_t p = __warp_lerp565(top, bottom, fy);
+					uint16_t val = p | (p >> 16);
+					out[2 * u] = val >> 8;
+					out[2 * u + 1] = val & 0xff;
+				} else {
+					uint32_t fx = (bx >> 8) & 0xff, fy = (by >> 8) & 0xff;
+					const uint8_t *ra = data + (uint32_t)ya * stride;
+					const uint8_t *rb = data + (uint32_t)yb * stride;
+					uint32_t top = ra[xa * step] * (256 - fx) + ra[xb * step] * fx;
+					uint32_t bottom = rb[xa * step] * (256 - fx) + rb[xb * step] * fx;
+					out[u] = (top * (256 - fy) + bottom * fy + (1 << 15)) >> 16;
+				}
+			}
+
+			x0 = x1;
+			y0 = y1;
+		}
+	}
+}
+
+/**
+ * @brief Rectifica un frame: despacha una vez por formato y filtro.
+ * @return 0 en éxito, -1 si el formato no está soportado.
+ */
+int PLACEMENT_RAM(warp_perspective)(const struct warp *warp, uint8_t *dst, uint32_t dst_stride,
+				    const struct camera_buffer *src, enum warp_filter filter)
+{
+	bool bilinear = filter == WARP_BILINEAR;
+
+	switch (src->format) {
+	case FORMAT_RGB565:
+		if (bilinear) {
+			__warp_rows(warp, dst, dst_stride, src, FORMAT_RGB565_BPP, true, true);
+		} else {
+			__warp_rows(warp, dst, dst_stride, src, FORMAT_RGB565_BPP, true, false);
+		}
+		break;
+	case FORMAT_YUYV:
+		if (bilinear) {
+			__warp_rows(warp, dst, dst_stride, src, FORMAT_YUYV_BPP, false, true);
+		} else {
+			__warp_rows(warp, dst, dst_stride, src, FORMAT_YUYV_BPP, false, false);
+		}
+		break;
+	case FORMAT_YUV422:
+		if (bilinear) {
+			__warp_rows(warp, dst, dst_stride, src, FORMAT_YUV422_BPP, false, true);
+		} else {
+			__warp_rows(warp, dst, dst_stride, src, FORMAT_YUV422_BPP, false, false);
+		}
+		break;
+	default:
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file warp.h
+ * @brief Rectificación por homografía (transformación de perspectiva) en punto fijo.
+ *
+ * La homografía lleva cada píxel (u, v) de la salida a la posición de origen
+ * (X / W, Y / W), con X, Y y W afines en u y v. En lugar de dividir en cada
+ * píxel, cada fila se recorre en tramos de WARP_SPAN píxeles: en los extremos
+ * del tramo se calcula el recíproco de W (una división entera) y dentro del
+ * tramo las coordenadas de origen avanzan con un paso fijo en Q16. El error
+ * de la interpolación lineal dentro del tramo es de una fracción de píxel
+ * salvo con perspectivas muy fuertes.
+ *
+ * El origen es un camera_buffer RGB565 (la salida es RGB565 big-endian) o
+ * YUYV/YUV422 (la salida es la luma en Y8). Los píxeles de salida que caen
+ * fuera del origen valen 0.
+ */
+
+#ifndef __WARP_H__
+#define __WARP_H__
+
+#include <stdint.h>
+
+#include "camera/buffer.h"
+
+#define WARP_SPAN_SHIFT 4                     /**< Tramo entre divisiones: 2^n píxeles */
+#define WARP_SPAN       (1 << WARP_SPAN_SHIFT) /**< Tramo entre divisiones en píxeles */
+
+/**
+ * @enum warp_filter
+ * @brief Muestreo del origen.
+ */
+enum warp_filter {
+    WARP_NEAREST = 0,  /**< Vecino más cercano */
+    WARP_BILINEAR,     /**< Interpolación bilineal de los cuatro vecinos */
+};
+
+/**
+ * @struct warp
+ * @brief Homografía en punto fijo para un tamaño de salida.
+ *
+ * X = x_u u + x_v v + x_0 y lo mismo para Y (Q16) y W (Q30, normalizada a un
+ * máximo de 1 en la salida), con los centros de píxel ya incluidos.
+ */
+struct warp {
+    uint16_t width;   /**< Ancho de la salida */
+    uint16_t height;  /**< Alto de la salida */
+    int32_t x_u;      /**< Coeficientes de X (Q16) */
+    int32_t x_v;
+    int32_t x_0;
+    int32_t y_u;      /**< Coeficientes de Y (Q16) */
+    int32_t y_v;
+    int32_t y_0;
+    int32_t w_u;      /**< Coeficientes de W (Q30) */
+    int32_t w_v;
+    int32_t w_0;
+};
+
+/**
+ * @brief Prepara una homografía dada como matriz.
+ *
+ * h lleva (u, v, 1) de la salida, con u y v en píxeles desde la esquina
+ * superior izquierda, a (x, y, w) en el origen, por filas.
+ *
+ * @param warp   Homografía en punto fijo
+ * @param h      Matriz 3x3 por filas
+ * @param width  Ancho de la salida
+ * @param height Alto de la salida
+ * @return 0 en éxito, -1 si la salida cruza el horizonte, la perspectiva es
+ *         demasiado fuerte o las coordenadas no caben en Q16
+ */
+int warp_init(struct warp *warp, const float h[9], uint16_t width, uint16_t height);
+
+/**
+ * @brief Prepara la homografía que lleva un cuadrilátero del origen a toda la salida.
+ * @param warp   Homografía en punto fijo
+ * @param quad   Esquinas en el origen, en píxeles: superior izquierda, superior derecha,
+ *               inferior derecha, inferior izquierda
+ * @param width  Ancho de la salida
+ * @param height Alto de la salida
+ * @return 0 en éxito, -1 si el cuadrilátero es degenerado o como en warp_init()
+ */
+int warp_init_quad(struct warp *warp, const float quad[4][2], uint16_t width, uint16_t height);
+
+/**
+ * @brief Prepara la homografía que lleva cuatro puntos de la salida a cuatro puntos del origen.
+ *
+ * Los puntos van en el mismo orden en los dos arreglos y deben formar
+ * cuadriláteros convexos recorridos en el mismo sentido. Las coordenadas de
+ * salida son continuas: el centro del píxel (u, v) es (u + 0.5, v + 0.5).
+ *
+ * @param warp   Homografía en punto fijo
+ * @param out    Puntos en la salida, en píxeles
+ * @param src    Puntos correspondientes en el origen, en píxeles
+ * @param width  Ancho de la salida
+ * @param height Alto de la salida
+ * @return 0 en éxito, -1 si algún cuadrilátero es degenerado o como en warp_init()
+ */
+int warp_init_points(struct warp *warp, const float out[4][2], const float src[4][2], uint16_t width,
+                     uint16_t height);
+
+/**
+ * @brief Calcula la posición de origen del centro de un píxel de salida.
+ *
+ * Para muestrear unos pocos puntos (por ejemplo los módulos de un código)
+ * sin rectificar la imagen entera. Cuesta una división.
+ *
+ * @param warp Homografía preparada
+ * @param u    Columna de salida (< width)
+ * @param v    Fila de salida (< height)
+ * @param x    Columna de origen en Q16
+ * @param y    Fila de origen en Q16
+ */
+void warp_map(const struct warp *warp, uint16_t u, uint16_t v, int32_t *x, int32_t *y);
+
+/**
+ * @brief Rectifica un frame.
+ * @param warp       Homografía preparada para el tamaño de la salida
+ * @param dst        Destino: RGB565 big-endian para origen RGB565, Y8 para YUYV/YUV422
+ * @param dst_stride Stride del destino en bytes
+ * @param src        Frame de origen (solo se lee el plano 0)
+ * @param filter     Muestreo
+ * @return 0 en éxito, -1 si el formato no está soportado
+ */
+int warp_perspective(const struct warp *warp, uint8_t *dst, uint32_t dst_stride, const struct camera_buffer *src,
+                     enum warp_filter filter);
+
+#endif /* __WARP_H__ */